@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+#######################################################################
+# compare_outputs.py
+#
+# Compares the ASCII output files of two vicNl runs (e.g. a reference
+# run and a run with FORCE_PRECISION FLOAT or SHORT), and reports, for
+# each output variable, the maximum absolute difference, the RMS
+# difference, and the maximum absolute difference relative to the
+# range of the variable in the reference run.  Variables are named from
+# the file headers (PRT_HEADER TRUE); otherwise they are numbered by
+# column.  Date columns are compared too, and must match exactly.
+#
+# Usage:
+#   compare_outputs.py [-a] [-r maxrel] refdir testdir
+#
+# By default the variables of all files are summarized over all files
+# with the same prefix (e.g. all fluxes_* files); -a lists every file.
+# With -r, the exit status is 1 if the relative difference of any
+# variable exceeds maxrel.
+#
+# Written by Keith Mathews, October 2026
+#
+# Modifications:
+#######################################################################
+
+import argparse
+import math
+import os
+import sys
+
+
+def read_output(fname):
+    """Returns (column names, rows of floats) of an ASCII output file."""
+    names = None
+    rows = []
+    with open(fname) as f:
+        for line in f:
+            if line.startswith("#"):
+                fields = line[1:].split()
+                if fields and fields[0] == "YEAR":
+                    names = fields
+                continue
+            if line.strip():
+                rows.append([float(x) for x in line.split()])
+    ncols = len(rows[0]) if rows else 0
+    if names is None or len(names) != ncols:
+        names = ["COL_%d" % i for i in range(ncols)]
+    return names, rows
+
+
+def compare_file(ref, test):
+    """Returns {name: [max abs, sum sq, n, ref min, ref max]}."""
+    names, ref_rows = read_output(ref)
+    test_names, test_rows = read_output(test)
+    if len(ref_rows) != len(test_rows) or len(names) != len(test_names):
+        sys.exit("compare_outputs.py: %s and %s differ in shape" % (ref, test))
+    stats = dict((n, [0.0, 0.0, 0, math.inf, -math.inf]) for n in names)
+    for r, t in zip(ref_rows, test_rows):
+        for n, a, b in zip(names, r, t):
+            s = stats[n]
+            d = abs(a - b)
+            s[0] = max(s[0], d)
+            s[1] += d * d
+            s[2] += 1
+            s[3] = min(s[3], a)
+            s[4] = max(s[4], a)
+    return stats
+
+
+def merge(total, stats):
+    for n, s in stats.items():
+        if n not in total:
+            total[n] = list(s)
+        else:
+            t = total[n]
+            t[0] = max(t[0], s[0])
+            t[1] += s[1]
+            t[2] += s[2]
+            t[3] = min(t[3], s[3])
+            t[4] = max(t[4], s[4])
+
+
+def report(title, stats):
+    """Prints stats, and returns the largest relative difference."""
+    print(title)
+    print("  %-24s %12s %12s %12s %12s"
+          % ("VARIABLE", "MAX_ABS", "RMS", "REF_RANGE", "MAX_REL"))
+    worst = 0.0
+    for n, (maxabs, sumsq, cnt, lo, hi) in stats.items():
+        rng = hi - lo
+        rel = maxabs / rng if rng > 0 else (0.0 if maxabs == 0 else math.inf)
+        if n not in ("YEAR", "MONTH", "DAY", "HOUR"):
+            worst = max(worst, rel)
+        elif maxabs != 0:
+            sys.exit("compare_outputs.py: dates differ in %s" % title)
+        print("  %-24s %12.4g %12.4g %12.4g %12.4g"
+              % (n, maxabs, math.sqrt(sumsq / cnt) if cnt else 0., rng, rel))
+    return worst
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare the ASCII output files of two VIC runs.")
+    parser.add_argument("refdir", help="result directory of the reference run")
+    parser.add_argument("testdir", help="result directory of the test run")
+    parser.add_argument("-a", "--all", action="store_true",
+                        help="report every file rather than every prefix")
+    parser.add_argument("-r", "--maxrel", type=float,
+                        help="fail if any relative difference exceeds this")
+    args = parser.parse_args()
+
+    files = sorted(f for f in os.listdir(args.refdir)
+                   if os.path.isfile(os.path.join(args.refdir, f)))
+    if not files:
+        sys.exit("compare_outputs.py: no files in %s" % args.refdir)
+
+    groups = {}
+    for f in files:
+        test = os.path.join(args.testdir, f)
+        if not os.path.exists(test):
+            sys.exit("compare_outputs.py: %s not found" % test)
+        stats = compare_file(os.path.join(args.refdir, f), test)
+        key = f if args.all else f.split("_")[0]
+        merge(groups.setdefault(key, {}), stats)
+
+    worst = 0.0
+    for key in sorted(groups):
+        worst = max(worst, report(key, groups[key]))
+    print("Largest relative difference: %.4g" % worst)
+    if args.maxrel is not None and worst > args.maxrel:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
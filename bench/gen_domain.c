@@ -0,0 +1,369 @@
+/**********************************************************************
+  gen_domain.c		Keith Mathews			October 2026
+
+  Generates a synthetic but physically plausible VIC input domain for
+  benchmarking: soil parameter file, veg parameter files, veg library
+  files, snow band file, lake parameter file, and daily forcing files
+  (PREC, TMAX, TMIN, WIND) in either ASCII or binary format.
+
+  Cells are laid out on a regular 0.5-degree grid between 40N and 60N.
+  The mix of lakes, elevation bands, veg tiles, and frozen-soil cells is
+  controlled from the command line.  All random numbers come from a
+  fixed-seed generator, so the same arguments always produce the same
+  files.
+
+  Usage:
+    gen_domain -o <outdir> [-n ncells] [-y nyears] [-s startyear]
+               [-l lake_frac] [-b max_bands] [-t max_tiles]
+               [-f frozen_frac] [-F ascii|binary] [-r seed]
+
+  Files written to <outdir>:
+    soil.txt            soil parameters (3 layers)
+    vegparam.txt        veg parameters (3 root zones)
+    vegparam_blow.txt   veg parameters with BLOWING terms
+    veglib.txt          veg library
+    veglib_photo.txt    veg library with photosynthesis parameters
+    snowband.txt        snow band parameters (max_bands bands)
+    lakeparam.txt       lake parameters
+    forcing/data_<lat>_<lng>  daily forcings, 4 decimal places
+
+  Modifications:
+**********************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define PI          3.14159265358979
+#define RES         0.5
+#define NLAYER      3
+#define NVEGCLASS   5
+#define WETLAND     5
+
+static unsigned long long rng_state;
+
+static double urand()
+{
+  /* xorshift64* */
+  rng_state ^= rng_state >> 12;
+  rng_state ^= rng_state << 25;
+  rng_state ^= rng_state >> 27;
+  return (double)((rng_state * 2685821657736338717ULL) >> 11) / 9007199254740992.0;
+}
+
+static double nrand()
+{
+  double u1, u2;
+
+  do { u1 = urand(); } while (u1 <= 0);
+  u2 = urand();
+  return sqrt(-2. * log(u1)) * cos(2. * PI * u2);
+}
+
+static FILE *open_out(char *dir, char *name, char *mode)
+{
+  char path[2048];
+  FILE *fp;
+
+  sprintf(path, "%s/%s", dir, name);
+  if ((fp = fopen(path, mode)) == NULL) {
+    fprintf(stderr, "gen_domain: cannot open %s\n", path);
+    exit(1);
+  }
+  return fp;
+}
+
+static int is_leap(int year)
+{
+  return ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0);
+}
+
+/* Veg library: class, overstory, rarc, rmin, LAI, albedo, rough, displ,
+   wind_h, RGL, rad_atten, wind_atten, trunk_ratio, photosynthesis */
+static struct {
+  int    overstory;
+  double rarc, rmin, lai_min, lai_max, albedo, height;
+  double rgl;
+  char  *ctype;
+  double vcmax, jmax_or_k, lue;
+  char  *comment;
+} veglib[NVEGCLASS] = {
+  { 1, 60., 250., 3.4, 4.4, 0.12, 20., 30., "C3", 6.e-5, 1.2e-4, 0.25, "Evergreen_Needleleaf" },
+  { 1, 60., 125., 0.5, 5.0, 0.18, 16., 30., "C3", 9.e-5, 1.8e-4, 0.25, "Deciduous_Broadleaf" },
+  { 0,  2., 120., 0.3, 2.5, 0.20,  0.5, 100., "C4", 4.e-5, 7.0e+5, 0.04, "Grassland" },
+  { 0,  2., 120., 0.1, 3.5, 0.20,  1.0, 100., "C3", 1.e-4, 2.0e-4, 0.25, "Cropland" },
+  { 0,  2., 100., 0.5, 2.0, 0.15,  0.5, 100., "C3", 5.e-5, 1.0e-4, 0.25, "Wetland" },
+};
+
+static void write_veglib(char *dir, char *name, int photo)
+{
+  FILE  *fp;
+  int    v, m;
+  double lai, season;
+
+  fp = open_out(dir, name, "w");
+  fprintf(fp, "#Class\tOvrstry\tRarc\tRmin\tLAI(12)\tAlbedo(12)\tRough(12)\tDispl(12)\tWind_h\tRGL\trad_atn\twnd_atn\ttrnk_r");
+  if (photo)
+    fprintf(fp, "\tCtype\tVcmax\tJmax/k\tLUE\tNscale\tWnpp_inhib\tNPP_sat");
+  fprintf(fp, "\tComment\n");
+  for (v = 0; v < NVEGCLASS; v++) {
+    fprintf(fp, "%d\t%d\t%.1f\t%.1f", v+1, veglib[v].overstory,
+            veglib[v].rarc, veglib[v].rmin);
+    for (m = 0; m < 12; m++) {
+      season = 0.5 - 0.5 * cos(2. * PI * (m - 0.5) / 12.);
+      lai = veglib[v].lai_min + (veglib[v].lai_max - veglib[v].lai_min) * season;
+      fprintf(fp, "\t%.3f", lai);
+    }
+    for (m = 0; m < 12; m++)
+      fprintf(fp, "\t%.3f", veglib[v].albedo);
+    for (m = 0; m < 12; m++)
+      fprintf(fp, "\t%.4f", 0.123 * veglib[v].height);
+    for (m = 0; m < 12; m++)
+      fprintf(fp, "\t%.4f", 0.67 * veglib[v].height);
+    fprintf(fp, "\t%.1f\t%.1f\t0.5\t0.5\t0.2",
+            veglib[v].overstory ? veglib[v].height + 10. : 2., veglib[v].rgl);
+    if (photo)
+      fprintf(fp, "\t%s\t%.2e\t%.2e\t%.3f\t1\t0.7\t0.1", veglib[v].ctype,
+              veglib[v].vcmax, veglib[v].jmax_or_k, veglib[v].lue);
+    fprintf(fp, "\t%s\n", veglib[v].comment);
+  }
+  fclose(fp);
+}
+
+static void write_forcing(char *dir, char *binary, double lat, double lng,
+                          double elev, double annual_prec, int startyear,
+                          int nyears)
+{
+  char   name[1024];
+  FILE  *fp;
+  int    year, doy, ndays;
+  int    wet = 0;
+  double tmean, trange, prec, wind;
+  double tmax, tmin;
+  double p_wet;
+  double mean_amt;
+  unsigned short us;
+  short  ss;
+
+  sprintf(name, "forcing/data_%.4f_%.4f", lat, lng);
+  fp = open_out(dir, name, binary ? "wb" : "w");
+
+  p_wet = 0.35;
+  mean_amt = annual_prec / (365. * p_wet);
+  for (year = startyear; year < startyear + nyears; year++) {
+    ndays = is_leap(year) ? 366 : 365;
+    for (doy = 0; doy < ndays; doy++) {
+      tmean = 25. - 0.75 * (lat - 30.) - 0.0065 * elev
+              - (8. + 0.3 * (lat - 40.)) * cos(2. * PI * (doy - 15) / 365.25)
+              + 2.5 * nrand();
+      trange = 11. + 3. * sin(2. * PI * (doy - 100) / 365.25) + 1.5 * nrand();
+      if (trange < 2.) trange = 2.;
+      tmax = tmean + 0.5 * trange;
+      tmin = tmean - 0.5 * trange;
+      wet = urand() < (wet ? 0.6 : p_wet * 0.4 / 0.65);
+      prec = wet ? -mean_amt * log(1. - urand()) : 0.;
+      if (prec > 150.) prec = 150.;
+      wind = exp(log(3.) + 0.4 * nrand());
+      if (wind > 30.) wind = 30.;
+      if (binary) {
+        us = (unsigned short)(prec * 40. + 0.5);
+        fwrite(&us, sizeof(us), 1, fp);
+        ss = (short)floor(tmax * 100. + 0.5);
+        fwrite(&ss, sizeof(ss), 1, fp);
+        ss = (short)floor(tmin * 100. + 0.5);
+        fwrite(&ss, sizeof(ss), 1, fp);
+        ss = (short)floor(wind * 100. + 0.5);
+        fwrite(&ss, sizeof(ss), 1, fp);
+      }
+      else
+        fprintf(fp, "%.2f\t%.2f\t%.2f\t%.2f\n", prec, tmax, tmin, wind);
+    }
+  }
+  fclose(fp);
+}
+
+int main(int argc, char *argv[])
+{
+  char   *outdir = NULL;
+  char    path[1024];
+  int     ncells = 10;
+  int     nyears = 2;
+  int     startyear = 2000;
+  double  lake_frac = 0.2;
+  int     max_bands = 5;
+  int     max_tiles = 4;
+  double  frozen_frac = 0.5;
+  int     binary = 0;
+  int     opt;
+  int     cell, l, b, t, z, ncol;
+  int     nbands, ntiles, has_lake, frozen;
+  int     classes[NVEGCLASS];
+  double  lat, lng, elev, relief, annual_prec, avg_T;
+  double  depth[NLAYER] = { 0.1, 0.4, 1.0 };
+  double  bulk, soil_dens, porosity, init_moist;
+  double  cv[NVEGCLASS], sum, lake_cv;
+  double  area[16], band_elev[16], pfact[16];
+  FILE   *soil, *veg, *vegb, *band, *lake;
+
+  rng_state = 88172645463325252ULL;
+
+  while ((opt = getopt(argc, argv, "o:n:y:s:l:b:t:f:F:r:")) != -1) {
+    switch (opt) {
+    case 'o': outdir = optarg; break;
+    case 'n': ncells = atoi(optarg); break;
+    case 'y': nyears = atoi(optarg); break;
+    case 's': startyear = atoi(optarg); break;
+    case 'l': lake_frac = atof(optarg); break;
+    case 'b': max_bands = atoi(optarg); break;
+    case 't': max_tiles = atoi(optarg); break;
+    case 'f': frozen_frac = atof(optarg); break;
+    case 'F': binary = (strcasecmp(optarg, "binary") == 0); break;
+    case 'r': rng_state ^= (unsigned long long)atol(optarg) * 0x9E3779B97F4A7C15ULL; break;
+    default:
+      fprintf(stderr, "Usage: %s -o outdir [-n ncells] [-y nyears] [-s startyear] [-l lake_frac] [-b max_bands] [-t max_tiles] [-f frozen_frac] [-F ascii|binary] [-r seed]\n", argv[0]);
+      exit(1);
+    }
+  }
+  if (outdir == NULL || ncells < 1 || nyears < 1) {
+    fprintf(stderr, "gen_domain: -o outdir is required; ncells and nyears must be >= 1\n");
+    exit(1);
+  }
+  if (max_bands < 1) max_bands = 1;
+  if (max_bands > 10) max_bands = 10;
+  if (max_tiles < 1) max_tiles = 1;
+  if (max_tiles > NVEGCLASS - 1) max_tiles = NVEGCLASS - 1;
+
+  mkdir(outdir, 0755);
+  sprintf(path, "%s/forcing", outdir);
+  mkdir(path, 0755);
+
+  write_veglib(outdir, "veglib.txt", 0);
+  write_veglib(outdir, "veglib_photo.txt", 1);
+
+  soil = open_out(outdir, "soil.txt", "w");
+  veg  = open_out(outdir, "vegparam.txt", "w");
+  vegb = open_out(outdir, "vegparam_blow.txt", "w");
+  band = open_out(outdir, "snowband.txt", "w");
+  lake = open_out(outdir, "lakeparam.txt", "w");
+
+  ncol = (int)ceil(sqrt((double)ncells));
+  for (cell = 0; cell < ncells; cell++) {
+
+    lat = 40.25 + fmod(RES * (cell / ncol), 20.);
+    lng = -120.25 + RES * (cell % ncol);
+    elev = 200. + 2500. * urand() * urand();
+    relief = (elev > 1000.) ? 1500. * urand() : 200. * urand();
+    annual_prec = 400. + 1200. * urand() + 0.3 * elev;
+    avg_T = 25. - 0.75 * (lat - 30.) - 0.0065 * elev;
+    frozen = urand() < frozen_frac;
+    has_lake = urand() < lake_frac;
+    nbands = (relief > 500.) ? max_bands : 1;
+    ntiles = 1 + (int)(urand() * max_tiles);
+    if (ntiles > max_tiles) ntiles = max_tiles;
+
+    /* soil parameters */
+    fprintf(soil, "1\t%d\t%.4f\t%.4f\t%.3f\t%.4f\t%.3f\t%.3f\t2", cell+1,
+            lat, lng, 0.05 + 0.3 * urand(), 0.001 + 0.05 * urand(),
+            5. + 25. * urand(), 0.5 + 0.45 * urand());
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t%.2f", 10. + 4. * urand());
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t%.1f", 50. + 1000. * urand());
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t-999");
+    bulk = 1400. + 200. * urand();
+    soil_dens = 2685.;
+    porosity = 1. - bulk / soil_dens;
+    for (l = 0; l < NLAYER; l++) {
+      init_moist = 0.6 * porosity * depth[l] * 1000.;
+      fprintf(soil, "\t%.2f", init_moist);
+    }
+    fprintf(soil, "\t%.1f", elev);
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t%.2f", depth[l]);
+    fprintf(soil, "\t%.2f\t4.0", avg_T);
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t%.2f", 10. + 30. * urand());
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t%.2f", 0.2 + 0.6 * urand());
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t%.1f", bulk);
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t%.1f", soil_dens);
+    fprintf(soil, "\t%.2f", lng * 24. / 360.);
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t%.3f", 0.65 + 0.1 * urand());
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t%.3f", 0.3 + 0.1 * urand());
+    fprintf(soil, "\t0.001\t0.0005\t%.1f", annual_prec);
+    for (l = 0; l < NLAYER; l++) fprintf(soil, "\t0.02");
+    fprintf(soil, "\t%d\n", frozen);
+
+    /* veg tiles: random distinct classes from 1..NVEGCLASS-1; lake cells
+       get an extra wetland tile */
+    for (t = 0; t < NVEGCLASS - 1; t++) classes[t] = t + 1;
+    for (t = 0; t < NVEGCLASS - 1; t++) {
+      z = t + (int)(urand() * (NVEGCLASS - 1 - t));
+      if (z > NVEGCLASS - 2) z = NVEGCLASS - 2;
+      b = classes[t]; classes[t] = classes[z]; classes[z] = b;
+    }
+    lake_cv = has_lake ? 0.1 + 0.3 * urand() : 0.;
+    sum = 0;
+    for (t = 0; t < ntiles; t++) {
+      cv[t] = 0.2 + urand();
+      sum += cv[t];
+    }
+    for (t = 0; t < ntiles; t++) cv[t] *= (1. - lake_cv) / sum;
+    fprintf(veg, "%d %d\n", cell+1, ntiles + has_lake);
+    fprintf(vegb, "%d %d\n", cell+1, ntiles + has_lake);
+    for (t = 0; t < ntiles + has_lake; t++) {
+      int    vc = (t < ntiles) ? classes[t] : WETLAND;
+      double c  = (t < ntiles) ? cv[t] : lake_cv;
+      char  *roots = veglib[vc-1].overstory ?
+                     "0.30 0.20 0.70 0.50 0.50 0.30" :
+                     "0.10 0.40 0.50 0.50 0.40 0.10";
+      fprintf(veg, "\t%d %.6f %s\n", vc, c, roots);
+      fprintf(vegb, "\t%d %.6f %s %.3f %.3f %.1f\n", vc, c, roots,
+              0.02 + 0.1 * urand(), 0.5 + 0.4 * urand(), 500. + 1500. * urand());
+    }
+
+    /* snow bands: nbands bands spanning +/- relief/2 around elev */
+    for (b = 0; b < max_bands; b++) {
+      if (b < nbands) {
+        area[b] = 1. / nbands;
+        band_elev[b] = elev + relief * ((b + 0.5) / nbands - 0.5);
+        pfact[b] = area[b] * (1. + 0.3 * ((b + 0.5) / nbands - 0.5) * relief / 1000.);
+      }
+      else {
+        area[b] = 0.;
+        band_elev[b] = elev;
+        pfact[b] = 0.;
+      }
+    }
+    sum = 0;
+    for (b = 0; b < nbands; b++) sum += pfact[b];
+    for (b = 0; b < nbands; b++) pfact[b] /= sum;
+    fprintf(band, "%d", cell+1);
+    for (b = 0; b < max_bands; b++) fprintf(band, "\t%.6f", area[b]);
+    for (b = 0; b < max_bands; b++) fprintf(band, "\t%.1f", band_elev[b]);
+    for (b = 0; b < max_bands; b++) fprintf(band, "\t%.6f", pfact[b]);
+    fprintf(band, "\n");
+
+    /* lake parameters: lake occupies most of the wetland tile at full depth */
+    if (has_lake) {
+      double maxdepth = 2. + 18. * urand();
+      fprintf(lake, "%d %d %d %.3f %.3f %.3f %.2f\n", cell+1, ntiles,
+              5 + (int)(5 * urand()), 0.1 * maxdepth, 0.005,
+              0.5 * maxdepth, 0.2 + 0.6 * urand());
+      fprintf(lake, "%.3f %.6f\n", maxdepth, 0.9 * lake_cv);
+    }
+    else
+      fprintf(lake, "%d -1\n", cell+1);
+
+    write_forcing(outdir, binary ? "b" : NULL, lat, lng, elev, annual_prec,
+                  startyear, nyears);
+  }
+
+  fclose(soil);
+  fclose(veg);
+  fclose(vegb);
+  fclose(band);
+  fclose(lake);
+
+  fprintf(stderr, "gen_domain: wrote %d cells, %d years, to %s\n", ncells,
+          nyears, outdir);
+  return 0;
+}
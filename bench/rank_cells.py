@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+#######################################################################
+# rank_cells.py
+#
+# Summarizes one or more per-cell cost logs written by vicNl's CELL_LOG
+# option.  Cells are ranked by cost (wall time by default), and the
+# table of the most expensive cells is printed along with the share of
+# the total cost that they account for.
+#
+# Optionally, the cells of a soil parameter file can be partitioned
+# into N groups of roughly equal total cost (greedy longest-processing-
+# time-first), so that later runs can be split across N processes with
+# balanced load.  Cells in the soil file with no record in the cost
+# logs are assigned the mean cost.  Within each group, cells are
+# written in order of decreasing cost.
+#
+# Usage:
+#   rank_cells.py [-k column] [-t ntop] [-p nparts -s soilfile -o prefix]
+#                 cell_log.csv [cell_log.csv ...]
+#
+# If several logs are given (e.g. from several runs over subsets of the
+# domain), the cost of a cell is the mean over all of its records.
+#
+# Written by Keith Mathews, October 2026
+#
+# Modifications:
+#######################################################################
+
+import argparse
+import csv
+import sys
+
+
+def read_logs(files, key):
+    """Returns {gridcel: (mean cost, last record)} from CELL_LOG files."""
+    total = {}
+    count = {}
+    record = {}
+    for fname in files:
+        with open(fname) as f:
+            for row in csv.DictReader(f):
+                if key not in row:
+                    sys.exit("rank_cells.py: column %s not found in %s"
+                             % (key, fname))
+                cell = int(row["GRIDCEL"])
+                total[cell] = total.get(cell, 0.0) + float(row[key])
+                count[cell] = count.get(cell, 0) + 1
+                record[cell] = row
+    return dict((c, (total[c] / count[c], record[c])) for c in total)
+
+
+def partition(soil_lines, cost, nparts):
+    """Assigns soil file lines to nparts groups, most expensive first."""
+    mean = sum(cost.values()) / len(cost) if cost else 1.0
+    cells = []
+    for line in soil_lines:
+        fields = line.split()
+        if len(fields) < 2 or fields[0].startswith("#"):
+            continue
+        cell = int(fields[1])
+        cells.append((cost.get(cell, mean), cell, line))
+    cells.sort(key=lambda c: -c[0])
+    loads = [0.0] * nparts
+    groups = [[] for i in range(nparts)]
+    for c in cells:
+        i = loads.index(min(loads))
+        loads[i] += c[0]
+        groups[i].append(c)
+    return groups, loads
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Rank VIC grid cells by cost from CELL_LOG files.")
+    parser.add_argument("logs", nargs="+", help="CELL_LOG file(s)")
+    parser.add_argument("-k", "--key", default="WALL_S",
+                        help="column to rank by (default WALL_S)")
+    parser.add_argument("-t", "--top", type=int, default=20,
+                        help="number of cells to list (default 20)")
+    parser.add_argument("-p", "--parts", type=int, default=0,
+                        help="number of balanced groups to write")
+    parser.add_argument("-s", "--soil", help="soil parameter file to split")
+    parser.add_argument("-o", "--prefix", default="soil.part",
+                        help="prefix of the partitioned soil files")
+    args = parser.parse_args()
+
+    cells = read_logs(args.logs, args.key)
+    if not cells:
+        sys.exit("rank_cells.py: no cell records found")
+    ranked = sorted(cells.items(), key=lambda c: -c[1][0])
+    total = sum(c[1][0] for c in ranked)
+
+    print("%d cells, total %s %.4f, mean %.4f"
+          % (len(ranked), args.key, total, total / len(ranked)))
+    print("%5s %8s %10s %11s %4s %6s %4s %12s %7s %7s"
+          % ("Rank", "GRIDCEL", "LAT", "LNG", "NVEG", "NBANDS", "LAKE",
+             args.key, "%", "Cum %"))
+    cum = 0.0
+    for rank, (cell, (value, row)) in enumerate(ranked[:args.top]):
+        cum += value
+        print("%5d %8d %10s %11s %4s %6s %4s %12.4f %7.2f %7.2f"
+              % (rank + 1, cell, row["LAT"], row["LNG"], row["NVEG"],
+                 row["NBANDS"], row["LAKE"], value,
+                 100. * value / total if total > 0 else 0.,
+                 100. * cum / total if total > 0 else 0.))
+
+    if args.parts > 0:
+        if not args.soil:
+            sys.exit("rank_cells.py: -p requires a soil parameter file (-s)")
+        with open(args.soil) as f:
+            lines = [l for l in f if l.strip()]
+        groups, loads = partition(lines,
+                                  dict((c, v[0]) for c, v in cells.items()),
+                                  args.parts)
+        for i, group in enumerate(groups):
+            fname = "%s%d" % (args.prefix, i)
+            with open(fname, "w") as f:
+                for c in group:
+                    f.write(c[2])
+            print("%s: %d cells, %s %.4f" % (fname, len(group), args.key,
+                                             loads[i]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,194 @@
+#!/bin/bash
+#######################################################################
+# run_bench.sh
+#
+# Generates a synthetic domain with gen_domain and runs vicNl over a
+# fixed matrix of model configurations, collecting throughput (cell-
+# years per second), peak resident set size, and per-phase times from
+# the TIMING summary.  Results are written as JSON so that runs from
+# different commits can be compared.
+#
+# Usage:
+#   run_bench.sh [-v vicNl] [-w workdir] [-n ncells] [-y nyears]
+#                [-l lake_frac] [-c config[,config...]] [-F ascii|binary]
+#                [-o out.json]
+#
+# Configurations:
+#   wb_daily         water balance, daily time step
+#   fe_hourly        FULL_ENERGY, hourly time step
+#   frozen_implicit  FULL_ENERGY + FROZEN_SOIL + IMPLICIT, 3-hourly
+#   frozen_explicit  FULL_ENERGY + FROZEN_SOIL, explicit (Gauss-Seidel), 3-hourly
+#   frozen_newton    FULL_ENERGY + FROZEN_SOIL, explicit (Newton), 3-hourly
+#   carbon           CARBON (RC_PHOTO), 3-hourly water balance
+#   lakes            FULL_ENERGY + LAKES, 3-hourly
+#   lakes_hourly     FULL_ENERGY + LAKES, hourly
+#   blowing          FULL_ENERGY + BLOWING, 3-hourly
+#
+# A lake-dominated domain (e.g. for the lake configurations) is made
+# with -l 1, so that every cell has a lake.
+#
+# Modifications:
+# 2026-Oct-17 Added -l option and lakes_hourly configuration.	KM
+# 2026-Oct-17 Added frozen_explicit and frozen_newton configurations.	KM
+#######################################################################
+
+BENCH_DIR=$(cd "$(dirname "$0")" && pwd)
+VIC=$BENCH_DIR/../src/vicNl
+WORK=${TMPDIR:-/tmp}/vic_bench
+NCELLS=20
+NYEARS=2
+STARTYEAR=2000
+FORMAT=binary
+LAKE_FRAC=0.2
+CONFIGS="wb_daily,fe_hourly,frozen_implicit,carbon,lakes,blowing"
+OUT=""
+
+while getopts "v:w:n:y:l:c:F:o:" opt; do
+  case $opt in
+    v) VIC=$OPTARG ;;
+    w) WORK=$OPTARG ;;
+    n) NCELLS=$OPTARG ;;
+    y) NYEARS=$OPTARG ;;
+    l) LAKE_FRAC=$OPTARG ;;
+    c) CONFIGS=$OPTARG ;;
+    F) FORMAT=$OPTARG ;;
+    o) OUT=$OPTARG ;;
+    *) echo "Usage: $0 [-v vicNl] [-w workdir] [-n ncells] [-y nyears] [-l lake_frac] [-c configs] [-F ascii|binary] [-o out.json]" >&2
+       exit 1 ;;
+  esac
+done
+
+if [ ! -x "$VIC" ]; then
+  echo "run_bench.sh: cannot find executable $VIC; build it with 'make' in src/" >&2
+  exit 1
+fi
+
+make -s -C "$BENCH_DIR" gen_domain || exit 1
+
+DOMAIN=$WORK/domain
+mkdir -p "$WORK"
+"$BENCH_DIR/gen_domain" -o "$DOMAIN" -n "$NCELLS" -y "$NYEARS" \
+  -s "$STARTYEAR" -l "$LAKE_FRAC" -F "$FORMAT" || exit 1
+ENDYEAR=$((STARTYEAR + NYEARS - 1))
+
+# write_global <config> <global file> <result dir>
+write_global() {
+  local cfg=$1 gfile=$2 rdir=$3
+  local dt=3 full=FALSE frozen=FALSE lakes=FALSE blowing=FALSE carbon=FALSE
+  local veglib=$DOMAIN/veglib.txt vegparam=$DOMAIN/vegparam.txt
+  local nodes quick implicit=TRUE solver=GAUSS_SEIDEL
+  case $cfg in
+    wb_daily)        dt=24 ;;
+    fe_hourly)       dt=1; full=TRUE ;;
+    frozen_implicit) full=TRUE; frozen=TRUE ;;
+    frozen_explicit) full=TRUE; frozen=TRUE; implicit=FALSE ;;
+    frozen_newton)   full=TRUE; frozen=TRUE; implicit=FALSE; solver=NEWTON ;;
+    carbon)          carbon=TRUE; veglib=$DOMAIN/veglib_photo.txt ;;
+    lakes)           full=TRUE; lakes=TRUE ;;
+    lakes_hourly)    dt=1; full=TRUE; lakes=TRUE ;;
+    blowing)         full=TRUE; blowing=TRUE; vegparam=$DOMAIN/vegparam_blow.txt ;;
+    *) echo "run_bench.sh: unknown configuration $cfg" >&2; return 1 ;;
+  esac
+  # the finite-difference ground heat flux is needed for FULL_ENERGY and
+  # FROZEN_SOIL; otherwise use the simplified 3-node method
+  if [ $full = TRUE ] || [ $frozen = TRUE ]; then
+    nodes=10; quick=FALSE
+  else
+    nodes=3; quick=TRUE
+  fi
+  cat > "$gfile" <<EOF
+NLAYER		3
+NODES		$nodes
+TIME_STEP	$dt
+SNOW_STEP	$([ $dt -eq 24 ] && echo 3 || echo $dt)
+STARTYEAR	$STARTYEAR
+STARTMONTH	01
+STARTDAY	01
+STARTHOUR	00
+ENDYEAR		$ENDYEAR
+ENDMONTH	12
+ENDDAY		31
+FULL_ENERGY	$full
+FROZEN_SOIL	$frozen
+QUICK_FLUX	$quick
+IMPLICIT	$([ $quick = TRUE ] && echo FALSE || echo $implicit)
+SOIL_T_SOLVER	$solver
+EXP_TRANS	$([ $quick = TRUE ] && echo FALSE || echo TRUE)
+BLOWING		$blowing
+CARBON		$carbon
+VEGLIB_PHOTO	$carbon
+RC_MODE		$([ $carbon = TRUE ] && echo RC_PHOTO || echo RC_JARVIS)
+FORCING1	$DOMAIN/forcing/data_
+FORCE_FORMAT	$(echo $FORMAT | tr a-z A-Z)
+FORCE_ENDIAN	LITTLE
+N_TYPES		4
+FORCE_TYPE	PREC	UNSIGNED	40
+FORCE_TYPE	TMAX	SIGNED	100
+FORCE_TYPE	TMIN	SIGNED	100
+FORCE_TYPE	WIND	SIGNED	100
+FORCE_DT	24
+FORCEYEAR	$STARTYEAR
+FORCEMONTH	01
+FORCEDAY	01
+FORCEHOUR	00
+GRID_DECIMAL	4
+WIND_H		10.0
+MEASURE_H	2.0
+SOIL		$DOMAIN/soil.txt
+VEGLIB		$veglib
+VEGPARAM	$vegparam
+ROOT_ZONES	3
+SNOW_BAND	5	$DOMAIN/snowband.txt
+LAKES		$([ $lakes = TRUE ] && echo $DOMAIN/lakeparam.txt || echo FALSE)
+LAKE_PROFILE	FALSE
+RESOLUTION	0.5
+RESULT_DIR	$rdir
+OUT_STEP	0
+TIMING		PHASE
+TIMING_FILE	$rdir/../$cfg.timing.csv
+EOF
+}
+
+# now_s: wall clock in seconds
+now_s() { date +%s.%N; }
+
+JSON="{\n  \"commit\": \"$(git -C "$BENCH_DIR" rev-parse --short HEAD 2>/dev/null)\",\n"
+JSON+="  \"ncells\": $NCELLS,\n  \"nyears\": $NYEARS,\n  \"lake_frac\": $LAKE_FRAC,\n  \"forcing_format\": \"$FORMAT\",\n"
+JSON+="  \"host\": \"$(hostname)\",\n  \"date\": \"$(date -u +%Y-%m-%dT%H:%M:%SZ)\",\n"
+JSON+="  \"configs\": ["
+
+first=1
+for cfg in ${CONFIGS//,/ }; do
+  rdir=$WORK/$cfg/results
+  rm -rf "$WORK/$cfg"
+  mkdir -p "$rdir"
+  write_global "$cfg" "$WORK/$cfg/global.txt" "$rdir" || exit 1
+  echo "run_bench.sh: running $cfg" >&2
+  t0=$(now_s)
+  "$VIC" -g "$WORK/$cfg/global.txt" > "$WORK/$cfg/vic.log" 2>&1
+  status=$?
+  t1=$(now_s)
+  wall=$(awk -v a="$t0" -v b="$t1" 'BEGIN { printf("%.3f", b - a) }')
+  rss=$(sed -n 's/^Peak resident set size: \([0-9]*\) kB/\1/p' "$WORK/$cfg/vic.log")
+  phases=$(awk '
+    /^Timing Summary/ { on = 1; next }
+    on && /^Phase/ { next }
+    on && /^Peak resident/ { on = 0 }
+    on && NF == 5 {
+      printf("%s\"%s\": {\"calls\": %s, \"incl_s\": %s, \"self_s\": %s}",
+             sep, $1, $2, $3, $4); sep = ", "
+    }' "$WORK/$cfg/vic.log")
+  [ $first -eq 1 ] || JSON+=","
+  first=0
+  JSON+="\n    {\"name\": \"$cfg\", \"status\": $status, \"wall_s\": $wall,"
+  JSON+=" \"cell_years_per_s\": $(awk -v n="$NCELLS" -v y="$NYEARS" -v w="$wall" 'BEGIN { printf("%.4f", n * y / (w > 0 ? w : 1e-3)) }'),"
+  JSON+=" \"peak_rss_kb\": ${rss:-null}, \"phases\": {$phases}}"
+done
+JSON+="\n  ]\n}\n"
+
+if [ -n "$OUT" ]; then
+  printf "$JSON" > "$OUT"
+  echo "run_bench.sh: results written to $OUT" >&2
+else
+  printf "$JSON"
+fi
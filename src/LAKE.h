@@ -29,6 +29,8 @@
   2013-Jul-25 Added advect_carbon_storage().				TJB
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
+  2026-Oct-17 Added compute_lake_volumes().  get_depth(), get_sarea(),
+	      get_volume() and water_balance() take lake_con by reference.	KM
 ******************************************************************************/
 
 //#ifndef LAKE_SET
@@ -81,14 +83,15 @@ void alblake(double, double, double *, double *, float *, float *, double, doubl
 double calc_density(double);
 double CalcIcePackEnergyBalance(double Tsurf, ...);
 void colavg (double *, double *, double *, float, double *, int, double, double);
+void compute_lake_volumes(lake_con_struct *);
 float dragcoeff(float, double, double);
 void eddy (int, double, double * , double *, double *, double, int, double, double);
 void energycalc(double *, double *, int, double, double,double *, double *, double *);
 double ErrorIcePackEnergyBalance(double Tsurf, ...);
 double ErrorPrintIcePackEnergyBalance(double, va_list);
-int get_depth(lake_con_struct, double, double *);
-int get_sarea(lake_con_struct, double, double *);
-int get_volume(lake_con_struct, double, double *);
+int get_depth(lake_con_struct *, double, double *);
+int get_sarea(lake_con_struct *, double, double *);
+int get_volume(lake_con_struct *, double, double *);
 void iceform (double *,double *,double ,double,double *,int, int, double, double, double *, double *, double *, double *, double *, double);
 void icerad(double,double ,double,double *, double *,double *);
 int ice_melt(double, double, double *, double, snow_data_struct *, lake_var_struct *, int, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double *, double *, double *, double *, double *, double *, double *, double *, double *, double);
@@ -111,6 +114,6 @@ double specheat (double);
 void temp_area(double, double, double, double *, double *, double *, double *, int, double *, int, double, double, double*, double *, double *);
 void tracer_mixer(double *, int *, int, double*, int, double, double, double *);
 void tridia(int, double *, double *, double *, double *, double *);
-int water_balance (lake_var_struct *, lake_con_struct, int, all_vars_struct *, int, int, int, double, soil_con_struct, veg_con_struct);
+int water_balance (lake_var_struct *, lake_con_struct *, int, all_vars_struct *, int, int, int, double, soil_con_struct, veg_con_struct);
 int  water_energy_balance(int, double*, double*, int, int, double, double, double, double, double, double, double, double, double, double, double, double, double, double *, double *, double *, double*, double *, double *, double *, double, double *, double *, double *, double *, double *, double);
 int water_under_ice(int, double,  double, double *, double *, double, int, double, double, double, double *, double *, double *, double *, int, double, double, double, double *);
@@ -35,6 +35,7 @@ void alloc_atmos(int nrecs, atmos_data_struct **atmos)
   2010-Sep-24 Renamed runoff_in to channel_in.				TJB
   2011-Nov-04 Added tskc.						TJB
   2013-Jul-25 Added Catm, coszen, fdir, and par.			TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 
 *******************************************************************/
 {
@@ -42,61 +43,78 @@ void alloc_atmos(int nrecs, atmos_data_struct **atmos)
 
   int i;
 
-  *atmos = (atmos_data_struct *) calloc(nrecs, sizeof(atmos_data_struct)); 
+  *atmos = (atmos_data_struct *) mem_calloc(nrecs, sizeof(atmos_data_struct), MEM_ATMOS); 
   if (*atmos == NULL)
     vicerror("Memory allocation error in alloc_atmos().");
 
-  for (i = 0; i < nrecs; i++) {
-    (*atmos)[i].air_temp = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].air_temp == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].Catm = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].Catm == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].channel_in = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].channel_in == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].coszen = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].coszen == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].density = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].density == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].fdir = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].fdir == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].longwave = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].longwave == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].par = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].par == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].prec = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].prec == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");      
-    (*atmos)[i].pressure = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].pressure == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].shortwave = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].shortwave == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].snowflag = (char *) calloc(NR+1, sizeof(char));	
-    if ((*atmos)[i].snowflag == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].tskc = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].tskc == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].vp = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].vp == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].vpd = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].vpd == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].wind = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].wind == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-  }    			
+  /* Each field is one block over all records; atmos[i] points into it */
+  (*atmos)[0].air_temp = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].air_temp == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].Catm = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].Catm == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].channel_in = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].channel_in == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].coszen = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].coszen == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].density = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].density == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].fdir = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].fdir == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].longwave = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].longwave == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].par = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].par == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].prec = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].prec == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].pressure = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].pressure == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].shortwave = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].shortwave == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].snowflag = (char *) mem_calloc(nrecs*(NR+1), sizeof(char), MEM_ATMOS);
+  if ((*atmos)[0].snowflag == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].tskc = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].tskc == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].vp = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].vp == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].vpd = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].vpd == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  (*atmos)[0].wind = (double *) mem_calloc(nrecs*(NR+1), sizeof(double), MEM_ATMOS);
+  if ((*atmos)[0].wind == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
 
+  for (i = 1; i < nrecs; i++) {
+    (*atmos)[i].air_temp = (*atmos)[0].air_temp + i*(NR+1);
+    (*atmos)[i].Catm = (*atmos)[0].Catm + i*(NR+1);
+    (*atmos)[i].channel_in = (*atmos)[0].channel_in + i*(NR+1);
+    (*atmos)[i].coszen = (*atmos)[0].coszen + i*(NR+1);
+    (*atmos)[i].density = (*atmos)[0].density + i*(NR+1);
+    (*atmos)[i].fdir = (*atmos)[0].fdir + i*(NR+1);
+    (*atmos)[i].longwave = (*atmos)[0].longwave + i*(NR+1);
+    (*atmos)[i].par = (*atmos)[0].par + i*(NR+1);
+    (*atmos)[i].prec = (*atmos)[0].prec + i*(NR+1);
+    (*atmos)[i].pressure = (*atmos)[0].pressure + i*(NR+1);
+    (*atmos)[i].shortwave = (*atmos)[0].shortwave + i*(NR+1);
+    (*atmos)[i].snowflag = (*atmos)[0].snowflag + i*(NR+1);
+    (*atmos)[i].tskc = (*atmos)[0].tskc + i*(NR+1);
+    (*atmos)[i].vp = (*atmos)[0].vp + i*(NR+1);
+    (*atmos)[i].vpd = (*atmos)[0].vpd + i*(NR+1);
+    (*atmos)[i].wind = (*atmos)[0].wind + i*(NR+1);
+  }
 }
 
 /****************************************************************************/
@@ -116,6 +134,8 @@ void free_atmos(int nrecs, atmos_data_struct **atmos)
   2010-Sep-24 Renamed runoff_in to channel_in.				TJB
   2011-Nov-04 Added tskc.						TJB
   2013-Jul-25 Added Catm, coszen, fdir, and par.			TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
+  2026-Oct-17 Each array is freed as one block over all records.	KM
 ***************************************************************************/
 {
   int i;
@@ -123,24 +143,24 @@ void free_atmos(int nrecs, atmos_data_struct **atmos)
   if (*atmos == NULL)
     return;
 
-  for (i = 0; i < nrecs; i++) {
-    free((*atmos)[i].air_temp);
-    free((*atmos)[i].Catm);
-    free((*atmos)[i].channel_in);
-    free((*atmos)[i].coszen);
-    free((*atmos)[i].density);
-    free((*atmos)[i].fdir);
-    free((*atmos)[i].longwave);
-    free((*atmos)[i].par);
-    free((*atmos)[i].prec);
-    free((*atmos)[i].pressure);
-    free((*atmos)[i].shortwave);
-    free((*atmos)[i].snowflag);
-    free((*atmos)[i].tskc);
-    free((*atmos)[i].vp);
-    free((*atmos)[i].vpd);
-    free((*atmos)[i].wind);
+  if (nrecs > 0) {
+    mem_free((*atmos)[0].air_temp, MEM_ATMOS);
+    mem_free((*atmos)[0].Catm, MEM_ATMOS);
+    mem_free((*atmos)[0].channel_in, MEM_ATMOS);
+    mem_free((*atmos)[0].coszen, MEM_ATMOS);
+    mem_free((*atmos)[0].density, MEM_ATMOS);
+    mem_free((*atmos)[0].fdir, MEM_ATMOS);
+    mem_free((*atmos)[0].longwave, MEM_ATMOS);
+    mem_free((*atmos)[0].par, MEM_ATMOS);
+    mem_free((*atmos)[0].prec, MEM_ATMOS);
+    mem_free((*atmos)[0].pressure, MEM_ATMOS);
+    mem_free((*atmos)[0].shortwave, MEM_ATMOS);
+    mem_free((*atmos)[0].snowflag, MEM_ATMOS);
+    mem_free((*atmos)[0].tskc, MEM_ATMOS);
+    mem_free((*atmos)[0].vp, MEM_ATMOS);
+    mem_free((*atmos)[0].vpd, MEM_ATMOS);
+    mem_free((*atmos)[0].wind, MEM_ATMOS);
   }
 
-  free(*atmos);
+  mem_free(*atmos, MEM_ATMOS);
 }
@@ -26,28 +26,40 @@ void alloc_veg_hist(int nrecs, int nveg, veg_hist_struct ***veg_hist)
 
   Modifications:
   2014-Apr-25 Added veg cover fraction.					TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
+  2026-Oct-17 The records and arrays are now allocated as single blocks
+	      over all records and tiles.				KM
 *******************************************************************/
 {
   int i,j;
 
-  (*veg_hist) = (veg_hist_struct **) calloc(nrecs, sizeof(veg_hist_struct *)); 
+  (*veg_hist) = (veg_hist_struct **) mem_calloc(nrecs, sizeof(veg_hist_struct *), MEM_VEG_HIST); 
   if ((*veg_hist) == NULL)
     vicerror("Memory allocation error in alloc_veg_hist().");
 
-  for (i = 0; i < nrecs; i++) {
-    (*veg_hist)[i] = (veg_hist_struct *) calloc(nveg, sizeof(veg_hist_struct));
-    if ((*veg_hist)[i] == NULL)
+  /* The records, and each of the arrays, are one block over all records
+     and tiles; veg_hist[i][j] points into them */
+  (*veg_hist)[0] = (veg_hist_struct *) mem_calloc(nrecs*nveg, sizeof(veg_hist_struct), MEM_VEG_HIST);
+  if ((*veg_hist)[0] == NULL)
+    vicerror("Memory allocation error in alloc_veg_hist().");
+  if (nveg > 0) {
+    (*veg_hist)[0][0].albedo = (double *) mem_calloc(nrecs*nveg*(NR+1), sizeof(double), MEM_VEG_HIST);
+    if ((*veg_hist)[0][0].albedo == NULL)
+      vicerror("Memory allocation error in alloc_veg_hist().");
+    (*veg_hist)[0][0].LAI = (double *) mem_calloc(nrecs*nveg*(NR+1), sizeof(double), MEM_VEG_HIST);
+    if ((*veg_hist)[0][0].LAI == NULL)
       vicerror("Memory allocation error in alloc_veg_hist().");
+    (*veg_hist)[0][0].vegcover = (double *) mem_calloc(nrecs*nveg*(NR+1), sizeof(double), MEM_VEG_HIST);
+    if ((*veg_hist)[0][0].vegcover == NULL)
+      vicerror("Memory allocation error in alloc_veg_hist().");
+  }
+
+  for (i = 0; i < nrecs; i++) {
+    (*veg_hist)[i] = (*veg_hist)[0] + i*nveg;
     for (j = 0; j < nveg; j++) {
-      (*veg_hist)[i][j].albedo = (double *) calloc(NR+1, sizeof(double));
-      if ((*veg_hist)[i][j].albedo == NULL)
-        vicerror("Memory allocation error in alloc_veg_hist().");
-      (*veg_hist)[i][j].LAI = (double *) calloc(NR+1, sizeof(double));
-      if ((*veg_hist)[i][j].LAI == NULL)
-        vicerror("Memory allocation error in alloc_veg_hist().");
-      (*veg_hist)[i][j].vegcover = (double *) calloc(NR+1, sizeof(double));
-      if ((*veg_hist)[i][j].vegcover == NULL)
-        vicerror("Memory allocation error in alloc_veg_hist().");
+      (*veg_hist)[i][j].albedo = (*veg_hist)[0][0].albedo + (i*nveg+j)*(NR+1);
+      (*veg_hist)[i][j].LAI = (*veg_hist)[0][0].LAI + (i*nveg+j)*(NR+1);
+      (*veg_hist)[i][j].vegcover = (*veg_hist)[0][0].vegcover + (i*nveg+j)*(NR+1);
     }
   }
 
@@ -60,6 +72,8 @@ void free_veg_hist(int nrecs, int nveg, veg_hist_struct ***veg_hist)
 /***************************************************************************
   Modifications:
   2014-Apr-25 Added veg cover fraction.					TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
+  2026-Oct-17 The records and arrays are freed as single blocks.	KM
 ***************************************************************************/
 {
   int i,j;
@@ -67,14 +81,13 @@ void free_veg_hist(int nrecs, int nveg, veg_hist_struct ***veg_hist)
   if (*veg_hist == NULL)
     return;
 
-  for (i = 0; i < nrecs; i++) {
-    for (j = 0; j < nveg; j++) {
-      free((*veg_hist)[i][j].albedo);
-      free((*veg_hist)[i][j].LAI);
-      free((*veg_hist)[i][j].vegcover);
-    }
-    free((*veg_hist)[i]);
+  if (nrecs > 0 && nveg > 0) {
+    mem_free((*veg_hist)[0][0].albedo, MEM_VEG_HIST);
+    mem_free((*veg_hist)[0][0].LAI, MEM_VEG_HIST);
+    mem_free((*veg_hist)[0][0].vegcover, MEM_VEG_HIST);
   }
+  if (nrecs > 0)
+    mem_free((*veg_hist)[0], MEM_VEG_HIST);
 
-  free(*veg_hist);
+  mem_free(*veg_hist, MEM_VEG_HIST);
 }
@@ -0,0 +1,657 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <vicNl.h>
+#ifdef VIC_ZSTD
+#include <zstd.h>
+#endif
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  arrow_output.c	Keith Mathews			October 2026
+
+  Apache Arrow IPC (Feather v2) output.  When ARROW_OUTPUT is TRUE,
+  each output file of the global parameter file (OUTFILE, or the
+  default output files) is written as one Arrow IPC file for the whole
+  run, <RESULT_DIR>/<prefix>.arrow, instead of one ASCII or binary file
+  per cell.  The file has the columns
+
+    cell     int32          cell id (gridcel of the soil parameter file)
+    time     timestamp[s]   start of the output interval
+    <OUTVAR> float32 or float64, one column per element of each
+             variable (suffix _layer<i>, _node<i>, _front<i> or _band<i>,
+             from 0, for variables with more than one element)
+
+  and one row per cell and output interval, in the order in which the
+  cells are run.  The values are those of the ASCII output files;
+  variables of type OUT_TYPE_DOUBLE are stored as float64, and all
+  others as float32.  put_data() adds the rows of each output interval
+  with arrow_output_accumulate(), and every ARROW_BATCH_ROWS rows are
+  written as one record batch, so that the memory used does not depend
+  on the number of cells; arrow_output_close() writes the last batch
+  and the file footer.  Buffers are aligned to 64 bytes, so that the
+  files can be memory-mapped and loaded without copying.
+
+  If COMPRESS is TRUE, the buffers of each record batch are compressed
+  with ZSTD (Arrow's buffer compression; the files are not gzipped).
+  ZSTD support is compiled in only if VIC_ZSTD is defined (see
+  ZSTD_CFLAGS in the Makefile).
+
+  The Arrow metadata (flatbuffers, see Schema.fbs, Message.fbs and
+  File.fbs of the Arrow format) is encoded here directly, so that no
+  Arrow library is needed.  The files are written in little-endian
+  byte order, and so this assumes a little-endian host.
+
+  Modifications:
+**********************************************************************/
+
+#define ARROW_BATCH_ROWS  65536  /* rows per record batch */
+#define ARROW_ALIGN       64     /* alignment of the body buffers */
+#define ARROW_V5          4      /* MetadataVersion V5 */
+#define ARROW_SCHEMA      1      /* MessageHeader types */
+#define ARROW_RECORDBATCH 3
+#define ARROW_INT         2      /* Type types */
+#define ARROW_FLOAT       3
+#define ARROW_TIMESTAMP   10
+
+typedef struct {
+  unsigned char *buf;
+  size_t         len;
+  size_t         cap;
+} arrow_fb_struct;
+
+typedef struct {
+  int64_t offset;       /* of the message in the file */
+  int32_t metalen;      /* length of the metadata, with its prefix */
+  int64_t bodylen;
+} arrow_block_struct;
+
+typedef struct {
+  FILE               *fh;
+  char                filename[2*MAXSTRING+32];
+  int                 ncols;     /* value columns */
+  int                *col_var;   /* variable of each value column */
+  int                *col_elem;  /* element of each value column */
+  int                *col_size;  /* 4 (float32) or 8 (float64) */
+  int                 nrows;     /* rows of the current batch */
+  int32_t            *cell;
+  int64_t            *time;
+  unsigned char     **values;
+  arrow_block_struct *blocks;    /* record batches written */
+  int                 nblocks;
+  int64_t             offset;    /* bytes written */
+} arrow_file_struct;
+
+static arrow_file_struct *arrow_files = NULL;
+static int                narrow_files = 0;
+static out_data_struct   *arrow_out_data = NULL;
+static arrow_fb_struct    fb = { NULL, 0, 0 };
+static unsigned char     *body = NULL;
+static size_t             body_cap = 0;
+
+/**********************************************************************
+  Flatbuffer encoding.  Objects are appended in order, so that every
+  object is written after the table or vector that refers to it (as
+  flatbuffer offsets must point forward); each table is preceded by
+  its vtable.
+**********************************************************************/
+
+static size_t fb_zero(size_t n)
+/* Appends n zero bytes, and returns their position. */
+{
+  size_t pos;
+
+  if (fb.len + n > fb.cap) {
+    fb.cap = 2 * (fb.len + n) + 256;
+    fb.buf = (unsigned char *)realloc(fb.buf, fb.cap);
+    if (fb.buf == NULL)
+      nrerror("Memory allocation failure in arrow_output.c");
+  }
+  pos = fb.len;
+  memset(fb.buf + pos, 0, n);
+  fb.len += n;
+  return pos;
+}
+
+static void fb_align(size_t align)
+{
+  if (fb.len % align)
+    fb_zero(align - fb.len % align);
+}
+
+static void fb_set(size_t pos, const void *src, size_t n)
+{
+  memcpy(fb.buf + pos, src, n);
+}
+
+static void fb_set_int(size_t pos, int64_t value, int size)
+/* Stores a little-endian integer of size bytes at pos. */
+{
+  int8_t  i8;
+  int16_t i16;
+  int32_t i32;
+
+  switch (size) {
+  case 1: i8 = (int8_t)value; fb_set(pos, &i8, 1); break;
+  case 2: i16 = (int16_t)value; fb_set(pos, &i16, 2); break;
+  case 4: i32 = (int32_t)value; fb_set(pos, &i32, 4); break;
+  default: fb_set(pos, &value, 8); break;
+  }
+}
+
+static void fb_set_offset(size_t at, size_t target)
+/* Stores at position at the offset of the object at target. */
+{
+  uint32_t off = (uint32_t)(target - at);
+
+  fb_set(at, &off, 4);
+}
+
+static size_t fb_table(int         nfields,
+                       const int  *size,
+                       size_t     *pos)
+/* Appends a vtable and a zeroed table with nfields fields of the given
+   sizes (0 = field absent), and returns the position of the table;
+   pos[i] is set to the position of field i. */
+{
+  uint16_t vt[16];
+  size_t   vt_pos, tab, p;
+  int32_t  soff;
+  int      i;
+
+  fb_align(4);
+  vt_pos = fb.len;
+  tab = vt_pos + 4 + 2 * nfields;
+  tab = (tab + 3) & ~(size_t)3;
+  p = tab + 4;
+  for (i = 0; i < nfields; i++) {
+    if (size[i] == 0) {
+      vt[2 + i] = 0;
+      continue;
+    }
+    p = (p + size[i] - 1) / size[i] * size[i];
+    vt[2 + i] = (uint16_t)(p - tab);
+    pos[i] = p;
+    p += size[i];
+  }
+  vt[0] = (uint16_t)(4 + 2 * nfields);
+  vt[1] = (uint16_t)(p - tab);
+  fb_zero(p - vt_pos);
+  fb_set(vt_pos, vt, vt[0]);
+  soff = (int32_t)(tab - vt_pos);
+  fb_set(tab, &soff, 4);
+  return tab;
+}
+
+static size_t fb_vector(int    n,
+                        int    elem_size,
+                        size_t align)
+/* Appends a zeroed vector of n elements, whose elements are aligned to
+   align bytes, and returns its position (that of its length). */
+{
+  uint32_t len = (uint32_t)n;
+  size_t   pos;
+
+  fb_align(4);
+  while ((fb.len + 4) % align)
+    fb_zero(4);
+  pos = fb_zero(4 + (size_t)n * elem_size);
+  fb_set(pos, &len, 4);
+  return pos;
+}
+
+static size_t fb_string(const char *s)
+/* Appends a string, and returns its position. */
+{
+  uint32_t len = (uint32_t)strlen(s);
+  size_t   pos;
+
+  fb_align(4);
+  pos = fb_zero(4 + len + 1);
+  fb_set(pos, &len, 4);
+  fb_set(pos + 4, s, len);
+  return pos;
+}
+
+static void arrow_column_name(arrow_file_struct *af,
+                              int                col,
+                              char              *name)
+/* Builds the name of value column col. */
+{
+  int         varid = af->col_var[col];
+  const char *kind;
+
+  if (arrow_out_data[varid].nelem == 1) {
+    strcpy(name, arrow_out_data[varid].varname);
+    return;
+  }
+  if (varid == OUT_FDEPTH || varid == OUT_TDEPTH)
+    kind = "front";
+  else if (varid == OUT_SOIL_TNODE || varid == OUT_SOIL_TNODE_WL
+           || varid == OUT_SOILT_FBFLAG)
+    kind = "node";
+  else if (varid == OUT_SMLIQFRAC || varid == OUT_SMFROZFRAC
+           || varid == OUT_SOIL_ICE || varid == OUT_SOIL_LIQ
+           || varid == OUT_SOIL_MOIST || varid == OUT_SOIL_TEMP)
+    kind = "layer";
+  else
+    kind = "band";
+  sprintf(name, "%s_%s%d", arrow_out_data[varid].varname, kind,
+          af->col_elem[col]);
+}
+
+static size_t arrow_schema(arrow_file_struct *af)
+/* Appends the Schema table of af, and returns its position. */
+{
+  static const int schema_size[2] = { 2, 4 };  /* endianness, fields */
+  static const int field_size[6] = { 4, 1, 1, 4, 0, 4 };
+                                 /* name, nullable, type_type, type,
+                                    dictionary, children */
+  int    int_size[2] = { 4, 1 };               /* bitWidth, is_signed */
+  int    float_size[1] = { 2 };                /* precision */
+  int    ts_size[2] = { 2, 0 };                /* unit, timezone */
+  size_t schema_pos[2], field_pos[6], type_pos[2];
+  size_t schema, fields, field, type;
+  char   name[64];
+  int    k, nfields;
+
+  nfields = 2 + af->ncols;
+  schema = fb_table(2, schema_size, schema_pos);
+  fields = fb_vector(nfields, 4, 4);
+  fb_set_offset(schema_pos[1], fields);
+
+  for (k = 0; k < nfields; k++) {
+    field = fb_table(6, field_size, field_pos);
+    fb_set_offset(fields + 4 + 4 * k, field);
+    if (k == 0)
+      strcpy(name, "cell");
+    else if (k == 1)
+      strcpy(name, "time");
+    else
+      arrow_column_name(af, k - 2, name);
+    fb_set_offset(field_pos[0], fb_string(name));
+    if (k == 0) {
+      fb_set_int(field_pos[2], ARROW_INT, 1);
+      type = fb_table(2, int_size, type_pos);
+      fb_set_int(type_pos[0], 32, 4);
+      fb_set_int(type_pos[1], 1, 1);
+    }
+    else if (k == 1) {
+      fb_set_int(field_pos[2], ARROW_TIMESTAMP, 1);
+      type = fb_table(2, ts_size, type_pos);
+      fb_set_int(type_pos[0], 0, 2);           /* SECOND */
+    }
+    else {
+      fb_set_int(field_pos[2], ARROW_FLOAT, 1);
+      type = fb_table(1, float_size, type_pos);
+      fb_set_int(type_pos[0], (af->col_size[k - 2] == 8) ? 2 : 1, 2);
+    }
+    fb_set_offset(field_pos[3], type);
+    fb_set_offset(field_pos[5], fb_vector(0, 4, 4));
+  }
+
+  return schema;
+}
+
+static size_t arrow_message(int     header_type,
+                            size_t *bodylen_pos)
+/* Starts a new flatbuffer with a Message table, and returns the
+   position of its header field; bodylen_pos is set to the position of
+   its bodyLength field (0 until set). */
+{
+  static const int size[4] = { 2, 1, 4, 8 };
+                         /* version, header_type, header, bodyLength */
+  size_t pos[4];
+  size_t msg;
+
+  fb.len = 0;
+  fb_zero(4);
+  msg = fb_table(4, size, pos);
+  fb_set_offset(0, msg);
+  fb_set_int(pos[0], ARROW_V5, 2);
+  fb_set_int(pos[1], header_type, 1);
+  *bodylen_pos = pos[3];
+  return pos[2];
+}
+
+static int32_t arrow_write_message(arrow_file_struct *af,
+                                   size_t             bodylen)
+/* Writes the flatbuffer as an encapsulated message, followed by
+   bodylen bytes of body, and returns the length of the metadata. */
+{
+  uint32_t cont = 0xFFFFFFFF;
+  int32_t  len;
+
+  fb_align(8);
+  len = (int32_t)fb.len;
+  fwrite(&cont, 4, 1, af->fh);
+  fwrite(&len, 4, 1, af->fh);
+  fwrite(fb.buf, 1, fb.len, af->fh);
+  if (bodylen > 0)
+    fwrite(body, 1, bodylen, af->fh);
+  af->offset += 8 + len + bodylen;
+  return 8 + len;
+}
+
+static size_t arrow_body_buffer(size_t                cur,
+                                const unsigned char  *data,
+                                size_t                n,
+                                size_t               *len)
+/* Adds a buffer of n bytes to the body at cur (compressing it if
+   COMPRESS is TRUE), sets len to its length in the body, and returns
+   the position of the next buffer. */
+{
+  extern option_struct options;
+  size_t  need;
+  int64_t raw;
+
+  need = cur + n + 8 + ARROW_ALIGN;
+#ifdef VIC_ZSTD
+  if (options.COMPRESS)
+    need = cur + 8 + ZSTD_compressBound(n) + ARROW_ALIGN;
+#endif
+  if (need > body_cap) {
+    body_cap = 2 * need;
+    body = (unsigned char *)realloc(body, body_cap);
+    if (body == NULL)
+      nrerror("Memory allocation failure in arrow_output.c");
+  }
+
+  if (n == 0)
+    *len = 0;
+  else if (!options.COMPRESS) {
+    memcpy(body + cur, data, n);
+    *len = n;
+  }
+  else {
+#ifdef VIC_ZSTD
+    *len = ZSTD_compress(body + cur + 8, body_cap - cur - 8, data, n, 1);
+    if (ZSTD_isError(*len) || *len >= n) {
+      /* stored uncompressed, as allowed by the format */
+      raw = -1;
+      memcpy(body + cur + 8, data, n);
+      *len = n;
+    }
+    else
+      raw = (int64_t)n;
+    memcpy(body + cur, &raw, 8);
+    *len += 8;
+#endif
+  }
+
+  need = cur + *len;
+  while (need % ARROW_ALIGN)
+    body[need++] = 0;
+  return need;
+}
+
+static void arrow_write_batch(arrow_file_struct *af)
+/* Writes the rows of af as one record batch. */
+{
+  extern option_struct options;
+  static const int rb_size[4] = { 8, 4, 4, 4 };
+                            /* length, nodes, buffers, compression */
+  int      comp_size[2] = { 1, 1 };  /* codec, method */
+  size_t   rb_pos[4], comp_pos[2];
+  size_t   header, bodylen_pos, rb, nodes, buffers, comp;
+  size_t   cur, next, len;
+  int64_t  node[2], buf[2];
+  int      k, nfields, size;
+  const unsigned char *data;
+  arrow_block_struct  *block;
+
+  if (af->nrows == 0)
+    return;
+  nfields = 2 + af->ncols;
+
+  header = arrow_message(ARROW_RECORDBATCH, &bodylen_pos);
+  rb = fb_table(options.COMPRESS ? 4 : 3, rb_size, rb_pos);
+  fb_set_offset(header, rb);
+  fb_set_int(rb_pos[0], af->nrows, 8);
+  nodes = fb_vector(nfields, 16, 8);
+  fb_set_offset(rb_pos[1], nodes);
+  buffers = fb_vector(2 * nfields, 16, 8);
+  fb_set_offset(rb_pos[2], buffers);
+  if (options.COMPRESS) {
+    comp = fb_table(2, comp_size, comp_pos);
+    fb_set_offset(rb_pos[3], comp);
+    fb_set_int(comp_pos[0], 1, 1);            /* ZSTD */
+    fb_set_int(comp_pos[1], 0, 1);            /* BUFFER */
+  }
+
+  /* body: for each column, an empty validity buffer (there are no
+     nulls) and a data buffer */
+  cur = 0;
+  for (k = 0; k < nfields; k++) {
+    if (k == 0) {
+      data = (const unsigned char *)af->cell;
+      size = 4;
+    }
+    else if (k == 1) {
+      data = (const unsigned char *)af->time;
+      size = 8;
+    }
+    else {
+      data = af->values[k - 2];
+      size = af->col_size[k - 2];
+    }
+    node[0] = af->nrows;
+    node[1] = 0;
+    fb_set(nodes + 4 + 16 * k, node, 16);
+    buf[0] = (int64_t)cur;
+    buf[1] = 0;
+    fb_set(buffers + 4 + 32 * k, buf, 16);
+    next = arrow_body_buffer(cur, data, (size_t)af->nrows * size, &len);
+    buf[0] = (int64_t)cur;
+    buf[1] = (int64_t)len;
+    fb_set(buffers + 4 + 32 * k + 16, buf, 16);
+    cur = next;
+  }
+  fb_set_int(bodylen_pos, (int64_t)cur, 8);
+
+  if (af->nblocks % 64 == 0) {
+    af->blocks = (arrow_block_struct *)realloc(af->blocks, (af->nblocks + 64) * sizeof(arrow_block_struct));
+    if (af->blocks == NULL)
+      nrerror("Memory allocation failure in arrow_output.c");
+  }
+  block = &af->blocks[af->nblocks++];
+  block->offset = af->offset;
+  block->bodylen = (int64_t)cur;
+  block->metalen = arrow_write_message(af, cur);
+
+  af->nrows = 0;
+}
+
+static void arrow_write_footer(arrow_file_struct *af)
+/* Writes the end-of-stream marker and the file footer. */
+{
+  static const int footer_size[4] = { 2, 4, 4, 4 };
+                        /* version, schema, dictionaries, recordBatches */
+  uint32_t eos[2] = { 0xFFFFFFFF, 0 };
+  size_t   pos[4], footer, blocks;
+  int32_t  len;
+  int      b;
+
+  fwrite(eos, 4, 2, af->fh);
+
+  fb.len = 0;
+  fb_zero(4);
+  footer = fb_table(4, footer_size, pos);
+  fb_set_offset(0, footer);
+  fb_set_int(pos[0], ARROW_V5, 2);
+  fb_set_offset(pos[1], arrow_schema(af));
+  fb_set_offset(pos[2], fb_vector(0, 24, 8));
+  blocks = fb_vector(af->nblocks, 24, 8);
+  fb_set_offset(pos[3], blocks);
+  for (b = 0; b < af->nblocks; b++) {
+    fb_set_int(blocks + 4 + 24 * b, af->blocks[b].offset, 8);
+    fb_set_int(blocks + 4 + 24 * b + 8, af->blocks[b].metalen, 4);
+    fb_set_int(blocks + 4 + 24 * b + 16, af->blocks[b].bodylen, 8);
+  }
+
+  len = (int32_t)fb.len;
+  fwrite(fb.buf, 1, fb.len, af->fh);
+  fwrite(&len, 4, 1, af->fh);
+  fwrite("ARROW1", 1, 6, af->fh);
+}
+
+static int64_t arrow_time(dmy_struct *dmy)
+/* Returns the seconds from 1970-01-01 00:00 to dmy. */
+{
+  int64_t y, m, era, yoe, doy, doe;
+
+  /* days from the civil date, proleptic Gregorian calendar */
+  y = dmy->year - (dmy->month <= 2);
+  m = dmy->month;
+  era = (y >= 0 ? y : y - 399) / 400;
+  yoe = y - era * 400;
+  doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + dmy->day - 1;
+  doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return ((era * 146097 + doe - 719468) * 86400 + (int64_t)dmy->hour * 3600);
+}
+
+void arrow_output_init(filenames_struct     *names,
+                       out_data_file_struct *out_data_files,
+                       out_data_struct      *out_data)
+/**********************************************************************
+  arrow_output_init	Keith Mathews			October 2026
+
+  Opens one Arrow IPC file per output file, <RESULT_DIR>/<prefix>.arrow,
+  writes its schema, and allocates the buffers of its record batches.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  arrow_file_struct   *af;
+  size_t               bodylen_pos, header;
+  int                  f, v, i, c;
+
+  if (!options.ARROW_OUTPUT)
+    return;
+#ifndef VIC_ZSTD
+  if (options.COMPRESS)
+    nrerror("COMPRESS = TRUE with ARROW_OUTPUT = TRUE requires ZSTD support; rebuild VIC with ZSTD_CFLAGS and ZSTD_LIBS set in the Makefile.");
+#endif
+
+  arrow_out_data = out_data;
+  narrow_files = options.Noutfiles;
+  arrow_files = (arrow_file_struct *)mem_calloc(narrow_files, sizeof(arrow_file_struct), MEM_OUTPUT);
+
+  for (f = 0; f < narrow_files; f++) {
+    af = &arrow_files[f];
+
+    af->ncols = 0;
+    for (v = 0; v < out_data_files[f].nvars; v++)
+      af->ncols += out_data[out_data_files[f].varid[v]].nelem;
+    af->col_var = (int *)mem_calloc(af->ncols, sizeof(int), MEM_OUTPUT);
+    af->col_elem = (int *)mem_calloc(af->ncols, sizeof(int), MEM_OUTPUT);
+    af->col_size = (int *)mem_calloc(af->ncols, sizeof(int), MEM_OUTPUT);
+    af->values = (unsigned char **)mem_calloc(af->ncols, sizeof(unsigned char *), MEM_OUTPUT);
+    c = 0;
+    for (v = 0; v < out_data_files[f].nvars; v++) {
+      for (i = 0; i < out_data[out_data_files[f].varid[v]].nelem; i++) {
+        af->col_var[c] = out_data_files[f].varid[v];
+        af->col_elem[c] = i;
+        af->col_size[c] = (out_data[af->col_var[c]].type == OUT_TYPE_DOUBLE) ? 8 : 4;
+        af->values[c] = (unsigned char *)mem_calloc(ARROW_BATCH_ROWS, af->col_size[c], MEM_OUTPUT);
+        c++;
+      }
+    }
+    af->cell = (int32_t *)mem_calloc(ARROW_BATCH_ROWS, sizeof(int32_t), MEM_OUTPUT);
+    af->time = (int64_t *)mem_calloc(ARROW_BATCH_ROWS, sizeof(int64_t), MEM_OUTPUT);
+
+    sprintf(af->filename, "%s/%s.arrow", names->result_dir, out_data_files[f].prefix);
+    af->fh = open_file(af->filename, "wb");
+    fwrite("ARROW1\0\0", 1, 8, af->fh);
+    af->offset = 8;
+
+    header = arrow_message(ARROW_SCHEMA, &bodylen_pos);
+    fb_set_offset(header, arrow_schema(af));
+    arrow_write_message(af, 0);
+  }
+}
+
+void arrow_output_accumulate(out_data_struct *out_data,
+                             dmy_struct      *dmy,
+                             soil_con_struct *soil_con)
+/**********************************************************************
+  arrow_output_accumulate	Keith Mathews		October 2026
+
+  Adds the aggregated output values of the current cell for the
+  current output interval as one row of each Arrow output file, and
+  writes a record batch when ARROW_BATCH_ROWS rows have been added.
+  Called from put_data() at each output interval, before the values
+  are scaled for binary output.
+
+  Modifications:
+**********************************************************************/
+{
+  arrow_file_struct *af;
+  int64_t            time;
+  double             value;
+  int                f, c;
+
+  if (arrow_files == NULL)
+    return;
+
+  time = arrow_time(dmy);
+  for (f = 0; f < narrow_files; f++) {
+    af = &arrow_files[f];
+    af->cell[af->nrows] = soil_con->gridcel;
+    af->time[af->nrows] = time;
+    for (c = 0; c < af->ncols; c++) {
+      value = out_data[af->col_var[c]].aggdata[af->col_elem[c]];
+      if (af->col_size[c] == 8)
+        ((double *)af->values[c])[af->nrows] = value;
+      else
+        ((float *)af->values[c])[af->nrows] = (float)value;
+    }
+    af->nrows++;
+    if (af->nrows == ARROW_BATCH_ROWS)
+      arrow_write_batch(af);
+  }
+}
+
+void arrow_output_close()
+/**********************************************************************
+  arrow_output_close	Keith Mathews			October 2026
+
+  Writes the last record batch and the footer of each Arrow output
+  file, closes the files, and frees the buffers.
+
+  Modifications:
+**********************************************************************/
+{
+  arrow_file_struct *af;
+  int                f, c;
+
+  if (arrow_files == NULL)
+    return;
+
+  for (f = 0; f < narrow_files; f++) {
+    af = &arrow_files[f];
+    arrow_write_batch(af);
+    arrow_write_footer(af);
+    fclose(af->fh);
+    for (c = 0; c < af->ncols; c++)
+      mem_free(af->values[c], MEM_OUTPUT);
+    mem_free(af->values, MEM_OUTPUT);
+    mem_free(af->col_var, MEM_OUTPUT);
+    mem_free(af->col_elem, MEM_OUTPUT);
+    mem_free(af->col_size, MEM_OUTPUT);
+    mem_free(af->cell, MEM_OUTPUT);
+    mem_free(af->time, MEM_OUTPUT);
+    free((char *)af->blocks);
+  }
+  mem_free(arrow_files, MEM_OUTPUT);
+  arrow_files = NULL;
+  free((char *)fb.buf);
+  fb.buf = NULL;
+  fb.len = fb.cap = 0;
+  free((char *)body);
+  body = NULL;
+  body_cap = 0;
+}
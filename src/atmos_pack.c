@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  atmos_pack.c		Keith Mathews			October 2026
+
+  Reduced-precision storage of a cell's forcings and veg history.
+  When FORCE_PRECISION is FLOAT or SHORT, vicNl.c hands the atmos and
+  veg_hist arrays filled by initialize_atmos() to atmos_pack(), frees
+  them, and keeps only one record of each, which atmos_unpack() fills
+  (in double precision) before each call to full_energy().
+
+  FLOAT stores each value as a float.  SHORT stores each value as an
+  unsigned 16-bit integer, scaled linearly over the range of its field
+  within the cell, so that the error is at most 1/131070 of that range.
+  The forcings of a cell are disaggregated and adjusted (MTCLIM, lapse
+  rates, unit conversions) before they are stored, so the values are
+  no longer on the grid of the binary input multipliers, and the scale
+  is computed from the values themselves.  A field with a minimum of 0
+  (e.g. precipitation) keeps its zeros exact.
+
+  The snowflag array is kept as is, and out_prec, out_rain and out_snow
+  are set by full_energy() in each record, so none of them is stored.
+
+  Modifications:
+**********************************************************************/
+
+/* the double arrays of atmos_data_struct that are stored */
+static const size_t atmos_field[] = {
+  offsetof(atmos_data_struct, air_temp),
+  offsetof(atmos_data_struct, Catm),
+  offsetof(atmos_data_struct, channel_in),
+  offsetof(atmos_data_struct, coszen),
+  offsetof(atmos_data_struct, density),
+  offsetof(atmos_data_struct, fdir),
+  offsetof(atmos_data_struct, longwave),
+  offsetof(atmos_data_struct, par),
+  offsetof(atmos_data_struct, prec),
+  offsetof(atmos_data_struct, pressure),
+  offsetof(atmos_data_struct, shortwave),
+  offsetof(atmos_data_struct, tskc),
+  offsetof(atmos_data_struct, vp),
+  offsetof(atmos_data_struct, vpd),
+  offsetof(atmos_data_struct, wind)
+};
+#define N_ATMOS_FIELDS (sizeof(atmos_field) / sizeof(atmos_field[0]))
+
+/* the double arrays of veg_hist_struct that are stored */
+static const size_t veg_hist_field[] = {
+  offsetof(veg_hist_struct, albedo),
+  offsetof(veg_hist_struct, LAI),
+  offsetof(veg_hist_struct, vegcover)
+};
+#define N_VEG_HIST_FIELDS (sizeof(veg_hist_field) / sizeof(veg_hist_field[0]))
+
+#define FIELD(base, offset) (*(double **)((char *)(base) + (offset)))
+
+static int             pack_nrecs = 0;
+static int             pack_nveg = 0;
+static void           *atmos_store = NULL;    /* float or unsigned short */
+static void           *veg_hist_store = NULL;
+static char           *snowflag_store = NULL;
+static double          atmos_min[N_ATMOS_FIELDS];
+static double          atmos_scale[N_ATMOS_FIELDS];
+static double          veg_hist_min[N_VEG_HIST_FIELDS];
+static double          veg_hist_scale[N_VEG_HIST_FIELDS];
+
+static void pack_field(double *values, size_t n, void *store, size_t offset,
+                       double *min, double *scale)
+/* Stores n values at element offset in store, and returns the minimum
+   and scale used for SHORT. */
+{
+  extern option_struct options;
+  size_t i;
+  double lo, hi;
+
+  if (options.FORCE_PRECISION == FORCE_PREC_FLOAT) {
+    for (i = 0; i < n; i++)
+      ((float *)store)[offset + i] = (float)values[i];
+    *min = 0;
+    *scale = 1;
+    return;
+  }
+
+  lo = hi = values[0];
+  for (i = 1; i < n; i++) {
+    if (values[i] < lo) lo = values[i];
+    if (values[i] > hi) hi = values[i];
+  }
+  *min = lo;
+  *scale = (hi > lo) ? (hi - lo) / 65535. : 0;
+  for (i = 0; i < n; i++)
+    ((unsigned short *)store)[offset + i] =
+      (*scale > 0) ? (unsigned short)((values[i] - lo) / *scale + 0.5) : 0;
+}
+
+static void unpack_field(double *values, size_t n, void *store, size_t offset,
+                         double min, double scale)
+/* Widens n values at element offset in store. */
+{
+  extern option_struct options;
+  size_t i;
+
+  if (options.FORCE_PRECISION == FORCE_PREC_FLOAT)
+    for (i = 0; i < n; i++)
+      values[i] = (double)((float *)store)[offset + i];
+  else
+    for (i = 0; i < n; i++)
+      values[i] = min + scale * ((unsigned short *)store)[offset + i];
+}
+
+void atmos_pack(int                 nrecs,
+                int                 nveg,
+                atmos_data_struct  *atmos,
+                veg_hist_struct   **veg_hist)
+/**********************************************************************
+  atmos_pack		Keith Mathews			October 2026
+
+  Stores the nrecs records of atmos (and of veg_hist, with nveg tiles)
+  in FORCE_PRECISION.  The arrays must have been allocated by
+  alloc_atmos() and alloc_veg_hist(), so that each field is a single
+  block starting at record 0.  Any previously stored cell is released.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  size_t nvalues, elem_size;
+  int    f;
+
+  atmos_pack_free();
+
+  pack_nrecs = nrecs;
+  pack_nveg = nveg;
+  elem_size = (options.FORCE_PRECISION == FORCE_PREC_FLOAT)
+                ? sizeof(float) : sizeof(unsigned short);
+
+  /** Forcings **/
+  nvalues = (size_t)nrecs * (NR+1);
+  atmos_store = mem_calloc(N_ATMOS_FIELDS * nvalues, elem_size, MEM_ATMOS);
+  snowflag_store = (char *)mem_calloc(nvalues, sizeof(char), MEM_ATMOS);
+  if (atmos_store == NULL || snowflag_store == NULL)
+    vicerror("Memory allocation error in atmos_pack().");
+  for (f = 0; f < N_ATMOS_FIELDS; f++)
+    pack_field(FIELD(&atmos[0], atmos_field[f]), nvalues, atmos_store,
+               f * nvalues, &atmos_min[f], &atmos_scale[f]);
+  memcpy(snowflag_store, atmos[0].snowflag, nvalues);
+
+  /** Veg history **/
+  if (nveg > 0) {
+    nvalues = (size_t)nrecs * nveg * (NR+1);
+    veg_hist_store = mem_calloc(N_VEG_HIST_FIELDS * nvalues, elem_size,
+                                MEM_VEG_HIST);
+    if (veg_hist_store == NULL)
+      vicerror("Memory allocation error in atmos_pack().");
+    for (f = 0; f < N_VEG_HIST_FIELDS; f++)
+      pack_field(FIELD(&veg_hist[0][0], veg_hist_field[f]), nvalues,
+                 veg_hist_store, f * nvalues, &veg_hist_min[f],
+                 &veg_hist_scale[f]);
+  }
+}
+
+void atmos_unpack(int                rec,
+                  atmos_data_struct *atmos,
+                  veg_hist_struct   *veg_hist)
+/**********************************************************************
+  atmos_unpack		Keith Mathews			October 2026
+
+  Widens record rec of the stored forcings into atmos, and of the
+  stored veg history into the pack_nveg tiles of veg_hist.
+
+  Modifications:
+**********************************************************************/
+{
+  size_t nvalues, offset;
+  int    f, iveg;
+
+  nvalues = (size_t)pack_nrecs * (NR+1);
+  offset = (size_t)rec * (NR+1);
+  for (f = 0; f < N_ATMOS_FIELDS; f++)
+    unpack_field(FIELD(atmos, atmos_field[f]), NR+1, atmos_store,
+                 f * nvalues + offset, atmos_min[f], atmos_scale[f]);
+  memcpy(atmos->snowflag, &snowflag_store[offset], NR+1);
+
+  nvalues = (size_t)pack_nrecs * pack_nveg * (NR+1);
+  for (iveg = 0; iveg < pack_nveg; iveg++) {
+    offset = ((size_t)rec * pack_nveg + iveg) * (NR+1);
+    for (f = 0; f < N_VEG_HIST_FIELDS; f++)
+      unpack_field(FIELD(&veg_hist[iveg], veg_hist_field[f]), NR+1,
+                   veg_hist_store, f * nvalues + offset,
+                   veg_hist_min[f], veg_hist_scale[f]);
+  }
+}
+
+void atmos_pack_free()
+/**********************************************************************
+  atmos_pack_free	Keith Mathews			October 2026
+
+  Releases the stored forcings and veg history.
+
+  Modifications:
+**********************************************************************/
+{
+  mem_free(atmos_store, MEM_ATMOS);
+  mem_free(snowflag_store, MEM_ATMOS);
+  mem_free(veg_hist_store, MEM_VEG_HIST);
+  atmos_store = NULL;
+  snowflag_store = NULL;
+  veg_hist_store = NULL;
+  pack_nrecs = 0;
+  pack_nveg = 0;
+}
@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+void band_forcing(atmos_data_struct   *atmos,
+		  int                  Nrecs,
+		  int                  Nbands,
+		  soil_con_struct     *soil_con,
+		  double              *gauge_correction,
+		  double               MIN_RAIN_TEMP,
+		  double               MAX_SNOW_TEMP,
+		  band_forcing_struct *bf)
+/**********************************************************************
+  band_forcing		Keith Mathews		October 2026
+
+  Lapses the air temperature and precipitation of the first Nrecs
+  elements of atmos to each of the Nbands snow bands, and partitions
+  the band precipitation into gauge corrected rainfall and snowfall.
+
+  This used to be done by surface_fluxes() and solve_snow() for each
+  band of each veg tile, at each iteration of the snow and surface
+  energy balance.  None of it depends on the tile, so it is done here
+  once per grid cell and time step.  The band loop is innermost and
+  free of calls and of band-dependent control flow (calc_rainonly() is
+  written as selects), so that it is evaluated for all bands at once.
+  The results equal those of the original scalar code.
+
+  Modifications:
+**********************************************************************/
+{
+  int    i;
+  int    band;
+  double air_temp;
+  double prec;
+  double Tfactor[MAX_BANDS];
+  double Pfactor[MAX_BANDS];
+  double gauge_rain;
+  double gauge_snow;
+  double Tair;
+  double band_prec;
+  double mixed;
+  double rainonly;
+  double snowfall;
+
+  gauge_rain = gauge_correction[RAIN];
+  gauge_snow = gauge_correction[SNOW];
+  for ( band = 0; band < Nbands; band++ ) {
+    bf->active[band] = ( soil_con->AreaFract[band] > 0 );
+    Tfactor[band]    = soil_con->Tfactor[band];
+    Pfactor[band]    = soil_con->Pfactor[band];
+  }
+
+  for ( i = 0; i < Nrecs; i++ ) {
+    air_temp = atmos->air_temp[i];
+    prec     = atmos->prec[i];
+    for ( band = 0; band < Nbands; band++ ) {
+      Tair      = air_temp + Tfactor[band];
+      band_prec = prec * Pfactor[band];
+
+      /** Fraction of precipitation that falls as rain (calc_rainonly);
+	  MAX_SNOW_TEMP > MIN_RAIN_TEMP is checked by get_global_param() **/
+      mixed    = (Tair - MIN_RAIN_TEMP)
+	/ (MAX_SNOW_TEMP - MIN_RAIN_TEMP) * band_prec;
+      rainonly = ( Tair >= MAX_SNOW_TEMP ) ? band_prec
+	: ( ( Tair > MIN_RAIN_TEMP ) ? mixed : 0. );
+
+      snowfall = gauge_snow * (band_prec - rainonly);
+      snowfall = ( snowfall < 1e-5 ) ? 0. : snowfall;
+
+      bf->Tair[i][band]     = Tair;
+      bf->prec[i][band]     = band_prec;
+      bf->rainfall[i][band] = gauge_rain * rainonly;
+      bf->snowfall[i][band] = snowfall;
+    }
+  }
+
+}
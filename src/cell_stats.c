@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <malloc.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  cell_stats.c		Keith Mathews			October 2026
+
+  Optional per-cell cost log.  When CELL_LOG is given in the global
+  parameter file, one line is written to that file for every grid cell
+  after its output files have been closed, recording the size of the
+  cell (number of veg tiles, active snow bands, lake flag), its wall
+  time, the effort spent in the iterative solvers (root_brent() and
+  newt_raph() calls and iterations, and explicit soil temperature
+  profile solutions, their iterations, and their Newton failures), the
+  snow model steps merged by SNOW_STEP_ADAPT (and the SNOW_STEPs they
+  covered) and rejected by its error control, the TFALLBACK counts
+  accumulated over the run, and the heap allocated for the cell.
+
+  The solver counters live in the global solver_stats structure; they
+  are incremented by the solvers themselves and reset at the start of
+  each cell.  The table can be ranked and partitioned for load
+  balancing with bench/rank_cells.py.
+
+  Modifications:
+  2026-Oct-17 Added SOIL_T_CALLS, SOIL_T_ITER and SOIL_T_FALLBACKS.	KM
+  2026-Oct-17 Added SNOW_MERGED, SNOW_MERGED_STEPS and SNOW_REJECTED.	KM
+**********************************************************************/
+
+static FILE   *cell_log_fp = NULL;
+static double  cell_t0;
+static double  cell_heap0;
+
+static double cell_stats_now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec);
+}
+
+static double cell_stats_heap()
+/* Returns the number of bytes currently allocated on the heap. */
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  struct mallinfo2 mi;
+
+  mi = mallinfo2();
+  return ((double)mi.uordblks + (double)mi.hblkhd);
+#elif defined(__GLIBC__)
+  struct mallinfo mi;
+
+  mi = mallinfo();
+  return ((double)(unsigned int)mi.uordblks + (double)(unsigned int)mi.hblkhd);
+#else
+  return 0;
+#endif
+}
+
+void cell_stats_init(filenames_struct *names)
+/**********************************************************************
+  cell_stats_init	Keith Mathews			October 2026
+
+  Opens the CELL_LOG file, if one was given, and writes its header.
+
+  Modifications:
+**********************************************************************/
+{
+  if (strcmp(names->cell_log, "NONE") == 0)
+    return;
+
+  cell_log_fp = open_file(names->cell_log, "w");
+  fprintf(cell_log_fp, "CELLNUM,GRIDCEL,LAT,LNG,NVEG,NBANDS,LAKE,WALL_S,"
+          "ROOT_BRENT_CALLS,ROOT_BRENT_ITER,NEWT_RAPH_CALLS,NEWT_RAPH_ITER,"
+          "SOIL_T_CALLS,SOIL_T_ITER,SOIL_T_FALLBACKS,"
+          "SNOW_MERGED,SNOW_MERGED_STEPS,SNOW_REJECTED,"
+          "T_FBCOUNT,TSURF_FBCOUNT,TCANOPY_FBCOUNT,TFOLIAGE_FBCOUNT,"
+          "TSNOWSURF_FBCOUNT,ALLOC_KB\n");
+}
+
+void cell_stats_start()
+/**********************************************************************
+  cell_stats_start	Keith Mathews			October 2026
+
+  Resets the solver counters and records the start time and heap size
+  of the current cell.
+
+  Modifications:
+**********************************************************************/
+{
+  extern solver_stats_struct solver_stats;
+
+  solver_stats.root_brent_calls = 0;
+  solver_stats.root_brent_iter = 0;
+  solver_stats.newt_raph_calls = 0;
+  solver_stats.newt_raph_iter = 0;
+  solver_stats.soil_T_calls = 0;
+  solver_stats.soil_T_iter = 0;
+  solver_stats.soil_T_fallbacks = 0;
+  solver_stats.snow_merged = 0;
+  solver_stats.snow_merged_substeps = 0;
+  solver_stats.snow_rejected = 0;
+
+  if (cell_log_fp == NULL)
+    return;
+
+  cell_t0 = cell_stats_now();
+  cell_heap0 = cell_stats_heap();
+}
+
+void cell_stats_end(int               cellnum,
+                    soil_con_struct  *soil_con,
+                    veg_con_struct   *veg_con,
+                    all_vars_struct  *all_vars,
+                    lake_con_struct  *lake_con)
+/**********************************************************************
+  cell_stats_end	Keith Mathews			October 2026
+
+  Writes the CELL_LOG record of the current cell.  Must be called
+  before the cell's model structures are freed, so that the heap in
+  use (relative to the start of the cell) approximates the peak
+  allocation of the cell; VIC allocates all per-cell storage up front
+  and holds it until the end of the cell.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  extern solver_stats_struct solver_stats;
+  int    Nveg;
+  int    Nbands;
+  int    lake;
+  int    veg;
+  int    band;
+  int    index;
+  long   T_fb;
+  long   Tsurf_fb;
+  long   Tcanopy_fb;
+  long   Tfoliage_fb;
+  long   Tsnowsurf_fb;
+  double heap;
+  energy_bal_struct *energy;
+
+  if (cell_log_fp == NULL)
+    return;
+
+  Nveg = veg_con[0].vegetat_type_num;
+  Nbands = 0;
+  for (band = 0; band < options.SNOW_BAND; band++)
+    if (soil_con->AreaFract[band] > 0)
+      Nbands++;
+  lake = (options.LAKES && lake_con->lake_idx >= 0);
+
+  /* sum TFALLBACK counts over all tiles, including the lake tile */
+  T_fb = Tsurf_fb = Tcanopy_fb = Tfoliage_fb = Tsnowsurf_fb = 0;
+  for (veg = 0; veg <= Nveg; veg++) {
+    for (band = 0; band < options.SNOW_BAND; band++) {
+      energy = &(all_vars->energy[veg][band]);
+      for (index = 0; index < options.Nnode; index++)
+        T_fb += energy->T_fbcount[index];
+      Tsurf_fb += energy->Tsurf_fbcount;
+      Tcanopy_fb += energy->Tcanopy_fbcount;
+      Tfoliage_fb += energy->Tfoliage_fbcount;
+      Tsnowsurf_fb += (long)all_vars->snow[veg][band].surf_temp_fbcount;
+    }
+  }
+  if (lake) {
+    energy = &(all_vars->lake_var.energy);
+    for (index = 0; index < options.Nnode; index++)
+      T_fb += energy->T_fbcount[index];
+    Tsurf_fb += energy->Tsurf_fbcount;
+    Tsnowsurf_fb += (long)all_vars->lake_var.snow.surf_temp_fbcount;
+  }
+
+  heap = cell_stats_heap() - cell_heap0;
+  if (heap < 0) heap = 0;
+
+  fprintf(cell_log_fp, "%d,%d,%.6f,%.6f,%d,%d,%d,%.6f,%ld,%ld,%ld,%ld,"
+          "%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%ld,%.0f\n",
+          cellnum, soil_con->gridcel, soil_con->lat, soil_con->lng,
+          Nveg, Nbands, lake, cell_stats_now() - cell_t0,
+          solver_stats.root_brent_calls, solver_stats.root_brent_iter,
+          solver_stats.newt_raph_calls, solver_stats.newt_raph_iter,
+          solver_stats.soil_T_calls, solver_stats.soil_T_iter,
+          solver_stats.soil_T_fallbacks,
+          solver_stats.snow_merged, solver_stats.snow_merged_substeps,
+          solver_stats.snow_rejected,
+          T_fb, Tsurf_fb, Tcanopy_fb, Tfoliage_fb, Tsnowsurf_fb,
+          heap/1024.);
+  fflush(cell_log_fp);
+}
+
+void cell_stats_close()
+/**********************************************************************
+  cell_stats_close	Keith Mathews			October 2026
+
+  Closes the CELL_LOG file.
+
+  Modifications:
+**********************************************************************/
+{
+  if (cell_log_fp != NULL) {
+    fclose(cell_log_fp);
+    cell_log_fp = NULL;
+  }
+}
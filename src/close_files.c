@@ -27,6 +27,12 @@ void close_files(filep_struct         *filep,
 	      out_data_files structure.					TJB
   2006-Oct-16 Merged infiles and outfiles structs into filep_struct.	TJB
   2012-Jan-16 Removed LINK_DEBUG code					BN
+  2026-Oct-17 Output files are not closed if REGION_ONLY is TRUE.	KM
+  2026-Oct-17 Output files are not closed if STAT_ONLY is TRUE.	KM
+  2026-Oct-17 NETCDF forcing files are not closed here.		KM
+  2026-Oct-17 Output files are closed by the writer thread if
+	      WRITE_QUEUE > 0.						KM
+  2026-Oct-17 Output files are not closed if ARROW_OUTPUT is TRUE.	KM
 **********************************************************************/
 {
   extern option_struct options;
@@ -36,8 +42,10 @@ void close_files(filep_struct         *filep,
     Close All Input Files
     **********************/
 
-  fclose(filep->forcing[0]);
-  if(options.COMPRESS) compress_files(fnames->forcing[0]);
+  if(filep->forcing[0]!=NULL) {
+    fclose(filep->forcing[0]);
+    if(options.COMPRESS) compress_files(fnames->forcing[0]);
+  }
   if(filep->forcing[1]!=NULL) {
     fclose(filep->forcing[1]);
     if(options.COMPRESS) compress_files(fnames->forcing[1]);
@@ -46,6 +54,13 @@ void close_files(filep_struct         *filep,
   /*******************
     Close Output Files
     *******************/
+  if (options.REGION_ONLY || options.STAT_ONLY || options.ARROW_OUTPUT)
+    return;
+  if (options.WRITE_QUEUE > 0) {
+    /* the writer thread closes the files after their last record */
+    write_queue_close(out_data_files);
+    return;
+  }
   for (filenum=0; filenum<options.Noutfiles; filenum++) {
     fclose(out_data_files[filenum].fh);
     if(options.COMPRESS) compress_files(out_data_files[filenum].filename);
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <vicNl.h>
 
 static char vcid[] = "$Id$";
@@ -67,6 +68,25 @@ void display_current_settings(int                 mode,
   2014-Mar-28 Removed DIST_PRCP option.					TJB
   2014-Apr-25 Added LAI_SRC, VEGPARAM_ALB, and ALB_SRC options.		TJB
   2014-Apr-25 Added VEGPARAM_VEGCOVER and VEGCOVER_SRC options.		TJB
+  2026-Oct-17 Added TIMING option.					KM
+  2026-Oct-17 Added kernel capture options.				KM
+  2026-Oct-17 Added CELL_LOG option.					KM
+  2026-Oct-17 Added PROGRESS option.					KM
+  2026-Oct-17 Added MEM_STATS option.					KM
+  2026-Oct-17 Added region aggregation options.				KM
+  2026-Oct-17 Added routing options.					KM
+  2026-Oct-17 Added output statistics options.				KM
+  2026-Oct-17 Added forcing cache options.				KM
+  2026-Oct-17 Added FORCE_THREADS option.				KM
+  2026-Oct-17 Added FORCE_PRECISION option.				KM
+  2026-Oct-17 Added NETCDF_CACHE_MAX option.				KM
+  2026-Oct-17 Added PREFETCH_DEPTH option.				KM
+  2026-Oct-17 Added WRITE_QUEUE option.				KM
+  2026-Oct-17 Added ARROW_OUTPUT option.				KM
+  2026-Oct-17 Added SHM_NAME and SHM_SLOTS options.			KM
+  2026-Oct-17 Added SOIL_T_SOLVER option.				KM
+  2026-Oct-17 Added SNOW_STEP_ADAPT option.				KM
+  2026-Oct-17 Added IMPLICIT_JACOBIAN option.				KM
 
 **********************************************************************/
 {
@@ -76,6 +96,7 @@ void display_current_settings(int                 mode,
   extern param_set_struct param_set;
 
   int file_num;
+  int i;
 
   if (mode == DISP_VERSION) {
     fprintf(stderr,"***** VIC Version %s *****\n",version);
@@ -138,6 +159,10 @@ void display_current_settings(int                 mode,
   fprintf(stderr,"RESOLUTION\t\t%f\n",global->resolution);
   fprintf(stderr,"TIME_STEP\t\t%d\n",global->dt);
   fprintf(stderr,"SNOW_STEP\t\t%d\n",options.SNOW_STEP);
+  if (options.SNOW_STEP_ADAPT)
+    fprintf(stderr,"SNOW_STEP_ADAPT\t\tTRUE\n");
+  else
+    fprintf(stderr,"SNOW_STEP_ADAPT\t\tFALSE\n");
   fprintf(stderr,"STARTYEAR\t\t%d\n",global->startyear);
   fprintf(stderr,"STARTMONTH\t\t%d\n",global->startmonth);
   fprintf(stderr,"STARTDAY\t\t%d\n",global->startday);
@@ -216,10 +241,18 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"IMPLICIT\t\tTRUE\n");
   else
     fprintf(stderr,"IMPLICIT\t\tFALSE\n");
+  if (options.IMPLICIT_JACOBIAN == IMPL_JAC_GROUPED)
+    fprintf(stderr,"IMPLICIT_JACOBIAN\tGROUPED\n");
+  else
+    fprintf(stderr,"IMPLICIT_JACOBIAN\tNODE\n");
   if (options.NOFLUX)
     fprintf(stderr,"NOFLUX\t\t\tTRUE\n");
   else
     fprintf(stderr,"NOFLUX\t\t\tFALSE\n");
+  if (options.SOIL_T_SOLVER == SOIL_T_NEWTON)
+    fprintf(stderr,"SOIL_T_SOLVER\t\tNEWTON\n");
+  else
+    fprintf(stderr,"SOIL_T_SOLVER\t\tGAUSS_SEIDEL\n");
   if (options.MTCLIM_SWE_CORR)
     fprintf(stderr,"MTCLIM_SWE_CORR\t\tTRUE\n");
   else
@@ -300,15 +333,29 @@ void display_current_settings(int                 mode,
         fprintf(stderr,"FORCE_ENDIAN\t\tBIG\n");
       if (param_set.FORCE_FORMAT[file_num] == BINARY)
         fprintf(stderr,"FORCE_FORMAT\t\tBINARY\n");
+      else if (param_set.FORCE_FORMAT[file_num] == NETCDF)
+        fprintf(stderr,"FORCE_FORMAT\t\tNETCDF\n");
       else
         fprintf(stderr,"FORCE_FORMAT\t\tASCII\n");
     }
   }
   fprintf(stderr,"GRID_DECIMAL\t\t%d\n",options.GRID_DECIMAL);
+  if (param_set.FORCE_FORMAT[0] == NETCDF || param_set.FORCE_FORMAT[1] == NETCDF)
+    fprintf(stderr,"NETCDF_CACHE_MAX\t%d\n",options.NETCDF_CACHE_MAX);
+  fprintf(stderr,"PREFETCH_DEPTH\t\t%d\n",options.PREFETCH_DEPTH);
   if (options.ALMA_INPUT)
     fprintf(stderr,"ALMA_INPUT\t\tTRUE\n");
   else
     fprintf(stderr,"ALMA_INPUT\t\tFALSE\n");
+  fprintf(stderr,"FORCING_CACHE\t\t%s\n",names->forcing_cache);
+  if (strcmp(names->forcing_cache, "NONE") != 0)
+    fprintf(stderr,"FORCING_CACHE_MAX\t%d\n",options.FORCING_CACHE_MAX);
+  if (options.FORCE_PRECISION == FORCE_PREC_FLOAT)
+    fprintf(stderr,"FORCE_PRECISION\t\tFLOAT\n");
+  else if (options.FORCE_PRECISION == FORCE_PREC_SHORT)
+    fprintf(stderr,"FORCE_PRECISION\t\tSHORT\n");
+  else
+    fprintf(stderr,"FORCE_PRECISION\t\tDOUBLE\n");
 
   fprintf(stderr,"\n");
   fprintf(stderr,"Input Soil Data:\n");
@@ -421,6 +468,10 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"ALMA_OUTPUT\t\tTRUE\n");
   else
     fprintf(stderr,"ALMA_OUTPUT\t\tFALSE\n");
+  if (options.ARROW_OUTPUT)
+    fprintf(stderr,"ARROW_OUTPUT\t\tTRUE\n");
+  else
+    fprintf(stderr,"ARROW_OUTPUT\t\tFALSE\n");
   if (options.BINARY_OUTPUT)
     fprintf(stderr,"BINARY_OUTPUT\t\tTRUE\n");
   else
@@ -437,6 +488,8 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"OUTPUT_FORCE\t\tTRUE\n");
   else
     fprintf(stderr,"OUTPUT_FORCE\t\tFALSE\n");
+  if (options.OUTPUT_FORCE)
+    fprintf(stderr,"FORCE_THREADS\t\t%d\n",options.FORCE_THREADS);
   if (options.PRT_HEADER)
     fprintf(stderr,"PRT_HEADER\t\tTRUE\n");
   else
@@ -446,6 +499,64 @@ void display_current_settings(int                 mode,
   else
     fprintf(stderr,"PRT_SNOW_BAND\t\tFALSE\n");
   fprintf(stderr,"SKIPYEAR\t\t%d\n",global->skipyear);
+  fprintf(stderr,"REGION_MAP\t\t%s\n",names->region_map);
+  if (strcmp(names->region_map, "NONE") != 0) {
+    fprintf(stderr,"REGION_PREFIX\t\t%s\n",names->region_prefix);
+    if (options.REGION_ONLY)
+      fprintf(stderr,"REGION_ONLY\t\tTRUE\n");
+    else
+      fprintf(stderr,"REGION_ONLY\t\tFALSE\n");
+  }
+  fprintf(stderr,"SHM_NAME\t\t%s\n",names->shm_name);
+  if (strcmp(names->shm_name, "NONE") != 0)
+    fprintf(stderr,"SHM_SLOTS\t\t%d\n",options.SHM_SLOTS);
+  fprintf(stderr,"STAT_PREFIX\t\t%s\n",names->stat_prefix);
+  if (options.STAT_ONLY)
+    fprintf(stderr,"STAT_ONLY\t\tTRUE\n");
+  else
+    fprintf(stderr,"STAT_ONLY\t\tFALSE\n");
+  fprintf(stderr,"WRITE_QUEUE\t\t%d\n",options.WRITE_QUEUE);
+  fprintf(stderr,"ROUTING_FLOWDIR\t\t%s\n",names->route_flowdir);
+  if (strcmp(names->route_flowdir, "NONE") != 0) {
+    fprintf(stderr,"ROUTING_FRACTION\t%s\n",names->route_fraction);
+    fprintf(stderr,"ROUTING_STATIONS\t%s\n",names->route_stations);
+    fprintf(stderr,"ROUTING_UH\t\t%s\n",names->route_uh);
+    fprintf(stderr,"ROUTING_VELOCITY\t%f\n",global->route_velocity);
+    fprintf(stderr,"ROUTING_DIFFUSION\t%f\n",global->route_diffusion);
+  }
+
+  fprintf(stderr,"\n");
+  fprintf(stderr,"Diagnostics:\n");
+  if (options.TIMING == TIMING_PHASE)
+    fprintf(stderr,"TIMING\t\t\tPHASE\n");
+  else if (options.TIMING == TIMING_CELL)
+    fprintf(stderr,"TIMING\t\t\tCELL\n");
+  else
+    fprintf(stderr,"TIMING\t\t\tNONE\n");
+  if (options.TIMING != TIMING_NONE)
+    fprintf(stderr,"TIMING_FILE\t\t%s\n",names->timing);
+  if (options.KERNEL_CAPTURE) {
+    fprintf(stderr,"KERNEL_CAPTURE\t\t");
+    for (i = 0; i < N_KERNELS; i++)
+      if (options.KERNEL_CAPTURE & (1 << i))
+        fprintf(stderr,"%s ",kernel_name(i));
+    fprintf(stderr,"\n");
+    fprintf(stderr,"KERNEL_FILE\t\t%s\n",names->kernel);
+    fprintf(stderr,"KERNEL_SAMPLE\t\t%d\n",options.KERNEL_SAMPLE);
+    fprintf(stderr,"KERNEL_MAX\t\t%d\n",options.KERNEL_MAX);
+  }
+  else
+    fprintf(stderr,"KERNEL_CAPTURE\t\tNONE\n");
+  fprintf(stderr,"CELL_LOG\t\t%s\n",names->cell_log);
+  fprintf(stderr,"PROGRESS\t\t%d\n",options.PROGRESS);
+  if (options.PROGRESS > 0)
+    fprintf(stderr,"PROGRESS_FILE\t\t%s\n",names->progress);
+  if (options.MEM_STATS) {
+    fprintf(stderr,"MEM_STATS\t\tTRUE\n");
+    fprintf(stderr,"MEM_STATS_FILE\t\t%s\n",names->mem_stats);
+  }
+  else
+    fprintf(stderr,"MEM_STATS\t\tFALSE\n");
   fprintf(stderr,"\n");
 
 }
@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  force_disagg.c	Keith Mathews			October 2026
+
+  Threaded forcing disaggregation.  When OUTPUT_FORCE is TRUE and
+  FORCE_THREADS is greater than 1, vicNl.c hands the whole cell loop
+  to force_disagg().  The calling thread reads the soil parameter file
+  and passes each active cell through a small queue to one of
+  FORCE_THREADS worker threads.  Each worker has its own atmos array,
+  output variable list, output file list and forcing file handles (the
+  MTCLIM work arrays are allocated by mtclim_wrapper() on each call, so
+  they are per thread as well), and runs the same steps as the serial
+  cell loop: make_in_and_outfiles(), write_header(), initialize_atmos()
+  (which writes the disaggregated forcings via write_forcing_file()),
+  and close_files().  Cells are independent, so the output files are
+  identical to those of a serial run; only the order in which the cells
+  are completed differs.
+
+  The phase timers, the memory accounting and the forcing cache keep
+  global state, and cannot be combined with FORCE_THREADS > 1 (see
+  get_global_param()).  Progress is reported through progress.c
+  (PROGRESS), and a throughput summary is printed to stderr at the end
+  of the run.
+
+  Modifications:
+**********************************************************************/
+
+#define FORCE_QUEUE_PER_THREAD 4   /* queued cells per worker thread */
+
+typedef struct {
+  pthread_t             thread;
+  filenames_struct      names;           /* forcing and output file names */
+  filep_struct          filep;           /* forcing file handles */
+  atmos_data_struct    *atmos;
+  out_data_struct      *out_data;
+  out_data_file_struct *out_data_files;
+  int                   ncells;          /* number of cells disaggregated */
+} force_worker_struct;
+
+static soil_con_struct     *queue = NULL;   /* ring buffer of cells */
+static int                  queue_size = 0;
+static int                  queue_head = 0; /* index of next cell to take */
+static int                  queue_count = 0;
+static int                  queue_closed = FALSE;
+static pthread_mutex_t      queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t       queue_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t       queue_not_full = PTHREAD_COND_INITIALIZER;
+static pthread_mutex_t      progress_lock = PTHREAD_MUTEX_INITIALIZER;
+static dmy_struct          *force_dmy;
+static global_param_struct *force_global;
+
+static double force_now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec);
+}
+
+static void force_queue_put(soil_con_struct *soil_con)
+/* Adds a cell to the queue, waiting while the queue is full. */
+{
+  pthread_mutex_lock(&queue_lock);
+  while (queue_count == queue_size)
+    pthread_cond_wait(&queue_not_full, &queue_lock);
+  queue[(queue_head + queue_count) % queue_size] = *soil_con;
+  queue_count++;
+  pthread_cond_signal(&queue_not_empty);
+  pthread_mutex_unlock(&queue_lock);
+}
+
+static int force_queue_get(soil_con_struct *soil_con)
+/* Takes a cell from the queue, waiting while the queue is empty.
+   Returns FALSE when the queue is empty and no more cells will be
+   added. */
+{
+  pthread_mutex_lock(&queue_lock);
+  while (queue_count == 0 && !queue_closed)
+    pthread_cond_wait(&queue_not_empty, &queue_lock);
+  if (queue_count == 0) {
+    pthread_mutex_unlock(&queue_lock);
+    return FALSE;
+  }
+  *soil_con = queue[queue_head];
+  queue_head = (queue_head + 1) % queue_size;
+  queue_count--;
+  pthread_cond_signal(&queue_not_full);
+  pthread_mutex_unlock(&queue_lock);
+  return TRUE;
+}
+
+static void force_queue_close()
+/* Marks the end of the cells, and wakes any waiting workers. */
+{
+  pthread_mutex_lock(&queue_lock);
+  queue_closed = TRUE;
+  pthread_cond_broadcast(&queue_not_empty);
+  pthread_mutex_unlock(&queue_lock);
+}
+
+static void *force_worker(void *arg)
+/* Disaggregates the forcings of cells from the queue until it is
+   closed and empty. */
+{
+  extern option_struct options;
+  force_worker_struct *worker = (force_worker_struct *)arg;
+  soil_con_struct      soil_con;
+
+  while (force_queue_get(&soil_con)) {
+
+    make_in_and_outfiles(&worker->filep, &worker->names, &soil_con,
+                         worker->out_data_files);
+    if (options.PRT_HEADER && !options.REGION_ONLY && !options.STAT_ONLY)
+      write_header(worker->out_data_files, worker->out_data, force_dmy,
+                   *force_global);
+
+    initialize_atmos(worker->atmos, force_dmy, worker->filep.forcing,
+                     NULL, NULL, NULL, &soil_con, worker->out_data_files,
+                     worker->out_data);
+
+    close_files(&worker->filep, worker->out_data_files, &worker->names);
+
+    worker->ncells++;
+    pthread_mutex_lock(&progress_lock);
+    progress_end_cell();
+    pthread_mutex_unlock(&progress_lock);
+  }
+
+  return NULL;
+}
+
+void force_disagg(FILE                 *soilparam,
+                  filenames_struct     *names,
+                  global_param_struct  *global,
+                  dmy_struct           *dmy,
+                  out_data_file_struct *out_data_files,
+                  out_data_struct      *out_data)
+/**********************************************************************
+  force_disagg		Keith Mathews			October 2026
+
+  Disaggregates the forcings of all active cells in the soil parameter
+  file with FORCE_THREADS worker threads, and prints the throughput.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+
+  force_worker_struct *workers;
+  soil_con_struct      soil_con;
+  char                 MODEL_DONE;
+  char                 RUN_MODEL;
+  char                 ErrStr[MAXSTRING];
+  int                  nthreads;
+  int                  ncells;
+  int                  t;
+  double               t0, elapsed, cell_years;
+
+  nthreads = options.FORCE_THREADS;
+  force_dmy = dmy;
+  force_global = global;
+
+  queue_size = FORCE_QUEUE_PER_THREAD * nthreads;
+  queue = (soil_con_struct *)calloc(queue_size, sizeof(soil_con_struct));
+  workers = (force_worker_struct *)calloc(nthreads, sizeof(force_worker_struct));
+  if (queue == NULL || workers == NULL)
+    nrerror("Memory allocation failure in force_disagg");
+
+  t0 = force_now();
+
+  /** Start the worker threads **/
+  for (t = 0; t < nthreads; t++) {
+    workers[t].names = *names;
+    alloc_atmos(global->nrecs, &workers[t].atmos);
+    workers[t].out_data = copy_output_list(out_data);
+    workers[t].out_data_files = copy_out_data_files(out_data_files);
+    if (pthread_create(&workers[t].thread, NULL, force_worker, &workers[t]) != 0) {
+      sprintf(ErrStr, "Unable to start forcing disaggregation thread %d of %d.", t+1, nthreads);
+      nrerror(ErrStr);
+    }
+  }
+
+  /** Read the active cells and queue them **/
+  ncells = 0;
+  MODEL_DONE = FALSE;
+  while (!MODEL_DONE) {
+    soil_con = read_soilparam(soilparam, &RUN_MODEL, &MODEL_DONE);
+    if (RUN_MODEL) {
+      force_queue_put(&soil_con);
+      ncells++;
+    }
+  }
+  force_queue_close();
+
+  /** Wait for the workers to finish **/
+  for (t = 0; t < nthreads; t++) {
+    pthread_join(workers[t].thread, NULL);
+    free_atmos(global->nrecs, &workers[t].atmos);
+    free_out_data_files(&workers[t].out_data_files);
+    free_out_data(&workers[t].out_data);
+  }
+
+  elapsed = force_now() - t0;
+  cell_years = (double)ncells * global->nrecs * global->dt / (24. * 365.25);
+  fprintf(stderr, "Forcing disaggregation: %d cells (%.1f cell-years) in %.1f s "
+          "with %d threads: %.2f cells/s, %.1f cell-years/s\n", ncells,
+          cell_years, elapsed, nthreads,
+          (elapsed > 0) ? ncells / elapsed : 0.,
+          (elapsed > 0) ? cell_years / elapsed : 0.);
+
+  free((char *)workers);
+  free((char *)queue);
+}
@@ -0,0 +1,471 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  forcing_cache.c	Keith Mathews			October 2026
+
+  Persistent cache of the disaggregated forcings of each cell.  When a
+  FORCING_CACHE directory is given, initialize_atmos() computes a key
+  for the cell (forcing_cache_key()) and looks for a cache entry with
+  that key (forcing_cache_load()).  On a hit, the atmos arrays are read
+  from the entry and the forcing files are neither read nor passed
+  through MTCLIM; on a miss, the arrays are computed as usual and then
+  stored in a new entry (forcing_cache_store()).
+
+  The key is a 64-bit FNV-1a hash of everything the contents of the
+  atmos arrays depend on:
+    - the bytes of the forcing file(s) of the cell
+    - the forcing file descriptions (param_set)
+    - the simulation period and model and snow time steps
+    - the options that affect the disaggregation (ALMA_INPUT, LW_CLOUD,
+      LW_TYPE, MIN_WIND_SPEED, MTCLIM_SWE_CORR, OUTPUT_FORCE, PLAPSE,
+      SNOW_BAND, SW_PREC_THRESH, VP_INTERP, VP_ITER, and MAX_SNOW_TEMP)
+    - the location, elevation, slope, aspect, horizons, annual
+      precipitation, area, and snow band temperature offsets of the cell
+  Soil and vegetation parameters are not part of the key, so runs that
+  differ only in those share entries.  Cells whose forcings include
+  ALBEDO, LAI_IN, or VEGCOVER are not cached, since those depend on the
+  vegetation tiles of the cell.
+
+  Each entry is a file <key>.vfc in the cache directory (native byte
+  order and type sizes), holding a header (magic string, key, nrecs,
+  NR) followed by the atmos arrays of each record.  Entries are written
+  to a temporary file and renamed, so concurrent runs sharing the
+  directory never read a partial entry.  If FORCING_CACHE_MAX [MB] is
+  positive, the size of the directory is found once at the start of
+  the run and kept as a running total as entries are stored and
+  deleted.  When a store takes the total over the limit, the directory
+  is scanned again (picking up hits, which update the file
+  modification time, and entries written by other runs) and the least
+  recently used entries are deleted until the directory is within
+  FORCING_CACHE_LOW of the limit, so that a full cache is not scanned
+  on every store.  Entries larger than the limit are not stored.
+
+  Modifications:
+**********************************************************************/
+
+#define FORCING_CACHE_MAGIC "VICFC001"
+#define FORCING_CACHE_EXT   ".vfc"
+#define N_CACHE_ARRAYS      15
+#define FORCING_CACHE_LOW   0.9
+#define MAX_ENTRY_NAME      32
+
+static char cache_dir[MAXSTRING];
+static int  cache_on = FALSE;
+static long cache_hits = 0;
+static long cache_misses = 0;
+static long cache_evicted = 0;
+
+typedef struct {
+  char   name[MAX_ENTRY_NAME];
+  double size;
+  time_t mtime;
+} cache_entry_struct;
+
+static cache_entry_struct *cache_entries = NULL;
+static int                 cache_nentries = 0;
+static int                 cache_maxentries = 0;
+static double              cache_total = 0;
+
+static unsigned long fnv_add(unsigned long hash, const void *ptr, size_t n)
+/* Adds n bytes to a 64-bit FNV-1a hash. */
+{
+  const unsigned char *p = (const unsigned char *)ptr;
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    hash ^= p[i];
+    hash *= 1099511628211UL;
+  }
+  return hash;
+}
+
+static unsigned long fnv_int(unsigned long hash, int value)
+{
+  return fnv_add(hash, &value, sizeof(int));
+}
+
+static unsigned long fnv_double(unsigned long hash, double value)
+{
+  return fnv_add(hash, &value, sizeof(double));
+}
+
+static double **atmos_arrays(atmos_data_struct *atmos, double **arrays)
+/* Lists the double arrays of one record of atmos, in file order. */
+{
+  arrays[0]  = atmos->air_temp;
+  arrays[1]  = atmos->Catm;
+  arrays[2]  = atmos->channel_in;
+  arrays[3]  = atmos->coszen;
+  arrays[4]  = atmos->density;
+  arrays[5]  = atmos->fdir;
+  arrays[6]  = atmos->longwave;
+  arrays[7]  = atmos->par;
+  arrays[8]  = atmos->prec;
+  arrays[9]  = atmos->pressure;
+  arrays[10] = atmos->shortwave;
+  arrays[11] = atmos->tskc;
+  arrays[12] = atmos->vp;
+  arrays[13] = atmos->vpd;
+  arrays[14] = atmos->wind;
+  return arrays;
+}
+
+static void entry_path(unsigned long key, char *path)
+{
+  sprintf(path, "%s/%016lx%s", cache_dir, key, FORCING_CACHE_EXT);
+}
+
+static int entry_cmp(const void *a, const void *b)
+/* Orders cache entries from least to most recently used. */
+{
+  const cache_entry_struct *ea = (const cache_entry_struct *)a;
+  const cache_entry_struct *eb = (const cache_entry_struct *)b;
+
+  if (ea->mtime < eb->mtime) return -1;
+  if (ea->mtime > eb->mtime) return 1;
+  return strcmp(ea->name, eb->name);
+}
+
+static void forcing_cache_scan()
+/* Lists the entries in the cache directory and sets cache_total. */
+{
+  DIR           *dir;
+  struct dirent *dent;
+  struct stat    st;
+  size_t         len;
+  char           path[2*MAXSTRING];
+
+  cache_nentries = 0;
+  cache_total = 0;
+  if ((dir = opendir(cache_dir)) == NULL)
+    return;
+  while ((dent = readdir(dir)) != NULL) {
+    len = strlen(dent->d_name);
+    if (len <= strlen(FORCING_CACHE_EXT) || len >= MAX_ENTRY_NAME
+        || strcmp(dent->d_name + len - strlen(FORCING_CACHE_EXT), FORCING_CACHE_EXT) != 0)
+      continue;
+    sprintf(path, "%s/%s", cache_dir, dent->d_name);
+    if (stat(path, &st) != 0)
+      continue;
+    if (cache_nentries == cache_maxentries) {
+      cache_maxentries = (cache_maxentries > 0) ? 2*cache_maxentries : 64;
+      cache_entries = (cache_entry_struct *)realloc(cache_entries, cache_maxentries*sizeof(cache_entry_struct));
+      if (cache_entries == NULL)
+        nrerror("Memory allocation failure in forcing_cache_scan()");
+    }
+    strcpy(cache_entries[cache_nentries].name, dent->d_name);
+    cache_entries[cache_nentries].size = (double)st.st_size;
+    cache_entries[cache_nentries].mtime = st.st_mtime;
+    cache_total += cache_entries[cache_nentries].size;
+    cache_nentries++;
+  }
+  closedir(dir);
+}
+
+static void forcing_cache_evict(double max_bytes)
+/* Deletes least recently used entries until the cache is within
+   FORCING_CACHE_LOW of max_bytes. */
+{
+  int  i, n;
+  char path[2*MAXSTRING];
+
+  forcing_cache_scan();
+  if (cache_total <= max_bytes)
+    return;
+  qsort(cache_entries, cache_nentries, sizeof(cache_entry_struct), entry_cmp);
+  for (i = 0; i < cache_nentries && cache_total > FORCING_CACHE_LOW * max_bytes; i++) {
+    sprintf(path, "%s/%s", cache_dir, cache_entries[i].name);
+    if (unlink(path) == 0) {
+      cache_total -= cache_entries[i].size;
+      cache_evicted++;
+    }
+  }
+  /* keep the list to the entries that are left */
+  n = cache_nentries - i;
+  memmove(cache_entries, cache_entries + i, n*sizeof(cache_entry_struct));
+  cache_nentries = n;
+}
+
+void forcing_cache_init(filenames_struct *names)
+/**********************************************************************
+  forcing_cache_init	Keith Mathews			October 2026
+
+  Enables the forcing cache if a FORCING_CACHE directory was given,
+  creating the directory if necessary.  If FORCING_CACHE_MAX is set,
+  finds the size of the entries already in the directory.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+
+  char ErrStr[2*MAXSTRING];
+
+  if (strcmp(names->forcing_cache, "NONE") == 0)
+    return;
+
+  strcpy(cache_dir, names->forcing_cache);
+  if (mkdir(cache_dir, 0777) != 0 && access(cache_dir, W_OK) != 0) {
+    snprintf(ErrStr, sizeof(ErrStr), "Unable to create or write to the FORCING_CACHE directory %s", cache_dir);
+    nrerror(ErrStr);
+  }
+  cache_on = TRUE;
+  if (options.FORCING_CACHE_MAX > 0)
+    forcing_cache_scan();
+}
+
+int forcing_cache_key(FILE            **infile,
+                      soil_con_struct  *soil_con,
+                      unsigned long    *key)
+/**********************************************************************
+  forcing_cache_key	Keith Mathews			October 2026
+
+  Computes the cache key of the current cell.  Returns FALSE (and the
+  cell is not cached) if the cache is disabled or the forcings include
+  vegetation parameters.  The forcing files are read to compute the
+  key; the position of each file is restored afterwards.
+
+  Modifications:
+  2026-Oct-17 The snow band temperature offsets are not hashed when
+	      OUTPUT_FORCE is TRUE, since they are not read.		KM
+**********************************************************************/
+{
+  extern option_struct       options;
+  extern param_set_struct    param_set;
+  extern global_param_struct global_param;
+
+  unsigned long hash;
+  unsigned char buf[65536];
+  size_t        n;
+  long          pos;
+  int           f, i;
+
+  if (!cache_on)
+    return FALSE;
+  if (param_set.TYPE[ALBEDO].SUPPLIED || param_set.TYPE[LAI_IN].SUPPLIED
+      || param_set.TYPE[VEGCOVER].SUPPLIED)
+    return FALSE;
+
+  hash = 14695981039346656037UL;
+  hash = fnv_add(hash, FORCING_CACHE_MAGIC, strlen(FORCING_CACHE_MAGIC));
+
+  /* forcing files */
+  for (f = 0; f < 2; f++) {
+    if (param_set.FORCE_DT[f] <= 0)
+      continue;
+    pos = ftell(infile[f]);
+    fseek(infile[f], 0, SEEK_SET);
+    while ((n = fread(buf, 1, sizeof(buf), infile[f])) > 0)
+      hash = fnv_add(hash, buf, n);
+    clearerr(infile[f]);
+    fseek(infile[f], pos, SEEK_SET);
+    hash = fnv_int(hash, param_set.FORCE_DT[f]);
+    hash = fnv_int(hash, param_set.FORCE_ENDIAN[f]);
+    hash = fnv_int(hash, param_set.FORCE_FORMAT[f]);
+    hash = fnv_int(hash, param_set.N_TYPES[f]);
+    for (i = 0; i < N_FORCING_TYPES; i++)
+      hash = fnv_int(hash, param_set.FORCE_INDEX[f][i]);
+    hash = fnv_int(hash, global_param.forceskip[f]);
+  }
+  for (i = 0; i < N_FORCING_TYPES; i++) {
+    hash = fnv_int(hash, param_set.TYPE[i].N_ELEM);
+    hash = fnv_int(hash, param_set.TYPE[i].SIGNED);
+    hash = fnv_int(hash, param_set.TYPE[i].SUPPLIED);
+    hash = fnv_double(hash, param_set.TYPE[i].multiplier);
+  }
+
+  /* simulation period and time steps */
+  hash = fnv_int(hash, global_param.startyear);
+  hash = fnv_int(hash, global_param.startmonth);
+  hash = fnv_int(hash, global_param.startday);
+  hash = fnv_int(hash, global_param.starthour);
+  hash = fnv_int(hash, global_param.nrecs);
+  hash = fnv_int(hash, global_param.dt);
+  hash = fnv_int(hash, options.SNOW_STEP);
+
+  /* disaggregation options */
+  hash = fnv_int(hash, options.ALMA_INPUT);
+  hash = fnv_int(hash, options.LW_CLOUD);
+  hash = fnv_int(hash, options.LW_TYPE);
+  hash = fnv_double(hash, options.MIN_WIND_SPEED);
+  hash = fnv_int(hash, options.MTCLIM_SWE_CORR);
+  hash = fnv_int(hash, options.OUTPUT_FORCE);
+  hash = fnv_int(hash, options.PLAPSE);
+  hash = fnv_int(hash, options.SNOW_BAND);
+  hash = fnv_double(hash, options.SW_PREC_THRESH);
+  hash = fnv_int(hash, options.VP_INTERP);
+  hash = fnv_int(hash, options.VP_ITER);
+  hash = fnv_double(hash, global_param.MAX_SNOW_TEMP);
+
+  /* cell */
+  hash = fnv_double(hash, soil_con->lat);
+  hash = fnv_double(hash, soil_con->lng);
+  hash = fnv_double(hash, soil_con->time_zone_lng);
+  hash = fnv_double(hash, soil_con->elevation);
+  hash = fnv_double(hash, soil_con->slope);
+  hash = fnv_double(hash, soil_con->aspect);
+  hash = fnv_double(hash, soil_con->ehoriz);
+  hash = fnv_double(hash, soil_con->whoriz);
+  hash = fnv_double(hash, soil_con->annual_prec);
+  hash = fnv_double(hash, soil_con->cell_area);
+  if (!options.OUTPUT_FORCE) {
+    /* the snow bands are not read when OUTPUT_FORCE is TRUE */
+    for (i = 0; i < options.SNOW_BAND; i++)
+      hash = fnv_double(hash, soil_con->Tfactor[i]);
+  }
+
+  *key = hash;
+  return TRUE;
+}
+
+int forcing_cache_load(unsigned long      key,
+                       atmos_data_struct *atmos)
+/**********************************************************************
+  forcing_cache_load	Keith Mathews			October 2026
+
+  Fills the atmos arrays from the cache entry with the given key.
+  Returns TRUE on a hit, FALSE if there is no valid entry.
+
+  Modifications:
+**********************************************************************/
+{
+  extern global_param_struct global_param;
+  extern int                 NR;
+
+  FILE          *fp;
+  char           path[2*MAXSTRING];
+  char           magic[sizeof(FORCING_CACHE_MAGIC)];
+  unsigned long  file_key;
+  int            nrecs, nr;
+  int            rec, k;
+  int            ok;
+  double        *arrays[N_CACHE_ARRAYS];
+
+  entry_path(key, path);
+  if ((fp = fopen(path, "rb")) == NULL) {
+    cache_misses++;
+    return FALSE;
+  }
+
+  ok = (fread(magic, 1, sizeof(magic), fp) == sizeof(magic)
+        && memcmp(magic, FORCING_CACHE_MAGIC, sizeof(magic)) == 0
+        && fread(&file_key, sizeof(unsigned long), 1, fp) == 1
+        && file_key == key
+        && fread(&nrecs, sizeof(int), 1, fp) == 1
+        && nrecs == global_param.nrecs
+        && fread(&nr, sizeof(int), 1, fp) == 1
+        && nr == NR);
+  for (rec = 0; ok && rec < global_param.nrecs; rec++) {
+    atmos_arrays(&atmos[rec], arrays);
+    for (k = 0; ok && k < N_CACHE_ARRAYS; k++)
+      ok = (fread(arrays[k], sizeof(double), NR+1, fp) == (size_t)(NR+1));
+    if (ok)
+      ok = (fread(atmos[rec].snowflag, sizeof(char), NR+1, fp) == (size_t)(NR+1));
+  }
+  fclose(fp);
+
+  if (!ok) {
+    fprintf(stderr, "WARNING: ignoring invalid forcing cache entry %s\n", path);
+    cache_misses++;
+    return FALSE;
+  }
+
+  utime(path, NULL); // mark as recently used
+  cache_hits++;
+  return TRUE;
+}
+
+void forcing_cache_store(unsigned long      key,
+                         atmos_data_struct *atmos)
+/**********************************************************************
+  forcing_cache_store	Keith Mathews			October 2026
+
+  Writes the atmos arrays to a new cache entry with the given key and,
+  if FORCING_CACHE_MAX is set, adds it to the running total of the
+  cache size and evicts the least recently used entries if the total
+  is over the limit.
+  Failure to write an entry is not an error; the entry is skipped.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct       options;
+  extern global_param_struct global_param;
+  extern int                 NR;
+
+  FILE   *fp;
+  struct stat st;
+  char    path[2*MAXSTRING];
+  char    tmppath[2*MAXSTRING+32];
+  int     rec, k;
+  int     ok;
+  double  max_bytes;
+  double  entry_bytes;
+  double *arrays[N_CACHE_ARRAYS];
+
+  max_bytes = (double)options.FORCING_CACHE_MAX * 1024. * 1024.;
+  entry_bytes = sizeof(FORCING_CACHE_MAGIC) + sizeof(unsigned long) + 2*sizeof(int)
+    + (double)global_param.nrecs * (NR+1) * (N_CACHE_ARRAYS*sizeof(double) + sizeof(char));
+  if (max_bytes > 0 && entry_bytes > max_bytes)
+    return;
+
+  entry_path(key, path);
+  sprintf(tmppath, "%s.tmp.%ld", path, (long)getpid());
+  if ((fp = fopen(tmppath, "wb")) == NULL) {
+    fprintf(stderr, "WARNING: unable to write forcing cache entry %s\n", tmppath);
+    return;
+  }
+
+  ok = (fwrite(FORCING_CACHE_MAGIC, 1, sizeof(FORCING_CACHE_MAGIC), fp) == sizeof(FORCING_CACHE_MAGIC)
+        && fwrite(&key, sizeof(unsigned long), 1, fp) == 1
+        && fwrite(&global_param.nrecs, sizeof(int), 1, fp) == 1
+        && fwrite(&NR, sizeof(int), 1, fp) == 1);
+  for (rec = 0; ok && rec < global_param.nrecs; rec++) {
+    atmos_arrays(&atmos[rec], arrays);
+    for (k = 0; ok && k < N_CACHE_ARRAYS; k++)
+      ok = (fwrite(arrays[k], sizeof(double), NR+1, fp) == (size_t)(NR+1));
+    if (ok)
+      ok = (fwrite(atmos[rec].snowflag, sizeof(char), NR+1, fp) == (size_t)(NR+1));
+  }
+  if (fclose(fp) != 0)
+    ok = FALSE;
+
+  if (ok && max_bytes > 0 && stat(path, &st) == 0)
+    cache_total -= (double)st.st_size; // replacing an invalid entry
+  if (!ok || rename(tmppath, path) != 0) {
+    fprintf(stderr, "WARNING: unable to write forcing cache entry %s\n", path);
+    unlink(tmppath);
+    return;
+  }
+
+  if (max_bytes > 0) {
+    cache_total += entry_bytes;
+    if (cache_total > max_bytes)
+      forcing_cache_evict(max_bytes);
+  }
+}
+
+void forcing_cache_summary()
+/**********************************************************************
+  forcing_cache_summary	Keith Mathews			October 2026
+
+  Prints the numbers of cache hits, misses, and evictions to stderr.
+
+  Modifications:
+**********************************************************************/
+{
+  if (!cache_on)
+    return;
+  fprintf(stderr, "\nForcing cache %s: %ld hits, %ld misses, %ld entries evicted\n",
+          cache_dir, cache_hits, cache_misses, cache_evicted);
+}
@@ -21,6 +21,7 @@ void free_all_vars(all_vars_struct *all_vars,
   2009-Jul-31 Removed extra veg tile for lake/wetland.			TJB
   2013-Jul-29 Added freeing of photosynthesis terms.			TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 **********************************************************************/
 {
   extern option_struct options;
@@ -30,27 +31,27 @@ void free_all_vars(all_vars_struct *all_vars,
   Nitems = Nveg + 1;
 
   for(j=0;j<Nitems;j++) {
-    free((char *)all_vars[0].cell[j]);
+    mem_free((char *)all_vars[0].cell[j], MEM_MODEL_STATE);
   }
-  free((char *)all_vars[0].cell);
+  mem_free((char *)all_vars[0].cell, MEM_MODEL_STATE);
   for(j=0;j<Nitems;j++) {
     if (options.CARBON) {
       for ( k = 0 ; k < options.SNOW_BAND ; k++ ) {
-        free((char *)all_vars[0].veg_var[j][k].NscaleFactor);
-        free((char *)all_vars[0].veg_var[j][k].aPARLayer);
-        free((char *)all_vars[0].veg_var[j][k].CiLayer);
-        free((char *)all_vars[0].veg_var[j][k].rsLayer);
+        mem_free((char *)all_vars[0].veg_var[j][k].NscaleFactor, MEM_MODEL_STATE);
+        mem_free((char *)all_vars[0].veg_var[j][k].aPARLayer, MEM_MODEL_STATE);
+        mem_free((char *)all_vars[0].veg_var[j][k].CiLayer, MEM_MODEL_STATE);
+        mem_free((char *)all_vars[0].veg_var[j][k].rsLayer, MEM_MODEL_STATE);
       }
     }
-    free((char *)(*all_vars).veg_var[j]);
+    mem_free((char *)(*all_vars).veg_var[j], MEM_MODEL_STATE);
   }
-  free((char *)(*all_vars).veg_var);
+  mem_free((char *)(*all_vars).veg_var, MEM_MODEL_STATE);
   for(j=0;j<Nitems;j++) {
-    free((char *)all_vars[0].energy[j]);
+    mem_free((char *)all_vars[0].energy[j], MEM_MODEL_STATE);
   }
-  free((char *)all_vars[0].energy);
+  mem_free((char *)all_vars[0].energy, MEM_MODEL_STATE);
   for(i=0;i<Nitems;i++)
-    free((char *)all_vars[0].snow[i]);
-  free((char *)all_vars[0].snow);
+    mem_free((char *)all_vars[0].snow[i], MEM_MODEL_STATE);
+  mem_free((char *)all_vars[0].snow, MEM_MODEL_STATE);
 
 }
@@ -55,6 +55,7 @@ int calc_layer_average_thermal_props(energy_bal_struct *energy,
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
   2013-Dec-27 Removed QUICK_FS option.					TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
+  2026-Oct-17 Passes soil_con->node_layer to estimate_layer_ice_content().	KM
 ******************************************************************/
 
   extern option_struct options;
@@ -81,12 +82,11 @@ int calc_layer_average_thermal_props(energy_bal_struct *energy,
     if ( ErrorFlag == ERROR ) return (ERROR);
   }
   else {
-    ErrorFlag = estimate_layer_ice_content(layer, soil_con->Zsum_node, energy->T,
+    ErrorFlag = estimate_layer_ice_content(layer, &soil_con->node_layer, energy->T,
 					   soil_con->max_moist_node, 
 					   soil_con->expt_node, soil_con->bubble_node, 
 					   soil_con->depth, soil_con->max_moist, 
 					   soil_con->expt, soil_con->bubble, 
-					   soil_con->frost_fract, soil_con->frost_slope, 
 					   Nnodes, options.Nlayer, soil_con->FS_ACTIVE);
     if ( ErrorFlag == ERROR ) return (ERROR);
   }
@@ -346,6 +346,223 @@ int solve_T_profile_implicit(double *T,                           // update
 
  
 
+#define NEWTON_MAXIT  50     /* maximum number of Newton iterations */
+#define NEWTON_TOL    1.e-4  /* Newton convergence threshold [C] */
+#define NEWTON_HALVE  10     /* maximum number of step halvings */
+
+static double soil_thermal_system(int     Nnodes,
+                                  int     Nlast,
+                                  double *T,
+                                  double *T0,
+                                  double *moist,
+                                  double *max_moist,
+                                  double *ice,
+                                  double *bubble,
+                                  double *expt,
+                                  double *A,
+                                  double *B,
+                                  double *C,
+                                  double *D,
+                                  double *E,
+                                  int     FROZEN,
+                                  int     EXP_TRANS,
+                                  double *F,
+                                  double *a,
+                                  double *b,
+                                  double *c,
+                                  int    *linear)
+/**********************************************************************
+  soil_thermal_system	Keith Mathews			October 2026
+
+  Evaluates the residuals F of the heat equations of nodes 1..Nlast
+  (soil_thermal_eqn(), with TL = T of the node itself for the no-flux
+  bottom node) and their tridiagonal Jacobian (a = derivative with
+  respect to the node above, b = to the node itself, c = to the node
+  below), with the ice derivative computed analytically from
+  maximum_unfrozen_water().  Nodes at or above 0 C, or all nodes if
+  FROZEN is FALSE, have no ice and no cold nose fix, as in the linear
+  update of calc_soil_thermal_fluxes(); linear is set to TRUE if that
+  holds for every node, i.e. if the equations are linear around T.
+  Returns the largest residual.
+
+  Modifications:
+**********************************************************************/
+{
+  int    i, j;
+  double TL, TU, Tj, ice_j, dice, unfrozen;
+  double flux_term1, flux_term2, dT, dTL, dTU;
+  double Fmax;
+
+  Fmax = 0;
+  *linear = TRUE;
+  for (j = 1; j <= Nlast; j++) {
+    i = j-1;
+    Tj = T[j];
+    TU = T[j-1];
+    TL = (j == Nnodes-1) ? Tj : T[j+1];
+
+    if (!EXP_TRANS) {
+      flux_term1 = B[j]*(TL-TU);
+      flux_term2 = C[j]*(TL-Tj) - D[j]*(Tj-TU);
+      dT = -A[j] - C[j] - D[j];
+      dTL = B[j] + C[j];
+      dTU = -B[j] + D[j];
+    }
+    else {
+      flux_term1 = B[j]*(TL-TU);
+      flux_term2 = C[j]*(TL-2.*Tj+TU) - D[j]*(TL-TU);
+      dT = -A[j] - 2.*C[j];
+      dTL = B[j] + C[j] - D[j];
+      dTU = -B[j] + C[j] + D[j];
+    }
+
+    ice_j = 0;
+    if (FROZEN && Tj < 0.) {
+      *linear = FALSE;
+      unfrozen = maximum_unfrozen_water(Tj, max_moist[j], bubble[j], expt[j]);
+      ice_j = moist[j] - unfrozen;
+      dice = 0;
+      if (ice_j < 0.) ice_j = 0.;
+      else if (ice_j > max_moist[j]) ice_j = max_moist[j];
+      else if (unfrozen > 0. && unfrozen < max_moist[j])
+        dice = 2.0 / (expt[j] - 3.0) * unfrozen / Tj;
+      dT += E[j]*dice;
+
+      /* cold nose fix of soil_thermal_eqn() */
+      if (j == 1 && fabs(TL-TU) > 5. && Tj < TL && Tj < TU
+          && flux_term1 < 0 && flux_term2 > 0 && fabs(flux_term1) > fabs(flux_term2)) {
+        flux_term1 = 0;
+        dTL -= B[j];
+        dTU += B[j];
+      }
+    }
+
+    F[i] = -A[j]*(Tj-T0[j]) + flux_term1 + flux_term2 + E[j]*(ice_j-ice[j]);
+    if (fabs(F[i]) > Fmax) Fmax = fabs(F[i]);
+    if (j == Nnodes-1) {
+      dT += dTL;
+      dTL = 0;
+    }
+    a[i] = dTU;
+    b[i] = dT;
+    c[i] = dTL;
+  }
+
+  return (Fmax);
+}
+
+static int newton_soil_thermal_fluxes(int     Nnodes,
+                                      double *T,
+                                      double *T0,
+                                      double *moist,
+                                      double *max_moist,
+                                      double *ice,
+                                      double *bubble,
+                                      double *expt,
+                                      double *A,
+                                      double *B,
+                                      double *C,
+                                      double *D,
+                                      double *E,
+                                      int     FROZEN,
+                                      int     NOFLUX,
+                                      int     EXP_TRANS,
+                                      int    *ItCount)
+/**********************************************************************
+  newton_soil_thermal_fluxes	Keith Mathews			October 2026
+
+  Solves the heat equations of calc_soil_thermal_fluxes() as one
+  nonlinear tridiagonal system (SOIL_T_SOLVER NEWTON): Newton's method,
+  with the Jacobian of soil_thermal_system() solved by tridiag(), and
+  the step halved until the largest residual decreases, which keeps
+  the iteration from overshooting where the ice content changes
+  steeply just below 0 C.  When the equations are linear (no frozen
+  nodes) both before and after a full step, the step is exact and the
+  iteration ends without evaluating the residuals again.  T holds the starting profile on entry (T0, with the
+  boundary temperatures set) and the solution on return.  The number
+  of iterations is returned in ItCount.  Returns 0 if the solution
+  converged (largest temperature change of an iteration below
+  NEWTON_TOL), and 1 otherwise (no convergence, no decrease of the
+  residual, or non-finite values), in which case T is undefined.
+
+  Modifications:
+**********************************************************************/
+{
+  int    n, i, k, halve;
+  int    linear, linear_new;
+  double F[MAX_NODES], a[MAX_NODES], b[MAX_NODES], c[MAX_NODES];
+  double Fnew[MAX_NODES], anew[MAX_NODES], bnew[MAX_NODES], cnew[MAX_NODES];
+  double p[MAX_NODES], Tnew[MAX_NODES];
+  double Fmax, Fmax_new, lambda, maxdiff;
+
+  n = NOFLUX ? Nnodes-1 : Nnodes-2;
+  *ItCount = 0;
+  if (n < 1)
+    return (0);
+
+  for (i = 0; i < Nnodes; i++)
+    Tnew[i] = T[i];
+  Fmax = soil_thermal_system(Nnodes, n, T, T0, moist, max_moist, ice, bubble,
+                             expt, A, B, C, D, E, FROZEN, EXP_TRANS,
+                             F, a, b, c, &linear);
+
+  for (k = 0; k < NEWTON_MAXIT; k++) {
+    (*ItCount)++;
+
+    for (i = 0; i < n; i++) p[i] = -F[i];
+    tridiag(a, b, c, p, n);
+
+    /* a full step that stays within the linear region is exact */
+    if (linear) {
+      for (i = 0; i < n && (!FROZEN || T[i+1] + p[i] >= 0.); i++);
+      if (i == n) {
+        for (i = 0; i < n; i++) T[i+1] += p[i];
+        return (0);
+      }
+    }
+
+    /* damped step: halve it until the largest residual decreases; the
+       Jacobian at the accepted point is kept for the next iteration */
+    lambda = 1.;
+    for (halve = 0; halve <= NEWTON_HALVE; halve++) {
+      for (i = 0; i < n; i++) Tnew[i+1] = T[i+1] + lambda*p[i];
+      Fmax_new = soil_thermal_system(Nnodes, n, Tnew, T0, moist, max_moist,
+                                     ice, bubble, expt, A, B, C, D, E, FROZEN,
+                                     EXP_TRANS, Fnew, anew, bnew, cnew,
+                                     &linear_new);
+      if (Fmax_new < Fmax) break;
+      lambda *= 0.5;
+    }
+    if (!(Fmax_new == Fmax_new))
+      return (1);
+
+    maxdiff = 0;
+    for (i = 0; i < n; i++) {
+      if (fabs(Tnew[i+1]-T[i+1]) > maxdiff) maxdiff = fabs(Tnew[i+1]-T[i+1]);
+      T[i+1] = Tnew[i+1];
+      F[i] = Fnew[i];
+      a[i] = anew[i];
+      b[i] = bnew[i];
+      c[i] = cnew[i];
+    }
+    Fmax = Fmax_new;
+    if (!(maxdiff == maxdiff))
+      return (1);
+    if (maxdiff <= NEWTON_TOL)
+      return (0);
+    if (halve > NEWTON_HALVE)
+      return (1);
+    linear = linear_new;
+  }
+
+  return (1);
+}
+
+#undef NEWTON_MAXIT
+#undef NEWTON_TOL
+#undef NEWTON_HALVE
+
+
 int calc_soil_thermal_fluxes(int     Nnodes,
 			     double *T,
 			     double *T0,
@@ -394,11 +611,15 @@ int calc_soil_thermal_fluxes(int     Nnodes,
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
   2013-Dec-27 Removed QUICK_FS option.					TJB
   2014-Mar-28 Modified cold nose hack to also cover warm nose case.	TJB
+  2026-Oct-17 Added SOIL_T_SOLVER NEWTON option (Newton solution of the
+	      whole profile, falling back to the Gauss-Seidel iteration
+	      if it fails), and solver_stats counters.			KM
   **********************************************************************/
 
   /** Eventually the nodal ice contents will also have to be updated **/
 
   extern option_struct options;
+  extern solver_stats_struct solver_stats;
 
   int    Error;
   char   Done;
@@ -425,8 +646,26 @@ int calc_soil_thermal_fluxes(int     Nnodes,
     Tfbcount[j] = 0;
   }
 
+  solver_stats.soil_T_calls++;
+  if (options.SOIL_T_SOLVER == SOIL_T_NEWTON) {
+    if (newton_soil_thermal_fluxes(Nnodes, T, T0, moist, max_moist, ice, bubble,
+                                   expt, A, B, C, D, E,
+                                   FS_ACTIVE && options.FROZEN_SOIL, NOFLUX,
+                                   EXP_TRANS, &ItCount) == 0)
+      Done = TRUE;
+    else {
+      /* start over with the Gauss-Seidel iteration */
+      solver_stats.soil_T_fallbacks++;
+      for(j=0;j<Nnodes;j++)
+        T[j] = Tlast[j];
+    }
+    solver_stats.soil_T_iter += ItCount;
+    ItCount = 0;
+  }
+
   while(!Done && Error==0 && ItCount<MAXIT) {
     ItCount++;
+    solver_stats.soil_T_iter++;
     maxdiff=threshold;
     for(j=1;j<Nnodes-1;j++) {
       oldT=T[j];
@@ -657,6 +896,10 @@ void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
 	      now all nodes are checked and corrected if necessary.		TJB
   2013-Jan-08 Excluded bottom node from check in cold nose fix.			TJB
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
+  2026-Oct-17 The layer of each node and the transformed grid factors
+	      Bexp*(Zsum+1) of the flux terms are now computed once,
+	      at initialization, rather than at every evaluation.  The
+	      arithmetic of the residuals is unchanged.			KM
   **********************************************************************/
     
   static double  deltat;
@@ -695,6 +938,8 @@ void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
   static double DT[MAX_NODES],DT_down[MAX_NODES],DT_up[MAX_NODES],T_up[MAX_NODES];
   static double Dkappa[MAX_NODES];
   static double Bexp;
+  static int    node_lidx[MAX_NODES];
+  static double zf[MAX_NODES], zfz[MAX_NODES];
   char PAST_BOTTOM;
   double storage_term, flux_term, phase_term, flux_term1, flux_term2;
   double Lsum;
@@ -747,6 +992,30 @@ void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
       Tb = T0[n];
     for (i=0; i<n; i++) 
       T_2[i] = T0[i+1];    
+
+    // soil layer of each node
+    lidx = 0;
+    Lsum = 0.;
+    PAST_BOTTOM = FALSE;
+    for (i=0; i<=n; i++) {
+      node_lidx[i] = lidx;
+      if(Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
+	Lsum += depth[lidx];
+	lidx++;
+	if( lidx == Nlayers ) {
+	  PAST_BOTTOM = TRUE;
+	  lidx = Nlayers-1;
+	}
+      }
+    }
+
+    // transformed grid factors of the flux terms
+    if(EXP_TRANS) {
+      for (i=0; i<n; i++) {
+	zf[i]  = Bexp*(Zsum[i+1]+1.);
+	zfz[i] = zf[i]*(Zsum[i+1]+1.);
+      }
+    }
   }
   
   // calculate residuals if init==0
@@ -758,13 +1027,10 @@ void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
     // calculate all entries if focus == -1
     if (focus==-1) {
       
-      lidx = 0;
-      Lsum = 0.;
-      PAST_BOTTOM = FALSE;
-
       for (i=0; i<n+1; i++) {
 	kappa_new[i]=kappa[i];
 	if(i>=1) {  //all but surface node
+	  lidx = node_lidx[i];
 	  // update ice contents
 	  if (T_2[i-1]<0) {
 	    ice_new[i] = moist[i] - maximum_unfrozen_water(T_2[i-1], 
@@ -784,15 +1050,6 @@ void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
 	  }
 	  /************************************************/	  
 	}
-	
-	if(Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
-	  Lsum += depth[lidx];
-	  lidx++;
-	  if( lidx == Nlayers ) {
-	    PAST_BOTTOM = TRUE;
-	    lidx = Nlayers-1;
-	  }
-	}
       }
       
       // constants used in fda equation
@@ -831,8 +1088,8 @@ void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
 	  flux_term2 = kappa_new[i+1]*(DT_down[i]/gamma[i]-DT_up[i]/beta[i])/(0.5*alpha[i]);
 	}
 	else { //grid transformation
-	  flux_term1 = Dkappa[i]/2.*DT[i]/2./(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.));
-	  flux_term2 = kappa_new[i+1]*((DT_down[i]-DT_up[i])/(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.))  -  DT[i]/2./(Bexp*(Zsum[i+1]+1.)*(Zsum[i+1]+1.)));
+	  flux_term1 = Dkappa[i]/2.*DT[i]/2./zf[i]/zf[i];
+	  flux_term2 = kappa_new[i+1]*((DT_down[i]-DT_up[i])/zf[i]/zf[i]  -  DT[i]/2./zfz[i]);
 	}
 	//inelegant fix for "cold nose" problem - when a very cold node skates off to
 	//much colder and breaks the second law of thermodynamics (because
@@ -872,25 +1129,13 @@ void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
       
       // update other parameters due to ice content change
       /********************************************************/
-      lidx = 0;
-      Lsum = 0.;
-      PAST_BOTTOM = FALSE;
-      for (i=0; i<=right+1; i++) {
-	if(i>=left+1) {
-	  if (ice_new[i]!=ice[i]) {
-	    kappa_new[i] = soil_conductivity(moist[i], moist[i] - ice_new[i],
-					     soil_dens_min[lidx], bulk_dens_min[lidx], quartz[lidx],
-					     soil_density[lidx], bulk_density[lidx], organic[lidx]);
-	    Cs_new[i] = volumetric_heat_capacity(bulk_density[lidx]/soil_density[lidx], moist[i]-ice_new[i], ice_new[i], organic[lidx]);
-	  }
-	}
-	if(Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
-	  Lsum += depth[lidx];
-	  lidx++;
-	  if( lidx == Nlayers ) {
-	    PAST_BOTTOM = TRUE;
-	    lidx = Nlayers-1;
-	  }
+      for (i=left+1; i<=right+1; i++) {
+	if (ice_new[i]!=ice[i]) {
+	  lidx = node_lidx[i];
+	  kappa_new[i] = soil_conductivity(moist[i], moist[i] - ice_new[i],
+					   soil_dens_min[lidx], bulk_dens_min[lidx], quartz[lidx],
+					   soil_density[lidx], bulk_density[lidx], organic[lidx]);
+	  Cs_new[i] = volumetric_heat_capacity(bulk_density[lidx]/soil_density[lidx], moist[i]-ice_new[i], ice_new[i], organic[lidx]);
 	}
       }
       /*********************************************************/
@@ -934,8 +1179,8 @@ void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
 	  flux_term2 = kappa_new[i+1]*(DT_down[i]/gamma[i]-DT_up[i]/beta[i])/(0.5*alpha[i]);
 	}
 	else { //grid transformation
-	  flux_term1 = Dkappa[i]/2.*DT[i]/2./(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.));
-	  flux_term2 = kappa_new[i+1]*((DT_down[i]-DT_up[i])/(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.))  -  DT[i]/2./(Bexp*(Zsum[i+1]+1.)*(Zsum[i+1]+1.)));
+	  flux_term1 = Dkappa[i]/2.*DT[i]/2./zf[i]/zf[i];
+	  flux_term2 = kappa_new[i+1]*((DT_down[i]-DT_up[i])/zf[i]/zf[i]  -  DT[i]/2./zfz[i]);
 	}
 	//inelegant fix for "cold nose" problem - when a very cold node skates off to
 	//much colder and breaks the second law of thermodynamics (because
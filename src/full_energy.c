@@ -14,7 +14,7 @@ int  full_energy(int                  gridcell,
 		 lake_con_struct     *lake_con,
                  soil_con_struct     *soil_con,
                  veg_con_struct      *veg_con,
-                 veg_hist_struct    **veg_hist)
+                 veg_hist_struct     *veg_hist)
 /**********************************************************************
 	full_energy	Keith Cherkauer		January 8, 1997
 
@@ -113,6 +113,17 @@ int  full_energy(int                  gridcell,
   2014-Mar-28 Removed DIST_PRCP option.						TJB
   2014-Apr-25 Added non-climatological veg params.				TJB
   2014-Apr-25 Added partial vegcover fraction.					TJB
+  2026-Oct-17 Added phase timers.						KM
+  2026-Oct-17 Call solve_lake() through the kernel capture wrapper.	KM
+  2026-Oct-17 veg_hist is now the current record's tiles rather than
+	      the whole veg history.					KM
+  2026-Oct-17 Passes lake_con to water_balance() by reference.		KM
+  2026-Oct-17 Computes aero_resist of the potential evap reference
+	      surfaces only when options.PET_OUTPUT is TRUE.		KM
+  2026-Oct-17 The band forcing is computed for all bands by
+	      band_forcing() before the veg tile loop, and runoff() is
+	      called once per tile for all of its bands, after
+	      surface_fluxes() has been solved for each band.		KM
 
 **********************************************************************/
 {
@@ -153,6 +164,7 @@ int  full_energy(int                  gridcell,
   double                 sum_baseflow;
   double                 tmp_wind[3];
   double                 gauge_correction[2];
+  band_forcing_struct    bf;
   float 	         lag_one;
   float 	         sigma_slope;
   float  	         fetch;
@@ -206,17 +218,22 @@ int  full_energy(int                  gridcell,
   atmos->out_rain = 0;
   atmos->out_snow = 0;
 
+  /* Compute air temperature, precipitation, rainfall and snowfall of
+     all snow bands, for all SNOW_STEPs of the time step */
+  band_forcing(atmos, NR+1, Nbands, soil_con, gauge_correction,
+	       gp->MIN_RAIN_TEMP, gp->MAX_SNOW_TEMP, &bf);
+
   /* Assign current veg albedo and LAI */
   if (rec >= 0) {
     // Loop over vegetated tiles
     for(iveg = 0; iveg < Nveg; iveg++){
       veg_class = veg_con[iveg].veg_class;
-      if (veg_hist[rec][iveg].vegcover[0] < MIN_VEGCOVER)
-        veg_hist[rec][iveg].vegcover[0] = MIN_VEGCOVER;
+      if (veg_hist[iveg].vegcover[0] < MIN_VEGCOVER)
+        veg_hist[iveg].vegcover[0] = MIN_VEGCOVER;
       for ( band = 0; band < Nbands; band++ ) {
-        veg_var[iveg][band].vegcover = veg_hist[rec][iveg].vegcover[0];
-        veg_var[iveg][band].albedo = veg_hist[rec][iveg].albedo[0];
-        veg_var[iveg][band].LAI = veg_hist[rec][iveg].LAI[0];
+        veg_var[iveg][band].vegcover = veg_hist[iveg].vegcover[0];
+        veg_var[iveg][band].albedo = veg_hist[iveg].albedo[0];
+        veg_var[iveg][band].LAI = veg_hist[iveg].LAI[0];
         // Convert LAI from global to local
         veg_var[iveg][band].LAI /= veg_var[iveg][band].vegcover;
         veg_var[iveg][band].Wdew /= veg_var[iveg][band].vegcover;
@@ -325,8 +342,9 @@ int  full_energy(int                  gridcell,
       *************************************/
 
       /* Loop over types of potential evap, plus current veg */
-      /* Current veg will be last */
-      for (p=0; p<N_PET_TYPES+1; p++) {
+      /* Current veg will be last; the types of potential evap are
+         skipped if no OUT_PET_* variable is written */
+      for (p=(options.PET_OUTPUT ? 0 : N_PET_TYPES); p<N_PET_TYPES+1; p++) {
 
         /* Initialize wind speeds */
         tmp_wind[0] = atmos->wind[NR];
@@ -417,6 +435,7 @@ int  full_energy(int                  gridcell,
 	  for (p=0; p<N_PET_TYPES; p++)
 	    cell[iveg][band].pot_evap[p] = 0;
 
+	  timer_start(TIMER_SURFACE_FLUXES);
 	  ErrorFlag = surface_fluxes(overstory, bare_albedo, height, ice0[band], moist0[band], 
 				     surf_atten, &(Melt[band*2]), &Le, 
 				     aero_resist,
@@ -427,11 +446,12 @@ int  full_energy(int                  gridcell,
 				     &snow_inflow[band], 
 				     tmp_wind, veg_con[iveg].root, Nbands, 
 				     options.Nlayer, Nveg, band, dp, iveg, rec, veg_class, 
-				     atmos, dmy, &(energy[iveg][band]), gp, 
+				     atmos, &bf, dmy, &(energy[iveg][band]), gp, 
 				     &(cell[iveg][band]),
 				     &(snow[iveg][band]), 
 				     soil_con, &(veg_var[iveg][band]), 
 				     lag_one, sigma_slope, fetch, veg_con[iveg].CanopLayerBnd);
+	  timer_stop(TIMER_SURFACE_FLUXES);
 	  
 	  if ( ErrorFlag == ERROR ) return ( ERROR );
 	  
@@ -439,6 +459,24 @@ int  full_energy(int                  gridcell,
 	  atmos->out_rain += out_rain[band*2] * Cv * soil_con->AreaFract[band];
 	  atmos->out_snow += out_snow[band*2] * Cv * soil_con->AreaFract[band];
 
+	} /** End non-zero area band **/
+      } /** End Loop Through Elevation Bands **/
+
+      /********************************************************
+        Compute runoff, baseflow, and soil moisture transport
+        for all elevation bands of the tile at once
+      ********************************************************/
+      timer_start(TIMER_RUNOFF);
+      ErrorFlag = runoff(cell[iveg], energy[iveg], soil_con,
+			 soil_con->frost_fract, gp->dt, options.Nnode,
+			 Nbands, rec, iveg);
+      timer_stop(TIMER_RUNOFF);
+
+      if ( ErrorFlag == ERROR ) return ( ERROR );
+
+      for ( band = 0; band < Nbands; band++ ) {
+	if( soil_con->AreaFract[band] > 0 ) {
+
           /********************************************************
             Compute soil wetness and root zone soil moisture
           ********************************************************/
@@ -452,8 +490,8 @@ int  full_energy(int                  gridcell,
           }
           cell[iveg][band].wetness /= options.Nlayer;
 
-	} /** End non-zero area band **/
-      } /** End Loop Through Elevation Bands **/
+	}
+      }
 
     } /** end non-zero area veg tile **/
   } /** end of vegetation loop **/
@@ -547,20 +585,22 @@ int  full_energy(int                  gridcell,
     atmos->out_rain += rainprec * lake_con->Cl[0] * lakefrac;
     atmos->out_snow += snowprec * lake_con->Cl[0] * lakefrac;
 
-    ErrorFlag = solve_lake(snowprec, rainprec, atmos->air_temp[NR],
+    timer_start(TIMER_SOLVE_LAKE);
+    ErrorFlag = capture_solve_lake(snowprec, rainprec, atmos->air_temp[NR],
                            atmos->wind[NR], atmos->vp[NR] / 1000.,
                            atmos->shortwave[NR], atmos->longwave[NR],
                            atmos->vpd[NR] / 1000.,
                            atmos->pressure[NR] / 1000.,
                            atmos->density[NR], lake_var, *lake_con,
                            *soil_con, gp->dt, rec, gp->wind_h, dmy[rec], fraci);
+    timer_stop(TIMER_SOLVE_LAKE);
     if ( ErrorFlag == ERROR ) return (ERROR);
 
     /**********************************************************************
        Solve the water budget for the lake.
      **********************************************************************/
 
-    ErrorFlag = water_balance(lake_var, *lake_con, gp->dt, all_vars, rec, iveg, band, lakefrac, *soil_con, *veg_con);
+    ErrorFlag = water_balance(lake_var, lake_con, gp->dt, all_vars, rec, iveg, band, lakefrac, *soil_con, *veg_con);
     if ( ErrorFlag == ERROR ) return (ERROR);
 
   } // end if (options.LAKES && lake_con->lake_idx >= 0)
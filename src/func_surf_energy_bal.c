@@ -115,6 +115,9 @@ double func_surf_energy_bal(double Ts, va_list ap)
   2014-Apr-25 Added partial veg cover fraction, bare soil evap between
 	      the plants, and re-scaling of LAI & plant fluxes from
 	      global to local and back.					TJB
+  2026-Oct-17 Added phase timers around solve_T_profile*().		KM
+  2026-Oct-17 Call solve_T_profile*() through the kernel capture
+	      wrappers.							KM
 **********************************************************************/
 {
   extern option_struct options;
@@ -521,11 +524,13 @@ double func_surf_energy_bal(double Ts, va_list ap)
       
     /* IMPLICIT Solution */
     if(options.IMPLICIT) {
-      Error = solve_T_profile_implicit(Tnew_node, T_node, Tnew_fbflag, Tnew_fbcount, Zsum_node, kappa_node, Cs_node, 
+      timer_start(TIMER_SOLVE_T_PROFILE);
+      Error = capture_solve_T_profile_implicit(Tnew_node, T_node, Tnew_fbflag, Tnew_fbcount, Zsum_node, kappa_node, Cs_node, 
 				       moist_node, delta_t, max_moist_node, bubble_node, expt_node, 
 				       ice_node, alpha, beta, gamma, dp, Nnodes, 
 				       FIRST_SOLN, FS_ACTIVE, NOFLUX, EXP_TRANS, veg_class,
 				       bulk_dens_min, soil_dens_min, quartz, bulk_density, soil_density, organic, depth);
+      timer_stop(TIMER_SOLVE_T_PROFILE);
       
       /* print out error information for IMPLICIT solution */
       if(Error==0)
@@ -545,10 +550,12 @@ double func_surf_energy_bal(double Ts, va_list ap)
     if(!options.IMPLICIT || Error == 1) {
       if(options.IMPLICIT)
         FIRST_SOLN[0] = TRUE;
-      Error = solve_T_profile(Tnew_node, T_node, Tnew_fbflag, Tnew_fbcount, Zsum_node, kappa_node, Cs_node, 
+      timer_start(TIMER_SOLVE_T_PROFILE);
+      Error = capture_solve_T_profile(Tnew_node, T_node, Tnew_fbflag, Tnew_fbcount, Zsum_node, kappa_node, Cs_node, 
 			      moist_node, delta_t, max_moist_node, bubble_node, 
 			      expt_node, ice_node, alpha, beta, gamma, dp, depth, 
 			      Nnodes, FIRST_SOLN, FS_ACTIVE, NOFLUX, EXP_TRANS, veg_class);
+      timer_stop(TIMER_SOLVE_T_PROFILE);
     }
       
     if ( (int)Error == ERROR ) {
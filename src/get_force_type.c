@@ -39,13 +39,15 @@ void get_force_type(char   *cmdstr,
   2013-Jul-25 Added CATM, COSZEN, FDIR, and PAR.			TJB
   2014-Apr-25 Added LAI_IN.						TJB
   2014-Apr-25 Added VEGCOVER.						TJB
+  2026-Oct-17 The third field is also stored as the name of the
+	      variable in a NETCDF forcing file.			KM
 
 *************************************************************/
 
   extern param_set_struct param_set;
 
   char optstr[50];
-  char flgstr[10];
+  char flgstr[MAXSTRING];
   char ErrStr[MAXSTRING];
   int  type;
 
@@ -227,6 +229,14 @@ void get_force_type(char   *cmdstr,
     sscanf(cmdstr,"%*s %*s %s %lf",flgstr, &param_set.TYPE[type].multiplier);
     if(strcasecmp("SIGNED",flgstr)==0) param_set.TYPE[type].SIGNED=TRUE;
     else param_set.TYPE[type].SIGNED=FALSE;
+    /* for NETCDF forcing files, the third field is the variable name */
+    if(strcmp("NULL",flgstr)!=0) {
+      if(strlen(flgstr) >= MAX_FORCE_VARNAME) {
+        snprintf(ErrStr,sizeof(ErrStr),"Forcing variable name %.*s... is too long.",MAX_FORCE_VARNAME,flgstr);
+        nrerror(ErrStr);
+      }
+      strcpy(param_set.FORCE_VAR[type],flgstr);
+    }
   }
   param_set.TYPE[type].N_ELEM = 1;
 
@@ -117,6 +117,33 @@ global_param_struct get_global_param(filenames_struct *names,
   2014-Mar-28 Removed DIST_PRCP option.				                TJB
   2014-Apr-25 Changed LAI_FROM_* to FROM_*; added ALB_SRC.			TJB
   2014-Apr-25 Added VEGCOVER_SRC.						TJB
+  2026-Oct-17 Added TIMING and TIMING_FILE options.				KM
+  2026-Oct-17 Added KERNEL_CAPTURE, KERNEL_FILE, KERNEL_SAMPLE, and
+	      KERNEL_MAX options.						KM
+  2026-Oct-17 Added CELL_LOG option.						KM
+  2026-Oct-17 Added PROGRESS and PROGRESS_FILE options.			KM
+  2026-Oct-17 Added MEM_STATS and MEM_STATS_FILE options.			KM
+  2026-Oct-17 Added REGION_MAP, REGION_PREFIX, REGION_ONLY, and
+	      REGIONVAR options.						KM
+  2026-Oct-17 Added ROUTING_* options.					KM
+  2026-Oct-17 Added STATVAR, STAT_QUANTILES, STAT_PREFIX, and
+	      STAT_ONLY options.					KM
+  2026-Oct-17 Added FORCING_CACHE and FORCING_CACHE_MAX options.	KM
+  2026-Oct-17 Added FORCE_THREADS option.					KM
+  2026-Oct-17 Added FORCE_PRECISION option.					KM
+  2026-Oct-17 Added FORCE_FORMAT NETCDF and NETCDF_CACHE_MAX option.	KM
+  2026-Oct-17 Added PREFETCH_DEPTH option.					KM
+  2026-Oct-17 Added WRITE_QUEUE option.					KM
+  2026-Oct-17 Added ARROW_OUTPUT option.					KM
+  2026-Oct-17 Added SHM_NAME and SHM_SLOTS options.			KM
+  2026-Oct-17 Added SOIL_T_SOLVER option.					KM
+  2026-Oct-17 Added SNOW_STEP_ADAPT option.					KM
+  2026-Oct-17 Added IMPLICIT_JACOBIAN option.				KM
+  2026-Oct-17 PREFETCH_DEPTH > 0 is rejected with veg_hist forcings if
+	      COMPUTE_TREELINE may add an above-treeline vegetation
+	      tile, which the read-ahead thread cannot count.		KM
+  2026-Oct-17 MAX_SNOW_TEMP must be greater than MIN_RAIN_TEMP; this was
+	      checked by calc_rainonly() at every call.			KM
 **********************************************************************/
 {
   extern option_struct    options;
@@ -128,9 +155,11 @@ global_param_struct get_global_param(filenames_struct *names,
   char flgstr[MAXSTRING];
   char flgstr2[MAXSTRING];
   char ErrStr[MAXSTRING];
+  char *token;
   int  file_num;
+  int  kernel;
   int  field;
-  int  i;
+  int  i, j;
   int  tmpstartdate;
   int  tmpenddate;
   int  lastvalidday;
@@ -165,6 +194,8 @@ global_param_struct get_global_param(filenames_struct *names,
   global.MIN_RAIN_TEMP = -0.5;
   global.measure_h     = 2.0;
   global.wind_h        = 10.0;
+  global.route_velocity  = 1.5;
+  global.route_diffusion = 800.0;
   for(i = 0; i < 2; i++) {
     global.forceyear[i]  = MISSING;
     global.forcemonth[i] = 1;
@@ -186,6 +217,20 @@ global_param_struct get_global_param(filenames_struct *names,
   strcpy(names->snowband,     "MISSING");
   strcpy(names->lakeparam,    "MISSING");
   strcpy(names->result_dir,   "MISSING");
+  strcpy(names->timing,       "NONE");
+  strcpy(names->cell_log,     "NONE");
+  strcpy(names->progress,     "NONE");
+  strcpy(names->mem_stats,    "NONE");
+  strcpy(names->forcing_cache, "NONE");
+  strcpy(names->region_map,   "NONE");
+  strcpy(names->region_prefix, "region");
+  strcpy(names->route_flowdir, "NONE");
+  strcpy(names->route_fraction, "NONE");
+  strcpy(names->route_stations, "NONE");
+  strcpy(names->route_uh,     "NONE");
+  strcpy(names->stat_prefix,  "stats");
+  strcpy(names->shm_name,     "NONE");
+  strcpy(names->kernel,       "NONE");
   global.out_dt        = MISSING;
 
 
@@ -219,6 +264,11 @@ global_param_struct get_global_param(filenames_struct *names,
       else if(strcasecmp("SNOW_STEP",optstr)==0) {
 	sscanf(cmdstr,"%*s %d",&options.SNOW_STEP);
       }
+      else if(strcasecmp("SNOW_STEP_ADAPT",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.SNOW_STEP_ADAPT=TRUE;
+        else options.SNOW_STEP_ADAPT = FALSE;
+      }
       else if(strcasecmp("STARTYEAR",optstr)==0) {
         sscanf(cmdstr,"%*s %d",&global.startyear);
       }
@@ -282,6 +332,24 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.IMPLICIT=TRUE;
         else options.IMPLICIT = FALSE;
       }
+      else if(strcasecmp("IMPLICIT_JACOBIAN",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("NODE",flgstr)==0) options.IMPLICIT_JACOBIAN=IMPL_JAC_NODE;
+        else if(strcasecmp("GROUPED",flgstr)==0) options.IMPLICIT_JACOBIAN=IMPL_JAC_GROUPED;
+        else {
+          sprintf(ErrStr,"IMPLICIT_JACOBIAN must be either NODE or GROUPED.\n");
+          nrerror(ErrStr);
+        }
+      }
+      else if(strcasecmp("SOIL_T_SOLVER",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("GAUSS_SEIDEL",flgstr)==0) options.SOIL_T_SOLVER=SOIL_T_GS;
+        else if(strcasecmp("NEWTON",flgstr)==0) options.SOIL_T_SOLVER=SOIL_T_NEWTON;
+        else {
+          sprintf(ErrStr,"SOIL_T_SOLVER must be either GAUSS_SEIDEL or NEWTON.\n");
+          nrerror(ErrStr);
+        }
+      }
       else if(strcasecmp("EXP_TRANS",optstr)==0) {
         sscanf(cmdstr,"%*s %s",flgstr);
         if(strcasecmp("TRUE",flgstr)==0) options.EXP_TRANS=TRUE;
@@ -482,8 +550,10 @@ global_param_struct get_global_param(filenames_struct *names,
 	  param_set.FORCE_FORMAT[file_num] = BINARY;
 	else if (strcasecmp(flgstr, "ASCII") == 0)
 	  param_set.FORCE_FORMAT[file_num] = ASCII;
+	else if (strcasecmp(flgstr, "NETCDF") == 0)
+	  param_set.FORCE_FORMAT[file_num] = NETCDF;
 	else
-	  nrerror("FORCE_FORMAT must be either ASCII or BINARY.");
+	  nrerror("FORCE_FORMAT must be either ASCII, BINARY, or NETCDF.");
       }
       else if (strcasecmp("FORCE_ENDIAN",optstr)==0) {
 	sscanf(cmdstr, "%*s %s", flgstr);
@@ -529,6 +599,28 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.ALMA_INPUT=TRUE;
         else options.ALMA_INPUT = FALSE;
       }
+      else if(strcasecmp("FORCING_CACHE",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->forcing_cache);
+      }
+      else if(strcasecmp("FORCING_CACHE_MAX",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.FORCING_CACHE_MAX);
+      }
+      else if(strcasecmp("NETCDF_CACHE_MAX",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.NETCDF_CACHE_MAX);
+      }
+      else if(strcasecmp("PREFETCH_DEPTH",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.PREFETCH_DEPTH);
+      }
+      else if(strcasecmp("FORCE_PRECISION",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("DOUBLE",flgstr)==0) options.FORCE_PRECISION=FORCE_PREC_DOUBLE;
+        else if(strcasecmp("FLOAT",flgstr)==0) options.FORCE_PRECISION=FORCE_PREC_FLOAT;
+        else if(strcasecmp("SHORT",flgstr)==0) options.FORCE_PRECISION=FORCE_PREC_SHORT;
+        else {
+          sprintf(ErrStr,"FORCE_PRECISION must be either DOUBLE, FLOAT, or SHORT.\n");
+          nrerror(ErrStr);
+        }
+      }
 
       /*************************************
        Define parameter files
@@ -684,6 +776,11 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.COMPRESS=TRUE;
         else options.COMPRESS = FALSE;
       }
+      else if(strcasecmp("ARROW_OUTPUT",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.ARROW_OUTPUT=TRUE;
+        else options.ARROW_OUTPUT = FALSE;
+      }
       else if(strcasecmp("BINARY_OUTPUT",optstr)==0) {
         sscanf(cmdstr,"%*s %s",flgstr);
         if(strcasecmp("TRUE",flgstr)==0) options.BINARY_OUTPUT=TRUE;
@@ -704,6 +801,9 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.OUTPUT_FORCE=TRUE;
         else options.OUTPUT_FORCE = FALSE;
       }
+      else if(strcasecmp("FORCE_THREADS",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.FORCE_THREADS);
+      }
       else if(strcasecmp("PRT_HEADER",optstr)==0) {
         sscanf(cmdstr,"%*s %s",flgstr);
         if(strcasecmp("TRUE",flgstr)==0) options.PRT_HEADER=TRUE;
@@ -714,6 +814,111 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.PRT_SNOW_BAND=TRUE;
         else options.PRT_SNOW_BAND = FALSE;
       }
+      else if(strcasecmp("REGION_MAP",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->region_map);
+      }
+      else if(strcasecmp("REGION_PREFIX",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->region_prefix);
+      }
+      else if(strcasecmp("REGION_ONLY",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.REGION_ONLY=TRUE;
+        else options.REGION_ONLY = FALSE;
+      }
+      else if(strcasecmp("STAT_PREFIX",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->stat_prefix);
+      }
+      else if(strcasecmp("STAT_ONLY",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.STAT_ONLY=TRUE;
+        else options.STAT_ONLY = FALSE;
+      }
+      else if(strcasecmp("WRITE_QUEUE",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.WRITE_QUEUE);
+      }
+      else if(strcasecmp("SHM_NAME",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->shm_name);
+      }
+      else if(strcasecmp("SHM_SLOTS",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.SHM_SLOTS);
+      }
+      else if(strcasecmp("ROUTING_FLOWDIR",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->route_flowdir);
+      }
+      else if(strcasecmp("ROUTING_FRACTION",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->route_fraction);
+      }
+      else if(strcasecmp("ROUTING_STATIONS",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->route_stations);
+      }
+      else if(strcasecmp("ROUTING_UH",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->route_uh);
+      }
+      else if(strcasecmp("ROUTING_VELOCITY",optstr)==0) {
+        sscanf(cmdstr,"%*s %lf",&global.route_velocity);
+      }
+      else if(strcasecmp("ROUTING_DIFFUSION",optstr)==0) {
+        sscanf(cmdstr,"%*s %lf",&global.route_diffusion);
+      }
+
+      /*************************************
+       Define diagnostic options
+      *************************************/
+      else if(strcasecmp("TIMING",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("NONE",flgstr)==0 || strcasecmp("FALSE",flgstr)==0) options.TIMING=TIMING_NONE;
+        else if(strcasecmp("CELL",flgstr)==0) options.TIMING=TIMING_CELL;
+        else if(strcasecmp("PHASE",flgstr)==0 || strcasecmp("TRUE",flgstr)==0) options.TIMING=TIMING_PHASE;
+        else {
+          sprintf(ErrStr,"TIMING must be either NONE, CELL, or PHASE.\n");
+          nrerror(ErrStr);
+        }
+      }
+      else if(strcasecmp("TIMING_FILE",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->timing);
+      }
+      else if(strcasecmp("CELL_LOG",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->cell_log);
+      }
+      else if(strcasecmp("PROGRESS",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.PROGRESS);
+      }
+      else if(strcasecmp("PROGRESS_FILE",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->progress);
+      }
+      else if(strcasecmp("MEM_STATS",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.MEM_STATS=TRUE;
+        else options.MEM_STATS = FALSE;
+      }
+      else if(strcasecmp("MEM_STATS_FILE",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->mem_stats);
+      }
+      else if(strcasecmp("KERNEL_CAPTURE",optstr)==0) {
+        // one or more kernel names, or ALL, or NONE
+        token = strtok(cmdstr," \t\n");
+        while((token = strtok(NULL," \t\n")) != NULL && token[0] != '#') {
+          if(strcasecmp("NONE",token)==0 || strcasecmp("FALSE",token)==0)
+            options.KERNEL_CAPTURE = 0;
+          else if(strcasecmp("ALL",token)==0)
+            options.KERNEL_CAPTURE = (1 << N_KERNELS) - 1;
+          else if((kernel = kernel_id(token)) >= 0)
+            options.KERNEL_CAPTURE |= (1 << kernel);
+          else {
+            sprintf(ErrStr,"Unknown kernel %s in KERNEL_CAPTURE; must be one or more of SOLVE_T_PROFILE, SOLVE_T_PROFILE_IMPLICIT, SNOW_MELT, BLOWING_SNOW, and SOLVE_LAKE, or ALL, or NONE.\n",token);
+            nrerror(ErrStr);
+          }
+        }
+      }
+      else if(strcasecmp("KERNEL_FILE",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",names->kernel);
+      }
+      else if(strcasecmp("KERNEL_SAMPLE",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.KERNEL_SAMPLE);
+      }
+      else if(strcasecmp("KERNEL_MAX",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.KERNEL_MAX);
+      }
 
       /*************************************
        Define output file contents
@@ -727,6 +932,15 @@ global_param_struct get_global_param(filenames_struct *names,
       else if(strcasecmp("OUTVAR",optstr)==0) {
         ; // do nothing
       }
+      else if(strcasecmp("REGIONVAR",optstr)==0) {
+        ; // do nothing
+      }
+      else if(strcasecmp("STATVAR",optstr)==0) {
+        ; // do nothing
+      }
+      else if(strcasecmp("STAT_QUANTILES",optstr)==0) {
+        ; // do nothing
+      }
 
       /***********************************
         Unrecognized Global Parameter Flag
@@ -758,6 +972,10 @@ global_param_struct get_global_param(filenames_struct *names,
     nrerror("Invalid output step specified.  Output step must be an integer multiple of the model time step; >= model time step and <= 24");
   }
 
+  // Validate the rain/snow partition temperatures
+  if (global.MAX_SNOW_TEMP <= global.MIN_RAIN_TEMP)
+    nrerror("MAX_SNOW_TEMP must be greater than MIN_RAIN_TEMP.");
+
   // Validate SNOW_STEP and set NR and NF
   if (global.dt < 24 && global.dt != options.SNOW_STEP)
     nrerror("If the model step is smaller than daily, the snow model should run\nat the same time step as the rest of the model.");
@@ -768,6 +986,10 @@ global_param_struct get_global_param(filenames_struct *names,
     NR = 0;
   else
     NR = NF;
+  if (options.SNOW_STEP_ADAPT && NF == 1) {
+    fprintf(stderr, "WARNING: SNOW_STEP_ADAPT has no effect when SNOW_STEP = TIME_STEP.  Setting SNOW_STEP_ADAPT to FALSE.\n");
+    options.SNOW_STEP_ADAPT = FALSE;
+  }
 
   // Validate simulation start date
   if (global.startyear == MISSING)
@@ -843,7 +1065,7 @@ global_param_struct get_global_param(filenames_struct *names,
         nrerror(ErrStr);
       }
       if (param_set.FORCE_FORMAT[i] == MISSING) {
-        sprintf(ErrStr,"Need to specify the INPUT_FORMAT (ASCII or BINARY) for forcing file %d.",i);
+        sprintf(ErrStr,"Need to specify the INPUT_FORMAT (ASCII, BINARY, or NETCDF) for forcing file %d.",i);
         nrerror(ErrStr);
       }
       if (param_set.FORCE_INDEX[i][param_set.N_TYPES[i]-1] == MISSING) {
@@ -864,6 +1086,25 @@ global_param_struct get_global_param(filenames_struct *names,
     global.forceskip[1] = 0;
   }
 
+  // Validate NETCDF forcing file information
+  for(i=0;i<2;i++) {
+    if (param_set.FORCE_FORMAT[i] != NETCDF)
+      continue;
+    for (j=0;j<param_set.N_TYPES[i];j++) {
+      if (param_set.FORCE_INDEX[i][j] == ALBEDO || param_set.FORCE_INDEX[i][j] == LAI_IN
+          || param_set.FORCE_INDEX[i][j] == VEGCOVER) {
+        sprintf(ErrStr,"ALBEDO, LAI_IN, and VEGCOVER cannot be read from a NETCDF forcing file (forcing file %d).",i+1);
+        nrerror(ErrStr);
+      }
+    }
+    if (strcmp(names->forcing_cache, "NONE") != 0)
+      nrerror("FORCE_FORMAT NETCDF and FORCING_CACHE are incompatible options.");
+  }
+  if (options.NETCDF_CACHE_MAX < 0) {
+    sprintf(ErrStr, "NETCDF_CACHE_MAX (%d) must not be negative.", options.NETCDF_CACHE_MAX);
+    nrerror(ErrStr);
+  }
+
   // Validate result directory
   if ( strcmp ( names->result_dir, "MISSING" ) == 0 )
     nrerror("No results directory has been defined.  Make sure that the global file defines the result directory on the line that begins with \"RESULT_DIR\".");
@@ -872,6 +1113,67 @@ global_param_struct get_global_param(filenames_struct *names,
   if ( strcmp ( names->soil, "MISSING" ) == 0 )
     nrerror("No soil parameter file has been defined.  Make sure that the global file defines the soil parameter file on the line that begins with \"SOIL\".");
 
+  // Validate threaded forcing disaggregation information
+  if (options.FORCE_THREADS < 1) {
+    sprintf(ErrStr, "FORCE_THREADS (%d) must be at least 1.", options.FORCE_THREADS);
+    nrerror(ErrStr);
+  }
+  if (options.FORCE_THREADS > 1 && options.OUTPUT_FORCE) {
+    if (options.TIMING != TIMING_NONE)
+      nrerror("FORCE_THREADS > 1 and TIMING are incompatible options.");
+    if (options.MEM_STATS)
+      nrerror("FORCE_THREADS > 1 and MEM_STATS = TRUE are incompatible options.");
+    if (strcmp(names->forcing_cache, "NONE") != 0)
+      nrerror("FORCE_THREADS > 1 and FORCING_CACHE are incompatible options.");
+  }
+
+  // Validate input read-ahead information
+  if (options.PREFETCH_DEPTH < 0) {
+    sprintf(ErrStr, "PREFETCH_DEPTH (%d) must not be negative.", options.PREFETCH_DEPTH);
+    nrerror(ErrStr);
+  }
+  if (options.PREFETCH_DEPTH > 0) {
+    if (options.MEM_STATS)
+      nrerror("PREFETCH_DEPTH > 0 and MEM_STATS = TRUE are incompatible options.");
+    if (strcmp(names->forcing_cache, "NONE") != 0)
+      nrerror("PREFETCH_DEPTH > 0 and FORCING_CACHE are incompatible options.");
+    if (options.FORCE_THREADS > 1 && options.OUTPUT_FORCE)
+      nrerror("PREFETCH_DEPTH > 0 and FORCE_THREADS > 1 are incompatible options.");
+    if ((param_set.TYPE[ALBEDO].SUPPLIED || param_set.TYPE[LAI_IN].SUPPLIED
+         || param_set.TYPE[VEGCOVER].SUPPLIED) && !options.OUTPUT_FORCE
+        && options.SNOW_BAND > 1 && options.COMPUTE_TREELINE
+        && options.AboveTreelineVeg >= 0)
+      nrerror("PREFETCH_DEPTH > 0 is incompatible with ALBEDO, LAI_IN or VEGCOVER forcings when COMPUTE_TREELINE adds an above-treeline vegetation tile.");
+  }
+
+  // Validate Arrow output information
+  if (options.ARROW_OUTPUT && options.OUTPUT_FORCE)
+    nrerror("ARROW_OUTPUT = TRUE and OUTPUT_FORCE = TRUE are incompatible options.");
+
+  // Validate shared-memory output information
+  if (strcmp(names->shm_name, "NONE") != 0) {
+    if (names->shm_name[0] != '/' || strchr(names->shm_name+1, '/') != NULL)
+      nrerror("SHM_NAME must start with \"/\" and contain no other \"/\".");
+    if (options.SHM_SLOTS < 1) {
+      sprintf(ErrStr, "SHM_SLOTS (%d) must be at least 1.", options.SHM_SLOTS);
+      nrerror(ErrStr);
+    }
+    if (options.OUTPUT_FORCE)
+      nrerror("SHM_NAME and OUTPUT_FORCE = TRUE are incompatible options.");
+  }
+
+  // Validate output writer information
+  if (options.WRITE_QUEUE < 0) {
+    sprintf(ErrStr, "WRITE_QUEUE (%d) must not be negative.", options.WRITE_QUEUE);
+    nrerror(ErrStr);
+  }
+  if (options.WRITE_QUEUE > 0) {
+    if (options.MEM_STATS)
+      nrerror("WRITE_QUEUE > 0 and MEM_STATS = TRUE are incompatible options.");
+    if (options.FORCE_THREADS > 1 && options.OUTPUT_FORCE)
+      nrerror("WRITE_QUEUE > 0 and FORCE_THREADS > 1 are incompatible options.");
+  }
+
   /*******************************************************************************
     Validate parameters required for normal simulations but NOT for OUTPUT_FORCE
   *******************************************************************************/
@@ -1042,6 +1344,69 @@ global_param_struct get_global_param(filenames_struct *names,
     }
   }
 
+  // Validate region aggregation information
+  if (strcmp(names->region_map, "NONE") != 0) {
+    if (global.resolution == 0) {
+      sprintf(ErrStr, "The model grid cell resolution (RESOLUTION) must be defined in the global control file when REGION_MAP is given, since region means are weighted by cell area.");
+      nrerror(ErrStr);
+    }
+    if (options.OUTPUT_FORCE) {
+      sprintf(ErrStr, "REGION_MAP and OUTPUT_FORCE = TRUE are incompatible options.");
+      nrerror(ErrStr);
+    }
+  }
+  else if (options.REGION_ONLY) {
+    nrerror("REGION_ONLY = TRUE was specified, but no REGION_MAP file has been defined.");
+  }
+
+  // Validate routing information
+  if (strcmp(names->route_flowdir, "NONE") != 0) {
+    if (global.resolution == 0) {
+      sprintf(ErrStr, "The model grid cell resolution (RESOLUTION) must be defined in the global control file when ROUTING_FLOWDIR is given, since runoff is converted to discharge by cell area.");
+      nrerror(ErrStr);
+    }
+    if (options.OUTPUT_FORCE) {
+      sprintf(ErrStr, "ROUTING_FLOWDIR and OUTPUT_FORCE = TRUE are incompatible options.");
+      nrerror(ErrStr);
+    }
+    if (strcmp(names->route_stations, "NONE") == 0) {
+      sprintf(ErrStr, "ROUTING_FLOWDIR was specified, but no ROUTING_STATIONS file has been defined.");
+      nrerror(ErrStr);
+    }
+    if (global.route_velocity <= 0 || global.route_diffusion <= 0) {
+      sprintf(ErrStr, "ROUTING_VELOCITY (%f) and ROUTING_DIFFUSION (%f) must be positive.", global.route_velocity, global.route_diffusion);
+      nrerror(ErrStr);
+    }
+  }
+
+  // Validate forcing cache information
+  if (options.FORCING_CACHE_MAX < 0) {
+    sprintf(ErrStr, "FORCING_CACHE_MAX (%d) must not be negative.", options.FORCING_CACHE_MAX);
+    nrerror(ErrStr);
+  }
+
+  // Validate progress reporting information
+  if (options.PROGRESS < 0) {
+    sprintf(ErrStr, "PROGRESS (%d) must not be negative.", options.PROGRESS);
+    nrerror(ErrStr);
+  }
+  if (options.PROGRESS == 0 && strcmp(names->progress, "NONE") != 0)
+    options.PROGRESS = 60;
+
+  // Validate kernel capture information
+  if (options.KERNEL_CAPTURE) {
+    if ( strcmp ( names->kernel, "NONE" ) == 0 )
+      nrerror("KERNEL_CAPTURE was specified, but no kernel capture file has been defined.  Make sure that the global file defines KERNEL_FILE.");
+    if (options.KERNEL_SAMPLE < 1) {
+      sprintf(ErrStr, "KERNEL_SAMPLE (%d) must be at least 1.", options.KERNEL_SAMPLE);
+      nrerror(ErrStr);
+    }
+    if (options.KERNEL_MAX < 0) {
+      sprintf(ErrStr, "KERNEL_MAX (%d) must not be negative.", options.KERNEL_MAX);
+      nrerror(ErrStr);
+    }
+  }
+
   /*********************************
     Output major options to stderr
   *********************************/
@@ -21,6 +21,7 @@
   2012-Jan-16 Removed LINK_DEBUG code					BN
   2013-Dec-27 Removed QUICK_FS option.					TJB
   2014-May-20 Added ref_veg_vegcover.					TJB
+  2026-Oct-17 Added solver_stats.					KM
 **********************************************************************/
 char *version = "4.2.b 2015-January-22";
 char *optstring = "g:vo";
@@ -31,6 +32,7 @@ veg_lib_struct *veg_lib;
 option_struct options;
 Error_struct Error;
 param_set_struct param_set;
+solver_stats_struct solver_stats;
 
   /**************************************************************************
     Define some reference landcover types that always exist regardless
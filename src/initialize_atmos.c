@@ -4,6 +4,122 @@
 
 static char vcid[] = "$Id$";
 
+static double step_total(double *hourly, int hour, int nhours)
+/* Returns the sum of hourly[hour] ... hourly[hour+nhours-1]. */
+{
+  double total;
+  int    idx;
+
+  total = 0;
+  for (idx = hour; idx < hour+nhours; idx++)
+    total += hourly[idx];
+  return total;
+}
+
+static double step_mean(double *hourly, int hour, int nhours)
+/* Returns the mean of hourly[hour] ... hourly[hour+nhours-1]. */
+{
+  return step_total(hourly, hour, nhours) / nhours;
+}
+
+static double veg_hist_step(double     clim,
+                            double  ***local_veg_hist_data,
+                            int        type,
+                            int        v,
+                            int        day,
+                            int        hour,
+                            int        is_vegcover)
+/**********************************************************************
+  Returns the value of veg_hist variable type (ALBEDO, LAI_IN or
+  VEGCOVER) of vegetation tile v for the sub-step starting at local
+  hour hour of local day day.  If the variable was not supplied, this
+  is the climatological value clim; if it was supplied daily, the
+  supplied value unless missing; if it was supplied sub-daily, the
+  last non-missing value within the sub-step (0 if there is none).
+  Vegetation cover is limited below by MIN_VEGCOVER.
+**********************************************************************/
+{
+  extern option_struct    options;
+  extern param_set_struct param_set;
+
+  double value;
+  int    idx;
+
+  if (!param_set.TYPE[type].SUPPLIED)
+    return clim;
+
+  if (param_set.FORCE_DT[param_set.TYPE[type].SUPPLIED-1] == 24) {
+    value = clim;
+    if (local_veg_hist_data[type][v][day] != NODATA_VH) {
+      value = local_veg_hist_data[type][v][day]; // assume constant over the day
+      if (is_vegcover && value < MIN_VEGCOVER) value = MIN_VEGCOVER;
+    }
+  }
+  else {
+    value = 0;
+    for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
+      if (local_veg_hist_data[type][v][(idx < 0) ? idx+24 : idx] != NODATA_VH) {
+        value = local_veg_hist_data[type][v][(idx < 0) ? idx+24 : idx];
+        if (is_vegcover && value < MIN_VEGCOVER) value = MIN_VEGCOVER;
+      }
+    }
+  }
+
+  return value;
+}
+
+static void copy_param_set(veg_con_struct   *veg_con,
+                           param_set_struct *copy)
+/* Assigns N_ELEM for the veg-dependent forcings in the global param_set
+   (the forcing cache key includes them) and copies it.
+   initialize_atmos() shadows param_set with this copy, whose SUPPLIED
+   flags it modifies. */
+{
+  extern option_struct    options;
+  extern param_set_struct param_set;
+
+  if (!options.OUTPUT_FORCE) {
+    param_set.TYPE[LAI_IN].N_ELEM = veg_con[0].vegetat_type_num;
+    param_set.TYPE[VEGCOVER].N_ELEM = veg_con[0].vegetat_type_num;
+    param_set.TYPE[ALBEDO].N_ELEM = veg_con[0].vegetat_type_num;
+  }
+  *copy = param_set;
+}
+
+static void finish_atmos(atmos_data_struct    *atmos,
+                         dmy_struct           *dmy,
+                         double                avgJulyAirTemp,
+                         double               *Tfactor,
+                         char                 *AboveTreeLine,
+                         out_data_file_struct *out_data_files,
+                         out_data_struct      *out_data)
+/* Steps that follow the computation of the atmos arrays. */
+{
+  extern option_struct       options;
+  extern global_param_struct global_param;
+
+  if (!options.OUTPUT_FORCE) {
+
+    // If COMPUTE_TREELINE is TRUE and the treeline computation hasn't
+    // specifically been turned off for this cell (by supplying avgJulyAirTemp
+    // and setting it to -999), calculate which snowbands are above the
+    // treeline, based on average July air temperature.
+    if (options.COMPUTE_TREELINE) {
+      if ( !(options.JULY_TAVG_SUPPLIED && avgJulyAirTemp == -999) ) {
+        compute_treeline( atmos, dmy, avgJulyAirTemp, Tfactor, AboveTreeLine );
+      }
+    }
+
+  }
+  else {
+
+    // If OUTPUT_FORCE is TRUE then the full
+    // forcing data array is dumped into a new set of files.
+    write_forcing_file(atmos, global_param.nrecs, out_data_files, out_data);
+
+  }
+}
+
 void initialize_atmos(atmos_data_struct        *atmos,
                       dmy_struct               *dmy,
 		      FILE                    **infile,
@@ -134,13 +250,34 @@ void initialize_atmos(atmos_data_struct        *atmos,
   2013-Dec-27 Moved OUTPUT_FORCE to options_struct.				TJB
   2014-Apr-25 Added LAI and albedo.						TJB
   2014-Apr-25 Added partial vegcover fraction.					TJB
+  2026-Oct-17 Added phase timers.						KM
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
+  2026-Oct-17 Fused the transfers of the forcings to the atmos and
+	      veg_hist arrays into two passes over the records, one
+	      before and one after the hourly vapor pressure is computed.
+	      Fixed use of an undefined sub-step index in the sub-daily
+	      QAIR/REL_HUMID conversion and in the daily wind limit.	KM
+  2026-Oct-17 Added the forcing cache (FORCING_CACHE).			KM
+  2026-Oct-17 param_set is now a local copy of the global structure,
+	      so that the translated PREC, WIND, and VP SUPPLIED flags no
+	      longer need to be restored and the routine may be called by
+	      several threads at once (FORCE_THREADS).  The translated
+	      PREC and WIND forcing arrays are now freed.			KM
+  2026-Oct-17 Pass the cell's lat and lng to read_forcing_data(), for
+	      NETCDF forcing files.					KM
+  2026-Oct-17 The forcings are taken from the read-ahead thread if
+	      PREFETCH_DEPTH > 0.					KM
+  2026-Oct-17 Pass the cell's number of vegetation tiles to
+	      read_forcing_data(), and check that the read-ahead
+	      veg_hist forcings were read with the same number.	KM
 **********************************************************************/
 {
   extern option_struct       options;
-  extern param_set_struct    param_set;
   extern global_param_struct global_param;
   extern int                 NR, NF;
 
+  param_set_struct param_set;
+
   int     i;
   int     j;
   int     k;
@@ -151,6 +288,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
   int     rec;
   int     step;
   int     idx;
+  int     Nveg_hist;
   int    *tmaxhour;
   int    *tminhour;
   double  deltat;
@@ -211,9 +349,13 @@ void initialize_atmos(atmos_data_struct        *atmos,
   int fstepspday;
   int tmp_int;
   double tmp_double;
-  int save_prec_supplied;
-  int save_wind_supplied;
-  int save_vp_supplied;
+  int hour_raw;
+  int vp_from_daily;
+  int force_daily[N_FORCING_TYPES];
+  double step_sum[N_FORCING_TYPES];
+  double sw_daily_mean;
+  int use_cache;
+  unsigned long cache_key;
 
   wind_h = global_param.wind_h;
   theta_l = (double)soil_con->time_zone_lng;
@@ -236,9 +378,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
   avgJulyAirTemp = soil_con->avgJulyAirTemp;
   Tfactor = soil_con->Tfactor;
   AboveTreeLine = soil_con->AboveTreeLine;
-  save_prec_supplied = param_set.TYPE[PREC].SUPPLIED;
-  save_wind_supplied = param_set.TYPE[WIND].SUPPLIED;
-  save_vp_supplied = param_set.TYPE[VP].SUPPLIED;
+  copy_param_set(veg_con, &param_set);
 
   /* Check on minimum forcing requirements */
   if ( !param_set.TYPE[PREC].SUPPLIED
@@ -254,12 +394,31 @@ void initialize_atmos(atmos_data_struct        *atmos,
 //  if ( !param_set.TYPE[WIND].SUPPLIED && !(param_set.TYPE[WIND_N].SUPPLIED && param_set.TYPE[WIND_E].SUPPLIED) )
 //    nrerror("Input meteorological forcing files must contain either WIND (wind speed) or both WIND_N (north component of wind speed) and WIND_E (east component of wind speed); check input files\n");
 
-  /* Assign N_ELEM for veg-dependent forcings */
-  if (!options.OUTPUT_FORCE) {
-    param_set.TYPE[LAI_IN].N_ELEM = veg_con[0].vegetat_type_num;
-    param_set.TYPE[VEGCOVER].N_ELEM = veg_con[0].vegetat_type_num;
-    param_set.TYPE[ALBEDO].N_ELEM = veg_con[0].vegetat_type_num;
+  /*************************************************
+    If the disaggregated forcings of this cell are in the forcing
+    cache, read them instead of the forcing files
+  *************************************************/
+
+  use_cache = forcing_cache_key(infile, soil_con, &cache_key);
+  if (use_cache && forcing_cache_load(cache_key, atmos)) {
+    fprintf(stderr,"\nRead disaggregated forcings from the forcing cache\n");
+    if (!options.OUTPUT_FORCE) {
+      /* veg_hist forcings are never cached; assign default climatology */
+      for (rec = 0; rec < global_param.nrecs; rec++) {
+        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+          for (j = 0; j < NF; j++) {
+            veg_hist[rec][v].albedo[j] = veg_lib[veg_con[v].veg_class].albedo[dmy[rec].month-1];
+            veg_hist[rec][v].LAI[j] = veg_lib[veg_con[v].veg_class].LAI[dmy[rec].month-1];
+            veg_hist[rec][v].vegcover[j] = veg_lib[veg_con[v].veg_class].vegcover[dmy[rec].month-1];
+          }
+        }
+      }
+    }
+    finish_atmos(atmos, dmy, avgJulyAirTemp, Tfactor, AboveTreeLine,
+                 out_data_files, out_data);
+    return;
   }
+
   /* compute number of simulation days */
   tmp_starthour = 0;
   tmp_endhour = 24 - global_param.dt;
@@ -294,7 +453,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
   }
 
   /* compute local version of dmy array */
-  dmy_local = (dmy_struct *) calloc(Ndays_local*24, sizeof(dmy_struct));
+  dmy_local = (dmy_struct *) mem_calloc(Ndays_local*24, sizeof(dmy_struct), MEM_FORCING);
   if (dmy_local == NULL) {
     nrerror("Memory allocation failure in initialize_atmos()");
   }
@@ -341,17 +500,17 @@ void initialize_atmos(atmos_data_struct        *atmos,
 
   /* mtclim routine memory allocations */
 
-  hourlyrad  = (double *) calloc(Ndays_local*24, sizeof(double));
-  prec       = (double *) calloc(Ndays_local*24, sizeof(double));
-  tair       = (double *) calloc(Ndays_local*24, sizeof(double));
-  tmax       = (double *) calloc(Ndays_local, sizeof(double));
-  tmaxhour   = (int *)    calloc(Ndays_local, sizeof(int));
-  tmin       = (double *) calloc(Ndays_local, sizeof(double));
-  tminhour   = (int *)    calloc(Ndays_local, sizeof(int));
-  tskc       = (double *) calloc(Ndays_local*24, sizeof(double));
-  daily_vp   = (double *) calloc(Ndays_local, sizeof(double));
-  dailyrad   = (double *) calloc(Ndays_local, sizeof(double));
-  fdir       = (double *) calloc(Ndays_local*24, sizeof(double));
+  hourlyrad  = (double *) mem_calloc(Ndays_local*24, sizeof(double), MEM_FORCING);
+  prec       = (double *) mem_calloc(Ndays_local*24, sizeof(double), MEM_FORCING);
+  tair       = (double *) mem_calloc(Ndays_local*24, sizeof(double), MEM_FORCING);
+  tmax       = (double *) mem_calloc(Ndays_local, sizeof(double), MEM_FORCING);
+  tmaxhour   = (int *)    mem_calloc(Ndays_local, sizeof(int), MEM_FORCING);
+  tmin       = (double *) mem_calloc(Ndays_local, sizeof(double), MEM_FORCING);
+  tminhour   = (int *)    mem_calloc(Ndays_local, sizeof(int), MEM_FORCING);
+  tskc       = (double *) mem_calloc(Ndays_local*24, sizeof(double), MEM_FORCING);
+  daily_vp   = (double *) mem_calloc(Ndays_local, sizeof(double), MEM_FORCING);
+  dailyrad   = (double *) mem_calloc(Ndays_local, sizeof(double), MEM_FORCING);
+  fdir       = (double *) mem_calloc(Ndays_local*24, sizeof(double), MEM_FORCING);
   
   if (hourlyrad == NULL || prec == NULL || tair == NULL || tmax == NULL ||
       tmaxhour == NULL || tmin == NULL || tminhour == NULL || tskc == NULL ||
@@ -362,7 +521,19 @@ void initialize_atmos(atmos_data_struct        *atmos,
     read in meteorological data 
   *******************************/
 
-  forcing_data = read_forcing_data(infile, global_param, &veg_hist_data);
+  timer_start(TIMER_READ_FORCING);
+  if (options.PREFETCH_DEPTH > 0) {
+    forcing_data = prefetch_forcing_data(&veg_hist_data, &Nveg_hist);
+    if ( ( param_set.TYPE[ALBEDO].SUPPLIED || param_set.TYPE[LAI_IN].SUPPLIED
+           || param_set.TYPE[VEGCOVER].SUPPLIED )
+         && Nveg_hist != param_set.TYPE[LAI_IN].N_ELEM )
+      nrerror("The read-ahead veg_hist forcings do not match the number of vegetation tiles of the cell.");
+  }
+  else
+    forcing_data = read_forcing_data(infile, global_param, soil_con->lat,
+                                     soil_con->lng, param_set.TYPE[LAI_IN].N_ELEM,
+                                     &veg_hist_data);
+  timer_stop(TIMER_READ_FORCING);
   
   fprintf(stderr,"\nRead meteorological forcing file\n");
 
@@ -426,7 +597,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
   if(param_set.TYPE[RAINF].SUPPLIED && param_set.TYPE[SNOWF].SUPPLIED) {
     /* rainfall and snowfall supplied */
     if (forcing_data[PREC] == NULL) {
-      forcing_data[PREC] = (double *)calloc((global_param.nrecs * NF),sizeof(double));
+      forcing_data[PREC] = (double *)mem_calloc((global_param.nrecs * NF),sizeof(double), MEM_FORCING);
     }
     for (idx=0; idx<(global_param.nrecs*NF); idx++) {
       forcing_data[PREC][idx] = forcing_data[RAINF][idx] + forcing_data[SNOWF][idx];
@@ -437,7 +608,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
     && param_set.TYPE[CSNOWF].SUPPLIED && param_set.TYPE[LSSNOWF].SUPPLIED) {
     /* convective and large-scale rainfall and snowfall supplied */
     if (forcing_data[PREC] == NULL) {
-      forcing_data[PREC] = (double *)calloc((global_param.nrecs * NF),sizeof(double));
+      forcing_data[PREC] = (double *)mem_calloc((global_param.nrecs * NF),sizeof(double), MEM_FORCING);
     }
     for (idx=0; idx<(global_param.nrecs*NF); idx++) {
       forcing_data[PREC][idx] = forcing_data[CRAINF][idx] + forcing_data[LSRAINF][idx]
@@ -454,7 +625,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
   if(param_set.TYPE[WIND_E].SUPPLIED && param_set.TYPE[WIND_N].SUPPLIED) {
     /* specific wind_e and wind_n supplied */
     if (forcing_data[WIND] == NULL) {
-      forcing_data[WIND] = (double *)calloc((global_param.nrecs * NF),sizeof(double));
+      forcing_data[WIND] = (double *)mem_calloc((global_param.nrecs * NF),sizeof(double), MEM_FORCING);
     }
     for (idx=0; idx<(global_param.nrecs*NF); idx++) {
       forcing_data[WIND][idx] = sqrt( forcing_data[WIND_E][idx]*forcing_data[WIND_E][idx]
@@ -468,21 +639,21 @@ void initialize_atmos(atmos_data_struct        *atmos,
     This will simplify subsequent data processing
   *************************************************/
 
-  local_forcing_data = (double **) calloc(N_FORCING_TYPES, sizeof(double*));
-  local_veg_hist_data = (double ***) calloc(N_FORCING_TYPES, sizeof(double**));
+  local_forcing_data = (double **) mem_calloc(N_FORCING_TYPES, sizeof(double*), MEM_FORCING);
+  local_veg_hist_data = (double ***) mem_calloc(N_FORCING_TYPES, sizeof(double**), MEM_FORCING);
   for (type=0; type<N_FORCING_TYPES; type++) {
     // Allocate enough space for hourly data
     if (type != ALBEDO && type != LAI_IN && type != VEGCOVER) {
-      if ( ( local_forcing_data[type] = (double *)calloc(Ndays_local*24, sizeof(double)) ) == NULL ) {
+      if ( ( local_forcing_data[type] = (double *)mem_calloc(Ndays_local*24, sizeof(double), MEM_FORCING) ) == NULL ) {
         nrerror("Memory allocation failure in initialize_atmos()");
       }
     }
     else {
-      if ( ( local_veg_hist_data[type] = (double **)calloc(param_set.TYPE[type].N_ELEM, sizeof(double*)) ) == NULL ) {
+      if ( ( local_veg_hist_data[type] = (double **)mem_calloc(param_set.TYPE[type].N_ELEM, sizeof(double*), MEM_FORCING) ) == NULL ) {
         nrerror("Memory allocation failure in initialize_atmos()");
       }
       for (v=0; v<param_set.TYPE[type].N_ELEM; v++) {
-        if ( ( local_veg_hist_data[type][v] = (double *)calloc(Ndays_local*24, sizeof(double)) ) == NULL ) {
+        if ( ( local_veg_hist_data[type][v] = (double *)mem_calloc(Ndays_local*24, sizeof(double), MEM_FORCING) ) == NULL ) {
           nrerror("Memory allocation failure in initialize_atmos()");
         }
       }
@@ -542,92 +713,17 @@ void initialize_atmos(atmos_data_struct        *atmos,
   }
 
   /*************************************************
-    Incoming Channel Flow
-  *************************************************/
-
-  if(param_set.TYPE[CHANNEL_IN].SUPPLIED) {
-    if(param_set.FORCE_DT[param_set.TYPE[CHANNEL_IN].SUPPLIED-1] == 24) {
-      /* daily channel_in provided */
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          atmos[rec].channel_in[j] = local_forcing_data[CHANNEL_IN][idx] / (float)(NF*stepspday); // divide evenly over the day
-          atmos[rec].channel_in[j] *= 1000/cell_area; // convert to mm over grid cell 
-          sum += atmos[rec].channel_in[j];
-        }
-        if(NF>1) atmos[rec].channel_in[NR] = sum;
-      }
-    }
-    else {
-      /* sub-daily channel_in provided */
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          atmos[rec].channel_in[i] = 0;
-          while (hour < rec*global_param.dt + (i+1)*options.SNOW_STEP + global_param.starthour - hour_offset_int) {
-            idx = hour;
-            if (idx < 0) idx += 24;
-	    atmos[rec].channel_in[i] += local_forcing_data[CHANNEL_IN][idx];
-            hour++;
-          }
-	  atmos[rec].channel_in[i] *= 1000/cell_area; // convert to mm over grid cell 
-	  sum += atmos[rec].channel_in[i];
-        }
-        if(NF>1) atmos[rec].channel_in[NR] = sum;
-      }
-    }
-  }
-  else {
-    for(rec = 0; rec < global_param.nrecs; rec++) {
-      sum = 0;
-      for(i = 0; i < NF; i++) {
-        atmos[rec].channel_in[i] = 0;
-        sum += atmos[rec].channel_in[i];
-      }
-      if(NF>1) atmos[rec].channel_in[NR] = sum;
-    }
-  }
-
-  /*************************************************
-    Precipitation
+    Daily Precipitation (for MTCLIM)
   *************************************************/
 
   if(param_set.FORCE_DT[param_set.TYPE[PREC].SUPPLIED-1] == 24) {
     /* daily precipitation provided */
-    for (rec = 0; rec < global_param.nrecs; rec++) {
-      sum = 0;
-      for (j = 0; j < NF; j++) {
-        hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-        if (global_param.starthour - hour_offset_int < 0) hour += 24;
-        idx = (int)((float)hour/24.0);
-        atmos[rec].prec[j] = local_forcing_data[PREC][idx] / (float)(NF*stepspday); // divide evenly over the day
-        sum += atmos[rec].prec[j];
-      }
-      if(NF>1) atmos[rec].prec[NR] = sum;
-    }
     for (day = 0; day < Ndays_local; day++) {
       prec[day] = local_forcing_data[PREC][day];
     }
   }
   else {
     /* sub-daily precipitation provided */
-    for(rec = 0; rec < global_param.nrecs; rec++) {
-      sum = 0;
-      for(i = 0; i < NF; i++) {
-        hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-        if (global_param.starthour - hour_offset_int < 0) hour += 24;
-        atmos[rec].prec[i] = 0;
-        for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	  atmos[rec].prec[i] += local_forcing_data[PREC][idx];
-        }
-	sum += atmos[rec].prec[i];
-      }
-      if(NF>1) atmos[rec].prec[NR] = sum;
-    }
     for (day = 0; day < Ndays_local; day++) {
       prec[day] = 0;
       for (hour=0; hour<24; hour++) {
@@ -636,60 +732,6 @@ void initialize_atmos(atmos_data_struct        *atmos,
     }
   }
 
-  /*************************************************
-    Wind Speed
-  *************************************************/
-
-  if (param_set.TYPE[WIND].SUPPLIED) {
-    if(param_set.FORCE_DT[param_set.TYPE[WIND].SUPPLIED-1] == 24) {
-      /* daily wind provided */
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          atmos[rec].wind[j] = local_forcing_data[WIND][idx]; // assume constant over the day
-          sum += atmos[rec].wind[j];
-        }
-        if(NF>1) atmos[rec].wind[NR] = sum / (float)NF;
-	if(global_param.dt == 24) {
-	  if(atmos[rec].wind[j] < options.MIN_WIND_SPEED)
-	    atmos[rec].wind[j] = options.MIN_WIND_SPEED;
-	}
-      }
-    }
-    else {
-      /* sub-daily wind provided */
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          atmos[rec].wind[i] = 0;
-          for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	    if(local_forcing_data[WIND][idx] < options.MIN_WIND_SPEED)
-	      atmos[rec].wind[i] += options.MIN_WIND_SPEED;
-	    else
-	      atmos[rec].wind[i] += local_forcing_data[WIND][idx];
-          }
-          atmos[rec].wind[i] /= options.SNOW_STEP;
-	  sum += atmos[rec].wind[i];
-        }
-        if(NF>1) atmos[rec].wind[NR] = sum / (float)NF;
-      }
-    }
-  }
-  else {
-    /* no wind data provided, use default constant */
-    for (rec = 0; rec < global_param.nrecs; rec++) {
-      for (i = 0; i < NF; i++) {
-	atmos[rec].wind[i] = DEFAULT_WIND_SPEED;
-      }
-      atmos[rec].wind[NR] = DEFAULT_WIND_SPEED;	
-    }
-  }
-
   /*************************************************
     Air Temperature, part 1.
   *************************************************/
@@ -732,27 +774,6 @@ void initialize_atmos(atmos_data_struct        *atmos,
     }
   }
 
-  /*************************************************
-    Store sub-daily air temperature if provided
-  *************************************************/
-
-  if(param_set.TYPE[AIR_TEMP].SUPPLIED) {
-    for(rec = 0; rec < global_param.nrecs; rec++) {
-      sum = 0;
-      for(i = 0; i < NF; i++) {
-        hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-        if (global_param.starthour - hour_offset_int < 0) hour += 24;
-        atmos[rec].air_temp[i] = 0;
-        for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	  atmos[rec].air_temp[i] += local_forcing_data[AIR_TEMP][idx];
-        }
-        atmos[rec].air_temp[i] /= options.SNOW_STEP;
-	sum += atmos[rec].air_temp[i];
-      }
-      if(NF>1) atmos[rec].air_temp[NR] = sum / (float)NF;
-    }
-  }
-
   /******************************************************
     Determine Tmax and Tmin from sub-daily temperatures
   ******************************************************/
@@ -865,7 +886,8 @@ void initialize_atmos(atmos_data_struct        *atmos,
   } // end if VP not supplied
 
   /*************************************************
-    If vapor pressure supplied, transfer to appropriate arrays
+    If vapor pressure supplied, compute daily vapor pressure for MTCLIM
+    (the transfer to the atmos array is done after the call to MTCLIM)
   *************************************************/
 
   if(param_set.TYPE[VP].SUPPLIED) {
@@ -877,17 +899,6 @@ void initialize_atmos(atmos_data_struct        *atmos,
       for (day=0; day<Ndays_local; day++) {
         daily_vp[day] = local_forcing_data[VP][day];
       }
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          atmos[rec].vp[j] = local_forcing_data[VP][idx]; // assume constant over the day
-          sum += atmos[rec].vp[j];
-        }
-        if(NF>1) atmos[rec].vp[NR] = sum / (float)NF;
-      }
     }
     else {
       /* sub-daily vp provided */
@@ -898,20 +909,6 @@ void initialize_atmos(atmos_data_struct        *atmos,
         }
         daily_vp[day] /= 24;
       }
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          atmos[rec].vp[i] = 0;
-          for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	    atmos[rec].vp[i] += local_forcing_data[VP][idx];
-          }
-          atmos[rec].vp[i] /= options.SNOW_STEP;
-	  sum += atmos[rec].vp[i];
-        }
-        if(NF>1) atmos[rec].vp[NR] = sum / (float)NF;
-      }
     }
 
   }
@@ -951,9 +948,11 @@ void initialize_atmos(atmos_data_struct        *atmos,
     vp, MTCLIM will use them to compute the other variables
     more accurately.
   **************************************************/
+  timer_start(TIMER_MTCLIM);
   mtclim_wrapper(have_dewpt, have_shortwave, hour_offset, elevation, slope,
                    aspect, ehoriz, whoriz, annual_prec, phi, Ndays_local,
                    dmy_local, prec, tmax, tmin, tskc, daily_vp, hourlyrad, fdir);
+  timer_stop(TIMER_MTCLIM);
 
   /***********************************************************
     Shortwave, part 2.
@@ -972,21 +971,6 @@ void initialize_atmos(atmos_data_struct        *atmos,
       }
     }
   }
-  // Transfer hourlyrad to atmos structure
-  for(rec = 0; rec < global_param.nrecs; rec++) {
-    sum = 0;
-    for(i = 0; i < NF; i++) {
-      hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-      if (global_param.starthour - hour_offset_int < 0) hour += 24;
-      atmos[rec].shortwave[i] = 0;
-      for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	atmos[rec].shortwave[i] += hourlyrad[idx];
-      }
-      atmos[rec].shortwave[i] /= options.SNOW_STEP;
-      sum += atmos[rec].shortwave[i];
-    }
-    if(NF>1) atmos[rec].shortwave[NR] = sum / (float)NF;
-  }
 
   /**************************************************************************
     Air Temperature, part 2.
@@ -1002,230 +986,195 @@ void initialize_atmos(atmos_data_struct        *atmos,
   if(!param_set.TYPE[AIR_TEMP].SUPPLIED) {
 
     /**********************************************************************
-      Calculate the subdaily and daily temperature based on tmax and tmin 
+      Calculate the hourly temperature based on tmax and tmin 
     **********************************************************************/
     HourlyT(1, Ndays_local, tmaxhour, tmax, tminhour, tmin, tair);
-    for(rec = 0; rec < global_param.nrecs; rec++) {
-      sum = 0;
-      for(i = 0; i < NF; i++) {
-        hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-        if (global_param.starthour - hour_offset_int < 0) hour += 24;
-        atmos[rec].air_temp[i] = 0;
-        for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	  atmos[rec].air_temp[i] += tair[idx];
-        }
-        atmos[rec].air_temp[i] /= options.SNOW_STEP;
-        sum += atmos[rec].air_temp[i];
-      }
-      if(NF>1) atmos[rec].air_temp[NR] = sum / (float)NF;
-    }
 
   }
 
-
   /**************************************************************************
-    Atmospheric Pressure and Density
+    Transfer to the atmos array, pass 1.
+
+    Incoming channel flow, precipitation, wind speed, air temperature,
+    shortwave, density and pressure are computed in a single pass over
+    the records, reading each sub-step's window of the local hourly
+    arrays once.  Within each variable the order of the arithmetic is
+    that of the original per-variable passes, so the results are
+    identical.  Daily specific or relative humidity that could not be
+    converted before MTCLIM (no pressure or air temperature supplied)
+    is converted here, once pressure and air temperature are known.
   **************************************************************************/
 
-  /*************************************************
-    Store atmospheric density if provided (kg/m^3)
-  *************************************************/
-
-  if (param_set.TYPE[DENSITY].SUPPLIED) {
-    if(param_set.FORCE_DT[param_set.TYPE[DENSITY].SUPPLIED-1] == 24) {
-      /* daily density provided */
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          atmos[rec].density[j] = local_forcing_data[DENSITY][idx]; // assume constant over the day
-          sum += atmos[rec].density[j];
-        }
-        if(NF>1) atmos[rec].density[NR] = sum / (float)NF;
-      }
-    }
-    else {
-      /* sub-daily density provided */
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          atmos[rec].density[i] = 0;
-          for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	    atmos[rec].density[i] += local_forcing_data[DENSITY][idx];
-          }
-          atmos[rec].density[i] /= options.SNOW_STEP;
-	  sum += atmos[rec].density[i];
-        }
-        if(NF>1) atmos[rec].density[NR] = sum / (float)NF;
-      }
-    }
+  for (type = 0; type < N_FORCING_TYPES; type++) {
+    force_daily[type] = (param_set.TYPE[type].SUPPLIED
+                         && param_set.FORCE_DT[param_set.TYPE[type].SUPPLIED-1] == 24);
   }
+  vp_from_daily = (!param_set.TYPE[VP].SUPPLIED || force_daily[VP]);
 
-  /**************************************
-    Estimate Atmospheric Pressure (Pa) 
-  **************************************/
+  for (rec = 0; rec < global_param.nrecs; rec++) {
 
-  if(!param_set.TYPE[PRESSURE].SUPPLIED) {
-    if(!param_set.TYPE[DENSITY].SUPPLIED) {
-      /* Estimate pressure */
-      if (options.PLAPSE) {
-        /* Assume average virtual temperature in air column
-           between ground and sea level = KELVIN+atmos[rec].air_temp[NR] + 0.5*elevation*T_LAPSE */
-        for (rec = 0; rec < global_param.nrecs; rec++) {
-          atmos[rec].pressure[NR] = PS_PM*exp(-elevation*G/(Rd*(KELVIN+atmos[rec].air_temp[NR]+0.5*elevation*T_LAPSE)));
-          for (i = 0; i < NF; i++) {
-            atmos[rec].pressure[i] = PS_PM*exp(-elevation*G/(Rd*(KELVIN+atmos[rec].air_temp[i]+0.5*elevation*T_LAPSE)));
-          }
+    for (type = 0; type < N_FORCING_TYPES; type++)
+      step_sum[type] = 0;
+
+    for (i = 0; i < NF; i++) {
+      hour_raw = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
+      hour = hour_raw;
+      if (global_param.starthour - hour_offset_int < 0) hour += 24;
+      idx = (int)((float)hour/24.0);
+
+      /* Incoming channel flow */
+      if (param_set.TYPE[CHANNEL_IN].SUPPLIED) {
+        if (force_daily[CHANNEL_IN]) {
+          atmos[rec].channel_in[i] = local_forcing_data[CHANNEL_IN][idx] / (float)(NF*stepspday); // divide evenly over the day
         }
+        else {
+          atmos[rec].channel_in[i] = 0;
+          for (k = hour_raw; k < hour_raw+options.SNOW_STEP; k++)
+            atmos[rec].channel_in[i] += local_forcing_data[CHANNEL_IN][(k < 0) ? k+24 : k];
+        }
+        atmos[rec].channel_in[i] *= 1000/cell_area; // convert to mm over grid cell 
       }
+      else
+        atmos[rec].channel_in[i] = 0;
+      step_sum[CHANNEL_IN] += atmos[rec].channel_in[i];
+
+      /* Precipitation */
+      if (force_daily[PREC])
+        atmos[rec].prec[i] = local_forcing_data[PREC][idx] / (float)(NF*stepspday); // divide evenly over the day
+      else
+        atmos[rec].prec[i] = step_total(local_forcing_data[PREC], hour, options.SNOW_STEP);
+      step_sum[PREC] += atmos[rec].prec[i];
+
+      /* Wind speed */
+      if (!param_set.TYPE[WIND].SUPPLIED)
+        atmos[rec].wind[i] = DEFAULT_WIND_SPEED;
+      else if (force_daily[WIND])
+        atmos[rec].wind[i] = local_forcing_data[WIND][idx]; // assume constant over the day
       else {
-        /* set pressure to constant value */
-        for (rec = 0; rec < global_param.nrecs; rec++) {
-	  atmos[rec].pressure[NR] = 95500.;
-	  for (i = 0; i < NF; i++) {
-	    atmos[rec].pressure[i] = atmos[rec].pressure[NR];
-	  }
+        atmos[rec].wind[i] = 0;
+        for (k = hour; k < hour+options.SNOW_STEP; k++) {
+          if(local_forcing_data[WIND][k] < options.MIN_WIND_SPEED)
+            atmos[rec].wind[i] += options.MIN_WIND_SPEED;
+          else
+            atmos[rec].wind[i] += local_forcing_data[WIND][k];
         }
+        atmos[rec].wind[i] /= options.SNOW_STEP;
       }
-    }
-    else {
-      /* use observed densities to estimate pressure */
-      if (options.PLAPSE) {
-        for (rec = 0; rec < global_param.nrecs; rec++) {
-          atmos[rec].pressure[NR] = (KELVIN+atmos[rec].air_temp[NR])*atmos[rec].density[NR]*Rd;
-          for (i = 0; i < NF; i++) {
-            atmos[rec].pressure[i] = (KELVIN+atmos[rec].air_temp[i])*atmos[rec].density[i]*Rd;
-          }
-        }
+      step_sum[WIND] += atmos[rec].wind[i];
+
+      /* Air temperature, supplied or from MTCLIM's tmax and tmin */
+      if (param_set.TYPE[AIR_TEMP].SUPPLIED)
+        atmos[rec].air_temp[i] = step_mean(local_forcing_data[AIR_TEMP], hour, options.SNOW_STEP);
+      else
+        atmos[rec].air_temp[i] = step_mean(tair, hour, options.SNOW_STEP);
+      step_sum[AIR_TEMP] += atmos[rec].air_temp[i];
+
+      /* Shortwave */
+      atmos[rec].shortwave[i] = step_mean(hourlyrad, hour, options.SNOW_STEP);
+      step_sum[SHORTWAVE] += atmos[rec].shortwave[i];
+
+      /* Density, if supplied */
+      if (param_set.TYPE[DENSITY].SUPPLIED) {
+        if (force_daily[DENSITY])
+          atmos[rec].density[i] = local_forcing_data[DENSITY][idx]; // assume constant over the day
+        else
+          atmos[rec].density[i] = step_mean(local_forcing_data[DENSITY], hour, options.SNOW_STEP);
+        step_sum[DENSITY] += atmos[rec].density[i];
       }
-      else {
-        for (rec = 0; rec < global_param.nrecs; rec++) {
-	  atmos[rec].pressure[NR] = (275.0 + atmos[rec].air_temp[NR]) *atmos[rec].density[NR]/0.003486;
-	  for (i = 0; i < NF; i++) {
-	    atmos[rec].pressure[i] = (275.0 + atmos[rec].air_temp[i]) *atmos[rec].density[i]/0.003486;
-	  }
-        }
+
+      /* Pressure, supplied or estimated */
+      if (param_set.TYPE[PRESSURE].SUPPLIED) {
+        if (force_daily[PRESSURE])
+          atmos[rec].pressure[i] = local_forcing_data[PRESSURE][idx]; // assume constant over the day
+        else
+          atmos[rec].pressure[i] = step_mean(local_forcing_data[PRESSURE], hour, options.SNOW_STEP);
+        step_sum[PRESSURE] += atmos[rec].pressure[i];
       }
-    }
-  }
-  else {
-    /* observed atmospheric pressure supplied */
-    if(param_set.FORCE_DT[param_set.TYPE[PRESSURE].SUPPLIED-1] == 24) {
-      /* daily pressure provided */
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          atmos[rec].pressure[j] = local_forcing_data[PRESSURE][idx]; // assume constant over the day
-          sum += atmos[rec].pressure[j];
-        }
-        if(NF>1) atmos[rec].pressure[NR] = sum / (float)NF;
+      else if (!param_set.TYPE[DENSITY].SUPPLIED) {
+        /* Assume average virtual temperature in air column
+           between ground and sea level = KELVIN+atmos[rec].air_temp[i] + 0.5*elevation*T_LAPSE */
+        if (options.PLAPSE)
+          atmos[rec].pressure[i] = PS_PM*exp(-elevation*G/(Rd*(KELVIN+atmos[rec].air_temp[i]+0.5*elevation*T_LAPSE)));
+        else
+          atmos[rec].pressure[i] = 95500.;
       }
-    }
-    else {
-      /* sub-daily pressure provided */
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          atmos[rec].pressure[i] = 0;
-          for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	    atmos[rec].pressure[i] += local_forcing_data[PRESSURE][idx];
-          }
-          atmos[rec].pressure[i] /= options.SNOW_STEP;
-	  sum += atmos[rec].pressure[i];
-        }
-        if(NF>1) atmos[rec].pressure[NR] = sum / (float)NF;
+      else {
+        /* use observed densities to estimate pressure */
+        if (options.PLAPSE)
+          atmos[rec].pressure[i] = (KELVIN+atmos[rec].air_temp[i])*atmos[rec].density[i]*Rd;
+        else
+          atmos[rec].pressure[i] = (275.0 + atmos[rec].air_temp[i]) *atmos[rec].density[i]/0.003486;
       }
-    }
-  }
 
-  /********************************************************
-    Estimate Atmospheric Density if not provided (kg/m^3)
-  ********************************************************/
-
-  if(!param_set.TYPE[DENSITY].SUPPLIED) {
-    /* use pressure to estimate density */
-    if (options.PLAPSE) {
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        atmos[rec].density[NR] = atmos[rec].pressure[NR]/(Rd*(KELVIN+atmos[rec].air_temp[NR]));
-        for (i = 0; i < NF; i++) {
+      /* Density, if not supplied */
+      if (!param_set.TYPE[DENSITY].SUPPLIED) {
+        if (options.PLAPSE)
           atmos[rec].density[i] = atmos[rec].pressure[i]/(Rd*(KELVIN+atmos[rec].air_temp[i]));
-        }
+        else
+          atmos[rec].density[i] = 0.003486*atmos[rec].pressure[i]/ (275.0 + atmos[rec].air_temp[i]);
+      }
+
+      /* Daily vapor pressure from daily QAIR or REL_HUMID */
+      if (!param_set.TYPE[VP].SUPPLIED) {
+        if (force_daily[QAIR])
+          daily_vp[idx] = local_forcing_data[QAIR][idx] * atmos[rec].pressure[i] / EPS;
+        else if (force_daily[REL_HUMID])
+          daily_vp[idx] = local_forcing_data[REL_HUMID][idx] * svp(atmos[rec].air_temp[i]) / 100;
+      }
+    }
+
+    if (NF > 1) {
+      atmos[rec].channel_in[NR] = step_sum[CHANNEL_IN];
+      atmos[rec].prec[NR] = step_sum[PREC];
+      atmos[rec].air_temp[NR] = step_sum[AIR_TEMP] / (float)NF;
+      atmos[rec].shortwave[NR] = step_sum[SHORTWAVE] / (float)NF;
+      if (param_set.TYPE[WIND].SUPPLIED)
+        atmos[rec].wind[NR] = step_sum[WIND] / (float)NF;
+      if (param_set.TYPE[DENSITY].SUPPLIED)
+        atmos[rec].density[NR] = step_sum[DENSITY] / (float)NF;
+      if (param_set.TYPE[PRESSURE].SUPPLIED)
+        atmos[rec].pressure[NR] = step_sum[PRESSURE] / (float)NF;
+    }
+    if (!param_set.TYPE[WIND].SUPPLIED)
+      atmos[rec].wind[NR] = DEFAULT_WIND_SPEED;
+    else if (force_daily[WIND] && global_param.dt == 24) {
+      if (atmos[rec].wind[NR] < options.MIN_WIND_SPEED)
+        atmos[rec].wind[NR] = options.MIN_WIND_SPEED;
+    }
+    if (!param_set.TYPE[PRESSURE].SUPPLIED) {
+      if (!param_set.TYPE[DENSITY].SUPPLIED) {
+        if (options.PLAPSE)
+          atmos[rec].pressure[NR] = PS_PM*exp(-elevation*G/(Rd*(KELVIN+atmos[rec].air_temp[NR]+0.5*elevation*T_LAPSE)));
+        else
+          atmos[rec].pressure[NR] = 95500.;
+      }
+      else {
+        if (options.PLAPSE)
+          atmos[rec].pressure[NR] = (KELVIN+atmos[rec].air_temp[NR])*atmos[rec].density[NR]*Rd;
+        else
+          atmos[rec].pressure[NR] = (275.0 + atmos[rec].air_temp[NR]) *atmos[rec].density[NR]/0.003486;
       }
     }
-    else {
-      for (rec = 0; rec < global_param.nrecs; rec++) {
+    if (!param_set.TYPE[DENSITY].SUPPLIED) {
+      if (options.PLAPSE)
+        atmos[rec].density[NR] = atmos[rec].pressure[NR]/(Rd*(KELVIN+atmos[rec].air_temp[NR]));
+      else
         atmos[rec].density[NR] = 0.003486*atmos[rec].pressure[NR]/ (275.0 + atmos[rec].air_temp[NR]);
-        for (i = 0; i < NF; i++) {
-	  atmos[rec].density[i] = 0.003486*atmos[rec].pressure[i]/ (275.0 + atmos[rec].air_temp[i]);
-        }
-      }
     }
+
   }
 
   /**************************************************************************
     Vapor Pressure, part 2.
   **************************************************************************/
 
-  if(!param_set.TYPE[VP].SUPPLIED) {
-
-    /* handle cases of daily QAIR or RH supplied without pressure or temperature */
-
-    if(param_set.TYPE[QAIR].SUPPLIED && param_set.FORCE_DT[param_set.TYPE[QAIR].SUPPLIED-1] == 24) {
-
-      /**************************************************************************
-        If we arrive here, it means we couldn't use Qair earlier because
-        atmospheric pressure wasn't available at that time.  Now it is
-        available, so use Qair and pressure to estimate vp.
-      **************************************************************************/
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          daily_vp[idx] = local_forcing_data[QAIR][idx] * atmos[rec].pressure[j] / EPS;
-        }
-      }
-
-    } // end if QAIR supplied
-
-    else if(param_set.TYPE[REL_HUMID].SUPPLIED && param_set.FORCE_DT[param_set.TYPE[REL_HUMID].SUPPLIED-1] == 24) {
-
-      /**************************************************************************
-        If we arrive here, it means we couldn't use RH earlier because
-        air temperature wasn't available at that time.  Now it is
-        available, so use RH and temperature to estimate vp.
-      **************************************************************************/
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          daily_vp[idx] = local_forcing_data[REL_HUMID][idx] * svp(atmos[rec].air_temp[j]) / 100;
-        }
-      }
-
-    } // end if REL_HUMID supplied
-
-  } // end if VP not supplied
-
-  if (!param_set.TYPE[VP].SUPPLIED || param_set.FORCE_DT[param_set.TYPE[VP].SUPPLIED-1] == 24) {
+  if (vp_from_daily) {
 
     /**************************************************
       Either no observations of VP, QAIR, or REL_HUMID were supplied,
       in which case we will use MTCLIM's estimates of daily vapor pressure,
       or daily VP was supplied.
-      Now, calculate subdaily vapor pressure 
+      Now, calculate hourly vapor pressure 
     **************************************************/
 
     if (options.VP_INTERP) {
@@ -1276,474 +1225,190 @@ void initialize_atmos(atmos_data_struct        *atmos,
 
     }
 
-    /* Transfer sub-daily VP to atmos array */
-    for(rec = 0; rec < global_param.nrecs; rec++) {
-      sum = 0;
-      for(i = 0; i < NF; i++) {
-        hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-        if (global_param.starthour - hour_offset_int < 0) hour += 24;
-        atmos[rec].vp[i] = 0;
-        for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	  atmos[rec].vp[i] += local_forcing_data[VP][idx];
-        }
-        atmos[rec].vp[i] /= options.SNOW_STEP;
-	sum += atmos[rec].vp[i];
-      }
-      if(NF>1) atmos[rec].vp[NR] = sum / (float)NF;
-    }
+  } // end computation of hourly VP
 
-    /**************************************************
-      If sub-daily specific or relative humidity were supplied without pressure or temperature,
-      overwrite the sub-daily VP from MTCLIM here.
-    **************************************************/
-    if(param_set.TYPE[QAIR].SUPPLIED && param_set.FORCE_DT[param_set.TYPE[QAIR].SUPPLIED-1] < 24) {
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          atmos[rec].vp[i] = 0;
-          for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-            atmos[rec].vp[i] += local_forcing_data[QAIR][idx] * atmos[rec].pressure[j] / EPS;
-          }
-          atmos[rec].vp[i] /= options.SNOW_STEP;
-            sum += atmos[rec].vp[i];
-        }
-        if(NF>1) atmos[rec].vp[NR] = sum / (float)NF;
-      }
-    }
-    else if(param_set.TYPE[REL_HUMID].SUPPLIED && param_set.FORCE_DT[param_set.TYPE[REL_HUMID].SUPPLIED-1] < 24) {
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          atmos[rec].vp[i] = 0;
-          for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-            atmos[rec].vp[i] += local_forcing_data[REL_HUMID][idx] * svp(atmos[rec].air_temp[j]) / 100;
-          }
-          atmos[rec].vp[i] /= options.SNOW_STEP;
-          sum += atmos[rec].vp[i];
-        }
-        if(NF>1) atmos[rec].vp[NR] = sum / (float)NF;
-      }
-    }
+  /**************************************************************************
+    Transfer to the atmos array, pass 2.
+
+    Vapor pressure and its deficit, cloud transmissivity, longwave,
+    albedo, LAI, vegetation cover, solar zenith angle, direct shortwave
+    fraction, PAR, CO2 and the snowfall flag are computed in a single
+    pass over the records, using the air temperature, pressure and
+    shortwave from pass 1.  If sub-daily specific or relative humidity
+    were supplied without pressure or temperature, they overwrite the
+    sub-daily VP from MTCLIM here.
+  **************************************************************************/
 
-  } // end computation of sub-daily VP
+  if (!options.OUTPUT_FORCE) {
+    min_Tfactor = Tfactor[0];
+    for (band = 1; band < options.SNOW_BAND; band++) {
+      if (Tfactor[band] < min_Tfactor)
+        min_Tfactor = Tfactor[band];
+    }
+  }
 
-  /*************************************************
-    Vapor Pressure Deficit
-  *************************************************/
+  for (rec = 0; rec < global_param.nrecs; rec++) {
 
-  for(rec = 0; rec < global_param.nrecs; rec++) {
+    for (type = 0; type < N_FORCING_TYPES; type++)
+      step_sum[type] = 0;
     sum = 0;
     sum2 = 0;
-    for(i = 0; i < NF; i++) {
-      atmos[rec].vpd[i] = svp(atmos[rec].air_temp[i]) - atmos[rec].vp[i];
-      if (atmos[rec].vpd[i] < 0) {
-        atmos[rec].vpd[i] = 0;
-        atmos[rec].vp[i] = svp(atmos[rec].air_temp[i]);
-      }
-      sum += atmos[rec].vpd[i];
-      sum2 += atmos[rec].vp[i];
-    }
-    if (param_set.TYPE[VP].SUPPLIED || options.VP_INTERP) { // ensure that vp[NR] and vpd[NR] are accurate averages of vp[i] and vpd[i]
-      if(NF>1) atmos[rec].vpd[NR] = sum / (float)NF;
-      if(NF>1) atmos[rec].vp[NR] = sum2 / (float)NF;
-    }
-    else { // do not recompute vp[NR]; vpd[NR] is computed relative to vp[NR] and air_temp[NR]
-      atmos[rec].vpd[NR] = (svp(atmos[rec].air_temp[NR]) - atmos[rec].vp[NR]);
+
+    /* mean shortwave over the day, for disaggregating daily PAR */
+    if (force_daily[PAR]) {
+      tmp_int = (int)(rec/stepspday)*stepspday;
+      sw_daily_mean = 0;
+      for (k=0; k<stepspday; k++)
+        sw_daily_mean += atmos[tmp_int+k].shortwave[NR];
+      sw_daily_mean /= stepspday;
     }
-  }
 
-  /*************************************************
-    Cloud Transmissivity (from MTCLIM)
-  *************************************************/
+    dmy_tmp.year = dmy[rec].year;
+    dmy_tmp.month = dmy[rec].month;
+    dmy_tmp.day = dmy[rec].day;
+    dmy_tmp.day_in_year = dmy[rec].day_in_year;
 
-  for (rec = 0; rec < global_param.nrecs; rec++) {
-    sum = 0;
-    for (j = 0; j < NF; j++) {
-      hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
+    for (i = 0; i < NF; i++) {
+      hour_raw = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
+      hour = hour_raw;
       if (global_param.starthour - hour_offset_int < 0) hour += 24;
       idx = (int)((float)hour/24.0);
-      atmos[rec].tskc[j] = tskc[idx]; // assume constant over the day
-      sum += atmos[rec].tskc[j];
-    }
-    if(NF>1) atmos[rec].tskc[NR] = sum / (float)NF;
-  }
 
-  /*************************************************
-    Longwave
-  *************************************************/
-
-  if ( !param_set.TYPE[LONGWAVE].SUPPLIED ) {
-    /** Incoming longwave radiation not supplied **/
-    for (rec = 0; rec < global_param.nrecs; rec++) {
-      sum = 0;
-      for (i = 0; i < NF; i++) {
-	calc_longwave(&(atmos[rec].longwave[i]), atmos[rec].tskc[i],
-		      atmos[rec].air_temp[i], atmos[rec].vp[i]);
-        sum += atmos[rec].longwave[i];
-      }
-      if(NF>1) atmos[rec].longwave[NR] = sum / (float)NF;
-    }
-  }
-  else {
-    if(param_set.FORCE_DT[param_set.TYPE[LONGWAVE].SUPPLIED-1] == 24) {
-      /* daily incoming longwave radiation provided */
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          atmos[rec].longwave[j] = local_forcing_data[LONGWAVE][idx]; // assume constant over the day
-          sum += atmos[rec].longwave[j];
-        }
-        if(NF>1) atmos[rec].longwave[NR] = sum / (float)NF;
+      /* Vapor pressure */
+      if (vp_from_daily && param_set.TYPE[QAIR].SUPPLIED && !force_daily[QAIR]) {
+        atmos[rec].vp[i] = 0;
+        for (k = hour; k < hour+options.SNOW_STEP; k++)
+          atmos[rec].vp[i] += local_forcing_data[QAIR][k] * atmos[rec].pressure[i] / EPS;
+        atmos[rec].vp[i] /= options.SNOW_STEP;
       }
-    }
-    else {
-      /* sub-daily incoming longwave radiation provided */
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          atmos[rec].longwave[i] = 0;
-          for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	    atmos[rec].longwave[i] += local_forcing_data[LONGWAVE][idx];
-          }
-          atmos[rec].longwave[i] /= options.SNOW_STEP;
-	  sum += atmos[rec].longwave[i];
-        }
-        if(NF>1) atmos[rec].longwave[NR] = sum / (float)NF;
+      else if (vp_from_daily && param_set.TYPE[REL_HUMID].SUPPLIED && !force_daily[REL_HUMID]) {
+        atmos[rec].vp[i] = 0;
+        for (k = hour; k < hour+options.SNOW_STEP; k++)
+          atmos[rec].vp[i] += local_forcing_data[REL_HUMID][k] * svp(atmos[rec].air_temp[i]) / 100;
+        atmos[rec].vp[i] /= options.SNOW_STEP;
       }
-    }
-  }
+      else
+        atmos[rec].vp[i] = step_mean(local_forcing_data[VP], hour, options.SNOW_STEP);
+      step_sum[VP] += atmos[rec].vp[i];
 
-  if (!options.OUTPUT_FORCE) {
-
-    /****************************************************
-      Albedo
-    ****************************************************/
-
-    /* First, assign default climatology */
-    for (rec = 0; rec < global_param.nrecs; rec++) {
-      for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
-        for (j = 0; j < NF; j++) {
-          veg_hist[rec][v].albedo[j] = veg_lib[veg_con[v].veg_class].albedo[dmy[rec].month-1];
-        }
+      /* Vapor pressure deficit */
+      atmos[rec].vpd[i] = svp(atmos[rec].air_temp[i]) - atmos[rec].vp[i];
+      if (atmos[rec].vpd[i] < 0) {
+        atmos[rec].vpd[i] = 0;
+        atmos[rec].vp[i] = svp(atmos[rec].air_temp[i]);
       }
-    }
+      sum += atmos[rec].vpd[i];
+      sum2 += atmos[rec].vp[i];
 
-    if(param_set.TYPE[ALBEDO].SUPPLIED) {
-      if(param_set.FORCE_DT[param_set.TYPE[ALBEDO].SUPPLIED-1] == 24) {
-        /* daily albedo provided */
-        for (rec = 0; rec < global_param.nrecs; rec++) {
-          for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
-            sum = 0;
-            for (j = 0; j < NF; j++) {
-              hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-              if (global_param.starthour - hour_offset_int < 0) hour += 24;
-              idx = (int)((float)hour/24.0);
-              if (local_veg_hist_data[ALBEDO][v][idx] != NODATA_VH)
-  	      veg_hist[rec][v].albedo[j] = local_veg_hist_data[ALBEDO][v][idx]; // assume constant over the day
-              sum += veg_hist[rec][v].albedo[j];
-            }
-            if(NF>1) veg_hist[rec][v].albedo[NR] = sum / (float)NF;
-          }
+      /* Cloud transmissivity (from MTCLIM) */
+      atmos[rec].tskc[i] = tskc[idx]; // assume constant over the day
+      step_sum[TSKC] += atmos[rec].tskc[i];
+
+      /* Longwave */
+      if (!param_set.TYPE[LONGWAVE].SUPPLIED)
+        calc_longwave(&(atmos[rec].longwave[i]), atmos[rec].tskc[i],
+                      atmos[rec].air_temp[i], atmos[rec].vp[i]);
+      else if (force_daily[LONGWAVE])
+        atmos[rec].longwave[i] = local_forcing_data[LONGWAVE][idx]; // assume constant over the day
+      else
+        atmos[rec].longwave[i] = step_mean(local_forcing_data[LONGWAVE], hour, options.SNOW_STEP);
+      step_sum[LONGWAVE] += atmos[rec].longwave[i];
+
+      /* Albedo, LAI and fractional vegetation cover */
+      if (!options.OUTPUT_FORCE) {
+        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+          veg_hist[rec][v].albedo[i]
+            = veg_hist_step(veg_lib[veg_con[v].veg_class].albedo[dmy[rec].month-1],
+                            local_veg_hist_data, ALBEDO, v, idx, hour_raw, FALSE);
+          veg_hist[rec][v].LAI[i]
+            = veg_hist_step(veg_lib[veg_con[v].veg_class].LAI[dmy[rec].month-1],
+                            local_veg_hist_data, LAI_IN, v, idx, hour_raw, FALSE);
+          veg_hist[rec][v].vegcover[i]
+            = veg_hist_step(veg_lib[veg_con[v].veg_class].vegcover[dmy[rec].month-1],
+                            local_veg_hist_data, VEGCOVER, v, idx, hour_raw, TRUE);
         }
       }
-      else {
-        /* sub-daily albedo provided */
-        for(rec = 0; rec < global_param.nrecs; rec++) {
-          for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
-            sum = 0;
-            for(i = 0; i < NF; i++) {
-              hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-              veg_hist[rec][v].albedo[i] = 0;
-              while (hour < rec*global_param.dt + (i+1)*options.SNOW_STEP + global_param.starthour - hour_offset_int) {
-                idx = hour;
-                if (idx < 0) idx += 24;
-                if (local_veg_hist_data[ALBEDO][v][idx] != NODATA_VH)
-  	        veg_hist[rec][v].albedo[i] = local_veg_hist_data[ALBEDO][v][idx];
-                hour++;
-              }
-  	    sum += veg_hist[rec][v].albedo[i];
-            }
-            if(NF>1) veg_hist[rec][v].albedo[NR] = sum / (float)NF;
-          }
-        }
-      }
-    }
 
-    /****************************************************
-      Leaf Area Index (LAI)
-    ****************************************************/
+      /* Cosine of solar zenith angle */
+      dmy_tmp.hour = hour+0.5*options.SNOW_STEP;
+      atmos[rec].coszen[i] = compute_coszen(phi,theta_s,theta_l,dmy_tmp);
 
-    /* First, assign default climatology */
-    for (rec = 0; rec < global_param.nrecs; rec++) {
-      for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
-        for (j = 0; j < NF; j++) {
-          veg_hist[rec][v].LAI[j] = veg_lib[veg_con[v].veg_class].LAI[dmy[rec].month-1];
-        }
-      }
-    }
+      /* Direct shortwave fraction (from MTCLIM) */
+      atmos[rec].fdir[i] = fdir[idx]; // assume constant over the day
+      step_sum[FDIR] += atmos[rec].fdir[i];
 
-    if(param_set.TYPE[LAI_IN].SUPPLIED) {
-      if(param_set.FORCE_DT[param_set.TYPE[LAI_IN].SUPPLIED-1] == 24) {
-        /* daily LAI provided */
-        for (rec = 0; rec < global_param.nrecs; rec++) {
-          for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
-            sum = 0;
-            for (j = 0; j < NF; j++) {
-              hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-              if (global_param.starthour - hour_offset_int < 0) hour += 24;
-              idx = (int)((float)hour/24.0);
-              if (local_veg_hist_data[LAI_IN][v][idx] != NODATA_VH)
-  	      veg_hist[rec][v].LAI[j] = local_veg_hist_data[LAI_IN][v][idx]; // assume constant over the day
-              sum += veg_hist[rec][v].LAI[j];
-            }
-            if(NF>1) veg_hist[rec][v].LAI[NR] = sum / (float)NF;
-          }
-        }
+      /* Photosynthetically active radiation */
+      if (!param_set.TYPE[PAR].SUPPLIED)
+        atmos[rec].par[i] = SW2PAR * atmos[rec].shortwave[i];
+      else if (force_daily[PAR]) {
+        if (sw_daily_mean > 0)
+          atmos[rec].par[i] = local_forcing_data[PAR][idx]*atmos[rec].shortwave[i]/sw_daily_mean;
+        else
+          atmos[rec].par[i] = 0;
       }
+      else
+        atmos[rec].par[i] = step_mean(local_forcing_data[PAR], hour, options.SNOW_STEP);
+      step_sum[PAR] += atmos[rec].par[i];
+
+      /* Atmospheric carbon dioxide mixing ratio */
+      if (!param_set.TYPE[CATM].SUPPLIED)
+        atmos[rec].Catm[i] = CatmCurrent * 1e-6; // convert ppm to mixing ratio
+      else if (force_daily[CATM])
+        atmos[rec].Catm[i] = local_forcing_data[CATM][idx]*1e-6; // convert ppm to mixing ratio
       else {
-        /* sub-daily LAI provided */
-        for(rec = 0; rec < global_param.nrecs; rec++) {
-          for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
-            sum = 0;
-            for(i = 0; i < NF; i++) {
-              hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-              veg_hist[rec][v].LAI[i] = 0;
-              while (hour < rec*global_param.dt + (i+1)*options.SNOW_STEP + global_param.starthour - hour_offset_int) {
-                idx = hour;
-                if (idx < 0) idx += 24;
-                if (local_veg_hist_data[LAI_IN][v][idx] != NODATA_VH)
-  	        veg_hist[rec][v].LAI[i] = local_veg_hist_data[LAI_IN][v][idx];
-                hour++;
-              }
-  	    sum += veg_hist[rec][v].LAI[i];
-            }
-            if(NF>1) veg_hist[rec][v].LAI[NR] = sum / (float)NF;
-          }
-        }
+        atmos[rec].Catm[i] = 0;
+        for (k = hour; k < hour+options.SNOW_STEP; k++)
+          atmos[rec].Catm[i] += local_forcing_data[CATM][k]*1e-6; // convert ppm to mixing ratio
+        atmos[rec].Catm[i] /= options.SNOW_STEP;
       }
+      step_sum[CATM] += atmos[rec].Catm[i];
     }
 
-    /****************************************************
-      Fractional Vegetation Cover
-    ****************************************************/
-
-    /* First, assign default climatology */
-    for (rec = 0; rec < global_param.nrecs; rec++) {
-      for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
-        for (j = 0; j < NF; j++) {
-          veg_hist[rec][v].vegcover[j] = veg_lib[veg_con[v].veg_class].vegcover[dmy[rec].month-1];
-        }
-      }
+    if (NF > 1) {
+      atmos[rec].vp[NR] = step_sum[VP] / (float)NF;
+      atmos[rec].tskc[NR] = step_sum[TSKC] / (float)NF;
     }
-
-    if(param_set.TYPE[VEGCOVER].SUPPLIED) {
-      if(param_set.FORCE_DT[param_set.TYPE[VEGCOVER].SUPPLIED-1] == 24) {
-        /* daily vegcover provided */
-        for (rec = 0; rec < global_param.nrecs; rec++) {
-          for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
-            sum = 0;
-            for (j = 0; j < NF; j++) {
-              hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-              if (global_param.starthour - hour_offset_int < 0) hour += 24;
-              idx = (int)((float)hour/24.0);
-              if (local_veg_hist_data[VEGCOVER][v][idx] != NODATA_VH) {
-  	      veg_hist[rec][v].vegcover[j] = local_veg_hist_data[VEGCOVER][v][idx]; // assume constant over the day
-                if (veg_hist[rec][v].vegcover[j] < MIN_VEGCOVER) veg_hist[rec][v].vegcover[j] = MIN_VEGCOVER;
-              }
-              sum += veg_hist[rec][v].vegcover[j];
-            }
-            if(NF>1) veg_hist[rec][v].vegcover[NR] = sum / (float)NF;
-          }
-        }
-      }
-      else {
-        /* sub-daily vegcover provided */
-        for(rec = 0; rec < global_param.nrecs; rec++) {
-          for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
-            sum = 0;
-            for(i = 0; i < NF; i++) {
-              hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-              veg_hist[rec][v].vegcover[i] = 0;
-              while (hour < rec*global_param.dt + (i+1)*options.SNOW_STEP + global_param.starthour - hour_offset_int) {
-                idx = hour;
-                if (idx < 0) idx += 24;
-                if (local_veg_hist_data[VEGCOVER][v][idx] != NODATA_VH) {
-  	        veg_hist[rec][v].vegcover[i] = local_veg_hist_data[VEGCOVER][v][idx];
-                  if (veg_hist[rec][v].vegcover[i] < MIN_VEGCOVER) veg_hist[rec][v].vegcover[i] = MIN_VEGCOVER;
-                }
-                hour++;
-              }
-  	    sum += veg_hist[rec][v].vegcover[i];
-            }
-            if(NF>1) veg_hist[rec][v].vegcover[NR] = sum / (float)NF;
-          }
-        }
-      }
+    if (param_set.TYPE[VP].SUPPLIED || options.VP_INTERP) { // ensure that vp[NR] and vpd[NR] are accurate averages of vp[i] and vpd[i]
+      if(NF>1) atmos[rec].vpd[NR] = sum / (float)NF;
+      if(NF>1) atmos[rec].vp[NR] = sum2 / (float)NF;
     }
-  }
-  /*************************************************
-    Cosine of Solar Zenith Angle
-  *************************************************/
-
-  for (rec = 0; rec < global_param.nrecs; rec++) {
-    dmy_tmp.year = dmy[rec].year;
-    dmy_tmp.month = dmy[rec].month;
-    dmy_tmp.day = dmy[rec].day;
-    dmy_tmp.day_in_year = dmy[rec].day_in_year;
-    for (j = 0; j < NF; j++) {
-      hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-      if (global_param.starthour - hour_offset_int < 0) hour += 24;
-      dmy_tmp.hour = hour+0.5*options.SNOW_STEP;
-      atmos[rec].coszen[j] = compute_coszen(phi,theta_s,theta_l,dmy_tmp);
+    else { // do not recompute vp[NR]; vpd[NR] is computed relative to vp[NR] and air_temp[NR]
+      atmos[rec].vpd[NR] = (svp(atmos[rec].air_temp[NR]) - atmos[rec].vp[NR]);
     }
-    if (NF>1) {
+    if (NF > 1) {
+      atmos[rec].longwave[NR] = step_sum[LONGWAVE] / (float)NF;
+      atmos[rec].fdir[NR] = step_sum[FDIR] / (float)NF;
+      atmos[rec].par[NR] = step_sum[PAR] / (float)NF;
+      atmos[rec].Catm[NR] = step_sum[CATM] / (float)NF;
       dmy_tmp.hour = dmy[rec].hour + 0.5*global_param.dt;
       atmos[rec].coszen[NR] = compute_coszen(phi,theta_s,theta_l,dmy_tmp);
     }
-  }
-
-  /*************************************************
-    Direct Shortwave Fraction (from MTCLIM)
-  *************************************************/
-
-  for (rec = 0; rec < global_param.nrecs; rec++) {
-    sum = 0;
-    for (j = 0; j < NF; j++) {
-      hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-      if (global_param.starthour - hour_offset_int < 0) hour += 24;
-      idx = (int)((float)hour/24.0);
-      atmos[rec].fdir[j] = fdir[idx]; // assume constant over the day
-      sum += atmos[rec].fdir[j];
-    }
-    if(NF>1) atmos[rec].fdir[NR] = sum / (float)NF;
-  }
-
-  /*************************************************
-    Photosynthetically Active Radiation
-  *************************************************/
 
-  if ( !param_set.TYPE[PAR].SUPPLIED ) {
-    /** par not supplied **/
-    for (rec = 0; rec < global_param.nrecs; rec++) {
-      sum = 0;
-      for (i = 0; i < NF; i++) {
-        atmos[rec].par[i] = SW2PAR * atmos[rec].shortwave[i];
-        sum += atmos[rec].par[i];
-      }
-      if(NF>1) atmos[rec].par[NR] = sum / (float)NF;
-    }
-  }
-  else {
-    if(param_set.FORCE_DT[param_set.TYPE[PAR].SUPPLIED-1] == 24) {
-      /* daily par provided */
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          tmp_int = (int)(rec/stepspday)*stepspday;
-          tmp_double = 0;
-          for (i=0; i<stepspday; i++)
-            tmp_double += atmos[tmp_int+i].shortwave[NR];
-          tmp_double /= stepspday;
-          if (tmp_double > 0)
-            atmos[rec].par[j] = local_forcing_data[PAR][idx]*atmos[rec].shortwave[j]/tmp_double;
-          else
-            atmos[rec].par[j] = 0;
-          sum += atmos[rec].par[j];
-        }
-        if(NF>1) atmos[rec].par[NR] = sum / (float)NF;
-      }
-    }
-    else {
-      /* sub-daily par provided */
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          atmos[rec].par[i] = 0;
-          for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	    atmos[rec].par[i] += local_forcing_data[PAR][idx];
+    if (!options.OUTPUT_FORCE) {
+      if (NF > 1) {
+        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+          if (param_set.TYPE[ALBEDO].SUPPLIED) {
+            sum = 0;
+            for (i = 0; i < NF; i++)
+              sum += veg_hist[rec][v].albedo[i];
+            veg_hist[rec][v].albedo[NR] = sum / (float)NF;
           }
-          atmos[rec].par[i] /= options.SNOW_STEP;
-	  sum += atmos[rec].par[i];
-        }
-        if(NF>1) atmos[rec].par[NR] = sum / (float)NF;
-      }
-    }
-  }
-
-  /*************************************************
-    Atmospheric Carbon Dioxide Mixing Ratio
-  *************************************************/
-
-  if ( !param_set.TYPE[CATM].SUPPLIED ) {
-    /** Atmospheric carbon dioxide concentration not supplied **/
-    for (rec = 0; rec < global_param.nrecs; rec++) {
-      sum = 0;
-      for (i = 0; i < NF; i++) {
-        atmos[rec].Catm[i] = CatmCurrent * 1e-6; // convert ppm to mixing ratio
-        sum += atmos[rec].Catm[i];
-      }
-      if(NF>1) atmos[rec].Catm[NR] = sum / (float)NF;
-    }
-  }
-  else {
-    if(param_set.FORCE_DT[param_set.TYPE[CATM].SUPPLIED-1] == 24) {
-      /* daily atmospheric carbon dioxide concentration provided */
-      for (rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for (j = 0; j < NF; j++) {
-          hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          idx = (int)((float)hour/24.0);
-          atmos[rec].Catm[j] = local_forcing_data[CATM][idx]*1e-6; // convert ppm to mixing ratio
-          sum += atmos[rec].Catm[j];
-        }
-        if(NF>1) atmos[rec].Catm[NR] = sum / (float)NF;
-      }
-    }
-    else {
-      /* sub-daily atmospheric carbon dioxide concentration provided */
-      for(rec = 0; rec < global_param.nrecs; rec++) {
-        sum = 0;
-        for(i = 0; i < NF; i++) {
-          hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
-          if (global_param.starthour - hour_offset_int < 0) hour += 24;
-          atmos[rec].Catm[i] = 0;
-          for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-	    atmos[rec].Catm[i] += local_forcing_data[CATM][idx]*1e-6; // convert ppm to mixing ratio
+          if (param_set.TYPE[LAI_IN].SUPPLIED) {
+            sum = 0;
+            for (i = 0; i < NF; i++)
+              sum += veg_hist[rec][v].LAI[i];
+            veg_hist[rec][v].LAI[NR] = sum / (float)NF;
+          }
+          if (param_set.TYPE[VEGCOVER].SUPPLIED) {
+            sum = 0;
+            for (i = 0; i < NF; i++)
+              sum += veg_hist[rec][v].vegcover[i];
+            veg_hist[rec][v].vegcover[NR] = sum / (float)NF;
           }
-          atmos[rec].Catm[i] /= options.SNOW_STEP;
-	  sum += atmos[rec].Catm[i];
         }
-        if(NF>1) atmos[rec].Catm[NR] = sum / (float)NF;
       }
-    }
-  }
 
-  /****************************************************
-    Determine if Snow will Fall During Each Time Step
-  ****************************************************/
-
-  if (!options.OUTPUT_FORCE) {
-    min_Tfactor = Tfactor[0];
-    for (band = 1; band < options.SNOW_BAND; band++) {
-      if (Tfactor[band] < min_Tfactor)
-        min_Tfactor = Tfactor[band];
-    }
-    for (rec = 0; rec < global_param.nrecs; rec++) {
+      /* Determine if snow will fall during each time step */
       atmos[rec].snowflag[NR] = FALSE;
       for (i = 0; i < NF; i++) {
         if ((atmos[rec].air_temp[i] + min_Tfactor) < global_param.MAX_SNOW_TEMP
@@ -1755,68 +1420,50 @@ void initialize_atmos(atmos_data_struct        *atmos,
 	  atmos[rec].snowflag[i] = FALSE;
       }
     }
+
   }
 
-  param_set.TYPE[PREC].SUPPLIED = save_prec_supplied;
-  param_set.TYPE[WIND].SUPPLIED = save_wind_supplied;
-  param_set.TYPE[VP].SUPPLIED = save_vp_supplied;
- 
+  if (use_cache)
+    forcing_cache_store(cache_key, atmos);
+
   // Free temporary parameters
-  free(hourlyrad);
-  free(prec);
-  free(tair);
-  free(tmax);
-  free(tmaxhour);
-  free(tmin);
-  free(tminhour);
-  free(tskc);
-  free(daily_vp);
-  free(dailyrad);
-  free(fdir);
+  mem_free(hourlyrad, MEM_FORCING);
+  mem_free(prec, MEM_FORCING);
+  mem_free(tair, MEM_FORCING);
+  mem_free(tmax, MEM_FORCING);
+  mem_free(tmaxhour, MEM_FORCING);
+  mem_free(tmin, MEM_FORCING);
+  mem_free(tminhour, MEM_FORCING);
+  mem_free(tskc, MEM_FORCING);
+  mem_free(daily_vp, MEM_FORCING);
+  mem_free(dailyrad, MEM_FORCING);
+  mem_free(fdir, MEM_FORCING);
 
   for(i=0;i<N_FORCING_TYPES;i++)  {
     if (param_set.TYPE[i].SUPPLIED) {
       if (i != ALBEDO && i != LAI_IN && i != VEGCOVER) {
-        free(forcing_data[i]);
+        mem_free(forcing_data[i], MEM_FORCING);
       }
       else {
-        for (j=0;j<param_set.TYPE[i].N_ELEM;j++) free(veg_hist_data[i][j]);
-        free(veg_hist_data[i]);
+        for (j=0;j<param_set.TYPE[i].N_ELEM;j++) mem_free(veg_hist_data[i][j], MEM_FORCING);
+        mem_free(veg_hist_data[i], MEM_FORCING);
       }
     }
     if (i != ALBEDO && i != LAI_IN && i != VEGCOVER) {
-      free(local_forcing_data[i]);
+      mem_free(local_forcing_data[i], MEM_FORCING);
     }
     else {
-      for (j=0;j<param_set.TYPE[i].N_ELEM;j++) free(local_veg_hist_data[i][j]);
-      free(local_veg_hist_data[i]);
-    }
-  }
-  free(forcing_data);
-  free(local_forcing_data);
-  free(veg_hist_data);
-  free(local_veg_hist_data);
-  free((char *)dmy_local);
-
-  if (!options.OUTPUT_FORCE) {
-
-    // If COMPUTE_TREELINE is TRUE and the treeline computation hasn't
-    // specifically been turned off for this cell (by supplying avgJulyAirTemp
-    // and setting it to -999), calculate which snowbands are above the
-    // treeline, based on average July air temperature.
-    if (options.COMPUTE_TREELINE) {
-      if ( !(options.JULY_TAVG_SUPPLIED && avgJulyAirTemp == -999) ) {
-        compute_treeline( atmos, dmy, avgJulyAirTemp, Tfactor, AboveTreeLine );
-      }
+      for (j=0;j<param_set.TYPE[i].N_ELEM;j++) mem_free(local_veg_hist_data[i][j], MEM_FORCING);
+      mem_free(local_veg_hist_data[i], MEM_FORCING);
     }
-
-  }
-  else {
-
-    // If OUTPUT_FORCE is TRUE then the full
-    // forcing data array is dumped into a new set of files.
-    write_forcing_file(atmos, global_param.nrecs, out_data_files, out_data);
-
   }
+  mem_free(forcing_data, MEM_FORCING);
+  mem_free(local_forcing_data, MEM_FORCING);
+  mem_free(veg_hist_data, MEM_FORCING);
+  mem_free(local_veg_hist_data, MEM_FORCING);
+  mem_free((char *)dmy_local, MEM_FORCING);
+
+  finish_atmos(atmos, dmy, avgJulyAirTemp, Tfactor, AboveTreeLine,
+               out_data_files, out_data);
 
 }
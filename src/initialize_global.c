@@ -133,6 +133,24 @@ void initialize_global() {
   2014-Mar-28 Removed DIST_PRCP option.						TJB
   2014-Apr-25 Added LAI_SRC, VEGPARAM_ALB, and ALB_SRC options.			TJB
   2014-Apr-25 Added VEGPARAM_VEGCOVER and VEGCOVER_SRC options.			TJB
+  2026-Oct-17 Added TIMING option.						KM
+  2026-Oct-17 Added kernel capture options.					KM
+  2026-Oct-17 Added PROGRESS option.						KM
+  2026-Oct-17 Added MEM_STATS option.						KM
+  2026-Oct-17 Added REGION_ONLY option.						KM
+  2026-Oct-17 Added STAT_ONLY option.						KM
+  2026-Oct-17 Added FORCING_CACHE_MAX option.					KM
+  2026-Oct-17 Added FORCE_THREADS option.					KM
+  2026-Oct-17 Added FORCE_PRECISION option.					KM
+  2026-Oct-17 Added NETCDF_CACHE_MAX option and param_set.FORCE_VAR.	KM
+  2026-Oct-17 Added PREFETCH_DEPTH option.					KM
+  2026-Oct-17 Added WRITE_QUEUE option.					KM
+  2026-Oct-17 Added ARROW_OUTPUT option.					KM
+  2026-Oct-17 Added SHM_SLOTS option.					KM
+  2026-Oct-17 Added SOIL_T_SOLVER option.					KM
+  2026-Oct-17 Added SNOW_STEP_ADAPT option.					KM
+  2026-Oct-17 Added PET_OUTPUT option.						KM
+  2026-Oct-17 Added IMPLICIT_JACOBIAN option.					KM
 *********************************************************************/
 
   extern option_struct options;
@@ -157,6 +175,7 @@ void initialize_global() {
   options.FULL_ENERGY           = FALSE;
   options.GRND_FLUX_TYPE        = GF_410;
   options.IMPLICIT              = TRUE;
+  options.IMPLICIT_JACOBIAN     = IMPL_JAC_NODE;
   options.LAKES                 = FALSE;
   options.LAKE_PROFILE          = FALSE;
   options.LW_CLOUD              = LW_CLOUD_DEARDORFF;
@@ -177,6 +196,8 @@ void initialize_global() {
   options.SNOW_BAND             = 1;
   options.SNOW_DENSITY          = DENS_BRAS;
   options.SNOW_STEP             = 1;
+  options.SNOW_STEP_ADAPT       = FALSE;
+  options.SOIL_T_SOLVER         = SOIL_T_GS;
   options.SPATIAL_FROST         = FALSE;
   options.SPATIAL_SNOW          = FALSE;
   options.SW_PREC_THRESH        = 0;
@@ -186,10 +207,14 @@ void initialize_global() {
   // input options
   options.ALB_SRC               = FROM_VEGLIB;
   options.BASEFLOW              = ARNO;
+  options.FORCING_CACHE_MAX     = 0;
+  options.FORCE_PRECISION       = FORCE_PREC_DOUBLE;
   options.GRID_DECIMAL          = 2;
   options.JULY_TAVG_SUPPLIED    = FALSE;
   options.LAI_SRC               = FROM_VEGLIB;
+  options.NETCDF_CACHE_MAX      = 256;
   options.ORGANIC_FRACT         = FALSE;
+  options.PREFETCH_DEPTH        = 0;
   options.VEGCOVER_SRC          = FROM_VEGLIB;
   options.VEGLIB_PHOTO          = FALSE;
   options.VEGLIB_VEGCOVER       = FALSE;
@@ -202,13 +227,27 @@ void initialize_global() {
   options.SAVE_STATE            = FALSE;
   // output options
   options.ALMA_OUTPUT           = FALSE;
+  options.ARROW_OUTPUT          = FALSE;
   options.BINARY_OUTPUT         = FALSE;
   options.COMPRESS              = FALSE;
+  options.FORCE_THREADS         = 1;
   options.MOISTFRACT            = FALSE;
   options.Noutfiles             = 2;
   options.OUTPUT_FORCE          = FALSE;
+  options.PET_OUTPUT            = FALSE;
   options.PRT_HEADER            = FALSE;
   options.PRT_SNOW_BAND         = FALSE;
+  options.REGION_ONLY           = FALSE;
+  options.SHM_SLOTS             = 4096;
+  options.STAT_ONLY             = FALSE;
+  options.WRITE_QUEUE           = 0;
+  // diagnostic options
+  options.TIMING                = TIMING_NONE;
+  options.KERNEL_CAPTURE        = 0;
+  options.KERNEL_MAX            = 10000;
+  options.KERNEL_SAMPLE         = 1000;
+  options.PROGRESS              = 0;
+  options.MEM_STATS             = FALSE;
 
   /** Initialize forcing file input controls **/
 
@@ -216,6 +255,7 @@ void initialize_global() {
     param_set.TYPE[j].SUPPLIED = FALSE;
     param_set.TYPE[j].SIGNED   = 1;
     param_set.TYPE[j].multiplier = 1;
+    strcpy(param_set.FORCE_VAR[j], "");
   }
   for(i=0;i<2;i++) {
     param_set.FORCE_DT[i] = MISSING;
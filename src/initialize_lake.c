@@ -76,6 +76,8 @@ int initialize_lake (lake_var_struct   *lake,
 	      option.							TJB
   2013-Jul-25 Added soil carbon terms.					TJB
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
+  2026-Oct-17 Passes lake_con to get_sarea() and get_volume() by
+	      reference.						KM
 **********************************************************************/
 {
   extern option_struct options;
@@ -150,7 +152,7 @@ int initialize_lake (lake_var_struct   *lake,
         depth = lake->ldepth;
       else
         depth = lake->dz*(lake->activenod - k);
-      status = get_sarea(lake_con, depth, &(lake->surface[k]));
+      status = get_sarea(&lake_con, depth, &(lake->surface[k]));
       if (status < 0) {
         fprintf(stderr, "Error in get_sarea: record = %d, depth = %f, sarea = %e\n",0,depth,lake->surface[k]);
         return(status);
@@ -159,7 +161,7 @@ int initialize_lake (lake_var_struct   *lake,
 
     lake->sarea = lake->surface[0];
     lake->sarea_save = lake->sarea;
-    status = get_volume(lake_con, lake->ldepth, &tmp_volume);
+    status = get_volume(&lake_con, lake->ldepth, &tmp_volume);
     if (status < 0) {
       fprintf(stderr, "Error in get_volume: record = %d, depth = %f, volume = %e\n",0,depth,tmp_volume);
       return(status);
@@ -345,7 +347,25 @@ int initialize_lake (lake_var_struct   *lake,
 }
 
 
-int get_sarea(lake_con_struct lake_con, double depth, double *sarea)
+void compute_lake_volumes(lake_con_struct *lake_con)
+/******************************************************************************
+  Function to compute the lake hypsometry table: the volume of liquid water
+  in the lake when its depth is z[i], for each node i.  Between nodes, the
+  area varies linearly with depth, so the volume is quadratic in depth and
+  increases monotonically with it.  Called once per lake, by read_lakeparam().
+
+  Modifications:
+******************************************************************************/
+{
+  int i;
+
+  lake_con->volume[lake_con->numnod] = 0.0;
+  for (i=lake_con->numnod-1; i>=0; i--)
+    lake_con->volume[i] = lake_con->volume[i+1]
+      + (lake_con->basin[i] + lake_con->basin[i+1]) * (lake_con->z[i] - lake_con->z[i+1])/2.;
+}
+
+int get_sarea(lake_con_struct *lake_con, double depth, double *sarea)
 /******************************************************************************
   Function to compute surface area of liquid water in the lake, given the
   current depth of liquid water.
@@ -355,21 +375,33 @@ int get_sarea(lake_con_struct lake_con, double depth, double *sarea)
     Exit status values:
           0: No errors
       ERROR: Error: area cannot be reconciled with given lake depth and nodes
+  2026-Oct-17 Takes lake_con by reference; finds the node interval by
+	      binary search.							KM
 ******************************************************************************/
 {
-  int i;
+  int i, lo, hi;
   int status;
 
   status = 0;
   *sarea = 0.0;
 
-  if (depth > lake_con.z[0]) {
-    *sarea = lake_con.basin[0];
+  if (depth > lake_con->z[0]) {
+    *sarea = lake_con->basin[0];
   }
   else {	
-    for (i=0; i< lake_con.numnod; i++) {
-      if (depth <= lake_con.z[i] && depth > lake_con.z[i+1]) 
-	*sarea = lake_con.basin[i+1] + (depth-lake_con.z[i+1])*(lake_con.basin[i] - lake_con.basin[i+1])/(lake_con.z[i] - lake_con.z[i+1]);
+    if (depth > lake_con->z[lake_con->numnod]) {
+      // find i such that z[i] >= depth > z[i+1]
+      lo = 0;
+      hi = lake_con->numnod;
+      while (hi - lo > 1) {
+        i = (lo + hi) / 2;
+        if (depth <= lake_con->z[i])
+          lo = i;
+        else
+          hi = i;
+      }
+      i = lo;
+      *sarea = lake_con->basin[i+1] + (depth-lake_con->z[i+1])*(lake_con->basin[i] - lake_con->basin[i+1])/(lake_con->z[i] - lake_con->z[i+1]);
     }
     if (*sarea == 0.0 && depth != 0.0) {
       status = ERROR;
@@ -380,7 +412,7 @@ int get_sarea(lake_con_struct lake_con, double depth, double *sarea)
 
 }
 
-int get_volume(lake_con_struct lake_con, double depth, double *volume)
+int get_volume(lake_con_struct *lake_con, double depth, double *volume)
 /******************************************************************************
   Function to compute liquid water volume stored within the lake basin, given
   the current depth of liquid water.
@@ -391,26 +423,40 @@ int get_volume(lake_con_struct lake_con, double depth, double *volume)
           0: No errors
           1: Warning: lake depth exceeds maximum; setting to maximum
       ERROR: Error: volume cannot be reconciled with given lake depth and nodes
+  2026-Oct-17 Takes lake_con by reference; uses the volumes of
+	      compute_lake_volumes() and finds the node interval by binary
+	      search.  A depth above the maximum now gives maxvolume, as the
+	      warning says, instead of twice maxvolume.			KM
 ******************************************************************************/
 {
-  int i;
+  int i, lo, hi;
   int status;
-  double m, b;
+  double m;
 
   status = 0;
   *volume = 0.0;
 
-  if (depth > lake_con.z[0]) {
+  if (depth > lake_con->z[0]) {
     status = 1;
-    *volume = lake_con.maxvolume;
+    *volume = lake_con->maxvolume;
   }
-
-  for (i=lake_con.numnod-1; i>= 0; i--) {
-    if (depth >= lake_con.z[i]) 
-      *volume += (lake_con.basin[i] + lake_con.basin[i+1]) * (lake_con.z[i] - lake_con.z[i+1])/2.;
-    else if (depth < lake_con.z[i] && depth >= lake_con.z[i+1]) {
-      m = (lake_con.basin[i]-lake_con.basin[i+1])/(lake_con.z[i]-lake_con.z[i+1]);
-      *volume += (depth - lake_con.z[i+1])*(m*(depth - lake_con.z[i+1])/2. + lake_con.basin[i+1]);
+  else if (depth >= lake_con->z[lake_con->numnod]) {
+    // find i such that z[i] > depth >= z[i+1]
+    lo = 0;
+    hi = lake_con->numnod;
+    if (depth == lake_con->z[0])
+      *volume = lake_con->volume[0];
+    else {
+      while (hi - lo > 1) {
+        i = (lo + hi) / 2;
+        if (depth < lake_con->z[i])
+          lo = i;
+        else
+          hi = i;
+      }
+      i = lo;
+      m = (lake_con->basin[i]-lake_con->basin[i+1])/(lake_con->z[i]-lake_con->z[i+1]);
+      *volume = lake_con->volume[i+1] + (depth - lake_con->z[i+1])*(m*(depth - lake_con->z[i+1])/2. + lake_con->basin[i+1]);
     }
   }
 
@@ -422,7 +468,7 @@ int get_volume(lake_con_struct lake_con, double depth, double *volume)
 
 }
 
-int get_depth(lake_con_struct lake_con, double volume, double *depth)
+int get_depth(lake_con_struct *lake_con, double volume, double *depth)
 /******************************************************************************
   Function to compute the depth of liquid water in the lake (distance between
   surface and deepest point), given volume of liquid water currently stored in
@@ -435,9 +481,12 @@ int get_depth(lake_con_struct lake_con, double volume, double *depth)
           1: Warning: lake volume negative; setting to 0
       ERROR: Error: depth cannot be reconciled with given lake volume and nodes
   2007-Oct-30 Initialized surface area for lake bottom.				LCB via TJB
+  2026-Oct-17 Takes lake_con by reference; finds the node interval by
+	      binary search on the volumes of compute_lake_volumes(),
+	      instead of filling the layers one by one from the bottom.	KM
 ******************************************************************************/
 {
-  int k;
+  int k, lo, hi;
   int status;
   double m;
   double tempvolume;	
@@ -449,40 +498,44 @@ int get_depth(lake_con_struct lake_con, double volume, double *depth)
     status = 1;
   }
 
-  if (volume >= lake_con.maxvolume) {
-    *depth = lake_con.maxdepth;
-    *depth += (volume - lake_con.maxvolume)/lake_con.basin[0];	
+  if (volume >= lake_con->maxvolume) {
+    *depth = lake_con->maxdepth;
+    *depth += (volume - lake_con->maxvolume)/lake_con->basin[0];	
   }
   else if ( volume < SMALL ) {
     *depth = 0.0;
   }
-  else { 	
-    // Update lake depth
-    *depth = 0.0;
-    tempvolume = volume;
-    for ( k = lake_con.numnod - 1 ; k >= 0; k-- ) {
-      if ( tempvolume > ((lake_con.z[k]-lake_con.z[k+1])
-			 *(lake_con.basin[k]+lake_con.basin[k+1])/2.)) {
-	// current layer completely filled
-	tempvolume -= (lake_con.z[k]-lake_con.z[k+1])*(lake_con.basin[k]+lake_con.basin[k+1])/2.;
-	*depth += lake_con.z[k] - lake_con.z[k+1];
-      }
-      else if (tempvolume > 0.0 ) {
-        if (lake_con.basin[k]==lake_con.basin[k+1]) {
-          *depth += tempvolume/lake_con.basin[k+1];
-          tempvolume = 0.0;
-	}
-	else {
-	  m = (lake_con.basin[k]-lake_con.basin[k+1])/(lake_con.z[k] - lake_con.z[k+1]);
-	  *depth += ((-1*lake_con.basin[k+1]) + sqrt(lake_con.basin[k+1]*lake_con.basin[k+1] + 2.*m*tempvolume))/m;
-	  tempvolume = 0.0;
-	}
-      }
-    } 
-    if (tempvolume/lake_con.basin[0] > SMALL )   {                  
+  else if ( volume > lake_con->volume[0] ) {
+    // all layers filled; volume and maxvolume differ only by round-off
+    *depth = lake_con->z[0];
+    tempvolume = volume - lake_con->volume[0];
+    if (tempvolume/lake_con->basin[0] > SMALL )   {                  
       status = ERROR;
     }
   }
+  else { 	
+    // find the layer k such that volume[k] >= volume > volume[k+1]
+    lo = 0;
+    hi = lake_con->numnod;
+    while (hi - lo > 1) {
+      k = (lo + hi) / 2;
+      if (volume <= lake_con->volume[k])
+        lo = k;
+      else
+        hi = k;
+    }
+    k = lo;
+    // layers below k completely filled, layer k partially filled
+    *depth = lake_con->z[k+1];
+    tempvolume = volume - lake_con->volume[k+1];
+    if (lake_con->basin[k]==lake_con->basin[k+1]) {
+      *depth += tempvolume/lake_con->basin[k+1];
+    }
+    else {
+      m = (lake_con->basin[k]-lake_con->basin[k+1])/(lake_con->z[k] - lake_con->z[k+1]);
+      *depth += ((-1*lake_con->basin[k+1]) + sqrt(lake_con->basin[k+1]*lake_con->basin[k+1] + 2.*m*tempvolume))/m;
+    }
+  }
 
   if (*depth < 0.0 || (*depth == 0.0 && volume >= SMALL) ) {
     status = ERROR;
@@ -124,6 +124,10 @@ int initialize_model_state(all_vars_struct     *all_vars,
 	      annual average air temperature and bottom boundary
 	      temperature.											TJB
   2014-Mar-28 Removed DIST_PRCP option.							TJB
+  2026-Oct-17 Added call to set_node_layer_weights() after
+	      set_node_parameters(); node_layer passed to
+	      distribute_node_moisture_properties() and
+	      estimate_layer_ice_content().				KM
 **********************************************************************/
 {
   extern option_struct options;
@@ -504,6 +508,9 @@ int initialize_model_state(all_vars_struct     *all_vars,
 				soil_con->max_moist, soil_con->expt, 
 				soil_con->bubble, soil_con->quartz, 
 				Nnodes, options.Nlayer, soil_con->FS_ACTIVE);	  
+	    set_node_layer_weights(&soil_con->node_layer, soil_con->Zsum_node,
+				   soil_con->depth, soil_con->frost_fract,
+				   soil_con->frost_slope, Nnodes, options.Nlayer);
 	  }
 	
 	  /* set soil moisture properties for all soil thermal nodes */
@@ -511,7 +518,7 @@ int initialize_model_state(all_vars_struct     *all_vars,
 						energy[veg][band].ice,
 						energy[veg][band].kappa_node,
 						energy[veg][band].Cs_node,
-						soil_con->Zsum_node,
+						&soil_con->node_layer,
 						energy[veg][band].T,
 						soil_con->max_moist_node,
 						soil_con->expt_node,
@@ -555,7 +562,7 @@ int initialize_model_state(all_vars_struct     *all_vars,
           }
           else {
 	    ErrorFlag = estimate_layer_ice_content(cell[veg][band].layer,
-						     soil_con->Zsum_node,
+						     &soil_con->node_layer,
 						     energy[veg][band].T,
 						     soil_con->max_moist_node,
 						     soil_con->expt_node,
@@ -564,8 +571,6 @@ int initialize_model_state(all_vars_struct     *all_vars,
 						     soil_con->max_moist,
 						     soil_con->expt,
 						     soil_con->bubble,
-						     soil_con->frost_fract, 
-						     soil_con->frost_slope, 
 						     Nnodes, options.Nlayer, 
 						     soil_con->FS_ACTIVE);
           }
@@ -676,6 +681,10 @@ int update_thermal_nodes(all_vars_struct     *all_vars,
   2009-Feb-09 Removed dz_node from call to find_0_degree_front.		KAC via TJB
   2012-Jan-16 Removed LINK_DEBUG code					BN
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
+  2026-Oct-17 Added call to set_node_layer_weights() after
+	      set_node_parameters(); node_layer passed to
+	      distribute_node_moisture_properties() and
+	      estimate_layer_ice_content().				KM
 **********************************************************************/
 {
   extern option_struct options;
@@ -817,6 +826,9 @@ int update_thermal_nodes(all_vars_struct     *all_vars,
 				  soil_con->max_moist, soil_con->expt, 
 				  soil_con->bubble, soil_con->quartz, 
 				  Nnodes, options.Nlayer, soil_con->FS_ACTIVE);	  
+	    set_node_layer_weights(&soil_con->node_layer, soil_con->Zsum_node,
+				   soil_con->depth, soil_con->frost_fract,
+				   soil_con->frost_slope, Nnodes, options.Nlayer);
 	  }
 
 	  for ( lidx = 0; lidx < options.Nlayer; lidx++ ) 
@@ -828,7 +840,7 @@ int update_thermal_nodes(all_vars_struct     *all_vars,
 						  energy[veg][band].ice,
 						  energy[veg][band].kappa_node,
 						  energy[veg][band].Cs_node,
-						  soil_con->Zsum_node,
+						  &soil_con->node_layer,
 						  energy[veg][band].T,
 						  soil_con->max_moist_node,
 						  soil_con->expt_node,
@@ -859,7 +871,7 @@ int update_thermal_nodes(all_vars_struct     *all_vars,
             }
             else {
 	      ErrorFlag = estimate_layer_ice_content(cell[veg][band].layer,
-						     soil_con->Zsum_node,
+						     &soil_con->node_layer,
 						     energy[veg][band].T,
 						     soil_con->max_moist_node,
 						     soil_con->expt_node,
@@ -868,8 +880,6 @@ int update_thermal_nodes(all_vars_struct     *all_vars,
 						     soil_con->max_moist,
 						     soil_con->expt,
 						     soil_con->bubble,
-						     soil_con->frost_fract, 
-						     soil_con->frost_slope, 
 						     Nnodes, options.Nlayer, 
 						     soil_con->FS_ACTIVE);	      
 	    }
@@ -0,0 +1,898 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  kernel_capture.c	Keith Mathews			October 2026
+
+  Record/replay support for isolated physics kernels.  When the
+  KERNEL_CAPTURE option names one or more kernels, the call sites of
+  those kernels go through the capture_*() wrappers below, which write
+  the complete inputs and outputs of one out of every KERNEL_SAMPLE
+  calls (up to KERNEL_MAX calls per kernel) to the KERNEL_FILE.  The
+  replay driver (vicKernel, see kernel_replay.c) re-executes the kernel
+  on every captured input and compares the result with the captured
+  output.
+
+  Captured kernels:
+    SOLVE_T_PROFILE           explicit soil temperature profile
+    SOLVE_T_PROFILE_IMPLICIT  implicit soil temperature profile
+    SNOW_MELT                 snow pack energy and mass balance
+    BLOWING_SNOW              CalcBlowingSnow()
+    SOLVE_LAKE                lake energy balance
+
+  calc_surf_energy_bal() itself is not captured, since its inputs are a
+  graph of cell-level structures; solve_T_profile*(), which it calls on
+  every iteration, is where its time is spent.
+
+  File format (native byte order; the file can only be replayed by a
+  build with the same structure layouts):
+    header:  magic string, sizes of the captured structures, and the
+             option_struct of the run
+    records: kernel id, setup flag, number of arguments, one
+             (type, out, n) descriptor per argument, the input value of
+             every argument, then (except for setup records) the output
+             value of every argument with out = TRUE and the kernel's
+             return value
+
+  solve_T_profile() computes its finite-difference coefficients only on
+  the first call of each energy balance iteration (FIRST_SOLN[0] = TRUE)
+  and keeps them in static storage.  To make later calls replayable, the
+  inputs of the most recent first call are kept and written as a setup
+  record ahead of any captured call that depends on them; the replay
+  driver executes setup records but does not time or check them.
+
+  Modifications:
+**********************************************************************/
+
+#define KERNEL_MAGIC "VICKRN01"
+
+static char *kernel_names[N_KERNELS] = {
+  "SOLVE_T_PROFILE",
+  "SOLVE_T_PROFILE_IMPLICIT",
+  "SNOW_MELT",
+  "BLOWING_SNOW",
+  "SOLVE_LAKE",
+};
+
+static FILE   *kernel_fp = NULL;
+static long    kernel_ncalls[N_KERNELS];
+static long    kernel_nrecs[N_KERNELS];
+
+/* input section of the record being captured */
+static char   *rec_buf = NULL;
+static size_t  rec_len = 0;
+static size_t  rec_cap = 0;
+
+/* input section of the most recent solve_T_profile() setup call */
+static char   *prime_buf = NULL;
+static size_t  prime_len = 0;
+static size_t  prime_cap = 0;
+
+static void rec_put(const void *ptr, size_t size)
+{
+  if (rec_len + size > rec_cap) {
+    rec_cap = 2 * (rec_len + size);
+    rec_buf = (char *)realloc(rec_buf, rec_cap);
+    if (rec_buf == NULL)
+      nrerror("Memory allocation error in rec_put().");
+  }
+  memcpy(rec_buf + rec_len, ptr, size);
+  rec_len += size;
+}
+
+static void add_arg(kernel_arg_struct *arg, int *nargs, char type, char out,
+                    int n, void *ptr)
+{
+  if (*nargs >= MAX_KERNEL_ARGS)
+    nrerror("Too many kernel arguments; increase MAX_KERNEL_ARGS in vicNl_def.h.");
+  arg[*nargs].type = type;
+  arg[*nargs].out  = out;
+  arg[*nargs].n    = n;
+  arg[*nargs].ptr  = ptr;
+  (*nargs)++;
+}
+
+static int kernel_enabled(int kernel)
+{
+  extern option_struct options;
+
+  return (kernel_fp != NULL && (options.KERNEL_CAPTURE & (1 << kernel)));
+}
+
+static int kernel_sample(int kernel)
+/* Returns TRUE if the current call to kernel is to be captured. */
+{
+  extern option_struct options;
+
+  if (!kernel_enabled(kernel))
+    return FALSE;
+  kernel_ncalls[kernel]++;
+  if ((kernel_ncalls[kernel] - 1) % options.KERNEL_SAMPLE != 0)
+    return FALSE;
+  if (kernel_nrecs[kernel] >= options.KERNEL_MAX)
+    return FALSE;
+  return TRUE;
+}
+
+static void record_inputs(int kernel, kernel_arg_struct *arg, int nargs)
+/* Serializes the descriptors and input values of all arguments into
+   rec_buf. */
+{
+  char setup = FALSE;
+  int  i;
+
+  rec_len = 0;
+  rec_put(&kernel, sizeof(int));
+  rec_put(&setup, sizeof(char));
+  rec_put(&nargs, sizeof(int));
+  for (i = 0; i < nargs; i++) {
+    rec_put(&arg[i].type, sizeof(char));
+    rec_put(&arg[i].out, sizeof(char));
+    rec_put(&arg[i].n, sizeof(int));
+  }
+  for (i = 0; i < nargs; i++)
+    rec_put(arg[i].ptr, arg[i].n * kernel_arg_size(arg[i].type));
+}
+
+static void save_prime()
+/* Keeps the inputs in rec_buf as a setup record. */
+{
+  if (rec_len > prime_cap) {
+    prime_cap = rec_len;
+    prime_buf = (char *)realloc(prime_buf, prime_cap);
+    if (prime_buf == NULL)
+      nrerror("Memory allocation error in save_prime().");
+  }
+  memcpy(prime_buf, rec_buf, rec_len);
+  prime_buf[sizeof(int)] = TRUE;
+  prime_len = rec_len;
+}
+
+static void write_record(int kernel, kernel_arg_struct *arg, int nargs,
+                         double ret, int primed)
+/* Writes the record in rec_buf (preceded by the setup record if the call
+   depends on it), followed by the output values and return value. */
+{
+  int i;
+
+  if (primed && prime_len > 0)
+    fwrite(prime_buf, 1, prime_len, kernel_fp);
+  fwrite(rec_buf, 1, rec_len, kernel_fp);
+  for (i = 0; i < nargs; i++)
+    if (arg[i].out)
+      fwrite(arg[i].ptr, kernel_arg_size(arg[i].type), arg[i].n, kernel_fp);
+  fwrite(&ret, sizeof(double), 1, kernel_fp);
+  kernel_nrecs[kernel]++;
+}
+
+int kernel_arg_size(int type)
+/**********************************************************************
+  kernel_arg_size	Keith Mathews			October 2026
+
+  Returns the size in bytes of one element of a kernel argument of the
+  given type, or 0 if the type is unknown.
+
+  Modifications:
+**********************************************************************/
+{
+  switch (type) {
+  case KARG_DOUBLE:   return sizeof(double);
+  case KARG_FLOAT:    return sizeof(float);
+  case KARG_INT:      return sizeof(int);
+  case KARG_CHAR:     return sizeof(char);
+  case KARG_SNOW:     return sizeof(snow_data_struct);
+  case KARG_LAKE:     return sizeof(lake_var_struct);
+  case KARG_LAKE_CON: return sizeof(lake_con_struct);
+  case KARG_SOIL_CON: return sizeof(soil_con_struct);
+  case KARG_DMY:      return sizeof(dmy_struct);
+  }
+  return 0;
+}
+
+char *kernel_name(int kernel)
+/**********************************************************************
+  kernel_name		Keith Mathews			October 2026
+
+  Returns the name of a captured kernel, as used in the global
+  parameter file.
+
+  Modifications:
+**********************************************************************/
+{
+  if (kernel < 0 || kernel >= N_KERNELS)
+    return "UNKNOWN";
+  return kernel_names[kernel];
+}
+
+int kernel_id(char *name)
+/**********************************************************************
+  kernel_id		Keith Mathews			October 2026
+
+  Returns the id of the kernel with the given name, or -1 if there is
+  no such kernel.
+
+  Modifications:
+**********************************************************************/
+{
+  int kernel;
+
+  for (kernel = 0; kernel < N_KERNELS; kernel++)
+    if (strcasecmp(name, kernel_names[kernel]) == 0)
+      return kernel;
+  return -1;
+}
+
+void kernel_capture_init(filenames_struct *names)
+/**********************************************************************
+  kernel_capture_init	Keith Mathews			October 2026
+
+  Opens the KERNEL_FILE and writes its header, if any kernels are to be
+  captured.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int kernel;
+  int sizes[6];
+
+  for (kernel = 0; kernel < N_KERNELS; kernel++) {
+    kernel_ncalls[kernel] = 0;
+    kernel_nrecs[kernel] = 0;
+  }
+  prime_len = 0;
+
+  if (!options.KERNEL_CAPTURE)
+    return;
+
+  kernel_fp = open_file(names->kernel, "wb");
+  sizes[0] = sizeof(option_struct);
+  sizes[1] = sizeof(snow_data_struct);
+  sizes[2] = sizeof(lake_var_struct);
+  sizes[3] = sizeof(lake_con_struct);
+  sizes[4] = sizeof(soil_con_struct);
+  sizes[5] = sizeof(dmy_struct);
+  fwrite(KERNEL_MAGIC, 1, strlen(KERNEL_MAGIC), kernel_fp);
+  fwrite(sizes, sizeof(int), 6, kernel_fp);
+  fwrite(&options, sizeof(option_struct), 1, kernel_fp);
+}
+
+void kernel_capture_close()
+/**********************************************************************
+  kernel_capture_close	Keith Mathews			October 2026
+
+  Reports the number of captured records per kernel and closes the
+  KERNEL_FILE.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int kernel;
+
+  if (kernel_fp == NULL)
+    return;
+
+  fprintf(stderr, "Kernel capture:\n");
+  for (kernel = 0; kernel < N_KERNELS; kernel++)
+    if (options.KERNEL_CAPTURE & (1 << kernel))
+      fprintf(stderr, "  %-26s %10ld calls %8ld captured\n",
+              kernel_names[kernel], kernel_ncalls[kernel],
+              kernel_nrecs[kernel]);
+  fclose(kernel_fp);
+  kernel_fp = NULL;
+  free(rec_buf);
+  free(prime_buf);
+  rec_buf = prime_buf = NULL;
+  rec_cap = prime_cap = 0;
+}
+
+int kernel_read_header(FILE *fp)
+/**********************************************************************
+  kernel_read_header	Keith Mathews			October 2026
+
+  Reads the header of a kernel capture file and restores the options
+  of the run that wrote it.  Returns ERROR if the file was not written
+  by a build with the same structure layouts.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  char magic[9];
+  int  sizes[6];
+
+  magic[8] = '\0';
+  if (fread(magic, 1, 8, fp) != 8 || strcmp(magic, KERNEL_MAGIC) != 0)
+    return ERROR;
+  if (fread(sizes, sizeof(int), 6, fp) != 6)
+    return ERROR;
+  if (sizes[0] != sizeof(option_struct)
+      || sizes[1] != sizeof(snow_data_struct)
+      || sizes[2] != sizeof(lake_var_struct)
+      || sizes[3] != sizeof(lake_con_struct)
+      || sizes[4] != sizeof(soil_con_struct)
+      || sizes[5] != sizeof(dmy_struct))
+    return ERROR;
+  if (fread(&options, sizeof(option_struct), 1, fp) != 1)
+    return ERROR;
+  return 0;
+}
+
+int kernel_read_record(FILE              *fp,
+                       int               *kernel,
+                       char              *setup,
+                       int               *nargs,
+                       kernel_arg_struct *arg,
+                       void             **ref,
+                       double            *ret)
+/**********************************************************************
+  kernel_read_record	Keith Mathews			October 2026
+
+  Reads the next record of a kernel capture file.  Input values are
+  returned in newly allocated arg[i].ptr; captured output values of
+  arguments with out = TRUE are returned in newly allocated ref[i]
+  (NULL otherwise, and for setup records).  Pointers inside captured
+  soil_con_struct arguments are set to NULL, since they are not valid
+  in this process.  Returns 1 on success, 0 at end of file, and ERROR
+  if the file is truncated or corrupt.
+
+  Modifications:
+**********************************************************************/
+{
+  int     i;
+  size_t  size;
+  soil_con_struct *soil_con;
+
+  if (fread(kernel, sizeof(int), 1, fp) != 1)
+    return 0;
+  if (fread(setup, sizeof(char), 1, fp) != 1
+      || fread(nargs, sizeof(int), 1, fp) != 1)
+    return ERROR;
+  if (*kernel < 0 || *kernel >= N_KERNELS
+      || *nargs < 0 || *nargs > MAX_KERNEL_ARGS)
+    return ERROR;
+  for (i = 0; i < *nargs; i++) {
+    if (fread(&arg[i].type, sizeof(char), 1, fp) != 1
+        || fread(&arg[i].out, sizeof(char), 1, fp) != 1
+        || fread(&arg[i].n, sizeof(int), 1, fp) != 1)
+      return ERROR;
+    if (kernel_arg_size(arg[i].type) == 0 || arg[i].n < 0)
+      return ERROR;
+    arg[i].ptr = NULL;
+    ref[i] = NULL;
+  }
+  for (i = 0; i < *nargs; i++) {
+    size = arg[i].n * kernel_arg_size(arg[i].type);
+    arg[i].ptr = malloc(size > 0 ? size : 1);
+    if (fread(arg[i].ptr, 1, size, fp) != size)
+      return ERROR;
+    if (arg[i].type == KARG_SOIL_CON) {
+      soil_con = (soil_con_struct *)arg[i].ptr;
+      soil_con->BandElev = NULL;
+      soil_con->AreaFract = NULL;
+      soil_con->Pfactor = NULL;
+      soil_con->Tfactor = NULL;
+      soil_con->AboveTreeLine = NULL;
+      soil_con->layer_node_fract = NULL;
+    }
+  }
+  if (*setup)
+    return 1;
+  for (i = 0; i < *nargs; i++) {
+    if (!arg[i].out)
+      continue;
+    size = arg[i].n * kernel_arg_size(arg[i].type);
+    ref[i] = malloc(size > 0 ? size : 1);
+    if (fread(ref[i], 1, size, fp) != size)
+      return ERROR;
+  }
+  if (fread(ret, sizeof(double), 1, fp) != 1)
+    return ERROR;
+  return 1;
+}
+
+double kernel_invoke(int kernel, kernel_arg_struct *arg)
+/**********************************************************************
+  kernel_invoke		Keith Mathews			October 2026
+
+  Calls a kernel with the arguments described by arg, which must be in
+  the order in which the capture_*() wrappers below list them.
+
+  Modifications:
+**********************************************************************/
+{
+#define D(i) ((double *)arg[i].ptr)
+#define F(i) ((float *)arg[i].ptr)
+#define I(i) ((int *)arg[i].ptr)
+#define C(i) ((char *)arg[i].ptr)
+
+  switch (kernel) {
+  case KERNEL_T_PROFILE:
+    return (double)solve_T_profile(D(0), D(1), C(2), I(3), D(4), D(5), D(6),
+                                   D(7), *D(8), D(9), D(10), D(11), D(12),
+                                   D(13), D(14), D(15), *D(16), D(17),
+                                   *I(18), I(19), *I(20), *I(21), *I(22),
+                                   *I(23));
+  case KERNEL_T_PROFILE_IMPLICIT:
+    return (double)solve_T_profile_implicit(D(0), D(1), C(2), I(3), D(4),
+                                            D(5), D(6), D(7), *D(8), D(9),
+                                            D(10), D(11), D(12), D(13), D(14),
+                                            D(15), *D(16), *I(17), I(18),
+                                            *I(19), *I(20), *I(21), *I(22),
+                                            D(23), D(24), D(25), D(26), D(27),
+                                            D(28), D(29));
+  case KERNEL_SNOW_MELT:
+    return (double)snow_melt(*D(0), *D(1), *D(2), *D(3), D(4), *D(5), D(6),
+                             *D(7), *D(8), *D(9), *D(10), *D(11), *D(12),
+                             *D(13), *D(14), *D(15), *D(16), *D(17), *D(18),
+                             *D(19), *D(20), D(21), D(22), D(23), D(24),
+                             D(25), D(26), D(27), D(28), D(29), D(30), D(31),
+                             D(32), *I(33), *I(34), *I(35), *I(36),
+                             (snow_data_struct *)arg[37].ptr,
+                             (soil_con_struct *)arg[38].ptr);
+  case KERNEL_BLOWING_SNOW:
+    return CalcBlowingSnow(*D(0), *D(1), *I(2), *D(3), *D(4), *D(5), *D(6),
+                           *D(7), *D(8), *D(9), *D(10), *D(11), *F(12),
+                           *F(13), *D(14), *I(15), *I(16), *F(17), *D(18),
+                           *D(19), D(20));
+  case KERNEL_SOLVE_LAKE:
+    return (double)solve_lake(*D(0), *D(1), *D(2), *D(3), *D(4), *D(5),
+                              *D(6), *D(7), *D(8), *D(9),
+                              (lake_var_struct *)arg[10].ptr,
+                              *(lake_con_struct *)arg[11].ptr,
+                              *(soil_con_struct *)arg[12].ptr, *I(13),
+                              *I(14), *D(15), *(dmy_struct *)arg[16].ptr,
+                              *D(17));
+  }
+  return (double)ERROR;
+
+#undef D
+#undef F
+#undef I
+#undef C
+}
+
+int capture_solve_T_profile(double *T,
+                            double *T0,
+                            char   *Tfbflag,
+                            int    *Tfbcount,
+                            double *Zsum,
+                            double *kappa,
+                            double *Cs,
+                            double *moist,
+                            double  deltat,
+                            double *max_moist,
+                            double *bubble,
+                            double *expt,
+                            double *ice,
+                            double *alpha,
+                            double *beta,
+                            double *gamma,
+                            double  Dp,
+                            double *depth,
+                            int     Nnodes,
+                            int    *FIRST_SOLN,
+                            int     FS_ACTIVE,
+                            int     NOFLUX,
+                            int     EXP_TRANS,
+                            int     veg_class)
+/**********************************************************************
+  capture_solve_T_profile	Keith Mathews		October 2026
+
+  Calls solve_T_profile(), capturing its inputs and outputs if
+  required.  Calls that compute the finite-difference coefficients
+  (FIRST_SOLN[0] = TRUE) are kept as setup records for later calls.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  kernel_arg_struct arg[MAX_KERNEL_ARGS];
+  int  nargs = 0;
+  int  capture;
+  int  prime;
+  int  primed;
+  int  ret;
+
+  capture = kernel_sample(KERNEL_T_PROFILE);
+  prime = FIRST_SOLN[0] && kernel_enabled(KERNEL_T_PROFILE);
+  if (!capture && !prime)
+    return solve_T_profile(T, T0, Tfbflag, Tfbcount, Zsum, kappa, Cs, moist,
+                           deltat, max_moist, bubble, expt, ice, alpha, beta,
+                           gamma, Dp, depth, Nnodes, FIRST_SOLN, FS_ACTIVE,
+                           NOFLUX, EXP_TRANS, veg_class);
+
+  add_arg(arg, &nargs, KARG_DOUBLE, TRUE,  Nnodes, T);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes, T0);
+  add_arg(arg, &nargs, KARG_CHAR,   TRUE,  Nnodes, Tfbflag);
+  add_arg(arg, &nargs, KARG_INT,    TRUE,  Nnodes, Tfbcount);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes, Zsum);
+  add_arg(arg, &nargs, KARG_DOUBLE, TRUE,  Nnodes, kappa);
+  add_arg(arg, &nargs, KARG_DOUBLE, TRUE,  Nnodes, Cs);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes, moist);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1,      &deltat);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes, max_moist);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes, bubble);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes, expt);
+  add_arg(arg, &nargs, KARG_DOUBLE, TRUE,  Nnodes, ice);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes, alpha);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes, beta);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes, gamma);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1,      &Dp);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, options.Nlayer, depth);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,      &Nnodes);
+  add_arg(arg, &nargs, KARG_INT,    TRUE,  2,      FIRST_SOLN);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,      &FS_ACTIVE);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,      &NOFLUX);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,      &EXP_TRANS);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,      &veg_class);
+
+  record_inputs(KERNEL_T_PROFILE, arg, nargs);
+  primed = !FIRST_SOLN[0];
+  if (prime)
+    save_prime();
+
+  ret = solve_T_profile(T, T0, Tfbflag, Tfbcount, Zsum, kappa, Cs, moist,
+                        deltat, max_moist, bubble, expt, ice, alpha, beta,
+                        gamma, Dp, depth, Nnodes, FIRST_SOLN, FS_ACTIVE,
+                        NOFLUX, EXP_TRANS, veg_class);
+
+  if (capture)
+    write_record(KERNEL_T_PROFILE, arg, nargs, (double)ret, primed);
+  return ret;
+}
+
+int capture_solve_T_profile_implicit(double *T,
+                                     double *T0,
+                                     char   *Tfbflag,
+                                     int    *Tfbcount,
+                                     double *Zsum,
+                                     double *kappa,
+                                     double *Cs,
+                                     double *moist,
+                                     double  deltat,
+                                     double *max_moist,
+                                     double *bubble,
+                                     double *expt,
+                                     double *ice,
+                                     double *alpha,
+                                     double *beta,
+                                     double *gamma,
+                                     double  Dp,
+                                     int     Nnodes,
+                                     int    *FIRST_SOLN,
+                                     int     FS_ACTIVE,
+                                     int     NOFLUX,
+                                     int     EXP_TRANS,
+                                     int     veg_class,
+                                     double *bulk_dens_min,
+                                     double *soil_dens_min,
+                                     double *quartz,
+                                     double *bulk_density,
+                                     double *soil_density,
+                                     double *organic,
+                                     double *depth)
+/**********************************************************************
+  capture_solve_T_profile_implicit	Keith Mathews	October 2026
+
+  Calls solve_T_profile_implicit(), capturing its inputs and outputs if
+  required.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  kernel_arg_struct arg[MAX_KERNEL_ARGS];
+  int  nargs = 0;
+  int  Nlayers = options.Nlayer;
+  int  ret;
+
+  if (!kernel_sample(KERNEL_T_PROFILE_IMPLICIT))
+    return solve_T_profile_implicit(T, T0, Tfbflag, Tfbcount, Zsum, kappa,
+                                    Cs, moist, deltat, max_moist, bubble,
+                                    expt, ice, alpha, beta, gamma, Dp, Nnodes,
+                                    FIRST_SOLN, FS_ACTIVE, NOFLUX, EXP_TRANS,
+                                    veg_class, bulk_dens_min, soil_dens_min,
+                                    quartz, bulk_density, soil_density,
+                                    organic, depth);
+
+  add_arg(arg, &nargs, KARG_DOUBLE, TRUE,  Nnodes,  T);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes,  T0);
+  add_arg(arg, &nargs, KARG_CHAR,   TRUE,  Nnodes,  Tfbflag);
+  add_arg(arg, &nargs, KARG_INT,    TRUE,  Nnodes,  Tfbcount);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes,  Zsum);
+  add_arg(arg, &nargs, KARG_DOUBLE, TRUE,  Nnodes,  kappa);
+  add_arg(arg, &nargs, KARG_DOUBLE, TRUE,  Nnodes,  Cs);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes,  moist);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1,       &deltat);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes,  max_moist);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes,  bubble);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes,  expt);
+  add_arg(arg, &nargs, KARG_DOUBLE, TRUE,  Nnodes,  ice);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes,  alpha);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes,  beta);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nnodes,  gamma);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1,       &Dp);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,       &Nnodes);
+  add_arg(arg, &nargs, KARG_INT,    TRUE,  2,       FIRST_SOLN);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,       &FS_ACTIVE);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,       &NOFLUX);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,       &EXP_TRANS);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1,       &veg_class);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nlayers, bulk_dens_min);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nlayers, soil_dens_min);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nlayers, quartz);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nlayers, bulk_density);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nlayers, soil_density);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nlayers, organic);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, Nlayers, depth);
+
+  record_inputs(KERNEL_T_PROFILE_IMPLICIT, arg, nargs);
+
+  ret = solve_T_profile_implicit(T, T0, Tfbflag, Tfbcount, Zsum, kappa, Cs,
+                                 moist, deltat, max_moist, bubble, expt, ice,
+                                 alpha, beta, gamma, Dp, Nnodes, FIRST_SOLN,
+                                 FS_ACTIVE, NOFLUX, EXP_TRANS, veg_class,
+                                 bulk_dens_min, soil_dens_min, quartz,
+                                 bulk_density, soil_density, organic, depth);
+
+  write_record(KERNEL_T_PROFILE_IMPLICIT, arg, nargs, (double)ret, FALSE);
+  return ret;
+}
+
+int capture_snow_melt(double            Le,
+                      double            NetShortSnow,
+                      double            Tcanopy,
+                      double            Tgrnd,
+                      double           *Z0,
+                      double            aero_resist,
+                      double           *aero_resist_used,
+                      double            air_temp,
+                      double            coverage,
+                      double            delta_t,
+                      double            density,
+                      double            displacement,
+                      double            grnd_flux,
+                      double            LongSnowIn,
+                      double            pressure,
+                      double            rainfall,
+                      double            snowfall,
+                      double            vp,
+                      double            vpd,
+                      double            wind,
+                      double            z2,
+                      double           *NetLongSnow,
+                      double           *OldTSurf,
+                      double           *melt,
+                      double           *save_Qnet,
+                      double           *save_advected_sensible,
+                      double           *save_advection,
+                      double           *save_deltaCC,
+                      double           *save_grnd_flux,
+                      double           *save_latent,
+                      double           *save_latent_sub,
+                      double           *save_refreeze_energy,
+                      double           *save_sensible,
+                      int               UNSTABLE_SNOW,
+                      int               rec,
+                      int               iveg,
+                      int               band,
+                      snow_data_struct *snow,
+                      soil_con_struct  *soil_con)
+/**********************************************************************
+  capture_snow_melt	Keith Mathews			October 2026
+
+  Calls snow_melt(), capturing its inputs and outputs if required.
+
+  Modifications:
+**********************************************************************/
+{
+  kernel_arg_struct arg[MAX_KERNEL_ARGS];
+  int  nargs = 0;
+  int  ret;
+
+  if (!kernel_sample(KERNEL_SNOW_MELT))
+    return snow_melt(Le, NetShortSnow, Tcanopy, Tgrnd, Z0, aero_resist,
+                     aero_resist_used, air_temp, coverage, delta_t, density,
+                     displacement, grnd_flux, LongSnowIn, pressure, rainfall,
+                     snowfall, vp, vpd, wind, z2, NetLongSnow, OldTSurf, melt,
+                     save_Qnet, save_advected_sensible, save_advection,
+                     save_deltaCC, save_grnd_flux, save_latent,
+                     save_latent_sub, save_refreeze_energy, save_sensible,
+                     UNSTABLE_SNOW, rec, iveg, band, snow, soil_con);
+
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &Le);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &NetShortSnow);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &Tcanopy);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &Tgrnd);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 3, Z0);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &aero_resist);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, aero_resist_used);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &air_temp);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &coverage);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &delta_t);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &density);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &displacement);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &grnd_flux);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &LongSnowIn);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &pressure);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &rainfall);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &snowfall);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &vp);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &vpd);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &wind);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &z2);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, NetLongSnow);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, OldTSurf);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, melt);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, save_Qnet);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, save_advected_sensible);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, save_advection);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, save_deltaCC);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, save_grnd_flux);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, save_latent);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, save_latent_sub);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, save_refreeze_energy);
+  add_arg(arg, &nargs, KARG_DOUBLE,   TRUE,  1, save_sensible);
+  add_arg(arg, &nargs, KARG_INT,      FALSE, 1, &UNSTABLE_SNOW);
+  add_arg(arg, &nargs, KARG_INT,      FALSE, 1, &rec);
+  add_arg(arg, &nargs, KARG_INT,      FALSE, 1, &iveg);
+  add_arg(arg, &nargs, KARG_INT,      FALSE, 1, &band);
+  add_arg(arg, &nargs, KARG_SNOW,     TRUE,  1, snow);
+  add_arg(arg, &nargs, KARG_SOIL_CON, FALSE, 1, soil_con);
+
+  record_inputs(KERNEL_SNOW_MELT, arg, nargs);
+
+  ret = snow_melt(Le, NetShortSnow, Tcanopy, Tgrnd, Z0, aero_resist,
+                  aero_resist_used, air_temp, coverage, delta_t, density,
+                  displacement, grnd_flux, LongSnowIn, pressure, rainfall,
+                  snowfall, vp, vpd, wind, z2, NetLongSnow, OldTSurf, melt,
+                  save_Qnet, save_advected_sensible, save_advection,
+                  save_deltaCC, save_grnd_flux, save_latent, save_latent_sub,
+                  save_refreeze_energy, save_sensible, UNSTABLE_SNOW, rec,
+                  iveg, band, snow, soil_con);
+
+  write_record(KERNEL_SNOW_MELT, arg, nargs, (double)ret, FALSE);
+  return ret;
+}
+
+double capture_CalcBlowingSnow(double  Dt,
+                               double  Tair,
+                               int     LastSnow,
+                               double  SurfaceLiquidWater,
+                               double  Wind,
+                               double  Ls,
+                               double  AirDens,
+                               double  Press,
+                               double  EactAir,
+                               double  ZO,
+                               double  Zrh,
+                               double  snowdepth,
+                               float   lag_one,
+                               float   sigma_slope,
+                               double  Tsnow,
+                               int     iveg,
+                               int     Nveg,
+                               float   fe,
+                               double  displacement,
+                               double  roughness,
+                               double *TotalTransport)
+/**********************************************************************
+  capture_CalcBlowingSnow	Keith Mathews		October 2026
+
+  Calls CalcBlowingSnow(), capturing its inputs and outputs if required.
+
+  Modifications:
+**********************************************************************/
+{
+  kernel_arg_struct arg[MAX_KERNEL_ARGS];
+  int    nargs = 0;
+  double ret;
+
+  if (!kernel_sample(KERNEL_BLOWING_SNOW))
+    return CalcBlowingSnow(Dt, Tair, LastSnow, SurfaceLiquidWater, Wind, Ls,
+                           AirDens, Press, EactAir, ZO, Zrh, snowdepth,
+                           lag_one, sigma_slope, Tsnow, iveg, Nveg, fe,
+                           displacement, roughness, TotalTransport);
+
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &Dt);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &Tair);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1, &LastSnow);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &SurfaceLiquidWater);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &Wind);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &Ls);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &AirDens);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &Press);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &EactAir);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &ZO);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &Zrh);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &snowdepth);
+  add_arg(arg, &nargs, KARG_FLOAT,  FALSE, 1, &lag_one);
+  add_arg(arg, &nargs, KARG_FLOAT,  FALSE, 1, &sigma_slope);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &Tsnow);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1, &iveg);
+  add_arg(arg, &nargs, KARG_INT,    FALSE, 1, &Nveg);
+  add_arg(arg, &nargs, KARG_FLOAT,  FALSE, 1, &fe);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &displacement);
+  add_arg(arg, &nargs, KARG_DOUBLE, FALSE, 1, &roughness);
+  add_arg(arg, &nargs, KARG_DOUBLE, TRUE,  1, TotalTransport);
+
+  record_inputs(KERNEL_BLOWING_SNOW, arg, nargs);
+
+  ret = CalcBlowingSnow(Dt, Tair, LastSnow, SurfaceLiquidWater, Wind, Ls,
+                        AirDens, Press, EactAir, ZO, Zrh, snowdepth, lag_one,
+                        sigma_slope, Tsnow, iveg, Nveg, fe, displacement,
+                        roughness, TotalTransport);
+
+  write_record(KERNEL_BLOWING_SNOW, arg, nargs, ret, FALSE);
+  return ret;
+}
+
+int capture_solve_lake(double           snowfall,
+                       double           rainfall,
+                       double           tair,
+                       double           wind,
+                       double           vp,
+                       double           shortin,
+                       double           longin,
+                       double           vpd,
+                       double           pressure,
+                       double           air_density,
+                       lake_var_struct *lake,
+                       lake_con_struct  lake_con,
+                       soil_con_struct  soil_con,
+                       int              dt,
+                       int              rec,
+                       double           wind_h,
+                       dmy_struct       dmy,
+                       double           fracprv)
+/**********************************************************************
+  capture_solve_lake	Keith Mathews			October 2026
+
+  Calls solve_lake(), capturing its inputs and outputs if required.
+
+  Modifications:
+**********************************************************************/
+{
+  kernel_arg_struct arg[MAX_KERNEL_ARGS];
+  int  nargs = 0;
+  int  ret;
+
+  if (!kernel_sample(KERNEL_SOLVE_LAKE))
+    return solve_lake(snowfall, rainfall, tair, wind, vp, shortin, longin,
+                      vpd, pressure, air_density, lake, lake_con, soil_con,
+                      dt, rec, wind_h, dmy, fracprv);
+
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &snowfall);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &rainfall);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &tair);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &wind);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &vp);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &shortin);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &longin);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &vpd);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &pressure);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &air_density);
+  add_arg(arg, &nargs, KARG_LAKE,     TRUE,  1, lake);
+  add_arg(arg, &nargs, KARG_LAKE_CON, FALSE, 1, &lake_con);
+  add_arg(arg, &nargs, KARG_SOIL_CON, FALSE, 1, &soil_con);
+  add_arg(arg, &nargs, KARG_INT,      FALSE, 1, &dt);
+  add_arg(arg, &nargs, KARG_INT,      FALSE, 1, &rec);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &wind_h);
+  add_arg(arg, &nargs, KARG_DMY,      FALSE, 1, &dmy);
+  add_arg(arg, &nargs, KARG_DOUBLE,   FALSE, 1, &fracprv);
+
+  record_inputs(KERNEL_SOLVE_LAKE, arg, nargs);
+
+  ret = solve_lake(snowfall, rainfall, tair, wind, vp, shortin, longin, vpd,
+                   pressure, air_density, lake, lake_con, soil_con, dt, rec,
+                   wind_h, dmy, fracprv);
+
+  write_record(KERNEL_SOLVE_LAKE, arg, nargs, (double)ret, FALSE);
+  return ret;
+}
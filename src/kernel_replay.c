@@ -0,0 +1,505 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <vicNl.h>
+#include <global.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  kernel_replay.c	Keith Mathews			October 2026
+
+  Replay driver for kernel capture files written by vicNl with the
+  KERNEL_CAPTURE option (see kernel_capture.c).  Every captured call is
+  re-executed from its captured inputs, optionally several times for
+  timing, and the outputs and return value are compared with the
+  captured ones, either bit for bit (default) or within a relative
+  tolerance.  Output structures are compared field by field.
+
+  The options of the run that wrote the file are restored before any
+  kernel is called, so the driver needs no global parameter file.
+
+  Usage:
+    vicKernel -f <capture_file> [-k <kernel>] [-r <repeat>] [-t <tol>] [-v]
+
+    -f  kernel capture file
+    -k  replay only this kernel (e.g. SOLVE_T_PROFILE_IMPLICIT)
+    -r  number of times to execute each captured call (default 1)
+    -t  relative tolerance for floating point outputs; values a and b
+        match if |a - b| <= tol * max(1, |b|).  Default: bit for bit.
+    -v  describe every mismatch
+
+  The exit status is 0 if all outputs match and 1 otherwise.
+
+  Modifications:
+**********************************************************************/
+
+#define KARG_NESTED -1
+
+typedef struct kernel_field {
+  char                *name;   /* field name */
+  int                  type;   /* KARG_DOUBLE, etc., or KARG_NESTED */
+  int                  n;      /* number of elements */
+  size_t               offset; /* offset of field within structure */
+  size_t               size;   /* size of one element */
+  struct kernel_field *sub;    /* fields of a nested structure */
+} kernel_field_struct;
+
+#define FIELD(s, f, t, n) \
+  { #f, t, n, offsetof(s, f), sizeof(((s *)0)->f) / (n), NULL }
+#define NESTED(s, f, t, n, sub) \
+  { #f, KARG_NESTED, n, offsetof(s, f), sizeof(t), sub }
+
+static kernel_field_struct layer_fields[] = {
+  FIELD(layer_data_struct, Cs, KARG_DOUBLE, 1),
+  FIELD(layer_data_struct, T, KARG_DOUBLE, 1),
+  FIELD(layer_data_struct, bare_evap_frac, KARG_DOUBLE, 1),
+  FIELD(layer_data_struct, evap, KARG_DOUBLE, 1),
+  FIELD(layer_data_struct, ice, KARG_DOUBLE, MAX_FROST_AREAS),
+  FIELD(layer_data_struct, kappa, KARG_DOUBLE, 1),
+  FIELD(layer_data_struct, moist, KARG_DOUBLE, 1),
+  FIELD(layer_data_struct, phi, KARG_DOUBLE, 1),
+  FIELD(layer_data_struct, zwt, KARG_DOUBLE, 1),
+  { NULL }
+};
+
+static kernel_field_struct cell_fields[] = {
+  FIELD(cell_data_struct, aero_resist, KARG_DOUBLE, 2),
+  FIELD(cell_data_struct, asat, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, baseflow, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, CLitter, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, CInter, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, CSlow, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, inflow, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, pot_evap, KARG_DOUBLE, N_PET_TYPES),
+  FIELD(cell_data_struct, runoff, KARG_DOUBLE, 1),
+  NESTED(cell_data_struct, layer, layer_data_struct, MAX_LAYERS, layer_fields),
+  FIELD(cell_data_struct, RhLitter, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, RhLitter2Atm, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, RhInter, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, RhSlow, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, RhTot, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, rootmoist, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, wetness, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, zwt, KARG_DOUBLE, 1),
+  FIELD(cell_data_struct, zwt_lumped, KARG_DOUBLE, 1),
+  { NULL }
+};
+
+static kernel_field_struct energy_fields[] = {
+  FIELD(energy_bal_struct, AlbedoLake, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, AlbedoOver, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, AlbedoUnder, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, Cs, KARG_DOUBLE, 2),
+  FIELD(energy_bal_struct, Cs_node, KARG_DOUBLE, MAX_NODES),
+  FIELD(energy_bal_struct, fdepth, KARG_DOUBLE, MAX_FRONTS),
+  FIELD(energy_bal_struct, frozen, KARG_CHAR, 1),
+  FIELD(energy_bal_struct, ice, KARG_DOUBLE, MAX_NODES),
+  FIELD(energy_bal_struct, kappa, KARG_DOUBLE, 2),
+  FIELD(energy_bal_struct, kappa_node, KARG_DOUBLE, MAX_NODES),
+  FIELD(energy_bal_struct, moist, KARG_DOUBLE, MAX_NODES),
+  FIELD(energy_bal_struct, Nfrost, KARG_INT, 1),
+  FIELD(energy_bal_struct, Nthaw, KARG_INT, 1),
+  FIELD(energy_bal_struct, T, KARG_DOUBLE, MAX_NODES),
+  FIELD(energy_bal_struct, T_fbflag, KARG_CHAR, MAX_NODES),
+  FIELD(energy_bal_struct, T_fbcount, KARG_INT, MAX_NODES),
+  FIELD(energy_bal_struct, T1_index, KARG_INT, 1),
+  FIELD(energy_bal_struct, Tcanopy, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, Tcanopy_fbflag, KARG_CHAR, 1),
+  FIELD(energy_bal_struct, Tcanopy_fbcount, KARG_INT, 1),
+  FIELD(energy_bal_struct, tdepth, KARG_DOUBLE, MAX_FRONTS),
+  FIELD(energy_bal_struct, Tfoliage, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, Tfoliage_fbflag, KARG_CHAR, 1),
+  FIELD(energy_bal_struct, Tfoliage_fbcount, KARG_INT, 1),
+  FIELD(energy_bal_struct, Tsurf, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, Tsurf_fbflag, KARG_CHAR, 1),
+  FIELD(energy_bal_struct, Tsurf_fbcount, KARG_INT, 1),
+  FIELD(energy_bal_struct, unfrozen, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, advected_sensible, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, advection, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, AtmosError, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, AtmosLatent, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, AtmosLatentSub, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, AtmosSensible, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, canopy_advection, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, canopy_latent, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, canopy_latent_sub, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, canopy_refreeze, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, canopy_sensible, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, deltaCC, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, deltaH, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, error, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, fusion, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, grnd_flux, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, latent, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, latent_sub, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, longwave, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, LongOverIn, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, LongUnderIn, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, LongUnderOut, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, melt_energy, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, NetLongAtmos, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, NetLongOver, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, NetLongUnder, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, NetShortAtmos, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, NetShortGrnd, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, NetShortOver, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, NetShortUnder, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, out_long_canopy, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, out_long_surface, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, refreeze_energy, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, sensible, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, shortwave, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, ShortOverIn, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, ShortUnderIn, KARG_DOUBLE, 1),
+  FIELD(energy_bal_struct, snow_flux, KARG_DOUBLE, 1),
+  { NULL }
+};
+
+static kernel_field_struct snow_fields[] = {
+  FIELD(snow_data_struct, albedo, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, canopy_albedo, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, coldcontent, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, coverage, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, density, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, depth, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, last_snow, KARG_INT, 1),
+  FIELD(snow_data_struct, max_snow_depth, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, MELTING, KARG_CHAR, 1),
+  FIELD(snow_data_struct, pack_temp, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, pack_water, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, snow, KARG_INT, 1),
+  FIELD(snow_data_struct, snow_canopy, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, store_coverage, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, store_snow, KARG_INT, 1),
+  FIELD(snow_data_struct, store_swq, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, surf_temp, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, surf_temp_fbcount, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, surf_temp_fbflag, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, surf_water, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, swq, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, snow_distrib_slope, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, tmp_int_storage, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, blowing_flux, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, canopy_vapor_flux, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, mass_error, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, melt, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, Qnet, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, surface_flux, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, transport, KARG_DOUBLE, 1),
+  FIELD(snow_data_struct, vapor_flux, KARG_DOUBLE, 1),
+  { NULL }
+};
+
+static kernel_field_struct lake_fields[] = {
+  FIELD(lake_var_struct, activenod, KARG_INT, 1),
+  FIELD(lake_var_struct, dz, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, surfdz, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, ldepth, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, surface, KARG_DOUBLE, MAX_LAKE_NODES+1),
+  FIELD(lake_var_struct, sarea, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, sarea_save, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, volume, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, volume_save, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, temp, KARG_DOUBLE, MAX_LAKE_NODES),
+  FIELD(lake_var_struct, tempavg, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, areai, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, new_ice_area, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, ice_water_eq, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, hice, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, tempi, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, swe, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, swe_save, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, surf_temp, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, pack_temp, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, coldcontent, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, surf_water, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, pack_water, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, SAlbedo, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, sdepth, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, aero_resist, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, density, KARG_DOUBLE, MAX_LAKE_NODES),
+  FIELD(lake_var_struct, baseflow_in, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, baseflow_out, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, channel_in, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, evapw, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, ice_throughfall, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, prec, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, recharge, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, runoff_in, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, runoff_out, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, snowmlt, KARG_DOUBLE, 1),
+  FIELD(lake_var_struct, vapor_flux, KARG_DOUBLE, 1),
+  NESTED(lake_var_struct, snow, snow_data_struct, 1, snow_fields),
+  NESTED(lake_var_struct, energy, energy_bal_struct, 1, energy_fields),
+  NESTED(lake_var_struct, soil, cell_data_struct, 1, cell_fields),
+  { NULL }
+};
+
+typedef struct {
+  long   nrecs;      /* number of captured calls replayed */
+  long   nsetup;     /* number of setup records executed */
+  long   nfail;      /* number of calls whose outputs did not match */
+  long   ncalls;     /* number of timed kernel calls */
+  double maxdiff;    /* largest absolute difference in any output */
+  double time;       /* total time spent in timed kernel calls [s] */
+} replay_stats_struct;
+
+static double tol = -1;
+static int    verbose = FALSE;
+
+static double replay_now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec);
+}
+
+static int compare_elem(int type, char *a, char *b, double *maxdiff)
+/* Returns TRUE if the element a (replayed) matches b (captured). */
+{
+  double va, vb, diff;
+
+  if (type == KARG_INT)
+    return (*(int *)a == *(int *)b);
+  if (type == KARG_CHAR)
+    return (*a == *b);
+  if (type == KARG_DOUBLE) {
+    va = *(double *)a;
+    vb = *(double *)b;
+  }
+  else {
+    va = *(float *)a;
+    vb = *(float *)b;
+  }
+  if (isnan(va) || isnan(vb))
+    return (isnan(va) && isnan(vb));
+  diff = fabs(va - vb);
+  if (diff > *maxdiff)
+    *maxdiff = diff;
+  if (tol < 0)
+    return (memcmp(a, b, type == KARG_DOUBLE ? sizeof(double) : sizeof(float)) == 0);
+  return (diff <= tol * (fabs(vb) > 1 ? fabs(vb) : 1));
+}
+
+static void report_mismatch(char *path, int type, char *a, char *b)
+{
+  if (type == KARG_DOUBLE)
+    fprintf(stderr, "    %s: replayed %.17g, captured %.17g\n", path,
+            *(double *)a, *(double *)b);
+  else if (type == KARG_FLOAT)
+    fprintf(stderr, "    %s: replayed %.9g, captured %.9g\n", path,
+            *(float *)a, *(float *)b);
+  else if (type == KARG_INT)
+    fprintf(stderr, "    %s: replayed %d, captured %d\n", path,
+            *(int *)a, *(int *)b);
+  else
+    fprintf(stderr, "    %s: replayed %d, captured %d\n", path,
+            (int)*a, (int)*b);
+}
+
+static int compare_fields(kernel_field_struct *field, char *a, char *b,
+                          char *path, double *maxdiff)
+/* Compares two structures field by field; returns the number of
+   mismatched elements. */
+{
+  char   subpath[MAXSTRING];
+  char  *fa, *fb;
+  int    nbad = 0;
+  int    i;
+
+  for ( ; field->name != NULL; field++) {
+    for (i = 0; i < field->n; i++) {
+      fa = a + field->offset + i * field->size;
+      fb = b + field->offset + i * field->size;
+      if (field->n > 1)
+        sprintf(subpath, "%s.%s[%d]", path, field->name, i);
+      else
+        sprintf(subpath, "%s.%s", path, field->name);
+      if (field->type == KARG_NESTED)
+        nbad += compare_fields(field->sub, fa, fb, subpath, maxdiff);
+      else if (!compare_elem(field->type, fa, fb, maxdiff)) {
+        nbad++;
+        if (verbose)
+          report_mismatch(subpath, field->type, fa, fb);
+      }
+    }
+  }
+  return nbad;
+}
+
+static int compare_arg(int iarg, kernel_arg_struct *arg, char *ref,
+                       double *maxdiff)
+/* Compares the replayed value of an output argument with the captured
+   one; returns the number of mismatched elements. */
+{
+  char   path[MAXSTRING];
+  char  *a = (char *)arg->ptr;
+  int    size = kernel_arg_size(arg->type);
+  int    nbad = 0;
+  int    i;
+
+  for (i = 0; i < arg->n; i++) {
+    sprintf(path, "arg %d[%d]", iarg, i);
+    if (arg->type == KARG_SNOW)
+      nbad += compare_fields(snow_fields, a + i * size, ref + i * size,
+                             path, maxdiff);
+    else if (arg->type == KARG_LAKE)
+      nbad += compare_fields(lake_fields, a + i * size, ref + i * size,
+                             path, maxdiff);
+    else if (!compare_elem(arg->type, a + i * size, ref + i * size, maxdiff)) {
+      nbad++;
+      if (verbose)
+        report_mismatch(path, arg->type, a + i * size, ref + i * size);
+    }
+  }
+  return nbad;
+}
+
+static void usage_replay(char *program)
+{
+  fprintf(stderr, "Usage: %s -f <capture_file> [-k <kernel>] [-r <repeat>] [-t <tol>] [-v]\n", program);
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  extern char *optarg;
+
+  FILE               *fp;
+  char               *filename = NULL;
+  char                setup;
+  char                ErrStr[MAXSTRING];
+  int                 only = -1;
+  int                 repeat = 1;
+  int                 optchar;
+  int                 status;
+  int                 kernel;
+  int                 nargs;
+  int                 nbad;
+  int                 i, r;
+  size_t              size;
+  long                nrec = 0;
+  double              ret, ref_ret, diff, t0;
+  kernel_arg_struct   in[MAX_KERNEL_ARGS];
+  kernel_arg_struct   work[MAX_KERNEL_ARGS];
+  void               *ref[MAX_KERNEL_ARGS];
+  replay_stats_struct stats[N_KERNELS];
+
+  while ((optchar = getopt(argc, argv, "f:k:r:t:v")) != EOF) {
+    switch ((char)optchar) {
+    case 'f':
+      filename = optarg;
+      break;
+    case 'k':
+      if ((only = kernel_id(optarg)) < 0) {
+        fprintf(stderr, "Unknown kernel %s\n", optarg);
+        usage_replay(argv[0]);
+      }
+      break;
+    case 'r':
+      repeat = atoi(optarg);
+      if (repeat < 1)
+        usage_replay(argv[0]);
+      break;
+    case 't':
+      tol = atof(optarg);
+      break;
+    case 'v':
+      verbose = TRUE;
+      break;
+    default:
+      usage_replay(argv[0]);
+    }
+  }
+  if (filename == NULL)
+    usage_replay(argv[0]);
+
+  memset(stats, 0, sizeof(stats));
+
+  fp = open_file(filename, "rb");
+  if (kernel_read_header(fp) == ERROR) {
+    sprintf(ErrStr, "%s is not a kernel capture file, or was written by a build with different structure layouts.", filename);
+    nrerror(ErrStr);
+  }
+
+  while ((status = kernel_read_record(fp, &kernel, &setup, &nargs, in, ref,
+                                      &ref_ret)) == 1) {
+    nrec++;
+    if (only < 0 || kernel == only) {
+      if (setup) {
+        kernel_invoke(kernel, in);
+        stats[kernel].nsetup++;
+      }
+      else {
+        for (i = 0; i < nargs; i++) {
+          work[i] = in[i];
+          size = in[i].n * kernel_arg_size(in[i].type);
+          work[i].ptr = malloc(size > 0 ? size : 1);
+        }
+        for (r = 0; r < repeat; r++) {
+          for (i = 0; i < nargs; i++)
+            memcpy(work[i].ptr, in[i].ptr,
+                   in[i].n * kernel_arg_size(in[i].type));
+          t0 = replay_now();
+          ret = kernel_invoke(kernel, work);
+          stats[kernel].time += replay_now() - t0;
+          stats[kernel].ncalls++;
+        }
+        stats[kernel].nrecs++;
+
+        nbad = 0;
+        if (verbose)
+          fprintf(stderr, "%s record %ld:\n", kernel_name(kernel), nrec);
+        for (i = 0; i < nargs; i++)
+          if (work[i].out)
+            nbad += compare_arg(i, &work[i], (char *)ref[i],
+                                &stats[kernel].maxdiff);
+        diff = fabs(ret - ref_ret);
+        if (diff > stats[kernel].maxdiff)
+          stats[kernel].maxdiff = diff;
+        if (tol < 0 ? ret != ref_ret : diff > tol * (fabs(ref_ret) > 1 ? fabs(ref_ret) : 1)) {
+          nbad++;
+          if (verbose)
+            fprintf(stderr, "    return value: replayed %.17g, captured %.17g\n",
+                    ret, ref_ret);
+        }
+        if (nbad > 0)
+          stats[kernel].nfail++;
+
+        for (i = 0; i < nargs; i++)
+          free(work[i].ptr);
+      }
+    }
+    for (i = 0; i < nargs; i++) {
+      free(in[i].ptr);
+      free(ref[i]);
+    }
+  }
+  fclose(fp);
+  if (status == ERROR) {
+    sprintf(ErrStr, "Kernel capture file %s is truncated or corrupt (record %ld).", filename, nrec + 1);
+    nrerror(ErrStr);
+  }
+
+  fprintf(stdout, "%-26s %9s %8s %9s %14s %14s\n", "Kernel", "Records",
+          "Setup", "Mismatch", "Max |diff|", "Time/call [us]");
+  status = 0;
+  for (kernel = 0; kernel < N_KERNELS; kernel++) {
+    if (stats[kernel].nrecs == 0)
+      continue;
+    fprintf(stdout, "%-26s %9ld %8ld %9ld %14.6g %14.3f\n",
+            kernel_name(kernel), stats[kernel].nrecs, stats[kernel].nsetup,
+            stats[kernel].nfail, stats[kernel].maxdiff,
+            1.e6 * stats[kernel].time / (double)stats[kernel].ncalls);
+    if (stats[kernel].nfail > 0)
+      status = 1;
+  }
+
+  return status;
+}
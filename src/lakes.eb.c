@@ -1870,7 +1870,7 @@ void energycalc (double *finaltemp, double *sumjoule, int numnod, double dz, dou
     }
 }
 
-int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_vars_struct *all_vars,
+int water_balance (lake_var_struct *lake, lake_con_struct *lake_con, int dt, all_vars_struct *all_vars,
 		    int rec, int iveg,int band, double lakefrac, soil_con_struct soil_con, veg_con_struct veg_con)
 /**********************************************************************
  * This routine calculates the water balance of the lake
@@ -1933,6 +1933,9 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
   2013-Dec-27 Removed QUICK_FS option.					TJB
+  2026-Oct-17 Takes lake_con by reference.				KM
+  2026-Oct-17 Passes soil_con.node_layer to
+	      distribute_node_moisture_properties.			KM
 **********************************************************************/
 {
   extern option_struct   options;
@@ -2023,7 +2026,7 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
   // Estimate the new lake fraction (before recharge)
   if(lake->new_ice_area > surfacearea)
     surfacearea = lake->new_ice_area;
-  newfraction = surfacearea/lake_con.basin[0];
+  newfraction = surfacearea/lake_con->basin[0];
  
   // Save this estimate of the new lake fraction for use later
   max_newfraction = newfraction;
@@ -2068,11 +2071,11 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
       delta_moist[j] += (soil_con.max_moist[j]-cell[iveg][band].layer[j].moist)*(max_newfraction-lakefrac)/(1-lakefrac); // mm over (1-lakefrac)
     }
     for(j=0; j<options.Nlayer; j++) {
-      lake->recharge += (delta_moist[j]) / 1000. * (1-lakefrac) * lake_con.basin[0]; // m^3
+      lake->recharge += (delta_moist[j]) / 1000. * (1-lakefrac) * lake_con->basin[0]; // m^3
     }
 
     // Above-ground storage in newly-flooded area is liberated and goes to lake
-    abovegrnd_storage = (veg_var[iveg][band].Wdew/1000. + snow[iveg][band].snow_canopy + snow[iveg][band].swq) * (max_newfraction-lakefrac) * lake_con.basin[0];
+    abovegrnd_storage = (veg_var[iveg][band].Wdew/1000. + snow[iveg][band].snow_canopy + snow[iveg][band].swq) * (max_newfraction-lakefrac) * lake_con->basin[0];
     lake->recharge -= abovegrnd_storage;
 
     // Fill the soil to saturation if possible in inundated area
@@ -2087,7 +2090,7 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
       lake->recharge = lake->volume-lake->ice_water_eq;
       lake->volume = lake->ice_water_eq;
 
-      Recharge = 1000.*lake->recharge/((max_newfraction-lakefrac)*lake_con.basin[0]) + (veg_var[iveg][band].Wdew + snow[iveg][band].snow_canopy*1000. + snow[iveg][band].swq*1000.); // mm over area that has been flooded
+      Recharge = 1000.*lake->recharge/((max_newfraction-lakefrac)*lake_con->basin[0]) + (veg_var[iveg][band].Wdew + snow[iveg][band].snow_canopy*1000. + snow[iveg][band].swq*1000.); // mm over area that has been flooded
 
       for(j=0; j<options.Nlayer; j++) {
 
@@ -2161,21 +2164,21 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
   }
 
   // Compute runoff volume in m^3 and extract runoff volume from lake
-  if(ldepth <= lake_con.mindepth )
+  if(ldepth <= lake_con->mindepth )
     lake->runoff_out = 0.0;
   else {
     circum=2*PI*pow(surfacearea/PI,0.5);
-    lake->runoff_out = lake_con.wfrac*circum*SECPHOUR*((double)dt)*1.6*pow(ldepth-lake_con.mindepth, 1.5);
+    lake->runoff_out = lake_con->wfrac*circum*SECPHOUR*((double)dt)*1.6*pow(ldepth-lake_con->mindepth, 1.5);
     if((lake->volume - lake->ice_water_eq) >= lake->runoff_out) { 
       /*liquid water is available */
-      if( (lake->volume - lake->runoff_out) < lake_con.minvolume ) 
-	lake->runoff_out = lake->volume - lake_con.minvolume;
+      if( (lake->volume - lake->runoff_out) < lake_con->minvolume ) 
+	lake->runoff_out = lake->volume - lake_con->minvolume;
       lake->volume -= lake->runoff_out;
     }
     else {
       lake->runoff_out = lake->volume - lake->ice_water_eq;
-      if( (lake->volume - lake->runoff_out) < lake_con.minvolume ) 
-	lake->runoff_out = lake->volume - lake_con.minvolume;
+      if( (lake->volume - lake->runoff_out) < lake_con->minvolume ) 
+	lake->runoff_out = lake->volume - lake_con->minvolume;
       lake->volume -= lake->runoff_out;
     }
   }
@@ -2190,14 +2193,14 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
   }
 
   // check that lake volume does not exceed its maximum
-  if (lake->volume - lake_con.maxvolume > SMALL) {
-    if(lake->ice_water_eq > lake_con.maxvolume) {
+  if (lake->volume - lake_con->maxvolume > SMALL) {
+    if(lake->ice_water_eq > lake_con->maxvolume) {
       lake->runoff_out += (lake->volume - lake->ice_water_eq);
       lake->volume = lake->ice_water_eq;
     }
     else {
-      lake->runoff_out += (lake->volume - lake_con.maxvolume);
-      lake->volume = lake_con.maxvolume;
+      lake->runoff_out += (lake->volume - lake_con->maxvolume);
+      lake->volume = lake_con->maxvolume;
     }
   }
   else if (lake->volume < SMALL)
@@ -2270,7 +2273,7 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
     lake->sarea = lake->new_ice_area;
   else 
     lake->sarea = lake->surface[0];
-  newfraction = lake->sarea/lake_con.basin[0];
+  newfraction = lake->sarea/lake_con->basin[0];
 
   /*******************************************************************/  
   /* Adjust temperature distribution if number of nodes has changed. 
@@ -2304,14 +2307,14 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
    **********************************************************************/
   // Wetland
   if (newfraction < 1.0) { // wetland exists at end of time step
-    advect_soil_veg_storage(lakefrac, max_newfraction, newfraction, delta_moist, &soil_con, &veg_con, &(cell[iveg][band]), &(veg_var[iveg][band]), lake_con);
+    advect_soil_veg_storage(lakefrac, max_newfraction, newfraction, delta_moist, &soil_con, &veg_con, &(cell[iveg][band]), &(veg_var[iveg][band]), *lake_con);
     rescale_soil_veg_fluxes((1-lakefrac), (1-newfraction), &(cell[iveg][band]), &(veg_var[iveg][band]));
     advect_snow_storage(lakefrac, max_newfraction, newfraction, &(snow[iveg][band])); 
     rescale_snow_energy_fluxes((1-lakefrac), (1-newfraction), &(snow[iveg][band]), &(energy[iveg][band])); 
     for (j=0; j<options.Nlayer; j++) moist[j] = cell[iveg][band].layer[j].moist;
     ErrorFlag = distribute_node_moisture_properties(energy[iveg][band].moist, energy[iveg][band].ice,
                                                     energy[iveg][band].kappa_node, energy[iveg][band].Cs_node,
-                                                    soil_con.Zsum_node, energy[iveg][band].T,
+                                                    &soil_con.node_layer, energy[iveg][band].T,
                                                     soil_con.max_moist_node,
                                                     soil_con.expt_node,
                                                     soil_con.bubble_node,
@@ -2328,24 +2331,24 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
   else if (lakefrac < 1.0) { // wetland is gone at end of time step, but existed at beginning of step
     if (lakefrac > 0.0) { // lake also existed at beginning of step
       for (j=0; j<options.Nlayer; j++) {
-        lake->evapw += cell[iveg][band].layer[j].evap*0.001*(1.-lakefrac)*lake_con.basin[0];
+        lake->evapw += cell[iveg][band].layer[j].evap*0.001*(1.-lakefrac)*lake_con->basin[0];
       }
-      lake->evapw +=veg_var[iveg][band].canopyevap*0.001*(1.-lakefrac)*lake_con.basin[0];
-      lake->evapw +=snow[iveg][band].canopy_vapor_flux*(1.-lakefrac)*lake_con.basin[0];
-      lake->evapw +=snow[iveg][band].vapor_flux*(1.-lakefrac)*lake_con.basin[0];
+      lake->evapw +=veg_var[iveg][band].canopyevap*0.001*(1.-lakefrac)*lake_con->basin[0];
+      lake->evapw +=snow[iveg][band].canopy_vapor_flux*(1.-lakefrac)*lake_con->basin[0];
+      lake->evapw +=snow[iveg][band].vapor_flux*(1.-lakefrac)*lake_con->basin[0];
     }
   }
 
   // Lake
   if (newfraction > 0.0) { // lake exists at end of time step
     // Copy moisture fluxes into lake->soil structure, mm over end-of-step lake area
-    lake->soil.runoff = lake->runoff_out*1000/(newfraction*lake_con.basin[0]);
-    lake->soil.baseflow = lake->baseflow_out*1000/(newfraction*lake_con.basin[0]);
-    lake->soil.inflow = lake->baseflow_out*1000/(newfraction*lake_con.basin[0]);
+    lake->soil.runoff = lake->runoff_out*1000/(newfraction*lake_con->basin[0]);
+    lake->soil.baseflow = lake->baseflow_out*1000/(newfraction*lake_con->basin[0]);
+    lake->soil.inflow = lake->baseflow_out*1000/(newfraction*lake_con->basin[0]);
     for (lindex=0; lindex<options.Nlayer; lindex++) {
       lake->soil.layer[lindex].evap = 0;
     }
-    lake->soil.layer[0].evap += lake->evapw*1000/(newfraction*lake_con.basin[0]);
+    lake->soil.layer[0].evap += lake->evapw*1000/(newfraction*lake_con->basin[0]);
     // Rescale other fluxes and storages to mm over end-of-step lake area
     if (lakefrac > 0.0) { // lake existed at beginning of time step
       rescale_snow_storage(lakefrac, newfraction, &(lake->snow));
@@ -2357,15 +2360,15 @@ int water_balance (lake_var_struct *lake, lake_con_struct lake_con, int dt, all_
         lake->snow.coverage = 0;
     }
     else { // lake didn't exist at beginning of time step; create new lake
-      initialize_lake(lake, lake_con, &soil_con, &(cell[iveg][band]), energy[iveg][band].T[0], 1);
+      initialize_lake(lake, *lake_con, &soil_con, &(cell[iveg][band]), energy[iveg][band].T[0], 1);
     }
   }
   else if (lakefrac > 0.0) { // lake is gone at end of time step, but existed at beginning of step
     if (lakefrac < 1.0) { // wetland also existed at beginning of step
-      cell[iveg][band].layer[0].evap += 1000.*lake->evapw/((1.-newfraction)*lake_con.basin[0]);
-      cell[iveg][band].runoff += 1000.*lake->runoff_out/((1.-newfraction)*lake_con.basin[0]);
-      cell[iveg][band].baseflow += 1000.*lake->baseflow_out/((1.-newfraction)*lake_con.basin[0]);
-      cell[iveg][band].inflow += 1000.*lake->baseflow_out/((1.-newfraction)*lake_con.basin[0]);
+      cell[iveg][band].layer[0].evap += 1000.*lake->evapw/((1.-newfraction)*lake_con->basin[0]);
+      cell[iveg][band].runoff += 1000.*lake->runoff_out/((1.-newfraction)*lake_con->basin[0]);
+      cell[iveg][band].baseflow += 1000.*lake->baseflow_out/((1.-newfraction)*lake_con->basin[0]);
+      cell[iveg][band].inflow += 1000.*lake->baseflow_out/((1.-newfraction)*lake_con->basin[0]);
     }
   }
 
@@ -11,6 +11,9 @@ cell_data_struct **make_cell_data(int veg_type_num, int Nlayer)
   This subroutine makes an array of type cell, which contains soil
   column variables for a single grid cell.
 
+  Modifications:
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
+
 **********************************************************************/
 {
   extern option_struct options;
@@ -18,11 +21,11 @@ cell_data_struct **make_cell_data(int veg_type_num, int Nlayer)
   int i;
   cell_data_struct **temp;
 
-  temp = (cell_data_struct**) calloc(veg_type_num, 
-                                  sizeof(cell_data_struct*));
+  temp = (cell_data_struct**) mem_calloc(veg_type_num, 
+                                  sizeof(cell_data_struct*), MEM_MODEL_STATE);
   for(i=0;i<veg_type_num;i++) {
-    temp[i] = (cell_data_struct*) calloc(options.SNOW_BAND, 
-					 sizeof(cell_data_struct));
+    temp[i] = (cell_data_struct*) mem_calloc(options.SNOW_BAND, 
+					 sizeof(cell_data_struct), MEM_MODEL_STATE);
 /*     for(j=0;j<options.SNOW_BAND;j++) { */
 /*       temp[i][j].layer  */
 /* 	= (layer_data_struct*)calloc(Nlayer, */
@@ -33,6 +33,7 @@ dmy_struct *make_dmy(global_param_struct *global)
 	   the number of forcing file records to skip.      KAC
   2006-Feb-07 Changed indexing of line 63 (if(endday...) by 1.		GCT 
   2013-Nov-21 Added check on start hour in computation of forceskip.	TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 **********************************************************************/
 {
   extern param_set_struct param_set;
@@ -105,7 +106,7 @@ dmy_struct *make_dmy(global_param_struct *global)
   }
 
   // allocate dmy struct
-  temp = (dmy_struct*) calloc(global->nrecs, sizeof(dmy_struct));
+  temp = (dmy_struct*) mem_calloc(global->nrecs, sizeof(dmy_struct), MEM_DMY);
 
   /** Create Date Structure for each Modeled Time Step **/
   jday = day;
@@ -210,12 +211,13 @@ void get_next_time_step(int *year,
   This subroutine frees the dmy array.
 
   modifications:
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 **********************************************************************/
 void free_dmy(dmy_struct **dmy) {
 
   if (*dmy == NULL)
     return;
 
-  free(*dmy);
+  mem_free(*dmy, MEM_DMY);
 
 }
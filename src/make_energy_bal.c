@@ -15,6 +15,7 @@ energy_bal_struct **make_energy_bal(int nveg)
   01-Nov-04 Removed modification of Nnodes, as this was preventing
 	    correct reading/writing of state files for QUICK_FLUX
 	    =TRUE.						TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 
 **********************************************************************/
 {
@@ -23,13 +24,13 @@ energy_bal_struct **make_energy_bal(int nveg)
   int i, j;
   energy_bal_struct **temp;
 
-  temp = (energy_bal_struct**) calloc(nveg, 
-				      sizeof(energy_bal_struct*));
+  temp = (energy_bal_struct**) mem_calloc(nveg, 
+				      sizeof(energy_bal_struct*), MEM_MODEL_STATE);
 
   /** Initialize all records to unfrozen conditions */
   for(i = 0; i < nveg; i++) {
-    temp[i] = (energy_bal_struct*) calloc(options.SNOW_BAND, 
-					  sizeof(energy_bal_struct));
+    temp[i] = (energy_bal_struct*) mem_calloc(options.SNOW_BAND, 
+					  sizeof(energy_bal_struct), MEM_MODEL_STATE);
     for(j = 0; j < options.SNOW_BAND; j++) {
       temp[i][j].frozen = FALSE;
     }
@@ -33,6 +33,13 @@ void make_in_and_outfiles(filep_struct         *filep,
 	      in global parameter file.					TJB
   2011-May-25 Expanded latchar, lngchar, and junk allocations to handle
 	      GRID_DECIMAL > 4.						TJB
+  2026-Oct-17 Output files are not opened if REGION_ONLY is TRUE.	KM
+  2026-Oct-17 Output files are not opened if STAT_ONLY is TRUE.	KM
+  2026-Oct-17 NETCDF forcing files are opened once, by
+	      netcdf_forcing_init(), rather than for each cell.		KM
+  2026-Oct-17 Moved the forcing files to make_in_files(); they are not
+	      opened here if PREFETCH_DEPTH > 0.			KM
+  2026-Oct-17 Output files are not opened if ARROW_OUTPUT is TRUE.	KM
 
 **********************************************************************/
 {
@@ -51,31 +58,21 @@ void make_in_and_outfiles(filep_struct         *filep,
   Input Forcing Files
   ********************************/
 
-  strcpy(filenames->forcing[0], filenames->f_path_pfx[0]);
-  strcat(filenames->forcing[0], latchar);
-  strcat(filenames->forcing[0], "_");
-  strcat(filenames->forcing[0], lngchar);
-  if(param_set.FORCE_FORMAT[0] == BINARY)
-    filep->forcing[0] = open_file(filenames->forcing[0], "rb");
-  else
-    filep->forcing[0] = open_file(filenames->forcing[0], "r");
-
-  filep->forcing[1] = NULL;
-  if(strcasecmp(filenames->f_path_pfx[1],"MISSING")!=0) {
-    strcpy(filenames->forcing[1], filenames->f_path_pfx[1]);
-    strcat(filenames->forcing[1], latchar);
-    strcat(filenames->forcing[1], "_");
-    strcat(filenames->forcing[1], lngchar);
-    if(param_set.FORCE_FORMAT[0] == BINARY) 
-      filep->forcing[1] = open_file(filenames->forcing[1], "rb");
-    else 
-      filep->forcing[1] = open_file(filenames->forcing[1], "r");
+  if (options.PREFETCH_DEPTH > 0) {
+    /* the forcing files are read by the read-ahead thread (prefetch.c) */
+    filep->forcing[0] = NULL;
+    filep->forcing[1] = NULL;
   }
+  else
+    make_in_files(filep, filenames, soil);
 
   /********************************
   Output Files
   ********************************/
 
+  if (options.REGION_ONLY || options.STAT_ONLY || options.ARROW_OUTPUT)
+    return;
+
   for (filenum=0; filenum<options.Noutfiles; filenum++) {
     strcpy(out_data_files[filenum].filename, filenames->result_dir);
     strcat(out_data_files[filenum].filename, "/");
@@ -90,3 +87,54 @@ void make_in_and_outfiles(filep_struct         *filep,
   }
 
 } 
+
+void make_in_files(filep_struct     *filep,
+		   filenames_struct *filenames,
+		   soil_con_struct  *soil)
+/**********************************************************************
+  make_in_files		Keith Mathews			October 2026
+
+  Builds the names of the forcing files of a cell, and opens them.
+  Split out of make_in_and_outfiles(), for the read-ahead thread
+  (prefetch.c).
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct    options;
+  extern param_set_struct param_set;
+  extern FILE *open_file(char string[], char type[]);
+
+  char   latchar[20], lngchar[20], junk[6];
+
+  sprintf(junk, "%%.%if", options.GRID_DECIMAL);
+  sprintf(latchar, junk, soil->lat);
+  sprintf(lngchar, junk, soil->lng);
+
+  strcpy(filenames->forcing[0], filenames->f_path_pfx[0]);
+  if(param_set.FORCE_FORMAT[0] == NETCDF)
+    filep->forcing[0] = NULL;
+  else {
+    strcat(filenames->forcing[0], latchar);
+    strcat(filenames->forcing[0], "_");
+    strcat(filenames->forcing[0], lngchar);
+    if(param_set.FORCE_FORMAT[0] == BINARY)
+      filep->forcing[0] = open_file(filenames->forcing[0], "rb");
+    else
+      filep->forcing[0] = open_file(filenames->forcing[0], "r");
+  }
+
+  filep->forcing[1] = NULL;
+  if(strcasecmp(filenames->f_path_pfx[1],"MISSING")!=0
+     && param_set.FORCE_FORMAT[1] != NETCDF) {
+    strcpy(filenames->forcing[1], filenames->f_path_pfx[1]);
+    strcat(filenames->forcing[1], latchar);
+    strcat(filenames->forcing[1], "_");
+    strcat(filenames->forcing[1], lngchar);
+    if(param_set.FORCE_FORMAT[0] == BINARY) 
+      filep->forcing[1] = open_file(filenames->forcing[1], "rb");
+    else 
+      filep->forcing[1] = open_file(filenames->forcing[1], "r");
+  }
+
+}
@@ -15,6 +15,7 @@ snow_data_struct **make_snow_data(int nveg)
   07-09-98 modified to make te make a two dimensional array which 
            also accounts for a variable number of snow elevation
            bands                                               KAC
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 
 **********************************************************************/
 {
@@ -23,12 +24,12 @@ snow_data_struct **make_snow_data(int nveg)
   int                i;
   snow_data_struct **temp;
 
-  temp = (snow_data_struct **) calloc(nveg, 
-				      sizeof(snow_data_struct *));
+  temp = (snow_data_struct **) mem_calloc(nveg, 
+				      sizeof(snow_data_struct *), MEM_MODEL_STATE);
 
   for(i=0;i<nveg;i++) {
-    temp[i] = (snow_data_struct *) calloc(options.SNOW_BAND, 
-					  sizeof(snow_data_struct));
+    temp[i] = (snow_data_struct *) mem_calloc(options.SNOW_BAND, 
+					  sizeof(snow_data_struct), MEM_MODEL_STATE);
   }
     
   return temp;
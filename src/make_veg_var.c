@@ -15,6 +15,7 @@ veg_var_struct **make_veg_var(int veg_type_num)
   07-13-98 modified to add structure definitions for all defined 
            elevation bands                                       KAC
   2013-Jul-25 Added photosynthesis terms.				TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 **********************************************************************/
 {
   extern option_struct options;
@@ -22,16 +23,16 @@ veg_var_struct **make_veg_var(int veg_type_num)
   int              i, j;
   veg_var_struct **temp;
 
-  temp = (veg_var_struct **) calloc(veg_type_num, sizeof(veg_var_struct *));
+  temp = (veg_var_struct **) mem_calloc(veg_type_num, sizeof(veg_var_struct *), MEM_MODEL_STATE);
   for(i=0;i<veg_type_num;i++) {
-    temp[i] = (veg_var_struct *) calloc(options.SNOW_BAND, sizeof(veg_var_struct));
+    temp[i] = (veg_var_struct *) mem_calloc(options.SNOW_BAND, sizeof(veg_var_struct), MEM_MODEL_STATE);
 
     if (options.CARBON) {
       for ( j = 0 ; j < options.SNOW_BAND ; j++ ) {
-         temp[i][j].NscaleFactor = (double *)calloc(options.Ncanopy,sizeof(double));
-         temp[i][j].aPARLayer = (double *)calloc(options.Ncanopy,sizeof(double));
-         temp[i][j].CiLayer = (double *)calloc(options.Ncanopy,sizeof(double));
-         temp[i][j].rsLayer = (double *)calloc(options.Ncanopy,sizeof(double));
+         temp[i][j].NscaleFactor = (double *)mem_calloc(options.Ncanopy,sizeof(double), MEM_MODEL_STATE);
+         temp[i][j].aPARLayer = (double *)mem_calloc(options.Ncanopy,sizeof(double), MEM_MODEL_STATE);
+         temp[i][j].CiLayer = (double *)mem_calloc(options.Ncanopy,sizeof(double), MEM_MODEL_STATE);
+         temp[i][j].rsLayer = (double *)mem_calloc(options.Ncanopy,sizeof(double), MEM_MODEL_STATE);
       }
     }
 
@@ -0,0 +1,265 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  mem_stats.c		Keith Mathews			October 2026
+
+  Optional memory accounting by subsystem.  The large per-run and
+  per-cell allocations of the model (atmos and veg_hist arrays, the
+  date structure, the forcing data and its disaggregation work arrays,
+  the MTCLIM buffers, the model state structures, and the output
+  variable arrays) are made through mem_calloc()/mem_malloc() and
+  released through mem_free(), each of which names the subsystem
+  (MEM_* in vicNl_def.h) that owns the memory.  Storage that is not
+  on the heap but scales with the configuration (e.g. the lake
+  structures, which are fixed-size arrays) is charged with
+  mem_charge().  The routing grids and hydrographs are charged to the
+  routing subsystem.
+
+  Accounting is enabled by MEM_STATS in the global parameter file.
+  When it is disabled, the wrappers reduce to calloc(), malloc() and
+  free().  Byte counts are the usable sizes of the blocks, as reported
+  by the C library (glibc); elsewhere the accounting is unavailable.
+
+  For each subsystem, the current and peak number of bytes are kept,
+  both for the whole run and for the current cell.  At the end of each
+  cell, mem_stats_end_cell() optionally writes the per-cell peaks to
+  the MEM_STATS_FILE; at the end of the run, mem_stats_summary()
+  prints a per-subsystem summary to stderr.
+
+  Modifications:
+**********************************************************************/
+
+static char *mem_names[N_MEM_SUBSYS] = {
+  "atmos", "veg_hist", "dmy", "forcing", "mtclim", "model_state",
+  "lake", "output", "routing"
+};
+
+static double  cur_bytes[N_MEM_SUBSYS];   /* bytes currently in use */
+static double  run_peak[N_MEM_SUBSYS];    /* peak bytes, whole run */
+static double  cell_peak[N_MEM_SUBSYS];   /* peak bytes, current cell */
+static double  sum_cell_peak[N_MEM_SUBSYS];
+static long    nallocs[N_MEM_SUBSYS];     /* number of allocations */
+static double  total_cur = 0;
+static double  total_run_peak = 0;
+static double  total_cell_peak = 0;
+static int     ncells = 0;
+static FILE   *mem_fp = NULL;
+
+static void mem_account(int subsys, double bytes)
+/* Adds bytes (which may be negative) to the counters of subsys. */
+{
+  cur_bytes[subsys] += bytes;
+  total_cur += bytes;
+  if (cur_bytes[subsys] > cell_peak[subsys])
+    cell_peak[subsys] = cur_bytes[subsys];
+  if (cur_bytes[subsys] > run_peak[subsys])
+    run_peak[subsys] = cur_bytes[subsys];
+  if (total_cur > total_cell_peak)
+    total_cell_peak = total_cur;
+  if (total_cur > total_run_peak)
+    total_run_peak = total_cur;
+}
+
+static double mem_block_size(void *ptr)
+/* Returns the usable size of an allocated block. */
+{
+#ifdef __GLIBC__
+  return (double)malloc_usable_size(ptr);
+#else
+  return 0;
+#endif
+}
+
+void *mem_calloc(size_t n, size_t size, int subsys)
+/**********************************************************************
+  mem_calloc		Keith Mathews			October 2026
+
+  calloc() that charges the block to subsystem subsys.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  void *ptr;
+
+  ptr = calloc(n, size);
+  if (options.MEM_STATS && ptr != NULL) {
+    nallocs[subsys]++;
+    mem_account(subsys, mem_block_size(ptr));
+  }
+  return ptr;
+}
+
+void *mem_malloc(size_t size, int subsys)
+/**********************************************************************
+  mem_malloc		Keith Mathews			October 2026
+
+  malloc() that charges the block to subsystem subsys.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  void *ptr;
+
+  ptr = malloc(size);
+  if (options.MEM_STATS && ptr != NULL) {
+    nallocs[subsys]++;
+    mem_account(subsys, mem_block_size(ptr));
+  }
+  return ptr;
+}
+
+void mem_free(void *ptr, int subsys)
+/**********************************************************************
+  mem_free		Keith Mathews			October 2026
+
+  free() for a block allocated by mem_calloc() or mem_malloc() with the
+  same subsystem.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+
+  if (ptr == NULL)
+    return;
+  if (options.MEM_STATS)
+    mem_account(subsys, -mem_block_size(ptr));
+  free(ptr);
+}
+
+void mem_charge(int subsys, long bytes)
+/**********************************************************************
+  mem_charge		Keith Mathews			October 2026
+
+  Charges (bytes > 0) or releases (bytes < 0) storage that is not
+  allocated on the heap to subsystem subsys.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+
+  if (options.MEM_STATS)
+    mem_account(subsys, (double)bytes);
+}
+
+void mem_stats_init(filenames_struct *names)
+/**********************************************************************
+  mem_stats_init	Keith Mathews			October 2026
+
+  If a MEM_STATS_FILE was given, opens it and writes the header line of
+  the per-cell table.  The counters are not reset, since the output
+  structures have already been allocated when this is called.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int i;
+
+  if (!options.MEM_STATS)
+    return;
+
+#ifndef __GLIBC__
+  fprintf(stderr, "WARNING: MEM_STATS requires the GNU C library; all byte counts will be 0.\n");
+#endif
+
+  if (strcmp(names->mem_stats, "NONE") != 0) {
+    mem_fp = open_file(names->mem_stats, "w");
+    fprintf(mem_fp, "CELLNUM,GRIDCEL,LAT,LNG");
+    for (i = 0; i < N_MEM_SUBSYS; i++)
+      fprintf(mem_fp, ",%s_KB", mem_names[i]);
+    fprintf(mem_fp, ",total_KB\n");
+  }
+}
+
+void mem_stats_start_cell()
+/**********************************************************************
+  mem_stats_start_cell	Keith Mathews			October 2026
+
+  Resets the per-cell peaks to the current usage.
+
+  Modifications:
+**********************************************************************/
+{
+  int i;
+
+  for (i = 0; i < N_MEM_SUBSYS; i++)
+    cell_peak[i] = cur_bytes[i];
+  total_cell_peak = total_cur;
+}
+
+void mem_stats_end_cell(int cellnum, soil_con_struct *soil_con)
+/**********************************************************************
+  mem_stats_end_cell	Keith Mathews			October 2026
+
+  Writes the per-cell peak usage [kB] of each subsystem, including the
+  storage that persists across cells, to the MEM_STATS_FILE (if any).
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int i;
+
+  if (!options.MEM_STATS)
+    return;
+
+  ncells++;
+  for (i = 0; i < N_MEM_SUBSYS; i++)
+    sum_cell_peak[i] += cell_peak[i];
+
+  if (mem_fp != NULL) {
+    fprintf(mem_fp, "%d,%d,%.6f,%.6f", cellnum, soil_con->gridcel,
+            soil_con->lat, soil_con->lng);
+    for (i = 0; i < N_MEM_SUBSYS; i++)
+      fprintf(mem_fp, ",%.0f", cell_peak[i]/1024.);
+    fprintf(mem_fp, ",%.0f\n", total_cell_peak/1024.);
+  }
+}
+
+void mem_stats_summary()
+/**********************************************************************
+  mem_stats_summary	Keith Mathews			October 2026
+
+  Prints the per-subsystem memory summary for the whole run to stderr
+  and closes the MEM_STATS_FILE.  This is called after the run-level
+  structures have been freed, so bytes still in use indicate leaks.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int i;
+
+  if (!options.MEM_STATS)
+    return;
+
+  fprintf(stderr, "\n");
+  fprintf(stderr, "Memory Summary (%d cells)\n", ncells);
+  fprintf(stderr, "%-16s %12s %14s %14s %14s\n", "Subsystem", "Allocs",
+          "Current [kB]", "Peak [kB]", "Cell Peak [kB]");
+  for (i = 0; i < N_MEM_SUBSYS; i++)
+    fprintf(stderr, "%-16s %12ld %14.0f %14.0f %14.0f\n", mem_names[i],
+            nallocs[i], cur_bytes[i]/1024., run_peak[i]/1024.,
+            (ncells > 0) ? sum_cell_peak[i]/1024./ncells : 0.);
+  fprintf(stderr, "%-16s %12s %14.0f %14.0f\n", "total", "",
+          total_cur/1024., total_run_peak/1024.);
+  fprintf(stderr, "(Cell Peak is the mean over cells of the peak within each cell.)\n");
+  fprintf(stderr, "\n");
+
+  if (mem_fp != NULL) {
+    fclose(mem_fp);
+    mem_fp = NULL;
+  }
+}
@@ -49,6 +49,7 @@
   2013-Jul-19 Fixed bug in shortwave computation for case when daily shortwave
 	      is supplied by the user.						HFC via TJB
   2013-Jul-25 Added data->s_fdir.						TJB
+  2026-Oct-17 Memory is accounted for by mem_malloc()/mem_free().	KM
 */
 
 /*
@@ -319,81 +320,81 @@ int data_alloc(const control_struct *ctrl, data_struct *data)
   
   ndays = ctrl->ndays;
   
-  if (ok && ctrl->inyear && !(data->year = (int*) malloc(ndays * sizeof(int)))) {
+  if (ok && ctrl->inyear && !(data->year = (int*) mem_malloc(ndays * sizeof(int), MEM_MTCLIM))) {
     printf("Error allocating for year array\n");
     ok=0;
   } 
-  if (ok && !(data->yday = (int*) malloc(ndays * sizeof(int)))) {
+  if (ok && !(data->yday = (int*) mem_malloc(ndays * sizeof(int), MEM_MTCLIM))) {
     printf("Error allocating for yearday array\n");
     ok=0;
   } 
-  if (ok && !(data->tmax = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->tmax = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for tmax array\n");
     ok=0;
   }
-  if (ok && !(data->tmin = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->tmin = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for tmin array\n");
     ok=0;
   }
-  if (ok && !(data->prcp = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->prcp = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for prcp array\n");
     ok=0;
   }
   if (ok && ctrl->indewpt && 
-      !(data->tdew = (double*) malloc(ndays * sizeof(double)))) {
+      !(data->tdew = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for input humidity array\n");
     ok=0;
   }
-  if (ok && !(data->s_tmax = (double*) malloc(ndays * sizeof(double))))	{
+  if (ok && !(data->s_tmax = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM)))	{
     printf("Error allocating for site Tmax array\n");
     ok=0;
   }
-  if (ok && !(data->s_tmin = (double*) malloc(ndays * sizeof(double))))	{
+  if (ok && !(data->s_tmin = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM)))	{
     printf("Error allocating for site Tmin array\n");
     ok=0;
   }
-  if (ok && !(data->s_tday = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_tday = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site Tday array\n");
     ok=0;
   }
-  if (ok && !(data->s_prcp = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_prcp = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site prcp array\n");
     ok=0;
   }
-  if (ok && !(data->s_hum = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_hum = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site VPD array\n");
     ok=0;
   }
-  if (ok && !(data->s_srad = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_srad = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site radiation array\n");
     ok=0;
   }
-  if (ok && !(data->s_dayl = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_dayl = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site daylength array\n");
     ok=0;
   }
-  if (ok && !(data->s_swe = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_swe = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site snowpack array\n");
     ok=0;
   }
   /* start vic_change */
-  if (ok && !(data->s_fdir = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_fdir = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for direct fraction array\n");
     ok=0;
   }
-  if (ok && !(data->s_tskc = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_tskc = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site cloudiness array\n");
     ok=0;
   }
-  if (ok && !(data->s_ppratio = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_ppratio = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site pet/prcp ratio array\n");
     ok=0;
   }
-  if (ok && !(data->s_tfmax = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_tfmax = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site pet/prcp ratio array\n");
     ok=0;
   }
-  if (ok && !(data->s_ttmax = (double*) malloc(ndays * sizeof(double)))) {
+  if (ok && !(data->s_ttmax = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for site pet/prcp ratio array\n");
     ok=0;
   }
@@ -596,51 +597,51 @@ int calc_srad_humidity_iterative(const control_struct *ctrl,
   
   /* local array memory allocation */
   /* allocate space for DTR and smoothed DTR arrays */
-  if (!(dtr = (double*) malloc(ndays * sizeof(double)))) {
+  if (!(dtr = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for DTR array\n");
     ok=0;
   }
-  if (!(sm_dtr = (double*) malloc(ndays * sizeof(double)))) {
+  if (!(sm_dtr = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for smoothed DTR array\n");
     ok=0;
   }
   /* allocate space for effective annual precip array */
-  if (!(parray = (double*) malloc(ndays * sizeof(double)))) {
+  if (!(parray = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for effective annual precip array\n");
     ok=0;
   }
   /* allocate space for the prcp totaling array */
-  if (!(window = (double*) malloc((ndays+90)*sizeof(double)))) {
+  if (!(window = (double*) mem_malloc((ndays+90)*sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for prcp totaling array\n");
     ok = 0;
   }
   /* allocate space for t_fmax */
-  if (!(t_fmax = (double*) malloc(ndays * sizeof(double)))) {
+  if (!(t_fmax = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for p_tt_max array\n");
       ok=0;
   }
   /* allocate space for Tdew array */
-  if (!(tdew = (double*) malloc(ndays * sizeof(double)))) {
+  if (!(tdew = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for Tdew array\n");
     ok=0;
   }
   /* allocate space for pet array */
-  if (!(pet = (double*) malloc(ndays * sizeof(double)))) {
+  if (!(pet = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for pet array\n");
     ok=0;
   }
   /* allocate space for pva array */
-  if (!(pva = (double*) malloc(ndays * sizeof(double)))) {
+  if (!(pva = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for pva array\n");
     ok=0;
   }
   /* allocate space for tdew_save array */
-  if (!(tdew_save = (double*) malloc(ndays * sizeof(double)))) {
+  if (!(tdew_save = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for tdew_save array\n");
     ok=0;
   }
   /* allocate space for pva_save array */
-  if (!(pva_save = (double*) malloc(ndays * sizeof(double)))) {
+  if (!(pva_save = (double*) mem_malloc(ndays * sizeof(double), MEM_MTCLIM))) {
     printf("Error allocating for pva_save array\n");
     ok=0;
   }
@@ -1079,16 +1080,16 @@ int calc_srad_humidity_iterative(const control_struct *ctrl,
   }
 
   /* free local array memory */
-  free(dtr);
-  free(sm_dtr);
-  free(parray);
-  free(window);
-  free(t_fmax);
-  free(tdew);
-  free(pet);
-  free(pva);
-  free(tdew_save);
-  free(pva_save);
+  mem_free(dtr, MEM_MTCLIM);
+  mem_free(sm_dtr, MEM_MTCLIM);
+  mem_free(parray, MEM_MTCLIM);
+  mem_free(window, MEM_MTCLIM);
+  mem_free(t_fmax, MEM_MTCLIM);
+  mem_free(tdew, MEM_MTCLIM);
+  mem_free(pet, MEM_MTCLIM);
+  mem_free(pva, MEM_MTCLIM);
+  mem_free(tdew_save, MEM_MTCLIM);
+  mem_free(pva_save, MEM_MTCLIM);
 
   return (!ok);
 
@@ -1226,26 +1227,26 @@ void compute_srad_humidity_onetime(int ndays, const control_struct *ctrl, data_s
 int data_free(const control_struct *ctrl, data_struct *data)
 {
   int ok=1;
-  if (ctrl->inyear) free(data->year);
-  free(data->yday);
-  free(data->tmax);
-  free(data->tmin);
-  free(data->prcp);
-  if (ctrl->indewpt) free(data->tdew);
-  free(data->s_tmax);
-  free(data->s_tmin);
-  free(data->s_tday);
-  free(data->s_prcp);
-  free(data->s_hum);
-  free(data->s_srad);
-  free(data->s_dayl);
-  free(data->s_swe);
+  if (ctrl->inyear) mem_free(data->year, MEM_MTCLIM);
+  mem_free(data->yday, MEM_MTCLIM);
+  mem_free(data->tmax, MEM_MTCLIM);
+  mem_free(data->tmin, MEM_MTCLIM);
+  mem_free(data->prcp, MEM_MTCLIM);
+  if (ctrl->indewpt) mem_free(data->tdew, MEM_MTCLIM);
+  mem_free(data->s_tmax, MEM_MTCLIM);
+  mem_free(data->s_tmin, MEM_MTCLIM);
+  mem_free(data->s_tday, MEM_MTCLIM);
+  mem_free(data->s_prcp, MEM_MTCLIM);
+  mem_free(data->s_hum, MEM_MTCLIM);
+  mem_free(data->s_srad, MEM_MTCLIM);
+  mem_free(data->s_dayl, MEM_MTCLIM);
+  mem_free(data->s_swe, MEM_MTCLIM);
   /* start vic_change */
-  free(data->s_fdir);
-  free(data->s_tskc);
-  free(data->s_ppratio);
-  free(data->s_tfmax);
-  free(data->s_ttmax);
+  mem_free(data->s_fdir, MEM_MTCLIM);
+  mem_free(data->s_tskc, MEM_MTCLIM);
+  mem_free(data->s_ppratio, MEM_MTCLIM);
+  mem_free(data->s_tfmax, MEM_MTCLIM);
+  mem_free(data->s_ttmax, MEM_MTCLIM);
   /* end vic_change */
   return (!ok);
 }
@@ -1348,7 +1349,7 @@ int pulled_boxcar(double *input,double *output,int n,int w,int w_flag)
     ok=0;
   }
   
-  if (ok && !(wt = (double*) malloc(w * sizeof(double)))) {
+  if (ok && !(wt = (double*) mem_malloc(w * sizeof(double), MEM_MTCLIM))) {
     printf("Allocation error in boxcar()\n");
     ok=0;
   }
@@ -1386,7 +1387,7 @@ int pulled_boxcar(double *input,double *output,int n,int w,int w_flag)
       output[i] = output[w-1];
     }
     
-    free(wt);
+    mem_free(wt, MEM_MTCLIM);
     
   } /* end if ok */
   
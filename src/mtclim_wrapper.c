@@ -78,6 +78,7 @@ void mtclim_wrapper(int have_dewpt, int have_shortwave, double hour_offset,
 
   Modifications:
   2012-Feb-16 Cleaned up commented code.					TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 ******************************************************************************/
 {
   control_struct ctrl;
@@ -87,12 +88,12 @@ void mtclim_wrapper(int have_dewpt, int have_shortwave, double hour_offset,
   int i;
 
   /* allocate space for the tiny_radfract array */
-  tiny_radfract = (double **) calloc(366, sizeof(double*));
+  tiny_radfract = (double **) mem_calloc(366, sizeof(double*), MEM_MTCLIM);
   if (tiny_radfract == NULL) {
     nrerror("Memory allocation error in mtclim_init() ...\n");
   }
   for (i=0; i<366; i++) {
-    tiny_radfract[i] = (double *) calloc(86400, sizeof(double));
+    tiny_radfract[i] = (double *) mem_calloc(86400, sizeof(double), MEM_MTCLIM);
     if (tiny_radfract[i] == NULL) {
       nrerror("Memory allocation error in mtclim_init() ...\n");
     }
@@ -134,9 +135,9 @@ void mtclim_wrapper(int have_dewpt, int have_shortwave, double hour_offset,
     nrerror("Error in data_free()... exiting\n");
   }
   for (i=0; i<366; i++) {
-    free(tiny_radfract[i]);
+    mem_free(tiny_radfract[i], MEM_MTCLIM);
   }
-  free(tiny_radfract);
+  mem_free(tiny_radfract, MEM_MTCLIM);
 }
   
 void mtclim_init(int have_dewpt, int have_shortwave, double elevation, double slope, double aspect,
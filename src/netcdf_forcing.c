@@ -0,0 +1,494 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <vicNl.h>
+#ifdef VIC_NETCDF
+#include <netcdf.h>
+#endif
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  netcdf_forcing.c	Keith Mathews			October 2026
+
+  Reader for gridded CF-NetCDF forcing files (FORCE_FORMAT NETCDF).
+  FORCING1 (and FORCING2) name a single NetCDF file rather than a path
+  prefix, and each FORCE_TYPE line gives the name of the file variable
+  that holds that forcing type, e.g.
+
+    FORCE_TYPE AIR_TEMP tas
+
+  Each variable must have the dimensions (time, lat, lon), in that
+  order, and the lat and lon dimensions must have coordinate variables
+  of the same names.  All variables of a file must share the same
+  dimensions.  The first record along time is at FORCEYEAR, FORCEMONTH,
+  FORCEDAY and FORCEHOUR, and records are FORCE_DT hours apart, as for
+  the other formats.  CF scale_factor and add_offset attributes are
+  applied, and a _FillValue (or missing_value) in the time series of an
+  active cell is an error.  Units are those of ASCII forcing files, or
+  of ALMA_INPUT if it is TRUE.  ALBEDO, LAI_IN and VEGCOVER cannot be
+  read from NetCDF files.
+
+  Cells are mapped to the nearest lat and lon coordinates (within half
+  a grid spacing; longitudes may be in [-180,180) or [0,360)), and
+  read_netcdf_forcing() reads the time series of one cell of each
+  variable directly into forcing_data, as read_atmos_data() does for
+  the other formats.
+
+  To avoid reading the chunks of a chunked (NetCDF-4/HDF5) file more
+  than once, netcdf_forcing_init() reorders the soil parameter file so
+  that cells are processed one spatial chunk of the first forcing file
+  at a time, and sizes the chunk cache of each variable to hold all
+  the chunks along time of one spatial chunk, up to NETCDF_CACHE_MAX MB
+  per variable.  The vegetation, snow band, lake and state files are
+  searched again from their first cell when a cell is not found, so
+  they need not be in the new order.  The NetCDF library is not
+  thread-safe, so reads are serialized (see force_disagg.c).
+
+  NetCDF support is compiled in only if VIC_NETCDF is defined (see
+  NETCDF_CFLAGS in the Makefile); otherwise FORCE_FORMAT NETCDF is an
+  error.
+
+  Modifications:
+**********************************************************************/
+
+#ifdef VIC_NETCDF
+
+typedef struct {
+  int     ncid;                       /* -1 if the file is not NETCDF */
+  char    name[MAXSTRING];
+  int     varid[N_FORCING_TYPES];
+  double  scale[N_FORCING_TYPES];     /* CF scale_factor */
+  double  offset[N_FORCING_TYPES];    /* CF add_offset */
+  double  fill[N_FORCING_TYPES];      /* _FillValue or missing_value */
+  char    has_fill[N_FORCING_TYPES];
+  int     dimid[3];                   /* time, lat, lon */
+  size_t  len[3];
+  size_t  chunk[3];                   /* chunk sizes of the first variable */
+  double *lat;
+  double *lon;
+} nc_forcing_file_struct;
+
+typedef struct {
+  long    key;                        /* spatial chunk of the cell */
+  int     ilat;
+  int     ilon;
+  int     order;                      /* position in the soil file */
+  char   *line;
+} nc_soil_line_struct;
+
+static nc_forcing_file_struct nc_file[2] = { { -1 }, { -1 } };
+static pthread_mutex_t        nc_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void nc_check(int status, char *what, char *fname)
+/* Stops the model if a NetCDF call failed. */
+{
+  char ErrStr[MAXSTRING];
+
+  if (status != NC_NOERR) {
+    snprintf(ErrStr, MAXSTRING, "NetCDF error %s in %s: %s", what, fname,
+             nc_strerror(status));
+    nrerror(ErrStr);
+  }
+}
+
+static double nc_att(int ncid, int varid, char *att, double def, char *found)
+/* Returns a numeric attribute of a variable, or def if it is absent. */
+{
+  double value;
+
+  if (nc_get_att_double(ncid, varid, att, &value) == NC_NOERR) {
+    if (found != NULL) *found = TRUE;
+    return value;
+  }
+  return def;
+}
+
+static int nc_nearest(double *coord, size_t n, double x, int is_lon)
+/* Returns the index of the coordinate nearest to x, or -1 if x is more
+   than half a grid spacing outside of the coordinates. */
+{
+  size_t i, best;
+  double d, dbest, spacing;
+
+  best = 0;
+  dbest = HUGE_RESIST;
+  for (i = 0; i < n; i++) {
+    d = fabs(coord[i] - x);
+    if (is_lon) {
+      d = fmod(d, 360.);
+      if (d > 180.) d = 360. - d;
+    }
+    if (d < dbest) {
+      dbest = d;
+      best = i;
+    }
+  }
+  spacing = (n > 1) ? fabs(coord[1] - coord[0]) : 0;
+  if (dbest > 0.5 * spacing + 1.e-6)
+    return -1;
+  return (int)best;
+}
+
+static size_t nc_next_prime(size_t n)
+{
+  size_t i;
+  int    prime;
+
+  for (;; n++) {
+    prime = (n > 1);
+    for (i = 2; prime && i * i <= n; i++)
+      if (n % i == 0) prime = FALSE;
+    if (prime) return n;
+  }
+}
+
+static void nc_skip_recs(int file_num, global_param_struct *global, int forceskip,
+                         size_t *skip, size_t *nrecs)
+/* Returns the first record and the number of records of forcing file
+   file_num that cover the simulation, with the checks of
+   read_atmos_data(). */
+{
+  extern param_set_struct param_set;
+  char ErrStr[MAXSTRING];
+
+  if((((global->dt < 24 && (param_set.FORCE_DT[file_num] * forceskip)
+	% global->dt) > 0))
+     || (global->dt == 24 && (global->dt
+				   % param_set.FORCE_DT[file_num] > 0)))
+    nrerror("Currently unable to handle a model starting date that does not correspond to a line in the forcing file.");
+  if(param_set.FORCE_DT[file_num] < 24
+     && global->dt != param_set.FORCE_DT[file_num]) {
+    sprintf(ErrStr,"When forcing the model with sub-daily data, the model must be run at the same time step as the forcing data.  Currently the model time step is %i hours, while forcing file %i has a time step of %i hours.",global->dt,file_num,param_set.FORCE_DT[file_num]);
+    nrerror(ErrStr);
+  }
+  *skip = (size_t)(global->dt * forceskip) / param_set.FORCE_DT[file_num];
+  *nrecs = ((size_t)global->nrecs * global->dt + param_set.FORCE_DT[file_num] - 1)
+           / param_set.FORCE_DT[file_num];
+}
+
+static void nc_open_forcing(int file_num, char *fname, global_param_struct *global)
+/* Opens a NetCDF forcing file, finds its variables and coordinates, and
+   sizes the chunk caches. */
+{
+  extern option_struct    options;
+  extern param_set_struct param_set;
+
+  nc_forcing_file_struct *f = &nc_file[file_num];
+  char    ErrStr[MAXSTRING];
+  char    dimname[NC_MAX_NAME+1];
+  char   *varname;
+  int     i, type, ndims, storage, first;
+  int     dimid[NC_MAX_VAR_DIMS];
+  int     coordid;
+  size_t  chunk[NC_MAX_VAR_DIMS];
+  size_t  skip, nrecs, nchunks, chunk_bytes, cache_bytes, max_bytes;
+  nc_type xtype;
+  size_t  type_size;
+
+  strcpy(f->name, fname);
+  nc_check(nc_open(fname, NC_NOWRITE, &f->ncid), "opening", fname);
+  nc_skip_recs(file_num, global, global->forceskip[file_num], &skip, &nrecs);
+  max_bytes = (size_t)options.NETCDF_CACHE_MAX * 1024 * 1024;
+
+  first = TRUE;
+  for (i = 0; i < param_set.N_TYPES[file_num]; i++) {
+    type = param_set.FORCE_INDEX[file_num][i];
+    f->varid[type] = -1;
+    if (type == SKIP)
+      continue;
+    varname = param_set.FORCE_VAR[type];
+    if (strlen(varname) == 0) {
+      snprintf(ErrStr, MAXSTRING, "No NetCDF variable name given for forcing variable %d of forcing file %d (FORCE_TYPE <type> <variable>).", i+1, file_num+1);
+      nrerror(ErrStr);
+    }
+    if (nc_inq_varid(f->ncid, varname, &f->varid[type]) != NC_NOERR) {
+      snprintf(ErrStr, MAXSTRING, "Variable %s not found in NetCDF forcing file %s.", varname, fname);
+      nrerror(ErrStr);
+    }
+
+    /** Dimensions must be (time, lat, lon), the same for all variables **/
+    nc_check(nc_inq_varndims(f->ncid, f->varid[type], &ndims), "reading dimensions", fname);
+    if (ndims != 3) {
+      snprintf(ErrStr, MAXSTRING, "Variable %s in NetCDF forcing file %s must have 3 dimensions (time, lat, lon), not %d.", varname, fname, ndims);
+      nrerror(ErrStr);
+    }
+    nc_check(nc_inq_vardimid(f->ncid, f->varid[type], dimid), "reading dimensions", fname);
+    if (first) {
+      f->dimid[0] = dimid[0];
+      f->dimid[1] = dimid[1];
+      f->dimid[2] = dimid[2];
+      nc_check(nc_inq_dimlen(f->ncid, dimid[0], &f->len[0]), "reading dimensions", fname);
+      nc_check(nc_inq_dimlen(f->ncid, dimid[1], &f->len[1]), "reading dimensions", fname);
+      nc_check(nc_inq_dimlen(f->ncid, dimid[2], &f->len[2]), "reading dimensions", fname);
+    }
+    else if (dimid[0] != f->dimid[0] || dimid[1] != f->dimid[1] || dimid[2] != f->dimid[2]) {
+      snprintf(ErrStr, MAXSTRING, "Variable %s in NetCDF forcing file %s does not have the same dimensions as the other forcing variables.", varname, fname);
+      nrerror(ErrStr);
+    }
+    if (skip + nrecs > f->len[0]) {
+      snprintf(ErrStr, MAXSTRING, "Not enough records in NetCDF forcing file %s (%d) to run the number of records defined in the global file (%d, starting at record %d).", fname, (int)f->len[0], (int)nrecs, (int)skip);
+      nrerror(ErrStr);
+    }
+
+    /** Packing and missing values **/
+    f->scale[type] = nc_att(f->ncid, f->varid[type], "scale_factor", 1., NULL);
+    f->offset[type] = nc_att(f->ncid, f->varid[type], "add_offset", 0., NULL);
+    f->has_fill[type] = FALSE;
+    f->fill[type] = nc_att(f->ncid, f->varid[type], "_FillValue", 0., &f->has_fill[type]);
+    if (!f->has_fill[type])
+      f->fill[type] = nc_att(f->ncid, f->varid[type], "missing_value", 0., &f->has_fill[type]);
+
+    /** Chunk cache: all chunks along time of one spatial chunk **/
+    nc_check(nc_inq_var_chunking(f->ncid, f->varid[type], &storage, chunk), "reading chunking", fname);
+    if (storage != NC_CHUNKED) {
+      chunk[0] = f->len[0];
+      chunk[1] = 1;
+      chunk[2] = 1;
+    }
+    if (first) {
+      f->chunk[0] = chunk[0];
+      f->chunk[1] = chunk[1];
+      f->chunk[2] = chunk[2];
+    }
+    if (storage == NC_CHUNKED) {
+      nc_check(nc_inq_vartype(f->ncid, f->varid[type], &xtype), "reading type", fname);
+      nc_check(nc_inq_type(f->ncid, xtype, NULL, &type_size), "reading type", fname);
+      nchunks = (skip + nrecs - 1) / chunk[0] - skip / chunk[0] + 1;
+      chunk_bytes = chunk[0] * chunk[1] * chunk[2] * type_size;
+      cache_bytes = nchunks * chunk_bytes;
+      if (max_bytes > 0 && cache_bytes > max_bytes) {
+        fprintf(stderr, "WARNING: the chunk cache of variable %s (%.1f MB) is limited to NETCDF_CACHE_MAX (%d MB); chunks will be read more than once.\n",
+                varname, cache_bytes / 1048576., options.NETCDF_CACHE_MAX);
+        cache_bytes = max_bytes;
+        nchunks = cache_bytes / chunk_bytes;
+      }
+      nc_check(nc_set_var_chunk_cache(f->ncid, f->varid[type], cache_bytes,
+                                      nc_next_prime(nchunks * 4 + 1), 0.),
+               "setting the chunk cache", fname);
+    }
+    first = FALSE;
+  }
+  if (first) {
+    snprintf(ErrStr, MAXSTRING, "No forcing variables defined for NetCDF forcing file %s.", fname);
+    nrerror(ErrStr);
+  }
+
+  /** Coordinates **/
+  f->lat = (double *)calloc(f->len[1], sizeof(double));
+  f->lon = (double *)calloc(f->len[2], sizeof(double));
+  if (f->lat == NULL || f->lon == NULL)
+    nrerror("Memory allocation failure in nc_open_forcing().");
+  for (i = 1; i <= 2; i++) {
+    nc_check(nc_inq_dimname(f->ncid, f->dimid[i], dimname), "reading dimensions", fname);
+    if (nc_inq_varid(f->ncid, dimname, &coordid) != NC_NOERR) {
+      snprintf(ErrStr, MAXSTRING, "No coordinate variable %s in NetCDF forcing file %s.", dimname, fname);
+      nrerror(ErrStr);
+    }
+    nc_check(nc_get_var_double(f->ncid, coordid, (i == 1) ? f->lat : f->lon),
+             "reading coordinates", fname);
+  }
+}
+
+static int nc_soil_line_cmp(const void *a, const void *b)
+{
+  const nc_soil_line_struct *la = (const nc_soil_line_struct *)a;
+  const nc_soil_line_struct *lb = (const nc_soil_line_struct *)b;
+
+  if (la->key != lb->key) return (la->key < lb->key) ? -1 : 1;
+  if (la->ilat != lb->ilat) return la->ilat - lb->ilat;
+  if (la->ilon != lb->ilon) return la->ilon - lb->ilon;
+  return la->order - lb->order;
+}
+
+static FILE *nc_sort_soilparam(FILE *soilparam, nc_forcing_file_struct *f)
+/* Returns a temporary copy of the soil parameter file, with the cells
+   in order of the spatial chunks of forcing file f (then by row and
+   column).  Cells outside of the grid are placed at the end.  The file
+   is read from its current position, i.e. after any header lines
+   skipped by open_file(). */
+{
+  nc_soil_line_struct *lines;
+  FILE   *sorted;
+  char   *line;
+  size_t  size;
+  int     nlines, maxlines, i, run, gridcel;
+  long    ntiles_lon;
+  double  lat, lng;
+
+  nlines = 0;
+  maxlines = 1024;
+  lines = (nc_soil_line_struct *)malloc(maxlines * sizeof(nc_soil_line_struct));
+  if (lines == NULL)
+    nrerror("Memory allocation failure in nc_sort_soilparam().");
+  ntiles_lon = (long)((f->len[2] + f->chunk[2] - 1) / f->chunk[2]);
+
+  line = NULL;
+  size = 0;
+  while (getline(&line, &size, soilparam) != -1) {
+    if (nlines == maxlines) {
+      maxlines *= 2;
+      lines = (nc_soil_line_struct *)realloc(lines, maxlines * sizeof(nc_soil_line_struct));
+      if (lines == NULL)
+        nrerror("Memory allocation failure in nc_sort_soilparam().");
+    }
+    lines[nlines].line = line;
+    lines[nlines].order = nlines;
+    lines[nlines].ilat = -1;
+    lines[nlines].ilon = -1;
+    if (sscanf(line, "%d %d %lf %lf", &run, &gridcel, &lat, &lng) == 4) {
+      lines[nlines].ilat = nc_nearest(f->lat, f->len[1], lat, FALSE);
+      lines[nlines].ilon = nc_nearest(f->lon, f->len[2], lng, TRUE);
+    }
+    if (lines[nlines].ilat < 0 || lines[nlines].ilon < 0)
+      lines[nlines].key = LONG_MAX;
+    else
+      lines[nlines].key = (lines[nlines].ilat / (long)f->chunk[1]) * ntiles_lon
+                          + lines[nlines].ilon / (long)f->chunk[2];
+    nlines++;
+    line = NULL;
+    size = 0;
+  }
+  free(line);
+  fclose(soilparam);
+
+  qsort(lines, nlines, sizeof(nc_soil_line_struct), nc_soil_line_cmp);
+
+  if ((sorted = tmpfile()) == NULL)
+    nrerror("Unable to create the sorted copy of the soil parameter file.");
+  for (i = 0; i < nlines; i++) {
+    fputs(lines[i].line, sorted);
+    free(lines[i].line);
+  }
+  free(lines);
+  rewind(sorted);
+
+  return sorted;
+}
+
+#endif /* VIC_NETCDF */
+
+void netcdf_forcing_init(filenames_struct    *names,
+                         global_param_struct *global,
+                         filep_struct        *filep)
+/**********************************************************************
+  netcdf_forcing_init	Keith Mathews			October 2026
+
+  Opens the NETCDF forcing files, and reorders the cells of the soil
+  parameter file (filep->soilparam is replaced by the reordered copy)
+  for the chunks of the first of them.  Does nothing if no forcing file
+  is NETCDF.
+
+  Modifications:
+**********************************************************************/
+{
+  extern param_set_struct param_set;
+  int i, sorted;
+
+  if (param_set.FORCE_FORMAT[0] != NETCDF && param_set.FORCE_FORMAT[1] != NETCDF)
+    return;
+
+#ifdef VIC_NETCDF
+  sorted = FALSE;
+  for (i = 0; i < 2; i++) {
+    if (param_set.FORCE_FORMAT[i] != NETCDF
+        || (i == 1 && param_set.N_TYPES[1] == MISSING))
+      continue;
+    nc_open_forcing(i, names->f_path_pfx[i], global);
+    if (!sorted) {
+      filep->soilparam = nc_sort_soilparam(filep->soilparam, &nc_file[i]);
+      sorted = TRUE;
+    }
+  }
+#else
+  nrerror("FORCE_FORMAT NETCDF requires VIC to be compiled with NetCDF support (see NETCDF_CFLAGS in the Makefile).");
+#endif /* VIC_NETCDF */
+}
+
+void read_netcdf_forcing(int                   file_num,
+                         double                lat,
+                         double                lng,
+                         global_param_struct   global_param,
+                         int                   forceskip,
+                         double              **forcing_data)
+/**********************************************************************
+  read_netcdf_forcing	Keith Mathews			October 2026
+
+  Reads the time series of the cell at (lat, lng) of each variable of
+  NETCDF forcing file file_num into forcing_data, converting them to
+  the units of an ASCII forcing file (see read_atmos_data()).
+
+  Modifications:
+**********************************************************************/
+{
+#ifdef VIC_NETCDF
+  extern param_set_struct param_set;
+
+  nc_forcing_file_struct *f = &nc_file[file_num];
+  char    ErrStr[2*MAXSTRING];
+  int     i, type, ilat, ilon;
+  size_t  rec, skip, nrecs;
+  size_t  start[3], count[3];
+
+  nc_skip_recs(file_num, &global_param, forceskip, &skip, &nrecs);
+  ilat = nc_nearest(f->lat, f->len[1], lat, FALSE);
+  ilon = nc_nearest(f->lon, f->len[2], lng, TRUE);
+  if (ilat < 0 || ilon < 0) {
+    snprintf(ErrStr, sizeof(ErrStr), "Cell at lat %f, lng %f is outside of the grid of NetCDF forcing file %s.", lat, lng, f->name);
+    nrerror(ErrStr);
+  }
+  start[0] = skip;
+  start[1] = ilat;
+  start[2] = ilon;
+  count[0] = nrecs;
+  count[1] = 1;
+  count[2] = 1;
+
+  for (i = 0; i < param_set.N_TYPES[file_num]; i++) {
+    type = param_set.FORCE_INDEX[file_num][i];
+    if (type == SKIP)
+      continue;
+    pthread_mutex_lock(&nc_lock);
+    nc_check(nc_get_vara_double(f->ncid, f->varid[type], start, count,
+                                forcing_data[type]),
+             "reading forcings", f->name);
+    pthread_mutex_unlock(&nc_lock);
+    for (rec = 0; rec < nrecs; rec++) {
+      if (f->has_fill[type] && forcing_data[type][rec] == f->fill[type]) {
+        snprintf(ErrStr, sizeof(ErrStr), "Missing value of %s in NetCDF forcing file %s at lat %f, lng %f, record %d.", param_set.FORCE_VAR[type], f->name, lat, lng, (int)(skip + rec));
+        nrerror(ErrStr);
+      }
+      forcing_data[type][rec] = forcing_data[type][rec] * f->scale[type]
+                                + f->offset[type];
+    }
+  }
+#else
+  nrerror("FORCE_FORMAT NETCDF requires VIC to be compiled with NetCDF support (see NETCDF_CFLAGS in the Makefile).");
+#endif /* VIC_NETCDF */
+}
+
+void netcdf_forcing_close()
+/**********************************************************************
+  netcdf_forcing_close	Keith Mathews			October 2026
+
+  Closes the NETCDF forcing files.
+
+  Modifications:
+**********************************************************************/
+{
+#ifdef VIC_NETCDF
+  int i;
+
+  for (i = 0; i < 2; i++) {
+    if (nc_file[i].ncid < 0)
+      continue;
+    nc_close(nc_file[i].ncid);
+    free((char *)nc_file[i].lat);
+    free((char *)nc_file[i].lon);
+    nc_file[i].ncid = -1;
+  }
+#endif /* VIC_NETCDF */
+}
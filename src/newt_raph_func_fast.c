@@ -30,16 +30,21 @@ int newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
   2012-Jan-28 Replaced local precompile variable MAXSIZE with VIC's
 	      MAX_NODES so that array lengths here are always in sync
 	      with array lengths in the rest of VIC.			TJB 
+  2026-Oct-17 Added solver_stats counters.			KM
 ******************************************************************/
 
+  extern solver_stats_struct solver_stats;
   int k, i, index[MAX_NODES], Error;
   double errx, errf, d, fvec[MAX_NODES], fjac[MAX_NODES*MAX_NODES], p[MAX_NODES];
   double a[MAX_NODES], b[MAX_NODES], c[MAX_NODES];
 
   Error = 0;
+  solver_stats.newt_raph_calls++;
 
   for (k=0; k<MAXTRIAL; k++) {
 
+    solver_stats.newt_raph_iter++;
+
     // calculate function value for all nodes, i.e. focus = -1
     (*vecfunc)(x, fvec, n, 0, -1);
 
@@ -113,10 +118,47 @@ void fdjac3(double x[], double fvec[], double a[], double b[], double c[],
  forward difference approx to Jacobian,
  adapted from "Numerical Recipes"
 
+  Modifications:
+  2026-Oct-17 Added IMPLICIT_JACOBIAN GROUPED: perturb every third node
+	      at once, and evaluate all residuals for each of the three
+	      groups, instead of one focused evaluation per node.
+	      Since residual i depends only on x[i-1], x[i] and x[i+1],
+	      the nodes of one group do not affect each other's
+	      columns, and the Jacobian takes 3 evaluations rather than
+	      n.  The default (NODE) is unchanged.			KM
 ******************************************************************/
 
-  int i, j;
+  extern option_struct options;
+
+  int i, j, group;
   double h, temp, f[MAX_NODES];
+  double hg[MAX_NODES], tempg[MAX_NODES];
+
+  if (options.IMPLICIT_JACOBIAN == IMPL_JAC_GROUPED) {
+    for (group=0; group<3 && group<n; group++) {
+
+      // perturb nodes group, group+3, group+6, ...
+      for (j=group; j<n; j+=3) {
+        tempg[j]=x[j];
+        hg[j]=EPS2*fabs(tempg[j]);
+        if (hg[j]==0) hg[j]=EPS2;
+        x[j]=tempg[j]+hg[j];
+        hg[j]=x[j]-tempg[j];
+      }
+
+      // calculate function value for all nodes, i.e. focus = -1
+      (*vecfunc)(x, f, n, 0, -1);
+
+      // columns j-1, j and j+1 are changed by x[j] only
+      for (j=group; j<n; j+=3) {
+        x[j]=tempg[j];
+        b[j]=(f[j]-fvec[j])/hg[j];
+        if (j!=0) c[j-1]=(f[j-1]-fvec[j-1])/hg[j];
+        if (j!=n-1) a[j+1]=(f[j+1]-fvec[j+1])/hg[j];
+      }
+    }
+    return;
+  }
 
   for (j=0; j<n; j++) {
     temp=x[j];
@@ -134,3 +134,30 @@ FILE *open_file(char string[],char type[])
 
   return stream;
 }
+
+void rewind_file(FILE *stream)
+/**********************************************************************
+  rewind_file		Keith Mathews			October 2026
+
+  Rewinds a file opened for reading by open_file(), and skips its
+  header lines (lines starting with #), as open_file() does.
+
+  Modifications:
+**********************************************************************/
+{
+  char jnkstr[MAXSTRING];
+  int  temp, headcnt, i;
+
+  rewind(stream);
+  temp=fgetc(stream);
+  while(temp==32) temp=fgetc(stream);
+  headcnt = 0;
+  while(temp==35) {
+    fgets(jnkstr,MAXSTRING,stream);
+    temp=fgetc(stream);
+    while(temp==32) temp=fgetc(stream);
+    headcnt++;
+  }
+  rewind(stream);
+  for(i=0;i<headcnt;i++) fgets(jnkstr,MAXSTRING,stream);
+}
@@ -0,0 +1,505 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  out_stats.c		Keith Mathews			October 2026
+
+  Optional temporal statistics of output variables, accumulated while
+  the model runs so that climatologies, extremes, and percentiles do
+  not have to be derived afterwards from the full per-cell output
+  series.
+
+  Each STATVAR line of the global parameter file names an output
+  variable, optionally followed by a threshold:
+
+    STATVAR <varname> [<threshold>]
+
+  At each output interval after the SKIPYEAR period, put_data() passes
+  the aggregated value of each element of each STATVAR (after the
+  conversion to ALMA units, if any) to out_stats_accumulate(), which
+  updates, for each element:
+
+    - the count, running mean, and variance (Welford's algorithm);
+    - the overall minimum and maximum;
+    - the number of intervals with values above the threshold (if
+      given);
+    - the mean of each month of the year (climatology);
+    - the minimum and maximum of each year, with their dates;
+    - a quantile sketch, from which the STAT_QUANTILES quantiles
+      (default 0.05, 0.5, 0.95) are estimated.
+
+  The sketch is the deterministic compacting buffer scheme of Manku,
+  Rajagopalan and Lindsay (1998): values enter a buffer of
+  STAT_SKETCH_K values; when a buffer at level h is full, it is
+  sorted and every other value (alternately the odd and even ones) is
+  moved to level h+1, where it stands for 2^(h+1) values.  The error
+  in rank is bounded by about (number of levels) / STAT_SKETCH_K of
+  the number of values, regardless of the order in which the values
+  arrive, which matters for the strongly seasonal series of the model
+  (streaming estimators that assume random order, such as the P-square
+  algorithm, are badly biased on them).  The sketch takes
+  STAT_SKETCH_K values per level, i.e. about 8 kB per variable element
+  for 10 years of 3-hourly output.
+
+  At the end of each cell, out_stats_end_cell() writes one ASCII file
+  to RESULT_DIR, named <STAT_PREFIX>_<lat>_<lng>, with one section per
+  kind of statistic.  If STAT_ONLY is TRUE, the per-cell output series
+  files are not written.
+
+  Modifications:
+**********************************************************************/
+
+#define MAX_STAT_QUANTILES 9
+#define STAT_SKETCH_K      128   /* values per sketch level (even) */
+#define STAT_SKETCH_LEVELS 32
+
+typedef struct {
+  double *buf[STAT_SKETCH_LEVELS];  /* values at each level */
+  int     n[STAT_SKETCH_LEVELS];    /* number of values at each level */
+  char    odd[STAT_SKETCH_LEVELS];  /* which half to keep at the next compaction */
+  int     nlevels;
+} sketch_struct;
+
+typedef struct {
+  double  n;
+  double  mean;
+  double  m2;            /* sum of squared deviations from the mean */
+  double  min;
+  double  max;
+  double  nexceed;
+  double  mon_sum[12];
+  double  mon_n[12];
+  sketch_struct sketch;
+  double *yr_min;        /* [year] */
+  double *yr_max;
+  dmy_struct *yr_min_dmy;
+  dmy_struct *yr_max_dmy;
+} stat_value_struct;
+
+typedef struct {
+  double  value;
+  double  weight;
+} sketch_item_struct;
+
+static int      stat_vars[N_OUTVAR_TYPES];     /* STATVARs, in order given */
+static double   stat_thresh[N_OUTVAR_TYPES];
+static char     stat_has_thresh[N_OUTVAR_TYPES];
+static int      nstat_vars = 0;
+static double   quantiles[MAX_STAT_QUANTILES] = { 0.05, 0.5, 0.95 };
+static int      nquantiles = 3;
+static stat_value_struct *values = NULL;
+static int      nvalues = 0;
+static sketch_item_struct *items = NULL;   /* work array for quantiles */
+static int      first_year;
+static int      nyears;
+static int      out_dt = 24;
+static char    *result_dir;
+static char    *stat_prefix;
+
+static int double_cmp(const void *a, const void *b)
+{
+  double da = *(const double *)a;
+  double db = *(const double *)b;
+
+  return (da < db) ? -1 : (da > db);
+}
+
+static int item_cmp(const void *a, const void *b)
+{
+  return double_cmp(&((const sketch_item_struct *)a)->value,
+                    &((const sketch_item_struct *)b)->value);
+}
+
+static void sketch_add(sketch_struct *sk, double x, int h)
+/* Adds x to level h of the sketch, compacting full levels. */
+{
+  double *buf;
+  int     i, j;
+
+  if (h >= STAT_SKETCH_LEVELS)
+    nrerror("Output statistics sketch overflow in sketch_add().");
+  if (sk->buf[h] == NULL)
+    sk->buf[h] = (double *)mem_calloc(STAT_SKETCH_K, sizeof(double), MEM_OUTPUT);
+  if (h >= sk->nlevels)
+    sk->nlevels = h + 1;
+  sk->buf[h][sk->n[h]++] = x;
+  if (sk->n[h] < STAT_SKETCH_K)
+    return;
+
+  /* compact: promote every other sorted value to the next level */
+  buf = sk->buf[h];
+  qsort(buf, STAT_SKETCH_K, sizeof(double), double_cmp);
+  sk->n[h] = 0;
+  j = sk->odd[h];
+  sk->odd[h] = !sk->odd[h];
+  for (i = j; i < STAT_SKETCH_K; i += 2)
+    sketch_add(sk, buf[i], h + 1);
+}
+
+static double sketch_quantile(sketch_struct *sk, double p)
+/* Returns the estimate of quantile p from the sketch. */
+{
+  double total, cum;
+  int    h, i, n;
+
+  n = 0;
+  total = 0;
+  for (h = 0; h < sk->nlevels; h++) {
+    for (i = 0; i < sk->n[h]; i++) {
+      items[n].value = sk->buf[h][i];
+      items[n].weight = (double)(1 << h);
+      total += items[n].weight;
+      n++;
+    }
+  }
+  if (n == 0)
+    return 0;
+  qsort(items, n, sizeof(sketch_item_struct), item_cmp);
+  cum = 0;
+  for (i = 0; i < n - 1; i++) {
+    cum += items[i].weight;
+    if (cum > p * total)
+      break;
+  }
+  return items[i].value;
+}
+
+static void stat_print_date(FILE *fp, dmy_struct *dmy)
+{
+  if (out_dt < 24)
+    fprintf(fp, "\t%04i-%02i-%02i-%02i", dmy->year, dmy->month, dmy->day, dmy->hour);
+  else
+    fprintf(fp, "\t%04i-%02i-%02i", dmy->year, dmy->month, dmy->day);
+}
+
+int out_stats_add_var(out_data_struct *out_data,
+                      char            *cmdstr)
+/**********************************************************************
+  out_stats_add_var	Keith Mathews			October 2026
+
+  Adds the output variable of a STATVAR line of the global parameter
+  file (with its threshold, if any) to the list of variables for which
+  statistics are computed.  Returns -1 if the name is unknown.
+
+  Modifications:
+**********************************************************************/
+{
+  char   varname[MAXSTRING];
+  double thresh;
+  int    nread, varid, i;
+
+  nread = sscanf(cmdstr, "%*s %s %lf", varname, &thresh);
+  if (nread < 1) {
+    fprintf(stderr, "Error: out_stats_add_var: no variable name was given.\n");
+    return -1;
+  }
+  for (varid = 0; varid < N_OUTVAR_TYPES; varid++) {
+    if (strcmp(out_data[varid].varname, varname) == 0) {
+      for (i = 0; i < nstat_vars && stat_vars[i] != varid; i++)
+        ;
+      if (i == nstat_vars)
+        stat_vars[nstat_vars++] = varid;
+      stat_has_thresh[i] = (nread == 2);
+      stat_thresh[i] = (nread == 2) ? thresh : 0;
+      return 0;
+    }
+  }
+  fprintf(stderr, "Error: out_stats_add_var: \"%s\" was not found in the list of supported output variable names.  Please use the exact name listed in vicNl_def.h.\n", varname);
+  return -1;
+}
+
+int out_stats_set_quantiles(char *cmdstr)
+/**********************************************************************
+  out_stats_set_quantiles	Keith Mathews		October 2026
+
+  Sets the quantiles estimated for each STATVAR from a STAT_QUANTILES
+  line of the global parameter file.  Returns -1 if the list is
+  invalid.
+
+  Modifications:
+**********************************************************************/
+{
+  char   *tok;
+  char    str[MAXSTRING];
+  double  p;
+  int     n;
+
+  strncpy(str, cmdstr, MAXSTRING - 1);
+  str[MAXSTRING - 1] = '\0';
+  n = 0;
+  tok = strtok(str, " \t\n");   /* option name */
+  while ((tok = strtok(NULL, " \t\n")) != NULL && tok[0] != '#') {
+    if (n == MAX_STAT_QUANTILES) {
+      fprintf(stderr, "Error: out_stats_set_quantiles: at most %d quantiles may be given.\n", MAX_STAT_QUANTILES);
+      return -1;
+    }
+    if (sscanf(tok, "%lf", &p) != 1 || p <= 0 || p >= 1) {
+      fprintf(stderr, "Error: out_stats_set_quantiles: \"%s\" is not a quantile between 0 and 1.\n", tok);
+      return -1;
+    }
+    quantiles[n++] = p;
+  }
+  if (n == 0) {
+    fprintf(stderr, "Error: out_stats_set_quantiles: no quantiles were given.\n");
+    return -1;
+  }
+  nquantiles = n;
+  return 0;
+}
+
+void out_stats_init(filenames_struct    *names,
+                    global_param_struct *global,
+                    out_data_struct     *out_data,
+                    dmy_struct          *dmy)
+/**********************************************************************
+  out_stats_init	Keith Mathews			October 2026
+
+  Allocates the statistics of each element of each STATVAR.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int v, i;
+
+  if (nstat_vars == 0) {
+    if (options.STAT_ONLY)
+      nrerror("STAT_ONLY = TRUE was specified, but no STATVAR has been defined.");
+    return;
+  }
+
+  out_dt = global->out_dt;
+  result_dir = names->result_dir;
+  stat_prefix = names->stat_prefix;
+  first_year = dmy[0].year;
+  nyears = dmy[global->nrecs - 1].year - first_year + 1;
+
+  nvalues = 0;
+  for (v = 0; v < nstat_vars; v++)
+    nvalues += out_data[stat_vars[v]].nelem;
+  values = (stat_value_struct *)mem_calloc(nvalues, sizeof(stat_value_struct), MEM_OUTPUT);
+  for (i = 0; i < nvalues; i++) {
+    values[i].yr_min = (double *)mem_calloc(nyears, sizeof(double), MEM_OUTPUT);
+    values[i].yr_max = (double *)mem_calloc(nyears, sizeof(double), MEM_OUTPUT);
+    values[i].yr_min_dmy = (dmy_struct *)mem_calloc(nyears, sizeof(dmy_struct), MEM_OUTPUT);
+    values[i].yr_max_dmy = (dmy_struct *)mem_calloc(nyears, sizeof(dmy_struct), MEM_OUTPUT);
+  }
+  items = (sketch_item_struct *)mem_calloc(STAT_SKETCH_LEVELS * STAT_SKETCH_K, sizeof(sketch_item_struct), MEM_OUTPUT);
+}
+
+void out_stats_start_cell()
+/**********************************************************************
+  out_stats_start_cell	Keith Mathews			October 2026
+
+  Resets the statistics for a new cell.
+
+  Modifications:
+**********************************************************************/
+{
+  stat_value_struct *sv;
+  int i, j;
+
+  for (i = 0; i < nvalues; i++) {
+    sv = &values[i];
+    sv->n = 0;
+    sv->mean = 0;
+    sv->m2 = 0;
+    sv->nexceed = 0;
+    for (j = 0; j < 12; j++)
+      sv->mon_sum[j] = sv->mon_n[j] = 0;
+    for (j = 0; j < nyears; j++) {
+      sv->yr_min[j] = HUGE_VAL;
+      sv->yr_max[j] = -HUGE_VAL;
+    }
+    for (j = 0; j < STAT_SKETCH_LEVELS; j++) {
+      sv->sketch.n[j] = 0;
+      sv->sketch.odd[j] = 0;
+    }
+    sv->sketch.nlevels = 0;
+  }
+}
+
+void out_stats_accumulate(out_data_struct *out_data,
+                          dmy_struct      *dmy)
+/**********************************************************************
+  out_stats_accumulate	Keith Mathews			October 2026
+
+  Adds the aggregated values of the current output interval to the
+  statistics.  Called from put_data() at each output interval after
+  the SKIPYEAR period.
+
+  Modifications:
+**********************************************************************/
+{
+  stat_value_struct *sv;
+  double x, delta;
+  int    v, e, i, yr;
+
+  if (nvalues == 0)
+    return;
+
+  yr = dmy->year - first_year;
+  i = 0;
+  for (v = 0; v < nstat_vars; v++) {
+    for (e = 0; e < out_data[stat_vars[v]].nelem; e++, i++) {
+      sv = &values[i];
+      x = out_data[stat_vars[v]].aggdata[e];
+
+      /* mean, variance, and extremes */
+      sv->n += 1;
+      delta = x - sv->mean;
+      sv->mean += delta / sv->n;
+      sv->m2 += delta * (x - sv->mean);
+      if (sv->n == 1 || x < sv->min)
+        sv->min = x;
+      if (sv->n == 1 || x > sv->max)
+        sv->max = x;
+      if (stat_has_thresh[v] && x > stat_thresh[v])
+        sv->nexceed += 1;
+
+      /* climatology */
+      sv->mon_sum[dmy->month - 1] += x;
+      sv->mon_n[dmy->month - 1] += 1;
+
+      /* annual extremes */
+      if (yr >= 0 && yr < nyears) {
+        if (x < sv->yr_min[yr]) {
+          sv->yr_min[yr] = x;
+          sv->yr_min_dmy[yr] = *dmy;
+        }
+        if (x > sv->yr_max[yr]) {
+          sv->yr_max[yr] = x;
+          sv->yr_max_dmy[yr] = *dmy;
+        }
+      }
+
+      /* quantiles */
+      sketch_add(&sv->sketch, x, 0);
+    }
+  }
+}
+
+void out_stats_end_cell(out_data_struct *out_data,
+                        soil_con_struct *soil_con)
+/**********************************************************************
+  out_stats_end_cell	Keith Mathews			October 2026
+
+  Writes the statistics of the current cell to
+  <RESULT_DIR>/<STAT_PREFIX>_<lat>_<lng>.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  static char *month_names[12] = { "JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                                   "JUL", "AUG", "SEP", "OCT", "NOV", "DEC" };
+  FILE   *fp;
+  char    filename[2*MAXSTRING+48];
+  char    fmt[8];
+  char    latchar[20], lngchar[20];
+  stat_value_struct *sv;
+  int     v, e, i, j, y;
+
+  if (nvalues == 0)
+    return;
+
+  sprintf(fmt, "%%.%if", options.GRID_DECIMAL);
+  sprintf(latchar, fmt, soil_con->lat);
+  sprintf(lngchar, fmt, soil_con->lng);
+  sprintf(filename, "%s/%s_%s_%s", result_dir, stat_prefix, latchar, lngchar);
+  fp = open_file(filename, "w");
+
+  fprintf(fp, "# STATISTICS %s %s\n", latchar, lngchar);
+  fprintf(fp, "# VARIABLE\tELEM\tN\tMEAN\tVARIANCE\tSTDEV\tMIN\tMAX\tN_EXCEED");
+  for (j = 0; j < nquantiles; j++)
+    fprintf(fp, "\tQ%g", quantiles[j]);
+  fprintf(fp, "\n");
+  for (v = 0, i = 0; v < nstat_vars; v++) {
+    for (e = 0; e < out_data[stat_vars[v]].nelem; e++, i++) {
+      sv = &values[i];
+      fprintf(fp, "%s\t%d\t%.0f\t%.6g\t%.6g\t%.6g\t%.6g\t%.6g",
+              out_data[stat_vars[v]].varname, e, sv->n, sv->mean,
+              (sv->n > 1) ? sv->m2 / (sv->n - 1) : 0.,
+              (sv->n > 1) ? sqrt(sv->m2 / (sv->n - 1)) : 0.,
+              sv->min, sv->max);
+      if (stat_has_thresh[v])
+        fprintf(fp, "\t%.0f", sv->nexceed);
+      else
+        fprintf(fp, "\t-");
+      for (j = 0; j < nquantiles; j++)
+        fprintf(fp, "\t%.6g", sketch_quantile(&sv->sketch, quantiles[j]));
+      fprintf(fp, "\n");
+    }
+  }
+
+  fprintf(fp, "# MONTHLY MEANS\n");
+  fprintf(fp, "# VARIABLE\tELEM");
+  for (j = 0; j < 12; j++)
+    fprintf(fp, "\t%s", month_names[j]);
+  fprintf(fp, "\n");
+  for (v = 0, i = 0; v < nstat_vars; v++) {
+    for (e = 0; e < out_data[stat_vars[v]].nelem; e++, i++) {
+      sv = &values[i];
+      fprintf(fp, "%s\t%d", out_data[stat_vars[v]].varname, e);
+      for (j = 0; j < 12; j++) {
+        if (sv->mon_n[j] > 0)
+          fprintf(fp, "\t%.6g", sv->mon_sum[j] / sv->mon_n[j]);
+        else
+          fprintf(fp, "\t-");
+      }
+      fprintf(fp, "\n");
+    }
+  }
+
+  fprintf(fp, "# ANNUAL EXTREMES\n");
+  fprintf(fp, "# VARIABLE\tELEM\tYEAR\tMIN\tMIN_DATE\tMAX\tMAX_DATE\n");
+  for (v = 0, i = 0; v < nstat_vars; v++) {
+    for (e = 0; e < out_data[stat_vars[v]].nelem; e++, i++) {
+      sv = &values[i];
+      for (y = 0; y < nyears; y++) {
+        if (sv->yr_max[y] < sv->yr_min[y])
+          continue;   /* no values in this year */
+        fprintf(fp, "%s\t%d\t%04d\t%.6g", out_data[stat_vars[v]].varname,
+                e, first_year + y, sv->yr_min[y]);
+        stat_print_date(fp, &sv->yr_min_dmy[y]);
+        fprintf(fp, "\t%.6g", sv->yr_max[y]);
+        stat_print_date(fp, &sv->yr_max_dmy[y]);
+        fprintf(fp, "\n");
+      }
+    }
+  }
+
+  fclose(fp);
+}
+
+void out_stats_free()
+/**********************************************************************
+  out_stats_free	Keith Mathews			October 2026
+
+  Frees the statistics.
+
+  Modifications:
+**********************************************************************/
+{
+  int i, h;
+
+  for (i = 0; i < nvalues; i++) {
+    for (h = 0; h < STAT_SKETCH_LEVELS; h++)
+      mem_free(values[i].sketch.buf[h], MEM_OUTPUT);
+    mem_free(values[i].yr_min, MEM_OUTPUT);
+    mem_free(values[i].yr_max, MEM_OUTPUT);
+    mem_free(values[i].yr_min_dmy, MEM_OUTPUT);
+    mem_free(values[i].yr_max_dmy, MEM_OUTPUT);
+  }
+  if (values != NULL) {
+    mem_free(values, MEM_OUTPUT);
+    mem_free(items, MEM_OUTPUT);
+  }
+  values = NULL;
+  nvalues = 0;
+}
@@ -64,13 +64,14 @@ out_data_struct *create_output_list() {
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2014-Apr-25 Added OUT_LAI.						TJB
   2014-Apr-25 Added OUT_VEGCOVER.					TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 *************************************************************/
 
   extern option_struct options;
   int v;
   out_data_struct *out_data;
 
-  out_data = (out_data_struct *)calloc(N_OUTVAR_TYPES,sizeof(out_data_struct));
+  out_data = (out_data_struct *)mem_calloc(N_OUTVAR_TYPES,sizeof(out_data_struct), MEM_OUTPUT);
 
   // Build the list of supported output variables
 
@@ -386,8 +387,8 @@ out_data_struct *create_output_list() {
 
   // Allocate space for data
   for (v=0; v<N_OUTVAR_TYPES; v++) {
-    out_data[v].data = (double *)calloc(out_data[v].nelem, sizeof(double));
-    out_data[v].aggdata = (double *)calloc(out_data[v].nelem, sizeof(double));
+    out_data[v].data = (double *)mem_calloc(out_data[v].nelem, sizeof(double), MEM_OUTPUT);
+    out_data[v].aggdata = (double *)mem_calloc(out_data[v].nelem, sizeof(double), MEM_OUTPUT);
   }
 
   // Initialize data values
@@ -478,20 +479,74 @@ void zero_output_list(out_data_struct *out_data) {
 
 }
 
+out_data_struct *copy_output_list(out_data_struct *out_data) {
+/*************************************************************
+  copy_output_list()      Keith Mathews     October 2026
+
+  This routine creates a copy of the list of output variables, with
+  its own data arrays, e.g. for use by another thread.
+
+*************************************************************/
+  out_data_struct *copy;
+  int varid, i;
+
+  copy = (out_data_struct *)mem_calloc(N_OUTVAR_TYPES, sizeof(out_data_struct), MEM_OUTPUT);
+  for (varid=0; varid<N_OUTVAR_TYPES; varid++) {
+    copy[varid] = out_data[varid];
+    copy[varid].data = (double *)mem_calloc(out_data[varid].nelem, sizeof(double), MEM_OUTPUT);
+    copy[varid].aggdata = (double *)mem_calloc(out_data[varid].nelem, sizeof(double), MEM_OUTPUT);
+    for (i=0; i<out_data[varid].nelem; i++) {
+      copy[varid].data[i] = out_data[varid].data[i];
+      copy[varid].aggdata[i] = out_data[varid].aggdata[i];
+    }
+  }
+
+  return copy;
+
+}
+
+out_data_file_struct *copy_out_data_files(out_data_file_struct *out_data_files) {
+/*************************************************************
+  copy_out_data_files()      Keith Mathews     October 2026
+
+  This routine creates a copy of the out_data_files array, with its
+  own varid arrays and no open files, e.g. for use by another thread.
+
+*************************************************************/
+  extern option_struct options;
+  out_data_file_struct *copy;
+  int filenum, i;
+
+  copy = (out_data_file_struct *)mem_calloc(options.Noutfiles, sizeof(out_data_file_struct), MEM_OUTPUT);
+  for (filenum=0; filenum<options.Noutfiles; filenum++) {
+    copy[filenum] = out_data_files[filenum];
+    copy[filenum].fh = NULL;
+    copy[filenum].varid = (int *)mem_calloc(out_data_files[filenum].nvars, sizeof(int), MEM_OUTPUT);
+    for (i=0; i<out_data_files[filenum].nvars; i++)
+      copy[filenum].varid[i] = out_data_files[filenum].varid[i];
+  }
+
+  return copy;
+
+}
+
 void free_out_data_files(out_data_file_struct **out_data_files) {
 /*************************************************************
   free_out_data_files()      Ted Bohn     September 08, 2006
 
   This routine frees the memory in the out_data_files array.
 
+  Modifications:
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
+
 *************************************************************/
   extern option_struct options;
   int filenum;
 
   for (filenum=0; filenum<options.Noutfiles; filenum++) {
-    free((char*)(*out_data_files)[filenum].varid);
+    mem_free((char*)(*out_data_files)[filenum].varid, MEM_OUTPUT);
   }
-  free((char*)(*out_data_files));
+  mem_free((char*)(*out_data_files), MEM_OUTPUT);
 
 }
 
@@ -501,15 +556,18 @@ void free_out_data(out_data_struct **out_data) {
 
   This routine frees the memory in the out_data array.
 
+  Modifications:
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
+
 *************************************************************/
 
   int varid;
 
   for (varid=0; varid<N_OUTVAR_TYPES; varid++) {
-    free((char*)(*out_data)[varid].data);
-    free((char*)(*out_data)[varid].aggdata);
+    mem_free((char*)(*out_data)[varid].data, MEM_OUTPUT);
+    mem_free((char*)(*out_data)[varid].aggdata, MEM_OUTPUT);
   }
-  free((char*)(*out_data));
+  mem_free((char*)(*out_data), MEM_OUTPUT);
 
 }
 
@@ -28,6 +28,12 @@ void parse_output_info(filenames_struct      *names,
   2009-Mar-15 Added default values for format, typestr, and
 	      multstr, so that they can be omitted from global
 	      param file.					TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
+  2026-Oct-17 Added REGIONVAR.					KM
+  2026-Oct-17 Added STATVAR and STAT_QUANTILES.			KM
+  2026-Oct-17 Added SHMVAR.					KM
+  2026-Oct-17 Sets PET_OUTPUT if any OUTVAR, REGIONVAR, SHMVAR or
+	      STATVAR is an OUT_PET_* variable.			KM
 **********************************************************************/
 {
   extern option_struct    options;
@@ -64,7 +70,7 @@ void parse_output_info(filenames_struct      *names,
         sscanf(cmdstr,"%*s %d",&tmp_noutfiles);
         free_out_data_files(out_data_files);
         options.Noutfiles = tmp_noutfiles;
-        *out_data_files = (out_data_file_struct *)calloc(options.Noutfiles, sizeof(out_data_file_struct));
+        *out_data_files = (out_data_file_struct *)mem_calloc(options.Noutfiles, sizeof(out_data_file_struct), MEM_OUTPUT);
         outfilenum = -1;
         init_output_list(out_data, FALSE, "%.4f", OUT_TYPE_FLOAT, 1);
         // PRT_SNOW_BAND is ignored if N_OUTFILES has been specified
@@ -80,7 +86,7 @@ void parse_output_info(filenames_struct      *names,
           nrerror(ErrStr);
         }
         sscanf(cmdstr,"%*s %s %d",(*out_data_files)[outfilenum].prefix,&((*out_data_files)[outfilenum].nvars));
-        (*out_data_files)[outfilenum].varid = (int *)calloc((*out_data_files)[outfilenum].nvars, sizeof(int));
+        (*out_data_files)[outfilenum].varid = (int *)mem_calloc((*out_data_files)[outfilenum].nvars, sizeof(int), MEM_OUTPUT);
         outvarnum = 0;
       }
       else if(strcasecmp("OUTVAR",optstr)==0) {
@@ -115,9 +121,40 @@ void parse_output_info(filenames_struct      *names,
         if (set_output_var((*out_data_files), TRUE, outfilenum, out_data, varname, outvarnum, format, type, mult) != 0) {
           nrerror("Error in global param file: Invalid output variable specification.");
         }
+        if (strncmp(varname,"OUT_PET_",8) == 0)
+          options.PET_OUTPUT = TRUE;
         strcpy(format,"");
         outvarnum++;
       }
+      else if(strcasecmp("REGIONVAR",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",varname);
+        if (region_add_var(out_data, varname) != 0) {
+          nrerror("Error in global param file: Invalid region variable specification.");
+        }
+        if (strncmp(varname,"OUT_PET_",8) == 0)
+          options.PET_OUTPUT = TRUE;
+      }
+      else if(strcasecmp("SHMVAR",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",varname);
+        if (shm_output_add_var(out_data, varname) != 0) {
+          nrerror("Error in global param file: Invalid shared-memory variable specification.");
+        }
+        if (strncmp(varname,"OUT_PET_",8) == 0)
+          options.PET_OUTPUT = TRUE;
+      }
+      else if(strcasecmp("STATVAR",optstr)==0) {
+        if (out_stats_add_var(out_data, cmdstr) != 0) {
+          nrerror("Error in global param file: Invalid statistics variable specification.");
+        }
+        sscanf(cmdstr,"%*s %s",varname);
+        if (strncmp(varname,"OUT_PET_",8) == 0)
+          options.PET_OUTPUT = TRUE;
+      }
+      else if(strcasecmp("STAT_QUANTILES",optstr)==0) {
+        if (out_stats_set_quantiles(cmdstr) != 0) {
+          nrerror("Error in global param file: Invalid STAT_QUANTILES specification.");
+        }
+      }
 
     }
     fgets(cmdstr,MAXSTRING,gp);
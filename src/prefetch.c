@@ -0,0 +1,314 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  prefetch.c		Keith Mathews			October 2026
+
+  Read-ahead of the inputs of the next cells.  When PREFETCH_DEPTH is
+  greater than 0, vicNl.c calls prefetch_start() before the cell loop,
+  and a background I/O thread then reads the soil parameter file, and
+  for each active cell opens its forcing files (make_in_files()), reads
+  them (read_forcing_data()), and closes them again.  Up to
+  PREFETCH_DEPTH cells that have been read are held in a queue.  The
+  cell loop takes the next cell from the queue with prefetch_next_cell()
+  instead of read_soilparam(), and initialize_atmos() takes its forcing
+  arrays with prefetch_forcing_data() instead of read_forcing_data(), so
+  that the forcings of the next cells are read while the current cell
+  is simulated.  Cells are taken in the order of the soil parameter
+  file, so the results are identical to those of a run without
+  read-ahead.  The vegetation, lake and snow band parameters of each
+  cell are still read by the cell loop; if there are veg_hist forcings
+  (ALBEDO, LAI_IN or VEGCOVER), whose number of elements is the cell's
+  number of vegetation tiles, the I/O thread finds that number in its
+  own handle on the vegetation parameter file.
+
+  The memory accounting and the forcing cache keep global state, and
+  cannot be combined with PREFETCH_DEPTH > 0 (see get_global_param()).
+  prefetch_end() prints to stderr the time the cell loop spent waiting
+  for inputs, and the time the I/O thread spent reading and waiting for
+  a free place in the queue.
+
+  Modifications:
+**********************************************************************/
+
+typedef struct {
+  soil_con_struct   soil_con;
+  double          **forcing_data;
+  double         ***veg_hist_data;
+  int               Nveg_hist;  /* elements of each veg_hist forcing */
+} prefetch_cell_struct;
+
+static prefetch_cell_struct *queue = NULL;  /* ring buffer of cells */
+static int                   queue_size = 0;
+static int                   queue_head = 0; /* index of next cell to take */
+static int                   queue_count = 0;
+static int                   queue_closed = FALSE;
+static pthread_mutex_t       queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t        queue_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t        queue_not_full = PTHREAD_COND_INITIALIZER;
+static pthread_t             io_thread;
+
+static FILE                 *prefetch_soilparam;
+static filenames_struct      prefetch_names;
+static global_param_struct   prefetch_global;
+static FILE                 *prefetch_vegparam = NULL;
+
+/* forcings of the cell last returned by prefetch_next_cell() */
+static double              **cur_forcing_data = NULL;
+static double             ***cur_veg_hist_data = NULL;
+static int                   cur_Nveg_hist = 0;
+
+/* statistics */
+static int                   ncells = 0;
+static int                   nwaits = 0;     /* cells the loop waited for */
+static double                loop_wait = 0;  /* s the cell loop waited */
+static double                io_read = 0;    /* s the I/O thread read */
+static double                io_wait = 0;    /* s the I/O thread waited */
+
+static double prefetch_now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec);
+}
+
+static int prefetch_veg_tiles(int gridcel)
+/* Returns the number of vegetation tiles of cell gridcel in the
+   vegetation parameter file, searching for it as read_vegparam() does,
+   and skips the cell's tile lines. */
+{
+  extern option_struct options;
+  char   str[500];
+  char   ErrStr[MAXSTRING];
+  int    vegcel, vegetat_type_num, skip, i, pass;
+
+  skip = 1;
+  if(options.VEGPARAM_LAI) skip++;
+  if(options.VEGPARAM_VEGCOVER) skip++;
+  if(options.VEGPARAM_ALB) skip++;
+
+  vegcel = -1;
+  vegetat_type_num = 0;
+  for ( pass = 0; pass < 2 && vegcel != gridcel; pass++ ) {
+    if ( pass > 0 ) rewind_file(prefetch_vegparam);
+    while ( fscanf(prefetch_vegparam, "%d %d", &vegcel, &vegetat_type_num) == 2 ) {
+      if (vegetat_type_num < 0) {
+        sprintf(ErrStr,"ERROR number of vegetation tiles (%i) given for cell %i is < 0.\n",vegetat_type_num,vegcel);
+        nrerror(ErrStr);
+      }
+      for (i = 0; i <= vegetat_type_num * skip; i++) {
+        if ( fgets(str, 500, prefetch_vegparam) == NULL ) {
+          sprintf(ErrStr,"ERROR unexpected EOF for cell %i while reading root zones and LAI\n",vegcel);
+          nrerror(ErrStr);
+        }
+      }
+      if ( vegcel == gridcel ) break;
+    }
+  }
+  if (vegcel != gridcel) {
+    sprintf(ErrStr,"Error in vegetation file.  Grid cell %d not found\n",gridcel);
+    nrerror(ErrStr);
+  }
+
+  return vegetat_type_num;
+}
+
+static void *prefetch_io(void *arg)
+/* Reads the inputs of all active cells into the queue, waiting while
+   the queue is full. */
+{
+  extern option_struct    options;
+  extern param_set_struct param_set;
+  prefetch_cell_struct cell;
+  filep_struct         filep;
+  char                 RUN_MODEL;
+  char                 MODEL_DONE;
+  double               t0;
+
+  MODEL_DONE = FALSE;
+  while (!MODEL_DONE) {
+
+    t0 = prefetch_now();
+    cell.soil_con = read_soilparam(prefetch_soilparam, &RUN_MODEL, &MODEL_DONE);
+    if (RUN_MODEL) {
+      if (prefetch_vegparam != NULL)
+        cell.Nveg_hist = prefetch_veg_tiles(cell.soil_con.gridcel);
+      else
+        cell.Nveg_hist = param_set.TYPE[LAI_IN].N_ELEM;
+      make_in_files(&filep, &prefetch_names, &cell.soil_con);
+      cell.forcing_data = read_forcing_data(filep.forcing, prefetch_global,
+                                            cell.soil_con.lat,
+                                            cell.soil_con.lng,
+                                            cell.Nveg_hist,
+                                            &cell.veg_hist_data);
+      if (filep.forcing[0] != NULL) {
+        fclose(filep.forcing[0]);
+        if (options.COMPRESS) compress_files(prefetch_names.forcing[0]);
+      }
+      if (filep.forcing[1] != NULL) {
+        fclose(filep.forcing[1]);
+        if (options.COMPRESS) compress_files(prefetch_names.forcing[1]);
+      }
+    }
+    io_read += prefetch_now() - t0;
+
+    if (RUN_MODEL) {
+      pthread_mutex_lock(&queue_lock);
+      t0 = prefetch_now();
+      while (queue_count == queue_size)
+        pthread_cond_wait(&queue_not_full, &queue_lock);
+      io_wait += prefetch_now() - t0;
+      queue[(queue_head + queue_count) % queue_size] = cell;
+      queue_count++;
+      pthread_cond_signal(&queue_not_empty);
+      pthread_mutex_unlock(&queue_lock);
+    }
+  }
+
+  pthread_mutex_lock(&queue_lock);
+  queue_closed = TRUE;
+  pthread_cond_broadcast(&queue_not_empty);
+  pthread_mutex_unlock(&queue_lock);
+
+  return NULL;
+}
+
+void prefetch_start(FILE                *soilparam,
+                    filenames_struct    *names,
+                    global_param_struct *global)
+/**********************************************************************
+  prefetch_start	Keith Mathews			October 2026
+
+  Starts the I/O thread, which reads the cells of soilparam and their
+  forcings ahead of the cell loop.  soilparam must not be read by the
+  caller until prefetch_end() has been called.  If there are veg_hist
+  forcings, the I/O thread opens the vegetation parameter file again,
+  to find the number of vegetation tiles of each cell.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct    options;
+  extern param_set_struct param_set;
+
+  prefetch_soilparam = soilparam;
+  prefetch_names = *names;
+  prefetch_global = *global;
+
+  if (!options.OUTPUT_FORCE
+      && (param_set.TYPE[ALBEDO].SUPPLIED || param_set.TYPE[LAI_IN].SUPPLIED
+          || param_set.TYPE[VEGCOVER].SUPPLIED))
+    prefetch_vegparam = open_file(names->veg, "r");
+
+  queue_size = options.PREFETCH_DEPTH;
+  queue = (prefetch_cell_struct *)calloc(queue_size, sizeof(prefetch_cell_struct));
+  if (queue == NULL)
+    nrerror("Memory allocation failure in prefetch_start");
+
+  if (pthread_create(&io_thread, NULL, prefetch_io, NULL) != 0)
+    nrerror("Unable to start the input read-ahead thread.");
+}
+
+soil_con_struct prefetch_next_cell(char *RUN_MODEL,
+                                   char *MODEL_DONE)
+/**********************************************************************
+  prefetch_next_cell	Keith Mathews			October 2026
+
+  Returns the next active cell read by the I/O thread, waiting for it
+  if necessary, with RUN_MODEL set to TRUE; or sets MODEL_DONE to TRUE
+  (and RUN_MODEL to FALSE) when there are no more cells.  The cell's
+  forcings are then available from prefetch_forcing_data().
+
+  Modifications:
+**********************************************************************/
+{
+  soil_con_struct soil_con;
+  double          t0;
+
+  memset(&soil_con, 0, sizeof(soil_con_struct));
+
+  pthread_mutex_lock(&queue_lock);
+  if (queue_count == 0 && !queue_closed) {
+    nwaits++;
+    t0 = prefetch_now();
+    while (queue_count == 0 && !queue_closed)
+      pthread_cond_wait(&queue_not_empty, &queue_lock);
+    loop_wait += prefetch_now() - t0;
+  }
+  if (queue_count == 0) {
+    pthread_mutex_unlock(&queue_lock);
+    *RUN_MODEL = FALSE;
+    *MODEL_DONE = TRUE;
+    return soil_con;
+  }
+  soil_con = queue[queue_head].soil_con;
+  cur_forcing_data = queue[queue_head].forcing_data;
+  cur_veg_hist_data = queue[queue_head].veg_hist_data;
+  cur_Nveg_hist = queue[queue_head].Nveg_hist;
+  queue_head = (queue_head + 1) % queue_size;
+  queue_count--;
+  ncells++;
+  pthread_cond_signal(&queue_not_full);
+  pthread_mutex_unlock(&queue_lock);
+
+  *RUN_MODEL = TRUE;
+  *MODEL_DONE = FALSE;
+  return soil_con;
+}
+
+double **prefetch_forcing_data(double ****veg_hist_data,
+                               int       *Nveg_hist)
+/**********************************************************************
+  prefetch_forcing_data	Keith Mathews			October 2026
+
+  Returns the forcing arrays of the current cell, as read_forcing_data()
+  would have, and sets Nveg_hist to the number of elements with which
+  the veg_hist forcings were read.  The caller frees them.
+
+  Modifications:
+**********************************************************************/
+{
+  double **forcing_data;
+
+  if (cur_forcing_data == NULL)
+    nrerror("No read-ahead forcings for the current cell.");
+  forcing_data = cur_forcing_data;
+  *veg_hist_data = cur_veg_hist_data;
+  *Nveg_hist = cur_Nveg_hist;
+  cur_forcing_data = NULL;
+  cur_veg_hist_data = NULL;
+
+  return forcing_data;
+}
+
+void prefetch_end()
+/**********************************************************************
+  prefetch_end		Keith Mathews			October 2026
+
+  Waits for the I/O thread, and prints the read-ahead statistics.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+
+  pthread_join(io_thread, NULL);
+  free((char *)queue);
+  queue = NULL;
+  if (prefetch_vegparam != NULL) {
+    fclose(prefetch_vegparam);
+    prefetch_vegparam = NULL;
+  }
+
+  fprintf(stderr, "Input read-ahead (PREFETCH_DEPTH %d): %d cells; the cell loop "
+          "waited %.2f s for inputs (%d cells); the I/O thread read for %.2f s "
+          "and waited %.2f s for the cell loop\n", options.PREFETCH_DEPTH,
+          ncells, loop_wait, nwaits, io_read, io_wait);
+}
@@ -393,6 +393,11 @@ print_lake_con(lake_con_struct *lcon,
         printf("\t%.4lf", lcon->Cl[i]);
     }
     printf("\n");
+    printf("\tvolume   :");
+    for (i = 0; i < nlnodes; i++) {
+        printf("\t%.4lf", lcon->volume[i]);
+    }
+    printf("\n");
     printf("\tb        : %.4lf\n", lcon->b);
     printf("\tmaxdepth : %.4lf\n", lcon->maxdepth);
     printf("\tmindepth : %.4lf\n", lcon->mindepth);
@@ -0,0 +1,258 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  progress.c		Keith Mathews			October 2026
+
+  Optional progress reporting.  When PROGRESS is set to a positive
+  number of seconds in the global parameter file, a one-line status
+  report is printed to stderr at most once per PROGRESS seconds:
+  cells completed out of the total number of active cells, simulated
+  cell-years per second, resident memory, elapsed time, and an
+  estimate of the time remaining.  If PROGRESS_FILE is also given, the
+  same information, plus the per-phase breakdown of the phase timers
+  (if TIMING is not NONE), is written to that file as "key value"
+  lines, for monitoring by job schedulers.  The status file is written
+  to a temporary file and then renamed, so that readers never see a
+  partial file; its "updated" time stamp allows stalls to be detected.
+
+  progress_step() is called once per time step from the record loop.
+  It only counts steps, and looks at the clock once every
+  PROGRESS_CHECK_STEPS steps, so it adds no measurable cost to the
+  record loop.
+
+  When a domain is split over several processes (e.g. with
+  bench/rank_cells.py), each process should be given its own
+  PROGRESS_FILE; the status file records the process id and the
+  soil parameter file so that the reports can be combined.
+
+  Modifications:
+**********************************************************************/
+
+#define PROGRESS_CHECK_STEPS 256
+
+static int     ncells_total = 0;
+static int     ncells_done = 0;
+static int     cell_gridcel = -1;
+static int     cell_rec = 0;
+static int     nsteps = 0;
+static int     nrecs = 1;
+static double  cell_years_per_rec;
+static double  progress_t0;
+static double  progress_last;
+static char   *soil_file;
+static char   *status_file = NULL;
+
+static double progress_now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec);
+}
+
+static long progress_rss()
+/* Returns the current resident set size [kB], or the peak if the
+   current size is not available. */
+{
+  FILE *fp;
+  long  size, resident;
+
+  if ((fp = fopen("/proc/self/statm", "r")) != NULL) {
+    if (fscanf(fp, "%ld %ld", &size, &resident) == 2) {
+      fclose(fp);
+      return resident * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+    fclose(fp);
+  }
+  return timer_peak_rss();
+}
+
+static char *progress_hms(double seconds, char *str)
+/* Formats a duration as hh:mm:ss. */
+{
+  long s;
+
+  if (seconds < 0) {
+    strcpy(str, "--:--:--");
+    return str;
+  }
+  s = (long)(seconds + 0.5);
+  sprintf(str, "%02ld:%02ld:%02ld", s / 3600, (s / 60) % 60, s % 60);
+  return str;
+}
+
+static void progress_report(char *state)
+/* Prints the status line and rewrites the status file. */
+{
+  extern option_struct options;
+  static int phases[] = { TIMER_READ_PARAM, TIMER_FILES, TIMER_INIT_ATMOS,
+                          TIMER_INIT_STATE, TIMER_FULL_ENERGY,
+                          TIMER_PUT_DATA };
+  char    tmpname[MAXSTRING+8];
+  char    elapsed_str[16], eta_str[16];
+  FILE   *fp;
+  int     i;
+  long    rss;
+  double  now, elapsed, done, rate, eta;
+
+  now = progress_now();
+  elapsed = now - progress_t0;
+  progress_last = now;
+
+  /* fraction of cells done, including the part of the current cell */
+  done = (double)ncells_done;
+  if (strcmp(state, "running") == 0 && cell_gridcel >= 0)
+    done += (double)cell_rec / (double)nrecs;
+  rate = (elapsed > 0) ? done * nrecs * cell_years_per_rec / elapsed : 0;
+  eta = (done > 0 && ncells_total > 0)
+        ? elapsed * ((double)ncells_total - done) / done : -1;
+  if (strcmp(state, "done") == 0) eta = 0;
+  rss = progress_rss();
+
+  fprintf(stderr, "Progress: %d/%d cells (%.1f%%), %.3f cell-years/s, "
+          "RSS %ld MB, elapsed %s, ETA %s\n", ncells_done, ncells_total,
+          (ncells_total > 0) ? 100. * done / ncells_total : 0., rate,
+          rss / 1024, progress_hms(elapsed, elapsed_str),
+          progress_hms(eta, eta_str));
+
+  if (status_file == NULL)
+    return;
+
+  sprintf(tmpname, "%s.tmp", status_file);
+  if ((fp = fopen(tmpname, "w")) == NULL)
+    return;
+  fprintf(fp, "state %s\n", state);
+  fprintf(fp, "pid %ld\n", (long)getpid());
+  fprintf(fp, "soil_file %s\n", soil_file);
+  fprintf(fp, "updated %ld\n", (long)time(NULL));
+  fprintf(fp, "cells_done %d\n", ncells_done);
+  fprintf(fp, "cells_total %d\n", ncells_total);
+  fprintf(fp, "current_cell %d\n", cell_gridcel);
+  fprintf(fp, "current_rec %d\n", cell_rec);
+  fprintf(fp, "nrecs %d\n", nrecs);
+  fprintf(fp, "elapsed_s %.3f\n", elapsed);
+  fprintf(fp, "eta_s %.3f\n", eta);
+  fprintf(fp, "cell_years_per_s %.6f\n", rate);
+  fprintf(fp, "rss_kb %ld\n", rss);
+  fprintf(fp, "peak_rss_kb %ld\n", timer_peak_rss());
+  if (options.TIMING != TIMING_NONE)
+    for (i = 0; i < sizeof(phases)/sizeof(phases[0]); i++)
+      fprintf(fp, "phase_%s_s %.3f\n", timer_name(phases[i]),
+              timer_get(phases[i]));
+  fclose(fp);
+  rename(tmpname, status_file);
+}
+
+void progress_init(FILE                *soilparam,
+                   filenames_struct    *names,
+                   global_param_struct *global)
+/**********************************************************************
+  progress_init		Keith Mathews			October 2026
+
+  Counts the active cells in the soil parameter file (which is then
+  rewound) and starts the progress clock.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  char line[MAXSTRING];
+  int  flag;
+
+  if (options.PROGRESS <= 0)
+    return;
+
+  ncells_total = 0;
+  while (fscanf(soilparam, "%d", &flag) == 1) {
+    if (flag) ncells_total++;
+    if (fgets(line, MAXSTRING, soilparam) == NULL)
+      break;
+  }
+  rewind(soilparam);
+
+  nrecs = (global->nrecs > 0) ? global->nrecs : 1;
+  cell_years_per_rec = (double)global->dt / (24. * 365.25);
+  soil_file = names->soil;
+  if (strcmp(names->progress, "NONE") != 0)
+    status_file = names->progress;
+
+  progress_t0 = progress_last = progress_now();
+  progress_report("running");
+}
+
+void progress_start_cell(int gridcel)
+/**********************************************************************
+  progress_start_cell	Keith Mathews			October 2026
+
+  Records the start of a new cell.
+
+  Modifications:
+**********************************************************************/
+{
+  cell_gridcel = gridcel;
+  cell_rec = 0;
+}
+
+void progress_step(int rec)
+/**********************************************************************
+  progress_step		Keith Mathews			October 2026
+
+  Called once per time step; reports progress if at least PROGRESS
+  seconds have passed since the last report.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+
+  if (options.PROGRESS <= 0 || ++nsteps < PROGRESS_CHECK_STEPS)
+    return;
+  nsteps = 0;
+  cell_rec = rec + 1;
+  if (progress_now() - progress_last >= options.PROGRESS)
+    progress_report("running");
+}
+
+void progress_end_cell()
+/**********************************************************************
+  progress_end_cell	Keith Mathews			October 2026
+
+  Records the completion of a cell, and reports progress if at least
+  PROGRESS seconds have passed since the last report.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+
+  if (options.PROGRESS <= 0)
+    return;
+  ncells_done++;
+  cell_gridcel = -1;
+  cell_rec = 0;
+  if (progress_now() - progress_last >= options.PROGRESS)
+    progress_report("running");
+}
+
+void progress_done()
+/**********************************************************************
+  progress_done		Keith Mathews			October 2026
+
+  Writes the final progress report.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+
+  if (options.PROGRESS <= 0)
+    return;
+  progress_report("done");
+}
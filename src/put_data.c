@@ -156,6 +156,18 @@ int  put_data(all_vars_struct   *all_vars,
   2014-Mar-28 Removed DIST_PRCP option.					TJB
   2014-Apr-25 Added OUT_LAI.						TJB
   2014-Apr-25 Added OUT_VEGCOVER.					TJB
+  2026-Oct-17 Added write_data() phase timer.				KM
+  2026-Oct-17 Accumulates region sums (REGION_MAP); per-cell output
+	      is not written if REGION_ONLY is TRUE.			KM
+  2026-Oct-17 Stores runoff for routing (ROUTING_FLOWDIR).		KM
+  2026-Oct-17 Accumulates output statistics (STATVAR); per-cell output
+	      is not written if STAT_ONLY is TRUE.			KM
+  2026-Oct-17 Records are queued for the writer thread if
+	      WRITE_QUEUE > 0.						KM
+  2026-Oct-17 Adds rows to the Arrow output files (ARROW_OUTPUT); per-cell
+	      output is not written if ARROW_OUTPUT is TRUE.		KM
+  2026-Oct-17 Publishes records in the shared-memory output channel
+	      (SHM_NAME).						KM
 **********************************************************************/
 {
   extern global_param_struct global_param;
@@ -759,10 +771,22 @@ int  put_data(all_vars_struct   *all_vars,
       out_data[OUT_VPD].aggdata[0] *= 1000;
     }
 
+    /*************
+      Route Runoff
+    *************/
+    route_accumulate(out_data, dmy, rec);
+
     /*************
       Write Data
     *************/
     if(rec >= skipyear) {
+      region_accumulate(out_data, dmy, soil_con);
+      out_stats_accumulate(out_data, dmy);
+      arrow_output_accumulate(out_data, dmy, soil_con);
+      shm_output_accumulate(out_data, dmy, soil_con);
+    }
+    if(rec >= skipyear && !options.REGION_ONLY && !options.STAT_ONLY
+       && !options.ARROW_OUTPUT) {
       if (options.BINARY_OUTPUT) {
         for (v=0; v<N_OUTVAR_TYPES; v++) {
           for (i=0; i<out_data[v].nelem; i++) {
@@ -770,7 +794,12 @@ int  put_data(all_vars_struct   *all_vars,
           }
         }
       }
-      write_data(out_data_files, out_data, dmy, global_param.out_dt);
+      timer_start(TIMER_WRITE_DATA);
+      if (options.WRITE_QUEUE > 0)
+        write_queue_push(out_data_files, out_data, dmy, global_param.out_dt);
+      else
+        write_data(out_data_files, out_data, dmy, global_param.out_dt);
+      timer_stop(TIMER_WRITE_DATA);
     }
 
     // Reset the step count
@@ -9,6 +9,7 @@ void read_atmos_data(FILE                 *infile,
 		     global_param_struct   global_param,
 		     int                   file_num,
 		     int                   forceskip,
+		     int                   Nveg_hist,
 		     double              **forcing_data,
 		     double             ***veg_hist_data)
 /**********************************************************************
@@ -60,6 +61,10 @@ void read_atmos_data(FILE                 *infile,
   2014-Apr-25 Added non-climatological veg parameters (as forcing
 	      variables).						TJB
   2014-Apr-25 Added partial vegcover fraction.				TJB
+  2026-Oct-17 The number of elements of the veg_hist forcings is now
+	      passed in as Nveg_hist, rather than taken from the global
+	      param_set, so that the inputs of other cells can be read
+	      by the read-ahead thread.				KM
 
   **********************************************************************/
 {
@@ -180,7 +185,7 @@ void read_atmos_data(FILE                 *infile,
 	  }
 	}
 	else {
-          for(j=0;j<param_set.TYPE[field_index[i]].N_ELEM;j++) {
+          for(j=0;j<Nveg_hist;j++) {
 	    if(param_set.TYPE[field_index[i]].SIGNED) {
 	      fread(&stmp,sizeof(short int),1,infile);
 	      if (endian != param_set.FORCE_ENDIAN[file_num]) {
@@ -235,7 +240,7 @@ void read_atmos_data(FILE                 *infile,
 	  fscanf(infile,"%lf", &forcing_data[field_index[i]][rec]);
         }
         else {
-          for(j=0;j<param_set.TYPE[field_index[i]].N_ELEM;j++) {
+          for(j=0;j<Nveg_hist;j++) {
 	    fscanf(infile,"%lf", &veg_hist_data[field_index[i]][j][rec]);
           }
         }
@@ -7,6 +7,9 @@ static char vcid[] = "$Id$";
 
 double **read_forcing_data(FILE                **infile,
 			   global_param_struct   global_param,
+			   double                lat,
+			   double                lng,
+			   int                   Nveg_hist,
 			   double            ****veg_hist_data)
 /**********************************************************************
   read_forcing_data    Keith Cherkauer      January 10, 2000
@@ -20,6 +23,12 @@ double **read_forcing_data(FILE                **infile,
   2014-Apr-25 Added non-climatological veg parameters (as forcing
 	      variables).						TJB
   2014-Apr-25 Added partial vegcover fraction.				TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
+  2026-Oct-17 Added NETCDF forcing files, read by read_netcdf_forcing()
+	      for the cell at (lat, lng).				KM
+  2026-Oct-17 Added Nveg_hist, the number of elements (vegetation
+	      tiles) of the veg_hist forcings of the cell, which was
+	      taken from the global param_set.				KM
 **********************************************************************/
 {
   extern option_struct    options;
@@ -31,17 +40,17 @@ double **read_forcing_data(FILE                **infile,
   double             **forcing_data;
 
   /** Allocate data arrays for input forcing data **/
-  forcing_data = (double **)calloc(N_FORCING_TYPES,sizeof(double*));
-  (*veg_hist_data) = (double ***)calloc(N_FORCING_TYPES,sizeof(double**));
+  forcing_data = (double **)mem_calloc(N_FORCING_TYPES,sizeof(double*), MEM_FORCING);
+  (*veg_hist_data) = (double ***)mem_calloc(N_FORCING_TYPES,sizeof(double**), MEM_FORCING);
   for(i=0;i<N_FORCING_TYPES;i++) {
     if (param_set.TYPE[i].SUPPLIED) {
       if (i != ALBEDO && i != LAI_IN && i != VEGCOVER) {
-        forcing_data[i] = (double *)calloc((global_param.nrecs * NF), sizeof(double));
+        forcing_data[i] = (double *)mem_calloc((global_param.nrecs * NF), sizeof(double), MEM_FORCING);
       }
       else {
-        (*veg_hist_data)[i] = (double **)calloc(param_set.TYPE[i].N_ELEM, sizeof(double*));
-        for(j=0;j<param_set.TYPE[i].N_ELEM;j++) {
-          (*veg_hist_data)[i][j] = (double *)calloc((global_param.nrecs * NF), sizeof(double));
+        (*veg_hist_data)[i] = (double **)mem_calloc(Nveg_hist, sizeof(double*), MEM_FORCING);
+        for(j=0;j<Nveg_hist;j++) {
+          (*veg_hist_data)[i][j] = (double *)mem_calloc((global_param.nrecs * NF), sizeof(double), MEM_FORCING);
         }
       }
     }
@@ -49,8 +58,12 @@ double **read_forcing_data(FILE                **infile,
 
   /** Read First Forcing Data File **/
   if(param_set.FORCE_DT[0] > 0) {
-    read_atmos_data(infile[0], global_param, 0, global_param.forceskip[0],
-		    forcing_data, (*veg_hist_data));
+    if(param_set.FORCE_FORMAT[0] == NETCDF)
+      read_netcdf_forcing(0, lat, lng, global_param, global_param.forceskip[0],
+			  forcing_data);
+    else
+      read_atmos_data(infile[0], global_param, 0, global_param.forceskip[0],
+		      Nveg_hist, forcing_data, (*veg_hist_data));
   }
   else {
     sprintf(errorstr,"ERROR: File time step must be defined for at least the first forcing file (FILE_DT).\n");
@@ -59,8 +72,12 @@ double **read_forcing_data(FILE                **infile,
 
   /** Read Second Forcing Data File **/
   if(param_set.FORCE_DT[1] > 0) {
-    read_atmos_data(infile[1], global_param, 1, global_param.forceskip[1], 
-		    forcing_data, (*veg_hist_data));
+    if(param_set.FORCE_FORMAT[1] == NETCDF)
+      read_netcdf_forcing(1, lat, lng, global_param, global_param.forceskip[1],
+			  forcing_data);
+    else
+      read_atmos_data(infile[1], global_param, 1, global_param.forceskip[1], 
+		      Nveg_hist, forcing_data, (*veg_hist_data));
   }
 
   return(forcing_data);
@@ -88,6 +88,8 @@ void read_initial_model_state(FILE                *init_state,
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
   2013-Dec-28 Removed NO_REWIND option.					TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
+  2026-Oct-17 Search again from the first cell of the file if the cell
+	      is not found, since cells may be out of file order.	KM
 *********************************************************************/
 {
   extern option_struct options;
@@ -102,6 +104,7 @@ void read_initial_model_state(FILE                *init_state,
   int    lidx;
   int    nidx;
   int    tmp_cellnum;
+  int    pass;
   int    tmp_Nveg;
   int    tmp_Nband;
   int    tmp_char;
@@ -121,41 +124,56 @@ void read_initial_model_state(FILE                *init_state,
   energy  = all_vars->energy;
   lake_var = &all_vars->lake_var;
 
-  /* read cell information */
-  if ( options.BINARY_STATE_FILE ) {
-    fread( &tmp_cellnum, sizeof(int), 1, init_state );
-    fread( &tmp_Nveg, sizeof(int), 1, init_state );
-    fread( &tmp_Nband, sizeof(int), 1, init_state );
-    fread( &Nbytes, sizeof(int), 1, init_state );
-  }
-  else 
-    fscanf( init_state, "%d %d %d", &tmp_cellnum, &tmp_Nveg, &tmp_Nband );
-  // Skip over unused cell information
-  while ( tmp_cellnum != cellnum && !feof(init_state) ) {
+  /* read cell information; cells are normally read in file order, but
+     if they are not (see netcdf_forcing_init()), search once more from
+     the first cell of the file (after the header read by
+     check_state_file()) */
+  for ( pass = 0; pass < 2; pass++ ) {
+    if ( pass > 0 ) {
+      rewind(init_state);
+      if ( options.BINARY_STATE_FILE )
+        fseek(init_state, 5 * sizeof(int), SEEK_SET);
+      else {
+        fgets(tmpstr, MAXSTRING, init_state);
+        fgets(tmpstr, MAXSTRING, init_state);
+      }
+    }
     if ( options.BINARY_STATE_FILE ) {
-      // skip rest of current cells info
-      for ( byte = 0; byte < Nbytes; byte++ ) 
-	fread ( &tmpchar, 1, 1, init_state);
-      // read info for next cell
       fread( &tmp_cellnum, sizeof(int), 1, init_state );
       fread( &tmp_Nveg, sizeof(int), 1, init_state );
       fread( &tmp_Nband, sizeof(int), 1, init_state );
       fread( &Nbytes, sizeof(int), 1, init_state );
     }
-    else {
-      // skip rest of current cells info
-      fgets(tmpstr, MAXSTRING, init_state); // skip rest of general cell info
-      for ( veg = 0; veg <= tmp_Nveg; veg++ ) {
-	for ( band = 0; band < tmp_Nband; band++ )
-	  fgets(tmpstr, MAXSTRING, init_state); // skip snowband info
-      }
-      if ( options.LAKES ) {
-        fgets(tmpstr, MAXSTRING, init_state); // skip lake info
-      }
-      // read info for next cell
+    else 
       fscanf( init_state, "%d %d %d", &tmp_cellnum, &tmp_Nveg, &tmp_Nband );
-    }//end if
-  }//end while
+    // Skip over unused cell information
+    while ( tmp_cellnum != cellnum && !feof(init_state) ) {
+      if ( options.BINARY_STATE_FILE ) {
+        // skip rest of current cells info
+        for ( byte = 0; byte < Nbytes; byte++ ) 
+	  fread ( &tmpchar, 1, 1, init_state);
+        // read info for next cell
+        fread( &tmp_cellnum, sizeof(int), 1, init_state );
+        fread( &tmp_Nveg, sizeof(int), 1, init_state );
+        fread( &tmp_Nband, sizeof(int), 1, init_state );
+        fread( &Nbytes, sizeof(int), 1, init_state );
+      }
+      else {
+        // skip rest of current cells info
+        fgets(tmpstr, MAXSTRING, init_state); // skip rest of general cell info
+        for ( veg = 0; veg <= tmp_Nveg; veg++ ) {
+	  for ( band = 0; band < tmp_Nband; band++ )
+	    fgets(tmpstr, MAXSTRING, init_state); // skip snowband info
+        }
+        if ( options.LAKES ) {
+          fgets(tmpstr, MAXSTRING, init_state); // skip lake info
+        }
+        // read info for next cell
+        fscanf( init_state, "%d %d %d", &tmp_cellnum, &tmp_Nveg, &tmp_Nband );
+      }//end if
+    }//end while
+    if ( !feof(init_state) ) break;
+  }
   
   if ( feof(init_state) ) {
     sprintf(ErrStr, "Requested grid cell (%d) is not in the model state file.", 
@@ -66,12 +66,18 @@ lake_con_struct read_lakeparam(FILE            *lakeparam,
   2013-Jul-25 Fixed bug in parsing lakeparam file in case of no lake
 	      in the cell.							TJB
   2013-Dec-28 Removed NO_REWIND option.					TJB
+  2026-Oct-17 Search again from the top of the file if the cell is not
+	      found, since cells may be out of file order.		KM
+  2026-Oct-17 Computes the lake hypsometry table with
+	      compute_lake_volumes(); checks that the node depths of a
+	      specified lake profile decrease.				KM
 **********************************************************************/
 
 {
   extern option_struct   options;
   int    i;
   int    lakecel;
+  int    pass;
   int    junk, flag;
   double tempdz;
   double radius, A, x, y;
@@ -86,12 +92,18 @@ lake_con_struct read_lakeparam(FILE            *lakeparam,
   /* Read in general lake parameters.                           */
   /******************************************************************/
 
-  fscanf(lakeparam, "%d %d", &lakecel, &temp.lake_idx);
-  while ( lakecel != soil_con.gridcel && !feof(lakeparam) ) {
-    fgets(tmpstr, MAXSTRING, lakeparam); // grid cell number, etc.
-    if (temp.lake_idx >= 0)
-      fgets(tmpstr, MAXSTRING, lakeparam); // lake depth-area relationship
+  /* Cells are normally read in file order; if they are not (see
+     netcdf_forcing_init()), search once more from the top of the file */
+  for ( pass = 0; pass < 2; pass++ ) {
+    if ( pass > 0 ) rewind_file(lakeparam);
     fscanf(lakeparam, "%d %d", &lakecel, &temp.lake_idx);
+    while ( lakecel != soil_con.gridcel && !feof(lakeparam) ) {
+      fgets(tmpstr, MAXSTRING, lakeparam); // grid cell number, etc.
+      if (temp.lake_idx >= 0)
+        fgets(tmpstr, MAXSTRING, lakeparam); // lake depth-area relationship
+      fscanf(lakeparam, "%d %d", &lakecel, &temp.lake_idx);
+    }
+    if ( !feof(lakeparam) ) break;
   }
 
   // cell number not found
@@ -210,6 +222,10 @@ lake_con_struct read_lakeparam(FILE            *lakeparam,
         sprintf(tmpstr, "Lake area fraction (%f) for cell (%d) specified in the lake parameter file must be a fraction between 0 and 1.", temp.Cl[0], soil_con.gridcel);
         nrerror(tmpstr);
       }
+      if(i > 0 && temp.z[i] > temp.z[i-1]) {
+        sprintf(tmpstr, "Lake node depth %f for cell (%d) specified in the lake parameter file exceeds the depth of the node above it (%f); the nodes must be listed from the surface (maximum depth) down.", temp.z[i], soil_con.gridcel, temp.z[i-1]);
+        nrerror(tmpstr);
+      }
     }
     temp.z[temp.numnod] = 0.0;
     temp.basin[temp.numnod] = 0.0;
@@ -221,8 +237,11 @@ lake_con_struct read_lakeparam(FILE            *lakeparam,
 
   }
 
+  // Compute volume at each node, for get_volume() and get_depth()
+  compute_lake_volumes(&temp);
+
   // Compute volume corresponding to mindepth
-  ErrFlag = get_volume(temp, temp.mindepth, &(temp.minvolume));
+  ErrFlag = get_volume(&temp, temp.mindepth, &(temp.minvolume));
   if (ErrFlag == ERROR) {
     sprintf(tmpstr, "ERROR: problem in get_volume(): depth %f volume %f rec %d\n", temp.mindepth, temp.minvolume, 0);
     nrerror(tmpstr);
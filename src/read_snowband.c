@@ -25,6 +25,8 @@ void read_snowband(FILE    *snowband,
   2009-Sep-28 Moved initialization of snow band parameters to the
 	      read_soilparam* functions.				TJB
   2013-Dec-28 Removed NO_REWIND option.					TJB
+  2026-Oct-17 Search again from the top of the file if the cell is not
+	      found, since cells may be out of file order.		KM
 **********************************************************************/
 {
   extern option_struct options;
@@ -33,6 +35,7 @@ void read_snowband(FILE    *snowband,
   int     band;
   int     Nbands;
   int     cell;
+  int     pass;
   double  total;
   double  area_fract;
   double  prec_frac;
@@ -44,10 +47,16 @@ void read_snowband(FILE    *snowband,
   if ( Nbands > 1 ) {
 
     /** Find Current Grid Cell in SnowBand File **/
-    fscanf(snowband, "%d", &cell);
-    while ( cell != soil_con->gridcel && !feof(snowband) ) {
-      fgets(ErrStr,MAXSTRING,snowband);
+    /* Cells are normally read in file order; if they are not (see
+       netcdf_forcing_init()), search once more from the top of the file */
+    for ( pass = 0; pass < 2; pass++ ) {
+      if ( pass > 0 ) rewind_file(snowband);
       fscanf(snowband, "%d", &cell);
+      while ( cell != soil_con->gridcel && !feof(snowband) ) {
+        fgets(ErrStr,MAXSTRING,snowband);
+        fscanf(snowband, "%d", &cell);
+      }
+      if ( !feof(snowband) ) break;
     }
 
     if ( feof(snowband) ) {
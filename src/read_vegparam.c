@@ -51,6 +51,8 @@ veg_con_struct *read_vegparam(FILE *vegparam,
 	      ALB_SRC.							TJB
   2014-Apr-25 Added optional vegcover values; added VEGPARAM_VEGCOVER
 	      and VEGCOVER_SRC.						TJB
+  2026-Oct-17 Search again from the top of the file if the cell is not
+	      found, since cells may be out of file order.		KM
 **********************************************************************/
 {
 
@@ -59,6 +61,7 @@ veg_con_struct *read_vegparam(FILE *vegparam,
   extern option_struct   options;
   veg_con_struct *temp;
   int             vegcel, i, j, k, vegetat_type_num, skip, veg_class;
+  int             pass;
   int             MaxVeg;
   int             Nfields, NfieldsMax;
   int             NoOverstory;
@@ -82,16 +85,22 @@ veg_con_struct *read_vegparam(FILE *vegparam,
 
   NoOverstory = 0;
 
-  while ( ( fscanf(vegparam, "%d %d", &vegcel, &vegetat_type_num) == 2 ) && vegcel != gridcel ){
-    if (vegetat_type_num < 0) {
-      sprintf(ErrStr,"ERROR number of vegetation tiles (%i) given for cell %i is < 0.\n",vegetat_type_num,vegcel);
-      nrerror(ErrStr);
-    }
-    for (i = 0; i <= vegetat_type_num * skip; i++){
-      if ( fgets(str, 500, vegparam) == NULL ){
-        sprintf(ErrStr,"ERROR unexpected EOF for cell %i while reading root zones and LAI\n",vegcel);
+  /* Cells are normally read in file order; if they are not (see
+     netcdf_forcing_init()), search once more from the top of the file */
+  vegcel = -1;
+  for ( pass = 0; pass < 2 && vegcel != gridcel; pass++ ) {
+    if ( pass > 0 ) rewind_file(vegparam);
+    while ( ( fscanf(vegparam, "%d %d", &vegcel, &vegetat_type_num) == 2 ) && vegcel != gridcel ){
+      if (vegetat_type_num < 0) {
+        sprintf(ErrStr,"ERROR number of vegetation tiles (%i) given for cell %i is < 0.\n",vegetat_type_num,vegcel);
         nrerror(ErrStr);
       }
+      for (i = 0; i <= vegetat_type_num * skip; i++){
+        if ( fgets(str, 500, vegparam) == NULL ){
+          sprintf(ErrStr,"ERROR unexpected EOF for cell %i while reading root zones and LAI\n",vegcel);
+          nrerror(ErrStr);
+        }
+      }
     }
   }
   fgets(str, 500, vegparam); // read newline at end of veg class line to advance to next line
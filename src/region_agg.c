@@ -0,0 +1,362 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  region_agg.c		Keith Mathews			October 2026
+
+  Optional aggregation of output variables over regions (basins or the
+  cells of a coarser grid), computed while the model runs so that
+  region totals do not have to be derived afterwards from the per-cell
+  output files.
+
+  The REGION_MAP file assigns grid cells to regions.  Each non-comment
+  line holds a cell id (as in the soil parameter file), a region id
+  (any integer), and the fraction of the cell's area that lies in the
+  region:
+
+    <gridcel> <region_id> <weight>
+
+  A cell may belong to several regions (e.g. fractions of a coarse
+  grid cell); cells not listed are ignored.  At each output interval,
+  the aggregated values of the REGIONVAR variables of each cell are
+  accumulated into its regions with weight (weight * cell_area).  At
+  the end of the run, one ASCII file per region is written to
+  RESULT_DIR, named <REGION_PREFIX>_<region_id>, holding the
+  area-weighted mean of each variable at each output interval; the
+  area of the region is given in the file header, so that volumes can
+  be recovered from the mean depths.  If REGION_ONLY is TRUE, the
+  per-cell output files are not written.
+
+  Since VIC runs the complete record of one cell before the next, the
+  regional series are held in memory (charged to MEM_OUTPUT) until
+  all cells have been run; they take 8 bytes per region, per output
+  record, per variable element.
+
+  Modifications:
+**********************************************************************/
+
+typedef struct {
+  int     gridcel;
+  int     region;       /* index into region_ids */
+  double  weight;       /* fraction of the cell's area in the region */
+} region_entry_struct;
+
+static region_entry_struct *entries = NULL;
+static int      nentries = 0;
+static int     *region_ids = NULL;
+static int      nregions = 0;
+static int     *region_ncells = NULL;
+static double  *region_area = NULL;   /* [m2] */
+static double  *region_sum = NULL;    /* [region][record][value] */
+static dmy_struct *region_dmy = NULL; /* date of each output record */
+static int      nvalues = 0;          /* elements over all REGIONVARs */
+static int      maxrecs = 0;
+static int      nrecs_written = 0;
+static int      cell_first = 0;       /* entries of the current cell */
+static int      cell_n = 0;
+static int      cell_rec = 0;
+static int      out_dt = 24;
+static int      region_vars[N_OUTVAR_TYPES]; /* REGIONVARs, in order given */
+static int      nregion_vars = 0;
+static char    *region_default_vars[] = { "OUT_PREC", "OUT_EVAP", "OUT_RUNOFF",
+                                          "OUT_BASEFLOW", "OUT_SWE",
+                                          "OUT_SOIL_MOIST" };
+
+static int region_entry_cmp(const void *a, const void *b)
+{
+  const region_entry_struct *ea = (const region_entry_struct *)a;
+  const region_entry_struct *eb = (const region_entry_struct *)b;
+
+  if (ea->gridcel != eb->gridcel)
+    return (ea->gridcel < eb->gridcel) ? -1 : 1;
+  return (ea->region < eb->region) ? -1 : (ea->region > eb->region);
+}
+
+static int region_index(int id)
+/* Returns the index of region id, adding it if it is new. */
+{
+  int i;
+
+  for (i = nregions - 1; i >= 0; i--)
+    if (region_ids[i] == id)
+      return i;
+  if (nregions % 64 == 0) {
+    region_ids = (int *)realloc(region_ids, (nregions + 64) * sizeof(int));
+    if (region_ids == NULL)
+      nrerror("Memory allocation error in region_index().");
+  }
+  region_ids[nregions] = id;
+  return nregions++;
+}
+
+int region_add_var(out_data_struct *out_data,
+                   char            *varname)
+/**********************************************************************
+  region_add_var	Keith Mathews			October 2026
+
+  Adds output variable varname (a REGIONVAR of the global parameter
+  file) to the list of variables aggregated over regions.  Returns -1
+  if the name is unknown.
+
+  Modifications:
+**********************************************************************/
+{
+  int varid;
+  int i;
+
+  for (varid = 0; varid < N_OUTVAR_TYPES; varid++) {
+    if (strcmp(out_data[varid].varname, varname) == 0) {
+      for (i = 0; i < nregion_vars; i++)
+        if (region_vars[i] == varid)
+          return 0;
+      region_vars[nregion_vars++] = varid;
+      return 0;
+    }
+  }
+  fprintf(stderr, "Error: region_add_var: \"%s\" was not found in the list of supported output variable names.  Please use the exact name listed in vicNl_def.h.\n", varname);
+  return -1;
+}
+
+void region_init(filenames_struct    *names,
+                 global_param_struct *global,
+                 out_data_struct     *out_data)
+/**********************************************************************
+  region_init		Keith Mathews			October 2026
+
+  Reads the REGION_MAP file and allocates the regional series.  If no
+  REGIONVAR was given, a default set of water balance variables is
+  aggregated.
+
+  Modifications:
+**********************************************************************/
+{
+  FILE   *fp;
+  char    line[MAXSTRING];
+  char    ErrStr[3*MAXSTRING];
+  int     gridcel, id, nalloc, v, i;
+  double  weight;
+
+  if (strcmp(names->region_map, "NONE") == 0)
+    return;
+
+  /* read the cell -> region map */
+  fp = open_file(names->region_map, "r");
+  nalloc = 0;
+  while (fgets(line, MAXSTRING, fp) != NULL) {
+    if (line[0] == '#' || line[0] == '\n' || line[0] == '\0')
+      continue;
+    if (sscanf(line, "%d %d %lf", &gridcel, &id, &weight) != 3) {
+      snprintf(ErrStr, sizeof(ErrStr), "Invalid line in REGION_MAP file %s:\n%s", names->region_map, line);
+      nrerror(ErrStr);
+    }
+    if (weight < 0 || weight > 1) {
+      snprintf(ErrStr, sizeof(ErrStr), "REGION_MAP weight of cell %d in region %d (%f) must be between 0 and 1.", gridcel, id, weight);
+      nrerror(ErrStr);
+    }
+    if (nentries == nalloc) {
+      nalloc = (nalloc > 0) ? 2 * nalloc : 1024;
+      entries = (region_entry_struct *)realloc(entries, nalloc * sizeof(region_entry_struct));
+      if (entries == NULL)
+        nrerror("Memory allocation error in region_init().");
+    }
+    entries[nentries].gridcel = gridcel;
+    entries[nentries].region = region_index(id);
+    entries[nentries].weight = weight;
+    nentries++;
+  }
+  fclose(fp);
+  if (nentries == 0) {
+    snprintf(ErrStr, sizeof(ErrStr), "REGION_MAP file %s contains no cells.", names->region_map);
+    nrerror(ErrStr);
+  }
+  qsort(entries, nentries, sizeof(region_entry_struct), region_entry_cmp);
+
+  /* variables to aggregate */
+  if (nregion_vars == 0)
+    for (i = 0; i < sizeof(region_default_vars)/sizeof(region_default_vars[0]); i++)
+      region_add_var(out_data, region_default_vars[i]);
+  for (v = 0; v < nregion_vars; v++)
+    nvalues += out_data[region_vars[v]].nelem;
+
+  /* global->skipyear has been converted to a number of records */
+  out_dt = global->out_dt;
+  maxrecs = (global->nrecs - global->skipyear) / (global->out_dt / global->dt) + 1;
+  region_ncells = (int *)mem_calloc(nregions, sizeof(int), MEM_OUTPUT);
+  region_area = (double *)mem_calloc(nregions, sizeof(double), MEM_OUTPUT);
+  region_dmy = (dmy_struct *)mem_calloc(maxrecs, sizeof(dmy_struct), MEM_OUTPUT);
+  region_sum = (double *)mem_calloc((size_t)nregions * maxrecs * nvalues, sizeof(double), MEM_OUTPUT);
+  if (region_ncells == NULL || region_area == NULL || region_dmy == NULL || region_sum == NULL) {
+    snprintf(ErrStr, sizeof(ErrStr), "Memory allocation error in region_init(): %d regions x %d records x %d values.", nregions, maxrecs, nvalues);
+    nrerror(ErrStr);
+  }
+}
+
+void region_start_cell(soil_con_struct *soil_con)
+/**********************************************************************
+  region_start_cell	Keith Mathews			October 2026
+
+  Finds the regions to which the current cell contributes.
+
+  Modifications:
+**********************************************************************/
+{
+  int lo, hi, mid;
+
+  cell_n = 0;
+  cell_rec = 0;
+  if (entries == NULL)
+    return;
+
+  /* first entry with gridcel >= soil_con->gridcel */
+  lo = 0;
+  hi = nentries;
+  while (lo < hi) {
+    mid = (lo + hi) / 2;
+    if (entries[mid].gridcel < soil_con->gridcel) lo = mid + 1;
+    else hi = mid;
+  }
+  cell_first = lo;
+  while (lo < nentries && entries[lo].gridcel == soil_con->gridcel) {
+    cell_n++;
+    lo++;
+  }
+}
+
+void region_accumulate(out_data_struct *out_data,
+                       dmy_struct      *dmy,
+                       soil_con_struct *soil_con)
+/**********************************************************************
+  region_accumulate	Keith Mathews			October 2026
+
+  Adds the aggregated output values of the current cell for the
+  current output interval to the sums of its regions.  Called from
+  put_data() at each output interval, before the values are scaled for
+  binary output.
+
+  Modifications:
+**********************************************************************/
+{
+  double *sum;
+  double  wa;
+  int     e, v, i, k;
+
+  if (cell_n == 0)
+    return;
+  if (cell_rec >= maxrecs)
+    nrerror("More output records than expected in region_accumulate().");
+
+  if (cell_rec >= nrecs_written) {
+    region_dmy[cell_rec] = *dmy;
+    nrecs_written = cell_rec + 1;
+  }
+  for (e = cell_first; e < cell_first + cell_n; e++) {
+    wa = entries[e].weight * soil_con->cell_area;
+    sum = &region_sum[((size_t)entries[e].region * maxrecs + cell_rec) * nvalues];
+    k = 0;
+    for (v = 0; v < nregion_vars; v++)
+      for (i = 0; i < out_data[region_vars[v]].nelem; i++)
+        sum[k++] += wa * out_data[region_vars[v]].aggdata[i];
+  }
+  cell_rec++;
+}
+
+void region_end_cell(soil_con_struct *soil_con)
+/**********************************************************************
+  region_end_cell	Keith Mathews			October 2026
+
+  Adds the area of the current cell to its regions.
+
+  Modifications:
+**********************************************************************/
+{
+  int e;
+
+  for (e = cell_first; e < cell_first + cell_n; e++) {
+    region_area[entries[e].region] += entries[e].weight * soil_con->cell_area;
+    region_ncells[entries[e].region]++;
+  }
+  cell_n = 0;
+}
+
+void region_write(filenames_struct *names,
+                  out_data_struct  *out_data)
+/**********************************************************************
+  region_write		Keith Mathews			October 2026
+
+  Writes the area-weighted mean series of each region to
+  <RESULT_DIR>/<REGION_PREFIX>_<region_id>, and frees the regional
+  storage.  Regions to which no simulated cell contributed are
+  skipped.
+
+  Modifications:
+**********************************************************************/
+{
+  FILE   *fp;
+  char    filename[2*MAXSTRING+32];
+  double *sum;
+  int     r, rec, v, i, k, nempty;
+  out_data_struct *var;
+
+  if (entries == NULL)
+    return;
+
+  nempty = 0;
+  for (r = 0; r < nregions; r++) {
+    if (region_ncells[r] == 0 || region_area[r] <= 0) {
+      nempty++;
+      continue;
+    }
+    sprintf(filename, "%s/%s_%d", names->result_dir, names->region_prefix, region_ids[r]);
+    fp = open_file(filename, "w");
+    fprintf(fp, "# REGION %d\n", region_ids[r]);
+    fprintf(fp, "# NCELLS %d\n", region_ncells[r]);
+    fprintf(fp, "# AREA_M2 %.6e\n", region_area[r]);
+    fprintf(fp, "# YEAR\tMONTH\tDAY");
+    if (out_dt < 24)
+      fprintf(fp, "\tHOUR");
+    for (v = 0; v < nregion_vars; v++) {
+      var = &out_data[region_vars[v]];
+      if (var->nelem == 1)
+        fprintf(fp, "\t%s", var->varname);
+      else
+        for (i = 0; i < var->nelem; i++)
+          fprintf(fp, "\t%s_%d", var->varname, i);
+    }
+    fprintf(fp, "\n");
+
+    for (rec = 0; rec < nrecs_written; rec++) {
+      if (out_dt < 24)
+        fprintf(fp, "%04i\t%02i\t%02i\t%02i", region_dmy[rec].year,
+                region_dmy[rec].month, region_dmy[rec].day, region_dmy[rec].hour);
+      else
+        fprintf(fp, "%04i\t%02i\t%02i", region_dmy[rec].year,
+                region_dmy[rec].month, region_dmy[rec].day);
+      sum = &region_sum[((size_t)r * maxrecs + rec) * nvalues];
+      k = 0;
+      for (v = 0; v < nregion_vars; v++) {
+        var = &out_data[region_vars[v]];
+        for (i = 0; i < var->nelem; i++) {
+          fprintf(fp, "\t ");
+          fprintf(fp, var->format, sum[k++] / region_area[r]);
+        }
+      }
+      fprintf(fp, "\n");
+    }
+    fclose(fp);
+  }
+  if (nempty > 0)
+    fprintf(stderr, "WARNING: %d of %d regions in the REGION_MAP contain no simulated cells; no output was written for them.\n", nempty, nregions);
+
+  mem_free(region_sum, MEM_OUTPUT);
+  mem_free(region_dmy, MEM_OUTPUT);
+  mem_free(region_area, MEM_OUTPUT);
+  mem_free(region_ncells, MEM_OUTPUT);
+  free(entries);
+  free(region_ids);
+  entries = NULL;
+  region_ids = NULL;
+}
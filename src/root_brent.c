@@ -101,10 +101,12 @@ static char vcid[] = "$Id$";
   2007-Sep-01 Removed the integer "eval" since it is never used for anything.	JCA
   2009-May-22 Modified root-bracketing scheme to handle case when one bound
 	      yields garbage output from the target function.			TJB
+  2026-Oct-17 Added solver_stats counters.				KM
 *****************************************************************************/
 double root_brent(double LowerBound, double UpperBound, char *ErrorString,
                 double (*Function)(double Estimate, va_list ap), ...)
 {
+  extern solver_stats_struct solver_stats;
   const char *Routine = "RootBrent";
   va_list ap;                   /* Used in traversing variable argument list */ 
   double a;
@@ -127,6 +129,8 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
   int i;
   int j;
 
+  solver_stats.root_brent_calls++;
+
   /* initialize variable argument list */
   a = LowerBound;
   b = UpperBound;
@@ -281,6 +285,8 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
 
   for (i = 0; i < MAXITER; i++) {
 
+    solver_stats.root_brent_iter++;
+
     if (fb*fc > 0) {
       c = a;
       fc = fa;
@@ -0,0 +1,580 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  routing.c		Keith Mathews			October 2026
+
+  Optional unit-hydrograph routing of runoff to basin outlets, in the
+  manner of the Lohmann et al. (1996, 1998) routing model, done while
+  the model runs so that routed streamflow does not have to be computed
+  afterwards from the per-cell output files.
+
+  The river network is given by a flow direction grid (ROUTING_FLOWDIR;
+  ArcInfo ASCII grid of D8 codes 1-8 = N, NE, E, SE, S, SW, W, NW, as
+  used by the routing model), with optionally a grid of the fraction of
+  each cell that drains into the network (ROUTING_FRACTION), and a list
+  of outlets (ROUTING_STATIONS; lines of "<name> <lat> <lng>").  Model
+  cells are located on these grids by their lat and lng.
+
+  At each output interval, route_accumulate() stores OUT_RUNOFF +
+  OUT_BASEFLOW of the current cell.  When the cell is done,
+  route_end_cell() follows the flow directions from the cell to every
+  station downstream of it, and convolves the cell's series with the
+  impulse response from the cell to that station: the within-cell unit
+  hydrograph (ROUTING_UH; ordinates at the output interval, default an
+  impulse), convolved with the linearized Saint-Venant response of the
+  channel over the flow distance to the station, for wave velocity
+  ROUTING_VELOCITY [m/s] and diffusivity ROUTING_DIFFUSION [m2/s].
+  The result is added to the station's hydrograph [m3/s].
+
+  Short kernels are convolved directly.  For long kernels (e.g. with
+  hourly output), the spectra of the cell series and kernel are
+  multiplied and summed per station, and the station hydrograph is
+  recovered with one inverse FFT at the end of the run.  The spectrum
+  of the cell series is computed once per cell, and the FFT twiddle
+  factors once per run.
+
+  The records of the SKIPYEAR period are routed (so that the channels
+  are filled at the start of the output period), but not written.  At
+  the end of the run, one file per station is written to RESULT_DIR,
+  named flow_<name>, holding the discharge [m3/s] at each output
+  interval.
+
+  Modifications:
+**********************************************************************/
+
+#define ROUTE_DIRECT_MAX  64       /* longest kernel convolved directly */
+#define ROUTE_MASS_MIN    0.9999   /* fraction of the channel response kept */
+
+typedef struct {
+  char     name[MAXSTRING];
+  double   lat;
+  double   lng;
+  int      idx;            /* grid index of the station cell */
+  int      ncells;         /* number of cells routed to the station */
+  double   area;           /* contributing area [m2] */
+  double  *flow;           /* hydrograph [m3/s], directly convolved part */
+  double  *spec;           /* summed spectra (re, im), or NULL */
+} route_station_struct;
+
+static route_station_struct *stations = NULL;
+static int      nstations = 0;
+static int      ncols, nrows;
+static double   xll, yll, cellsize;
+static int     *flowdir = NULL;    /* [row*ncols+col], row 0 at the top */
+static double  *fraction = NULL;
+static int     *station_at = NULL; /* station index of each grid cell, or -1 */
+static double  *uh_cell = NULL;    /* within-cell unit hydrograph */
+static int      nuh = 1;
+static double   velocity;
+static double   diffusion;
+static int      out_dt;            /* output interval [h] */
+static int      skiprec;           /* first model record written */
+static int      maxrecs = 0;
+static int      nrecs_written = 0;
+static int      fft_len = 0;
+static dmy_struct *route_dmy = NULL;
+static int     *route_rec = NULL;  /* model record of each output record */
+static double  *cell_q = NULL;     /* runoff of the current cell [m3/s] */
+static int      cell_n = 0;
+static double  *cell_spec = NULL;  /* spectrum of cell_q (re, im) */
+static double  *work1 = NULL;      /* kernel and FFT work arrays */
+static double  *work2 = NULL;
+static double  *twiddle = NULL;    /* cos, sin of -2 pi k / fft_len */
+static double  *kernel = NULL;
+
+static double *route_read_grid(char *filename, int check)
+/* Reads an ArcInfo ASCII grid.  The first grid read sets the geometry;
+   later grids (check = TRUE) must match it. */
+{
+  FILE   *fp;
+  char    key[MAXSTRING];
+  char    ErrStr[MAXSTRING];
+  int     nc, nr, i;
+  double  x, y, size, nodata;
+  double *grid;
+
+  fp = open_file(filename, "r");
+  if (fscanf(fp, "%s %d %s %d %s %lf %s %lf %s %lf %s %lf", key, &nc, key, &nr,
+             key, &x, key, &y, key, &size, key, &nodata) != 12) {
+    snprintf(ErrStr, sizeof(ErrStr), "Unable to read the header of grid file %s.", filename);
+    nrerror(ErrStr);
+  }
+  if (!check) {
+    ncols = nc;
+    nrows = nr;
+    xll = x;
+    yll = y;
+    cellsize = size;
+  }
+  else if (nc != ncols || nr != nrows || fabs(x - xll) > 1e-6 ||
+           fabs(y - yll) > 1e-6 || fabs(size - cellsize) > 1e-6) {
+    snprintf(ErrStr, sizeof(ErrStr), "Grid file %s does not match the geometry of the flow direction grid.", filename);
+    nrerror(ErrStr);
+  }
+  grid = (double *)mem_calloc((size_t)ncols * nrows, sizeof(double), MEM_ROUTING);
+  for (i = 0; i < ncols * nrows; i++) {
+    if (fscanf(fp, "%lf", &grid[i]) != 1) {
+      snprintf(ErrStr, sizeof(ErrStr), "Grid file %s ends after %d of %d values.", filename, i, ncols * nrows);
+      nrerror(ErrStr);
+    }
+    if (grid[i] == nodata)
+      grid[i] = 0;
+  }
+  fclose(fp);
+  return grid;
+}
+
+static int route_grid_index(double lat, double lng)
+/* Returns the grid index of the cell containing (lat, lng), or -1. */
+{
+  int col, row;
+
+  col = (int)floor((lng - xll) / cellsize);
+  row = nrows - 1 - (int)floor((lat - yll) / cellsize);
+  if (col < 0 || col >= ncols || row < 0 || row >= nrows)
+    return -1;
+  return row * ncols + col;
+}
+
+static int route_downstream(int idx)
+/* Returns the grid index of the cell downstream of idx, or -1. */
+{
+  static int dcol[9] = { 0, 0, 1, 1, 1, 0, -1, -1, -1 };
+  static int drow[9] = { 0, -1, -1, 0, 1, 1, 1, 0, -1 };
+  int dir, col, row;
+
+  dir = flowdir[idx];
+  if (dir < 1 || dir > 8)
+    return -1;
+  col = idx % ncols + dcol[dir];
+  row = idx / ncols + drow[dir];
+  if (col < 0 || col >= ncols || row < 0 || row >= nrows)
+    return -1;
+  return row * ncols + col;
+}
+
+static double route_lat(int idx)
+{
+  return yll + (nrows - 1 - idx / ncols + 0.5) * cellsize;
+}
+
+static double route_lng(int idx)
+{
+  return xll + (idx % ncols + 0.5) * cellsize;
+}
+
+static void route_fft(double *x, int n, int inverse)
+/* In-place radix-2 FFT of n = fft_len complex values (re, im
+   interleaved). */
+{
+  int     i, j, k, m, len, stride;
+  double  wr, wi, ur, ui, vr, vi, tr, ti, t;
+
+  for (i = 1, j = 0; i < n; i++) {
+    for (k = n >> 1; j & k; k >>= 1)
+      j ^= k;
+    j ^= k;
+    if (i < j) {
+      t = x[2*i];   x[2*i] = x[2*j];     x[2*j] = t;
+      t = x[2*i+1]; x[2*i+1] = x[2*j+1]; x[2*j+1] = t;
+    }
+  }
+  for (len = 2; len <= n; len <<= 1) {
+    stride = n / len;
+    for (i = 0; i < n; i += len) {
+      for (m = 0; m < len / 2; m++) {
+        wr = twiddle[2*m*stride];
+        wi = inverse ? -twiddle[2*m*stride+1] : twiddle[2*m*stride+1];
+        ur = x[2*(i+m)];
+        ui = x[2*(i+m)+1];
+        tr = x[2*(i+m+len/2)];
+        ti = x[2*(i+m+len/2)+1];
+        vr = tr * wr - ti * wi;
+        vi = tr * wi + ti * wr;
+        x[2*(i+m)] = ur + vr;
+        x[2*(i+m)+1] = ui + vi;
+        x[2*(i+m+len/2)] = ur - vr;
+        x[2*(i+m+len/2)+1] = ui - vi;
+      }
+    }
+  }
+  if (inverse)
+    for (i = 0; i < 2 * n; i++)
+      x[i] /= n;
+}
+
+static int route_kernel(double dist)
+/* Computes in kernel[] the impulse response (ordinates at the output
+   interval, summing to 1) of the flow path of length dist [m], and
+   returns its length. */
+{
+  double  t, h, mass, dt;
+  int     nriver, nk, i, j, sub;
+
+  /* channel response, integrated hourly into output intervals */
+  for (i = 0; i < maxrecs; i++)
+    work1[i] = 0;
+  if (dist <= 0) {
+    work1[0] = 1;
+    nriver = 1;
+  }
+  else {
+    dt = 3600.;
+    mass = 0;
+    nriver = 0;
+    for (i = 0; i < maxrecs && mass < ROUTE_MASS_MIN; i++) {
+      for (sub = 0; sub < out_dt; sub++) {
+        t = (i * out_dt + sub + 0.5) * dt;
+        h = dist / (2 * t * sqrt(PI * t * diffusion))
+            * exp(-(velocity * t - dist) * (velocity * t - dist) / (4 * diffusion * t));
+        work1[i] += h * dt;
+      }
+      mass += work1[i];
+      nriver = i + 1;
+    }
+    if (mass > 0)
+      for (i = 0; i < nriver; i++)
+        work1[i] /= mass;
+  }
+
+  /* convolve with the within-cell unit hydrograph */
+  nk = nriver + nuh - 1;
+  if (nk > maxrecs)
+    nk = maxrecs;
+  for (i = 0; i < nk; i++)
+    kernel[i] = 0;
+  for (j = 0; j < nuh; j++)
+    for (i = 0; i < nriver && i + j < nk; i++)
+      kernel[i + j] += uh_cell[j] * work1[i];
+  return nk;
+}
+
+void route_init(filenames_struct    *names,
+                global_param_struct *global)
+/**********************************************************************
+  route_init		Keith Mathews			October 2026
+
+  Reads the routing grids, station list, and within-cell unit
+  hydrograph, and allocates the station hydrographs.
+
+  Modifications:
+**********************************************************************/
+{
+  FILE   *fp;
+  char    line[MAXSTRING];
+  char    ErrStr[3*MAXSTRING];
+  double *grid;
+  double  sum;
+  int     i, n, nalloc;
+
+  if (strcmp(names->route_flowdir, "NONE") == 0)
+    return;
+
+  /* flow directions and contributing fractions */
+  grid = route_read_grid(names->route_flowdir, FALSE);
+  flowdir = (int *)mem_calloc((size_t)ncols * nrows, sizeof(int), MEM_ROUTING);
+  for (i = 0; i < ncols * nrows; i++)
+    flowdir[i] = (int)grid[i];
+  mem_free(grid, MEM_ROUTING);
+  if (strcmp(names->route_fraction, "NONE") != 0)
+    fraction = route_read_grid(names->route_fraction, TRUE);
+
+  /* stations */
+  station_at = (int *)mem_calloc((size_t)ncols * nrows, sizeof(int), MEM_ROUTING);
+  for (i = 0; i < ncols * nrows; i++)
+    station_at[i] = -1;
+  fp = open_file(names->route_stations, "r");
+  nalloc = 0;
+  while (fgets(line, MAXSTRING, fp) != NULL) {
+    if (line[0] == '#' || line[0] == '\n' || line[0] == '\0')
+      continue;
+    if (nstations == nalloc) {
+      nalloc = (nalloc > 0) ? 2 * nalloc : 16;
+      stations = (route_station_struct *)realloc(stations, nalloc * sizeof(route_station_struct));
+      if (stations == NULL)
+        nrerror("Memory allocation error in route_init().");
+    }
+    if (sscanf(line, "%s %lf %lf", stations[nstations].name,
+               &stations[nstations].lat, &stations[nstations].lng) != 3) {
+      snprintf(ErrStr, sizeof(ErrStr), "Invalid line in ROUTING_STATIONS file %s:\n%s", names->route_stations, line);
+      nrerror(ErrStr);
+    }
+    stations[nstations].idx = route_grid_index(stations[nstations].lat, stations[nstations].lng);
+    if (stations[nstations].idx < 0) {
+      snprintf(ErrStr, sizeof(ErrStr), "Station %s (%f, %f) is outside the flow direction grid.", stations[nstations].name, stations[nstations].lat, stations[nstations].lng);
+      nrerror(ErrStr);
+    }
+    if (station_at[stations[nstations].idx] >= 0) {
+      snprintf(ErrStr, sizeof(ErrStr), "Stations %s and %s are in the same grid cell.", stations[station_at[stations[nstations].idx]].name, stations[nstations].name);
+      nrerror(ErrStr);
+    }
+    station_at[stations[nstations].idx] = nstations;
+    nstations++;
+  }
+  fclose(fp);
+  if (nstations == 0) {
+    snprintf(ErrStr, sizeof(ErrStr), "ROUTING_STATIONS file %s contains no stations.", names->route_stations);
+    nrerror(ErrStr);
+  }
+
+  /* within-cell unit hydrograph */
+  if (strcmp(names->route_uh, "NONE") != 0) {
+    fp = open_file(names->route_uh, "r");
+    nalloc = 0;
+    nuh = 0;
+    while (fgets(line, MAXSTRING, fp) != NULL) {
+      if (line[0] == '#' || line[0] == '\n' || line[0] == '\0')
+        continue;
+      if (nuh == nalloc) {
+        nalloc = (nalloc > 0) ? 2 * nalloc : 64;
+        uh_cell = (double *)realloc(uh_cell, nalloc * sizeof(double));
+        if (uh_cell == NULL)
+          nrerror("Memory allocation error in route_init().");
+      }
+      if (sscanf(line, "%lf", &uh_cell[nuh]) != 1) {
+        snprintf(ErrStr, sizeof(ErrStr), "Invalid line in ROUTING_UH file %s:\n%s", names->route_uh, line);
+        nrerror(ErrStr);
+      }
+      nuh++;
+    }
+    fclose(fp);
+    sum = 0;
+    for (i = 0; i < nuh; i++)
+      sum += uh_cell[i];
+    if (sum <= 0) {
+      snprintf(ErrStr, sizeof(ErrStr), "The ordinates of the ROUTING_UH file %s must have a positive sum.", names->route_uh);
+      nrerror(ErrStr);
+    }
+    for (i = 0; i < nuh; i++)
+      uh_cell[i] /= sum;
+  }
+  else {
+    uh_cell = (double *)malloc(sizeof(double));
+    uh_cell[0] = 1;
+    nuh = 1;
+  }
+
+  /* series; all records, including the SKIPYEAR period, are routed */
+  velocity = global->route_velocity;
+  diffusion = global->route_diffusion;
+  out_dt = global->out_dt;
+  skiprec = global->skipyear;
+  maxrecs = global->nrecs / (global->out_dt / global->dt) + 1;
+  for (fft_len = 1; fft_len < 2 * maxrecs; fft_len <<= 1)
+    ;
+  route_dmy = (dmy_struct *)mem_calloc(maxrecs, sizeof(dmy_struct), MEM_ROUTING);
+  route_rec = (int *)mem_calloc(maxrecs, sizeof(int), MEM_ROUTING);
+  cell_q = (double *)mem_calloc(maxrecs, sizeof(double), MEM_ROUTING);
+  kernel = (double *)mem_calloc(maxrecs, sizeof(double), MEM_ROUTING);
+  cell_spec = (double *)mem_calloc(2 * fft_len, sizeof(double), MEM_ROUTING);
+  work1 = (double *)mem_calloc(2 * fft_len, sizeof(double), MEM_ROUTING);
+  work2 = (double *)mem_calloc(2 * fft_len, sizeof(double), MEM_ROUTING);
+  twiddle = (double *)mem_calloc(fft_len, sizeof(double), MEM_ROUTING);
+  for (i = 0; i < fft_len / 2; i++) {
+    twiddle[2*i] = cos(2 * PI / fft_len * i);
+    twiddle[2*i+1] = -sin(2 * PI / fft_len * i);
+  }
+  for (n = 0; n < nstations; n++) {
+    stations[n].flow = (double *)mem_calloc(maxrecs, sizeof(double), MEM_ROUTING);
+    stations[n].spec = NULL;
+    stations[n].ncells = 0;
+    stations[n].area = 0;
+  }
+}
+
+void route_start_cell()
+/**********************************************************************
+  route_start_cell	Keith Mathews			October 2026
+
+  Resets the runoff series of the current cell.
+
+  Modifications:
+**********************************************************************/
+{
+  cell_n = 0;
+}
+
+void route_accumulate(out_data_struct *out_data,
+                      dmy_struct      *dmy,
+                      int              rec)
+/**********************************************************************
+  route_accumulate	Keith Mathews			October 2026
+
+  Stores the runoff + baseflow of the current cell for the current
+  output interval.  Called from put_data() at each output interval,
+  after the conversion to ALMA units (if any) and before the values
+  are scaled for binary output.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  double q;
+
+  if (stations == NULL)
+    return;
+  if (cell_n >= maxrecs)
+    nrerror("More output records than expected in route_accumulate().");
+
+  /* depth per output interval [mm] -> depth rate [mm/s] */
+  q = out_data[OUT_RUNOFF].aggdata[0] + out_data[OUT_BASEFLOW].aggdata[0];
+  if (!options.ALMA_OUTPUT)
+    q /= (double)out_dt * SECPHOUR;
+  cell_q[cell_n] = q;
+  if (cell_n >= nrecs_written) {
+    route_dmy[cell_n] = *dmy;
+    route_rec[cell_n] = rec;
+    nrecs_written = cell_n + 1;
+  }
+  cell_n++;
+}
+
+void route_end_cell(soil_con_struct *soil_con)
+/**********************************************************************
+  route_end_cell	Keith Mathews			October 2026
+
+  Routes the runoff of the current cell to every station downstream
+  of it.
+
+  Modifications:
+**********************************************************************/
+{
+  route_station_struct *st;
+  double  area, dist, q_re, q_im, k_re, k_im;
+  int     idx, next, nsteps, nk, i, t, s;
+  int     have_spec;
+
+  if (stations == NULL || cell_n == 0)
+    return;
+  if ((idx = route_grid_index(soil_con->lat, soil_con->lng)) < 0)
+    return;
+
+  /* runoff [mm/s] -> discharge [m3/s] */
+  area = soil_con->cell_area * ((fraction != NULL) ? fraction[idx] : 1.);
+  if (area <= 0)
+    return;
+  for (t = 0; t < cell_n; t++)
+    cell_q[t] *= area / 1000.;
+
+  dist = 0;
+  have_spec = FALSE;
+  for (nsteps = 0; idx >= 0 && nsteps <= ncols * nrows; nsteps++) {
+    if ((s = station_at[idx]) >= 0) {
+      st = &stations[s];
+      st->ncells++;
+      st->area += area;
+      nk = route_kernel(dist);
+      if (nk <= ROUTE_DIRECT_MAX) {
+        for (i = 0; i < nk; i++)
+          for (t = 0; t + i < cell_n; t++)
+            st->flow[t + i] += kernel[i] * cell_q[t];
+      }
+      else {
+        if (st->spec == NULL)
+          st->spec = (double *)mem_calloc(2 * fft_len, sizeof(double), MEM_ROUTING);
+        if (!have_spec) {
+          for (i = 0; i < 2 * fft_len; i++)
+            cell_spec[i] = 0;
+          for (t = 0; t < cell_n; t++)
+            cell_spec[2*t] = cell_q[t];
+          route_fft(cell_spec, fft_len, FALSE);
+          have_spec = TRUE;
+        }
+        for (i = 0; i < 2 * fft_len; i++)
+          work2[i] = 0;
+        for (i = 0; i < nk; i++)
+          work2[2*i] = kernel[i];
+        route_fft(work2, fft_len, FALSE);
+        for (i = 0; i < fft_len; i++) {
+          q_re = cell_spec[2*i];
+          q_im = cell_spec[2*i+1];
+          k_re = work2[2*i];
+          k_im = work2[2*i+1];
+          st->spec[2*i] += q_re * k_re - q_im * k_im;
+          st->spec[2*i+1] += q_re * k_im + q_im * k_re;
+        }
+      }
+    }
+    if ((next = route_downstream(idx)) >= 0)
+      dist += 1000. * get_dist(route_lat(idx), route_lng(idx),
+                               route_lat(next), route_lng(next));
+    idx = next;
+  }
+  cell_n = 0;
+}
+
+void route_write(filenames_struct *names)
+/**********************************************************************
+  route_write		Keith Mathews			October 2026
+
+  Writes the hydrograph [m3/s] of each station to
+  <RESULT_DIR>/flow_<name>, omitting the SKIPYEAR period, and frees
+  the routing storage.
+
+  Modifications:
+**********************************************************************/
+{
+  FILE   *fp;
+  char    filename[2*MAXSTRING+16];
+  int     n, t;
+
+  if (stations == NULL)
+    return;
+
+  for (n = 0; n < nstations; n++) {
+    if (stations[n].spec != NULL) {
+      route_fft(stations[n].spec, fft_len, TRUE);
+      for (t = 0; t < nrecs_written; t++)
+        stations[n].flow[t] += stations[n].spec[2*t];
+      mem_free(stations[n].spec, MEM_ROUTING);
+    }
+    if (stations[n].ncells == 0)
+      fprintf(stderr, "WARNING: no simulated cell drains to routing station %s.\n", stations[n].name);
+
+    sprintf(filename, "%s/flow_%s", names->result_dir, stations[n].name);
+    fp = open_file(filename, "w");
+    fprintf(fp, "# STATION %s\n", stations[n].name);
+    fprintf(fp, "# LAT %.4f LNG %.4f\n", stations[n].lat, stations[n].lng);
+    fprintf(fp, "# NCELLS %d\n", stations[n].ncells);
+    fprintf(fp, "# AREA_M2 %.6e\n", stations[n].area);
+    fprintf(fp, "# YEAR\tMONTH\tDAY");
+    if (out_dt < 24)
+      fprintf(fp, "\tHOUR");
+    fprintf(fp, "\tFLOW_M3S\n");
+    for (t = 0; t < nrecs_written; t++) {
+      if (route_rec[t] < skiprec)
+        continue;
+      if (out_dt < 24)
+        fprintf(fp, "%04i\t%02i\t%02i\t%02i", route_dmy[t].year,
+                route_dmy[t].month, route_dmy[t].day, route_dmy[t].hour);
+      else
+        fprintf(fp, "%04i\t%02i\t%02i", route_dmy[t].year,
+                route_dmy[t].month, route_dmy[t].day);
+      fprintf(fp, "\t %.4f\n", stations[n].flow[t]);
+    }
+    fclose(fp);
+    mem_free(stations[n].flow, MEM_ROUTING);
+  }
+
+  mem_free(route_dmy, MEM_ROUTING);
+  mem_free(route_rec, MEM_ROUTING);
+  mem_free(cell_q, MEM_ROUTING);
+  mem_free(kernel, MEM_ROUTING);
+  mem_free(cell_spec, MEM_ROUTING);
+  mem_free(work1, MEM_ROUTING);
+  mem_free(work2, MEM_ROUTING);
+  mem_free(twiddle, MEM_ROUTING);
+  mem_free(flowdir, MEM_ROUTING);
+  mem_free(station_at, MEM_ROUTING);
+  if (fraction != NULL)
+    mem_free(fraction, MEM_ROUTING);
+  free(uh_cell);
+  free(stations);
+  stations = NULL;
+}
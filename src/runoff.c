@@ -7,11 +7,10 @@ static char vcid[] = "$Id$";
 int  runoff(cell_data_struct  *cell,
             energy_bal_struct *energy,
             soil_con_struct   *soil_con,
-	    double             ppt, 
 	    double            *frost_fract,
 	    int                dt,
             int                Nnodes,
-	    int                band,
+	    int                Nbands,
 	    int                rec,
 	    int                iveg)
 /**********************************************************************
@@ -166,365 +165,373 @@ int  runoff(cell_data_struct  *cell,
   2013-Dec-27 Removed QUICK_FS option.						TJB
   2014-Mar-28 Removed DIST_PRCP option.						TJB
   2014-May-09 Added check on liquid soil moisture to ensure always >= 0.	TJB
+  2026-Oct-17 Passes soil_con->node_layer to
+	      distribute_node_moisture_properties.			KM
+  2026-Oct-17 Solves all Nbands bands of a veg tile at once: cell and
+	      energy are the arrays of the tile's bands, and ppt is
+	      taken from cell[band].inflow.  The state of the bands with
+	      area is held in arrays indexed by band, which each step of
+	      the hourly drainage and the baseflow loops over; bands with
+	      AreaFract = 0 are skipped.  Each band's arithmetic is
+	      unchanged.  Removed the unused Tlayer_spatial, b, and
+	      last_layer variables.					KM
 **********************************************************************/
 {  
   extern option_struct options;
-  int                firstlayer, lindex;
   int                i;
-  int                last_layer[MAX_LAYERS*3];
-  int                last_index;
-  int                last_cnt;
+  int                lane;
+  int                Nlanes;
+  int                lane_band[MAX_BANDS];
+  int                lindex;
   int                time_step;
   int                tmplayer;
   int                frost_area;
   int                ErrorFlag;
   double             A, frac;
   double             tmp_runoff;
-  double             inflow;
   double             resid_moist[MAX_LAYERS]; // residual moisture (mm)
-  double             org_moist[MAX_LAYERS];   // total soil moisture (liquid and frozen) at beginning of this function (mm)
-  double             avail_liq[MAX_LAYERS][MAX_FROST_AREAS]; // liquid soil moisture available for evap/drainage (mm)
-  double             liq[MAX_LAYERS];         // current liquid soil moisture (mm)
-  double             ice[MAX_LAYERS];         // current frozen soil moisture (mm)
-  double             moist[MAX_LAYERS];       // current total soil moisture (liquid and frozen) (mm)
   double             max_moist[MAX_LAYERS];   // maximum storable moisture (liquid and frozen) (mm)
   double             Ksat[MAX_LAYERS];
-  double             Q12[MAX_LAYERS-1];
+  double             moist[MAX_LAYERS];       // total soil moisture (liquid and frozen) of a band (mm)
+  double             avail_liq[MAX_FROST_AREAS]; // liquid soil moisture available for evap/drainage (mm)
   double             Dsmax;
   double             tmp_inflow;
   double             tmp_moist;
   double             tmp_moist_for_runoff[MAX_LAYERS];
   double             tmp_liq;
-  double             dt_inflow;
   double             dt_runoff;
-  double             runoff[MAX_FROST_AREAS];
-  double             tmp_dt_runoff[MAX_FROST_AREAS];
-  double             baseflow[MAX_FROST_AREAS];
   double             dt_baseflow;
   double             rel_moist;
-  double             evap[MAX_LAYERS][MAX_FROST_AREAS];
   double             sum_liq;
   double             evap_fraction;
-  double             evap_sum;
-  double             min_temp;
-  double             max_temp;
-  double             tmp_fract;
-  double             Tlayer_spatial[MAX_LAYERS][MAX_FROST_AREAS];
-  double             b[MAX_LAYERS];
+  cell_data_struct  *c;
   layer_data_struct *layer;
-  layer_data_struct  tmp_layer;
 
-  /** Set Residual Moisture **/
-  for ( i = 0; i < options.Nlayer; i++ ) 
+  /* State of each active band ("lane"); the lane is the fastest
+     varying index, so that each step below is done for all bands */
+  double             org_moist[MAX_LAYERS][MAX_BANDS]; // total soil moisture (liquid and frozen) at beginning of this function (mm)
+  double             evap[MAX_LAYERS][MAX_FROST_AREAS][MAX_BANDS];
+  double             liq[MAX_LAYERS][MAX_BANDS];  // current liquid soil moisture (mm)
+  double             ice[MAX_LAYERS][MAX_BANDS];  // current frozen soil moisture (mm)
+  double             Q12[MAX_LAYERS-1][MAX_BANDS];
+  double             inflow[MAX_BANDS];
+  double             dt_inflow[MAX_BANDS];
+  double             tmp_dt_runoff[MAX_BANDS];
+  double             runoff[MAX_FROST_AREAS][MAX_BANDS];
+  double             baseflow[MAX_FROST_AREAS][MAX_BANDS];
+
+  /** Bands with area are solved; bands with AreaFract = 0 are masked out **/
+  Nlanes = 0;
+  for ( i = 0; i < Nbands; i++ )
+    if ( soil_con->AreaFract[i] > 0 ) lane_band[Nlanes++] = i;
+
+  /** Set soil properties, which are the same for all bands **/
+  for ( i = 0; i < options.Nlayer; i++ ) {
     resid_moist[i] = soil_con->resid_moist[i] * soil_con->depth[i] * 1000.;
+    Ksat[i]        = soil_con->Ksat[i] / 24.;
+    max_moist[i]   = soil_con->max_moist[i];
+  }
+  Dsmax = soil_con->Dsmax / 24.;
+
+  for ( lane = 0; lane < Nlanes; lane++ ) {
+    c = &cell[lane_band[lane]];
+    c->runoff = 0;
+    c->baseflow = 0;
+    c->asat = 0;
+    for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ )
+      baseflow[frost_area][lane] = 0;
+  }
 
-  /** Allocate and Set Values for Soil Sublayers **/
-  layer = cell->layer;
-
-  cell->runoff = 0;
-  cell->baseflow = 0;
-  cell->asat = 0;
-
-  for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ )
-    baseflow[frost_area] = 0;
-      
   for ( lindex = 0; lindex < options.Nlayer; lindex++ ) {
-    evap[lindex][0] = layer[lindex].evap/(double)dt;
-    org_moist[lindex] = layer[lindex].moist;
-    layer[lindex].moist = 0;
-    if ( evap[lindex][0] > 0 ) { // if there is positive evaporation
-      sum_liq = 0;
-      // compute available soil moisture for each frost sub area.
-      for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
-        avail_liq[lindex][frost_area] = (org_moist[lindex] - layer[lindex].ice[frost_area] - resid_moist[lindex]);
-        if (avail_liq[lindex][frost_area] < 0) avail_liq[lindex][frost_area] = 0;
-        sum_liq += avail_liq[lindex][frost_area]*frost_fract[frost_area];
-      }
-      // compute fraction of available soil moisture that is evaporated
-      if (sum_liq > 0) {
-        evap_fraction = evap[lindex][0] / sum_liq;
+    for ( lane = 0; lane < Nlanes; lane++ ) {
+      layer = cell[lane_band[lane]].layer;
+      evap[lindex][0][lane] = layer[lindex].evap/(double)dt;
+      org_moist[lindex][lane] = layer[lindex].moist;
+      layer[lindex].moist = 0;
+      if ( evap[lindex][0][lane] > 0 ) { // if there is positive evaporation
+        sum_liq = 0;
+        // compute available soil moisture for each frost sub area.
+        for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
+          avail_liq[frost_area] = (org_moist[lindex][lane] - layer[lindex].ice[frost_area] - resid_moist[lindex]);
+          if (avail_liq[frost_area] < 0) avail_liq[frost_area] = 0;
+          sum_liq += avail_liq[frost_area]*frost_fract[frost_area];
+        }
+        // compute fraction of available soil moisture that is evaporated
+        if (sum_liq > 0) {
+          evap_fraction = evap[lindex][0][lane] / sum_liq;
+        }
+        else {
+          evap_fraction = 1.0;
+        }
+        // distribute evaporation between frost sub areas by percentage
+        for ( frost_area = options.Nfrost - 1; frost_area >= 0; frost_area-- )
+          evap[lindex][frost_area][lane] = avail_liq[frost_area] * evap_fraction;
       }
       else {
-        evap_fraction = 1.0;
-      }
-      // distribute evaporation between frost sub areas by percentage
-      evap_sum = evap[lindex][0];
-      for ( frost_area = options.Nfrost - 1; frost_area >= 0; frost_area-- ) {
-        evap[lindex][frost_area] = avail_liq[lindex][frost_area] * evap_fraction;
-        avail_liq[lindex][frost_area] -= evap[lindex][frost_area];
-        evap_sum -= evap[lindex][frost_area] * frost_fract[frost_area];
+        for ( frost_area = options.Nfrost - 1; frost_area > 0; frost_area-- )
+          evap[lindex][frost_area][lane] = evap[lindex][0][lane];
       }
     }
-    else {
-      for ( frost_area = options.Nfrost - 1; frost_area > 0; frost_area-- )
-        evap[lindex][frost_area] = evap[lindex][0];
-    }
-  }
-
-  // compute temperatures of frost subareas
-  for ( lindex = 0; lindex < options.Nlayer; lindex++ ) {
-    min_temp = layer[lindex].T - soil_con->frost_slope / 2.;
-    max_temp = min_temp + soil_con->frost_slope;
-    for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
-      if ( options.Nfrost > 1 ) {
-        if ( frost_area == 0 ) tmp_fract = frost_fract[0] / 2.;
-        else tmp_fract += (frost_fract[frost_area-1] + frost_fract[frost_area]) / 2.;
-        Tlayer_spatial[lindex][frost_area] = linear_interp(tmp_fract, 0, 1, min_temp, max_temp);
-      }
-      else Tlayer_spatial[lindex][frost_area] = layer[lindex].T;
-    }
   }
 
   for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
 
-    /** ppt = amount of liquid water coming to the surface **/
-    inflow = ppt;
-	
     /**************************************************
       Initialize Variables
     **************************************************/
-    for ( lindex = 0; lindex < options.Nlayer; lindex++ ) {
-      Ksat[lindex]         = soil_con->Ksat[lindex] / 24.;
-      b[lindex]            = (soil_con->expt[lindex] - 3.) / 2.;
+    for ( lane = 0; lane < Nlanes; lane++ ) {
+      c = &cell[lane_band[lane]];
+      layer = c->layer;
 
-      /** Set Layer Liquid Moisture Content **/
-      liq[lindex] = org_moist[lindex] - layer[lindex].ice[frost_area];
+      /** ppt = amount of liquid water coming to the surface **/
+      inflow[lane] = c->inflow;
 
-      /** Set Layer Frozen Moisture Content **/
-      ice[lindex]       = layer[lindex].ice[frost_area];
+      for ( lindex = 0; lindex < options.Nlayer; lindex++ ) {
+        /** Set Layer Liquid Moisture Content **/
+        liq[lindex][lane] = org_moist[lindex][lane] - layer[lindex].ice[frost_area];
 
-      /** Set Layer Maximum Moisture Content **/
-      max_moist[lindex] = soil_con->max_moist[lindex];
+        /** Set Layer Frozen Moisture Content **/
+        ice[lindex][lane] = layer[lindex].ice[frost_area];
+      }
 
-    } // initialize variables for each layer
+      /******************************************************
+        Runoff Based on Soil Moisture Level of Upper Layers
+      ******************************************************/
 
-    /******************************************************
-      Runoff Based on Soil Moisture Level of Upper Layers
-    ******************************************************/
+      for(lindex=0;lindex<options.Nlayer;lindex++) {
+        tmp_moist_for_runoff[lindex] = (liq[lindex][lane] + ice[lindex][lane]);
+      }
+      compute_runoff_and_asat(soil_con, tmp_moist_for_runoff, inflow[lane], &A, &(runoff[frost_area][lane]));
 
-    for(lindex=0;lindex<options.Nlayer;lindex++) {
-      tmp_moist_for_runoff[lindex] = (liq[lindex] + ice[lindex]);
+      // save dt_runoff based on initial runoff estimate,
+      // since we will modify total runoff below for the case of completely saturated soil
+      tmp_dt_runoff[lane] = runoff[frost_area][lane] / (double) dt;
+
+      dt_inflow[lane] = inflow[lane] / (double) dt;
     }
-    compute_runoff_and_asat(soil_con, tmp_moist_for_runoff, inflow, &A, &(runoff[frost_area]));
 
-    // save dt_runoff based on initial runoff estimate,
-    // since we will modify total runoff below for the case of completely saturated soil
-    tmp_dt_runoff[frost_area] = runoff[frost_area] / (double) dt;
-	  
     /**************************************************
       Compute Flow Between Soil Layers (using an hourly time step)
     **************************************************/
-	  
-    dt_inflow  =  inflow / (double) dt;
-	  
+
     for (time_step = 0; time_step < dt; time_step++) {
-      inflow   = dt_inflow;
-      last_cnt = 0;
-	    
+      for ( lane = 0; lane < Nlanes; lane++ )
+        inflow[lane] = dt_inflow[lane];
+
       /*************************************
         Compute Drainage between Sublayers 
       *************************************/
 
       for( lindex = 0; lindex < options.Nlayer-1; lindex++ ) {
+        for ( lane = 0; lane < Nlanes; lane++ ) {
+
+          /** Brooks & Corey relation for hydraulic conductivity **/
 
-        /** Brooks & Corey relation for hydraulic conductivity **/
-	      
-        if((tmp_liq = liq[lindex] - evap[lindex][frost_area]) < resid_moist[lindex])
-	  tmp_liq = resid_moist[lindex];
-	      
-	if(liq[lindex] > resid_moist[lindex]) {
-	  Q12[lindex] = Ksat[lindex] * pow(((tmp_liq - resid_moist[lindex]) / (soil_con->max_moist[lindex] - resid_moist[lindex])), soil_con->expt[lindex]); 
-	}
-	else Q12[lindex] = 0.;
-	last_layer[last_cnt] = lindex;
+          if((tmp_liq = liq[lindex][lane] - evap[lindex][frost_area][lane]) < resid_moist[lindex])
+	    tmp_liq = resid_moist[lindex];
+
+	  if(liq[lindex][lane] > resid_moist[lindex]) {
+	    Q12[lindex][lane] = Ksat[lindex] * pow(((tmp_liq - resid_moist[lindex]) / (max_moist[lindex] - resid_moist[lindex])), soil_con->expt[lindex]); 
+	  }
+	  else Q12[lindex][lane] = 0.;
+        }
       }
-	    
+
       /**************************************************
         Solve for Current Soil Layer Moisture, and
         Check Versus Maximum and Minimum Moisture Contents.  
       **************************************************/
-	    
-      firstlayer = TRUE;
-      last_index = 0;
+
       for ( lindex = 0; lindex < options.Nlayer - 1; lindex++ ) {
-	      
-        if ( lindex == 0 ) dt_runoff = tmp_dt_runoff[frost_area];
-	else dt_runoff = 0;
-
-	/* transport moisture for all sublayers **/
-
-	tmp_inflow = 0.;
-	      
-	/** Update soil layer moisture content **/
-	liq[lindex] = liq[lindex] + (inflow - dt_runoff) - (Q12[lindex] + evap[lindex][frost_area]);
-	      
-	/** Verify that soil layer moisture is less than maximum **/
-	if((liq[lindex]+ice[lindex]) > max_moist[lindex]) {
-	  tmp_inflow = (liq[lindex]+ice[lindex]) - max_moist[lindex];
-	  liq[lindex] = max_moist[lindex] - ice[lindex];
-
-          if(lindex==0) {
-	    Q12[lindex] += tmp_inflow;
-	    tmp_inflow = 0;
-	  }
-	  else {
-	    tmplayer = lindex;
-	    while(tmp_inflow > 0) {
-	      tmplayer--;
-	      if ( tmplayer < 0 ) {
-		/** If top layer saturated, add to runoff **/
-		runoff[frost_area] += tmp_inflow;
-		tmp_inflow = 0;
-	      }
-	      else {
-		/** else add excess soil moisture to next higher layer **/
-		liq[tmplayer] += tmp_inflow;
-		if((liq[tmplayer]+ice[tmplayer]) > max_moist[tmplayer]) {
-		  tmp_inflow = ((liq[tmplayer] + ice[tmplayer]) - max_moist[tmplayer]);
-		  liq[tmplayer] = max_moist[tmplayer] - ice[tmplayer];
-		}
-	        else tmp_inflow=0;
-	      }
+        for ( lane = 0; lane < Nlanes; lane++ ) {
+
+          if ( lindex == 0 ) dt_runoff = tmp_dt_runoff[lane];
+	  else dt_runoff = 0;
+
+	  /* transport moisture for all sublayers **/
+
+	  tmp_inflow = 0.;
+
+	  /** Update soil layer moisture content **/
+	  liq[lindex][lane] = liq[lindex][lane] + (inflow[lane] - dt_runoff) - (Q12[lindex][lane] + evap[lindex][frost_area][lane]);
+
+	  /** Verify that soil layer moisture is less than maximum **/
+	  if((liq[lindex][lane]+ice[lindex][lane]) > max_moist[lindex]) {
+	    tmp_inflow = (liq[lindex][lane]+ice[lindex][lane]) - max_moist[lindex];
+	    liq[lindex][lane] = max_moist[lindex] - ice[lindex][lane];
+
+            if(lindex==0) {
+	      Q12[lindex][lane] += tmp_inflow;
+	      tmp_inflow = 0;
 	    }
-	  } /** end trapped excess moisture **/
-	} /** end check if excess moisture in top layer **/
-	      
-	firstlayer=FALSE;
-	      
-	/** verify that current layer moisture is greater than minimum **/
-	if (liq[lindex] < 0) {
-	  /** liquid cannot fall below 0 **/
-	  Q12[lindex] += liq[lindex];
-	  liq[lindex] = 0;
-	}
-	if ((liq[lindex]+ice[lindex]) < resid_moist[lindex]) {
-	  /** moisture cannot fall below minimum **/
-	  Q12[lindex] += (liq[lindex]+ice[lindex]) - resid_moist[lindex];
-	  liq[lindex] = resid_moist[lindex] - ice[lindex];
-	}
-	      
-	inflow = (Q12[lindex]+tmp_inflow);
-	Q12[lindex] += tmp_inflow;
-	      
-	last_index++;
-	      
+	    else {
+	      tmplayer = lindex;
+	      while(tmp_inflow > 0) {
+	        tmplayer--;
+	        if ( tmplayer < 0 ) {
+		  /** If top layer saturated, add to runoff **/
+		  runoff[frost_area][lane] += tmp_inflow;
+		  tmp_inflow = 0;
+	        }
+	        else {
+		  /** else add excess soil moisture to next higher layer **/
+		  liq[tmplayer][lane] += tmp_inflow;
+		  if((liq[tmplayer][lane]+ice[tmplayer][lane]) > max_moist[tmplayer]) {
+		    tmp_inflow = ((liq[tmplayer][lane] + ice[tmplayer][lane]) - max_moist[tmplayer]);
+		    liq[tmplayer][lane] = max_moist[tmplayer] - ice[tmplayer][lane];
+		  }
+	          else tmp_inflow=0;
+	        }
+	      }
+	    } /** end trapped excess moisture **/
+	  } /** end check if excess moisture in top layer **/
+
+	  /** verify that current layer moisture is greater than minimum **/
+	  if (liq[lindex][lane] < 0) {
+	    /** liquid cannot fall below 0 **/
+	    Q12[lindex][lane] += liq[lindex][lane];
+	    liq[lindex][lane] = 0;
+	  }
+	  if ((liq[lindex][lane]+ice[lindex][lane]) < resid_moist[lindex]) {
+	    /** moisture cannot fall below minimum **/
+	    Q12[lindex][lane] += (liq[lindex][lane]+ice[lindex][lane]) - resid_moist[lindex];
+	    liq[lindex][lane] = resid_moist[lindex] - ice[lindex][lane];
+	  }
+
+	  inflow[lane] = (Q12[lindex][lane]+tmp_inflow);
+	  Q12[lindex][lane] += tmp_inflow;
+        }
       } /* end loop through soil layers */
-	    
+
       /**************************************************
         Compute Baseflow
       **************************************************/
-	    
+
       /** ARNO model for the bottom soil layer (based on bottom
           soil layer moisture from previous time step) **/
-	    
+
       lindex = options.Nlayer-1;
-      Dsmax = soil_con->Dsmax / 24.;
 
-      /** Compute relative moisture **/
-      rel_moist = (liq[lindex]-resid_moist[lindex]) / (soil_con->max_moist[lindex]-resid_moist[lindex]);
+      for ( lane = 0; lane < Nlanes; lane++ ) {
 
-      /** Compute baseflow as function of relative moisture **/
-      frac = Dsmax * soil_con->Ds / soil_con->Ws;
-      dt_baseflow = frac * rel_moist;
-      if (rel_moist > soil_con->Ws) {
-        frac = (rel_moist - soil_con->Ws) / (1 - soil_con->Ws);
-        dt_baseflow += Dsmax * (1 - soil_con->Ds / soil_con->Ws) * pow(frac,soil_con->c);
-      }
-	    
-      /** Make sure baseflow isn't negative **/
-      if(dt_baseflow < 0) dt_baseflow = 0;
-	    
-      /** Extract baseflow from the bottom soil layer **/ 
-	    
-      liq[lindex] += Q12[lindex-1] - (evap[lindex][frost_area] + dt_baseflow);
-	    
-      /** Check Lower Sub-Layer Moistures **/
-      tmp_moist = 0;
-
-      /* If soil moisture has gone below minimum, take water out
-       * of baseflow and add back to soil to make up the difference
-       * Note: this may lead to negative baseflow, in which case we will
-       * reduce evap to make up for it */
-      if((liq[lindex]+ice[lindex]) < resid_moist[lindex]) {
-        dt_baseflow += (liq[lindex]+ice[lindex]) - resid_moist[lindex];
-        liq[lindex] = resid_moist[lindex] - ice[lindex];
-      }
+        /** Compute relative moisture **/
+        rel_moist = (liq[lindex][lane]-resid_moist[lindex]) / (max_moist[lindex]-resid_moist[lindex]);
 
-      if((liq[lindex]+ice[lindex]) > max_moist[lindex]) {
-        /* soil moisture above maximum */
-        tmp_moist = ((liq[lindex]+ice[lindex]) - max_moist[lindex]);
-        liq[lindex] = max_moist[lindex] - ice[lindex];
-        tmplayer = lindex;
-        while(tmp_moist > 0) {
-          tmplayer--;
-          if(tmplayer<0) {
-            /** If top layer saturated, add to runoff **/
-            runoff[frost_area] += tmp_moist;
-            tmp_moist = 0;
-          }
-          else {
-            /** else if sublayer exists, add excess soil moisture **/
-            liq[tmplayer] += tmp_moist ;
-            if ( ( liq[tmplayer] + ice[tmplayer]) > max_moist[tmplayer] ) {
-	      tmp_moist = ((liq[tmplayer] + ice[tmplayer]) - max_moist[tmplayer]);
-	      liq[tmplayer] = max_moist[tmplayer] - ice[tmplayer];
+        /** Compute baseflow as function of relative moisture **/
+        frac = Dsmax * soil_con->Ds / soil_con->Ws;
+        dt_baseflow = frac * rel_moist;
+        if (rel_moist > soil_con->Ws) {
+          frac = (rel_moist - soil_con->Ws) / (1 - soil_con->Ws);
+          dt_baseflow += Dsmax * (1 - soil_con->Ds / soil_con->Ws) * pow(frac,soil_con->c);
+        }
+
+        /** Make sure baseflow isn't negative **/
+        if(dt_baseflow < 0) dt_baseflow = 0;
+
+        /** Extract baseflow from the bottom soil layer **/ 
+
+        liq[lindex][lane] += Q12[lindex-1][lane] - (evap[lindex][frost_area][lane] + dt_baseflow);
+
+        /** Check Lower Sub-Layer Moistures **/
+        tmp_moist = 0;
+
+        /* If soil moisture has gone below minimum, take water out
+         * of baseflow and add back to soil to make up the difference
+         * Note: this may lead to negative baseflow, in which case we will
+         * reduce evap to make up for it */
+        if((liq[lindex][lane]+ice[lindex][lane]) < resid_moist[lindex]) {
+          dt_baseflow += (liq[lindex][lane]+ice[lindex][lane]) - resid_moist[lindex];
+          liq[lindex][lane] = resid_moist[lindex] - ice[lindex][lane];
+        }
+
+        if((liq[lindex][lane]+ice[lindex][lane]) > max_moist[lindex]) {
+          /* soil moisture above maximum */
+          tmp_moist = ((liq[lindex][lane]+ice[lindex][lane]) - max_moist[lindex]);
+          liq[lindex][lane] = max_moist[lindex] - ice[lindex][lane];
+          tmplayer = lindex;
+          while(tmp_moist > 0) {
+            tmplayer--;
+            if(tmplayer<0) {
+              /** If top layer saturated, add to runoff **/
+              runoff[frost_area][lane] += tmp_moist;
+              tmp_moist = 0;
+            }
+            else {
+              /** else if sublayer exists, add excess soil moisture **/
+              liq[tmplayer][lane] += tmp_moist ;
+              if ( ( liq[tmplayer][lane] + ice[tmplayer][lane]) > max_moist[tmplayer] ) {
+	        tmp_moist = ((liq[tmplayer][lane] + ice[tmplayer][lane]) - max_moist[tmplayer]);
+	        liq[tmplayer][lane] = max_moist[tmplayer] - ice[tmplayer][lane];
+              }
+              else tmp_moist=0;
             }
-            else tmp_moist=0;
           }
         }
+
+        baseflow[frost_area][lane] += dt_baseflow;
       }
-	    
-      baseflow[frost_area] += dt_baseflow;
-	    
+
     } /* end of hourly time step loop */
 
-    /** If negative baseflow, reduce evap accordingly **/
-    if ( baseflow[frost_area] < 0 ) {
-      layer[lindex].evap   += baseflow[frost_area];
-      baseflow[frost_area]  = 0;
-    }
+    lindex = options.Nlayer-1;
+    for ( lane = 0; lane < Nlanes; lane++ ) {
+      c = &cell[lane_band[lane]];
+      layer = c->layer;
 
-    /** Recompute Asat based on final moisture level of upper layers **/
-    for(lindex=0;lindex<options.Nlayer;lindex++) {
-      tmp_moist_for_runoff[lindex] = (liq[lindex] + ice[lindex]);
-    }
-    compute_runoff_and_asat(soil_con, tmp_moist_for_runoff, 0, &A, &tmp_runoff);
+      /** If negative baseflow, reduce evap accordingly **/
+      if ( baseflow[frost_area][lane] < 0 ) {
+        layer[lindex].evap         += baseflow[frost_area][lane];
+        baseflow[frost_area][lane]  = 0;
+      }
 
-    /** Store tile-wide values **/
-    for ( lindex = 0; lindex < options.Nlayer; lindex++ ) 
-      layer[lindex].moist += ((liq[lindex] + ice[lindex]) * frost_fract[frost_area]); 
-    cell->asat     += A * frost_fract[frost_area];
-    cell->runoff   += runoff[frost_area] * frost_fract[frost_area];
-    cell->baseflow += baseflow[frost_area] * frost_fract[frost_area];
+      /** Recompute Asat based on final moisture level of upper layers **/
+      for(i=0;i<options.Nlayer;i++) {
+        tmp_moist_for_runoff[i] = (liq[i][lane] + ice[i][lane]);
+      }
+      compute_runoff_and_asat(soil_con, tmp_moist_for_runoff, 0, &A, &tmp_runoff);
+
+      /** Store tile-wide values **/
+      for ( i = 0; i < options.Nlayer; i++ ) 
+        layer[i].moist += ((liq[i][lane] + ice[i][lane]) * frost_fract[frost_area]); 
+      c->asat     += A * frost_fract[frost_area];
+      c->runoff   += runoff[frost_area][lane] * frost_fract[frost_area];
+      c->baseflow += baseflow[frost_area][lane] * frost_fract[frost_area];
+    }
 
   }
 
-  /** Compute water table depth **/
-  wrap_compute_zwt(soil_con, cell);
+  for ( lane = 0; lane < Nlanes; lane++ ) {
+    c = &cell[lane_band[lane]];
+
+    /** Compute water table depth **/
+    wrap_compute_zwt(soil_con, c);
+
+    /** Recompute Thermal Parameters Based on New Moisture Distribution **/
+    if(options.FULL_ENERGY || options.FROZEN_SOIL) {
+
+      for(lindex=0;lindex<options.Nlayer;lindex++) {
+        moist[lindex] = c->layer[lindex].moist;
+      }
 
-  /** Recompute Thermal Parameters Based on New Moisture Distribution **/
-  if(options.FULL_ENERGY || options.FROZEN_SOIL) {
-    
-    for(lindex=0;lindex<options.Nlayer;lindex++) {
-      tmp_layer = cell->layer[lindex];
-      moist[lindex] = tmp_layer.moist;
+      ErrorFlag = distribute_node_moisture_properties(energy[lane_band[lane]].moist,
+						      energy[lane_band[lane]].ice,
+						      energy[lane_band[lane]].kappa_node,
+						      energy[lane_band[lane]].Cs_node,
+						      &soil_con->node_layer,
+						      energy[lane_band[lane]].T,
+						      soil_con->max_moist_node,
+						      soil_con->expt_node,
+						      soil_con->bubble_node, 
+						      moist, soil_con->depth, 
+						      soil_con->soil_dens_min,
+						      soil_con->bulk_dens_min,
+						      soil_con->quartz, 
+						      soil_con->soil_density,
+						      soil_con->bulk_density,
+						      soil_con->organic, Nnodes, 
+						      options.Nlayer, soil_con->FS_ACTIVE);
+      if ( ErrorFlag == ERROR ) return (ERROR);
     }
-    
-    ErrorFlag = distribute_node_moisture_properties(energy->moist, energy->ice,
-						    energy->kappa_node, energy->Cs_node,
-						    soil_con->Zsum_node, energy->T,
-						    soil_con->max_moist_node,
-						    soil_con->expt_node,
-						    soil_con->bubble_node, 
-						    moist, soil_con->depth, 
-						    soil_con->soil_dens_min,
-						    soil_con->bulk_dens_min,
-						    soil_con->quartz, 
-						    soil_con->soil_density,
-						    soil_con->bulk_density,
-						    soil_con->organic, Nnodes, 
-						    options.Nlayer, soil_con->FS_ACTIVE);
-    if ( ErrorFlag == ERROR ) return (ERROR);
   }
   return (0);
 
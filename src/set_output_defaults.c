@@ -30,6 +30,7 @@ out_data_file_struct *set_output_defaults(out_data_struct *out_data) {
 	      to set of output variables.  Added volumetric versions
 	      of these too.						TJB
   2013-Dec-27 Moved OUTPUT_FORCE to options_struct.			TJB
+  2026-Oct-17 Memory is accounted for by mem_calloc()/mem_free().	KM
 *************************************************************/
 
   extern option_struct options;
@@ -42,10 +43,10 @@ if(options.OUTPUT_FORCE) {
 
   // Output files
   options.Noutfiles = 1;
-  out_data_files = (out_data_file_struct *)calloc(options.Noutfiles,sizeof(out_data_file_struct));
+  out_data_files = (out_data_file_struct *)mem_calloc(options.Noutfiles,sizeof(out_data_file_struct), MEM_OUTPUT);
   strcpy(out_data_files[0].prefix,"full_data");
   out_data_files[0].nvars = 8;
-  out_data_files[0].varid = (int *)calloc(out_data_files[0].nvars, sizeof(int));
+  out_data_files[0].varid = (int *)mem_calloc(out_data_files[0].nvars, sizeof(int), MEM_OUTPUT);
 
   // Variables in first file
   filenum = 0;
@@ -73,7 +74,7 @@ else {
   if (options.LAKES) {
     options.Noutfiles++;
   }
-  out_data_files = (out_data_file_struct *)calloc(options.Noutfiles,sizeof(out_data_file_struct));
+  out_data_files = (out_data_file_struct *)mem_calloc(options.Noutfiles,sizeof(out_data_file_struct), MEM_OUTPUT);
   filenum = 0;
   strcpy(out_data_files[filenum].prefix,"fluxes");
   if (options.FULL_ENERGY || options.FROZEN_SOIL) {
@@ -114,7 +115,7 @@ else {
     out_data_files[filenum].nvars = 8;
   }
   for (filenum=0; filenum<options.Noutfiles; filenum++) {
-    out_data_files[filenum].varid = (int *)calloc(out_data_files[filenum].nvars, sizeof(int));
+    out_data_files[filenum].varid = (int *)mem_calloc(out_data_files[filenum].nvars, sizeof(int), MEM_OUTPUT);
   }
 
   // Variables in first file
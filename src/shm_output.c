@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <vicNl.h>
+#include <shm_output.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  shm_output.c		Keith Mathews			October 2026
+
+  Shared-memory output channel, for models that run on the same node
+  and take VIC's output as their input (e.g. routing or reservoir
+  models).  If SHM_NAME is given, the aggregated values of the SHMVAR
+  variables of each cell at each output interval (after SKIPYEAR) are
+  published as one record in a ring of SHM_SLOTS records in the POSIX
+  shared-memory object SHM_NAME, instead of being read back from the
+  output files.  If no SHMVAR was given, a default set of water balance
+  variables is published.  The layout of the object and the sequence
+  counters with which readers detect complete and overwritten records
+  are described in shm_output.h; vicShmRead (shm_reader.c) is a
+  reference reader.
+
+  The object is created (replacing any object of the same name) by
+  shm_output_init(), and is left in place at the end of the run, so
+  that readers can finish reading it; readers may remove it with
+  shm_unlink().  VIC never waits for readers: a reader that falls
+  more than SHM_SLOTS records behind loses the records that have been
+  overwritten, and can tell which ones from the sequence numbers.
+
+  Modifications:
+**********************************************************************/
+
+static vic_shm_header_struct *shm_header = NULL;
+static unsigned char         *shm_slots = NULL;
+static size_t                 shm_size = 0;
+static uint64_t               shm_seq = 0;
+static int                    shm_vars[N_OUTVAR_TYPES]; /* SHMVARs, in order given */
+static int                    nshm_vars = 0;
+static char                  *shm_default_vars[] = { "OUT_PREC", "OUT_EVAP",
+                                                     "OUT_RUNOFF", "OUT_BASEFLOW",
+                                                     "OUT_SWE", "OUT_SOIL_MOIST" };
+
+int shm_output_add_var(out_data_struct *out_data,
+                       char            *varname)
+/**********************************************************************
+  shm_output_add_var	Keith Mathews			October 2026
+
+  Adds output variable varname (a SHMVAR of the global parameter file)
+  to the list of variables published in the shared-memory channel.
+  Returns -1 if the name is unknown.
+
+  Modifications:
+**********************************************************************/
+{
+  int varid;
+  int i;
+
+  for (varid = 0; varid < N_OUTVAR_TYPES; varid++) {
+    if (strcmp(out_data[varid].varname, varname) == 0) {
+      for (i = 0; i < nshm_vars; i++)
+        if (shm_vars[i] == varid)
+          return 0;
+      shm_vars[nshm_vars++] = varid;
+      return 0;
+    }
+  }
+  fprintf(stderr, "Error: shm_output_add_var: \"%s\" was not found in the list of supported output variable names.  Please use the exact name listed in vicNl_def.h.\n", varname);
+  return -1;
+}
+
+void shm_output_init(filenames_struct    *names,
+                     global_param_struct *global,
+                     out_data_struct     *out_data)
+/**********************************************************************
+  shm_output_init	Keith Mathews			October 2026
+
+  Creates the shared-memory object SHM_NAME, sized for SHM_SLOTS
+  records of the SHMVAR variables, and writes its header and variable
+  table.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  vic_shm_var_struct  *vars;
+  char                 ErrStr[2*MAXSTRING];
+  size_t               header_size, slot_size;
+  uint32_t             nvalues;
+  int                  fd, v, i;
+
+  if (strcmp(names->shm_name, "NONE") == 0)
+    return;
+
+  if (nshm_vars == 0)
+    for (i = 0; i < sizeof(shm_default_vars)/sizeof(shm_default_vars[0]); i++)
+      shm_output_add_var(out_data, shm_default_vars[i]);
+  nvalues = 0;
+  for (v = 0; v < nshm_vars; v++)
+    nvalues += out_data[shm_vars[v]].nelem;
+
+  /* slots start, and are sized, on 64-byte (cache line) boundaries */
+  header_size = sizeof(vic_shm_header_struct) + nshm_vars * sizeof(vic_shm_var_struct);
+  header_size = (header_size + 63) / 64 * 64;
+  slot_size = sizeof(vic_shm_slot_struct) + nvalues * sizeof(double);
+  slot_size = (slot_size + 63) / 64 * 64;
+  shm_size = header_size + (size_t)options.SHM_SLOTS * slot_size;
+
+  shm_unlink(names->shm_name);
+  fd = shm_open(names->shm_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0 || ftruncate(fd, (off_t)shm_size) != 0) {
+    snprintf(ErrStr, sizeof(ErrStr), "Unable to create the shared-memory object %s (%lu bytes).", names->shm_name, (unsigned long)shm_size);
+    nrerror(ErrStr);
+  }
+  shm_header = (vic_shm_header_struct *)mmap(NULL, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (shm_header == (vic_shm_header_struct *)MAP_FAILED) {
+    snprintf(ErrStr, sizeof(ErrStr), "Unable to map the shared-memory object %s.", names->shm_name);
+    nrerror(ErrStr);
+  }
+  shm_slots = (unsigned char *)shm_header + header_size;
+
+  /* the object is zero-filled by ftruncate(), so every slot's seq is 0 */
+  shm_header->version = VIC_SHM_VERSION;
+  shm_header->header_size = (uint32_t)header_size;
+  shm_header->nvars = (uint32_t)nshm_vars;
+  shm_header->nvalues = nvalues;
+  shm_header->nslots = (uint32_t)options.SHM_SLOTS;
+  shm_header->slot_size = (uint32_t)slot_size;
+  shm_header->out_dt = global->out_dt;
+  shm_header->pid = (int32_t)getpid();
+  vars = (vic_shm_var_struct *)(shm_header + 1);
+  nvalues = 0;
+  for (v = 0; v < nshm_vars; v++) {
+    strncpy(vars[v].name, out_data[shm_vars[v]].varname, VIC_SHM_VARNAME - 1);
+    vars[v].nelem = (uint32_t)out_data[shm_vars[v]].nelem;
+    vars[v].offset = nvalues;
+    nvalues += vars[v].nelem;
+  }
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  memcpy(shm_header->magic, VIC_SHM_MAGIC, sizeof(shm_header->magic));
+  shm_seq = 0;
+}
+
+void shm_output_accumulate(out_data_struct *out_data,
+                           dmy_struct      *dmy,
+                           soil_con_struct *soil_con)
+/**********************************************************************
+  shm_output_accumulate	Keith Mathews			October 2026
+
+  Publishes the aggregated output values of the current cell for the
+  current output interval as the next record of the channel.  Called
+  from put_data() at each output interval, before the values are
+  scaled for binary output.
+
+  Modifications:
+**********************************************************************/
+{
+  vic_shm_slot_struct *slot;
+  double              *values;
+  int                  v, i, k;
+
+  if (shm_header == NULL)
+    return;
+
+  slot = (vic_shm_slot_struct *)(shm_slots + (shm_seq % shm_header->nslots) * shm_header->slot_size);
+  values = (double *)(slot + 1);
+
+  __atomic_store_n(&slot->seq, 2 * shm_seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  slot->cell = soil_con->gridcel;
+  slot->year = dmy->year;
+  slot->month = dmy->month;
+  slot->day = dmy->day;
+  slot->hour = dmy->hour;
+  k = 0;
+  for (v = 0; v < nshm_vars; v++)
+    for (i = 0; i < out_data[shm_vars[v]].nelem; i++)
+      values[k++] = out_data[shm_vars[v]].aggdata[i];
+  __atomic_store_n(&slot->seq, 2 * shm_seq + 2, __ATOMIC_RELEASE);
+
+  shm_seq++;
+  __atomic_store_n(&shm_header->write_seq, shm_seq, __ATOMIC_RELEASE);
+}
+
+void shm_output_close()
+/**********************************************************************
+  shm_output_close	Keith Mathews			October 2026
+
+  Marks the end of the run in the channel, and unmaps it.  The object
+  itself is left for the readers.
+
+  Modifications:
+**********************************************************************/
+{
+  if (shm_header == NULL)
+    return;
+
+  __atomic_store_n(&shm_header->done, 1, __ATOMIC_RELEASE);
+  fprintf(stderr, "Shared-memory output: %lu records published.\n",
+          (unsigned long)shm_seq);
+  munmap((void *)shm_header, shm_size);
+  shm_header = NULL;
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+// $Id$
+  shm_output.h		Keith Mathews			October 2026
+
+  Layout of the shared-memory output channel (SHM_NAME option, see
+  shm_output.c).  This header does not depend on the other VIC headers,
+  so that it can be included by the programs that read the channel.
+
+  The POSIX shared-memory object SHM_NAME holds, in the byte order of
+  the host:
+
+    vic_shm_header_struct             at offset 0
+    vic_shm_var_struct[nvars]         at offset sizeof(vic_shm_header_struct)
+    slot[nslots]                      at offset header_size, each
+                                      slot_size bytes:
+      vic_shm_slot_struct             record header
+      double values[nvalues]          the elements of the variables, in
+                                      the order of the variable table
+
+  Each output record (one cell, one output interval) gets a sequence
+  number n = 0, 1, 2, ..., and is written to slot n % nslots.  The
+  writer sets the slot's seq to 2n+1, writes the record, sets seq to
+  2n+2, and then sets write_seq in the header to n+1; so write_seq is
+  the number of records published.  A reader that wants record n
+  (n < write_seq) reads seq (with acquire ordering), the record, and
+  seq again: the record is valid only if both reads of seq are 2n+2.
+  If seq is greater than 2n+2, the record has been overwritten by a
+  later one because the reader fell more than nslots records behind.
+  The writer never waits for readers.  done is set to 1 after the
+  last record of the run has been published.
+
+  magic is written last when the channel is set up, so a reader must
+  check it (and version) before using the other fields.
+
+  Modifications:
+******************************************************************************/
+
+#ifndef SHM_OUTPUT_H
+#define SHM_OUTPUT_H
+
+#include <stdint.h>
+
+#define VIC_SHM_MAGIC   "VICSHM1"   /* 7 characters and a NUL */
+#define VIC_SHM_VERSION 1
+#define VIC_SHM_VARNAME 24          /* length of a variable name, with NUL */
+
+typedef struct {
+  char     magic[8];     /* VIC_SHM_MAGIC */
+  uint32_t version;      /* VIC_SHM_VERSION */
+  uint32_t header_size;  /* offset of the first slot [bytes] */
+  uint32_t nvars;        /* number of variables */
+  uint32_t nvalues;      /* number of values (elements) per record */
+  uint32_t nslots;       /* number of slots in the ring */
+  uint32_t slot_size;    /* size of one slot [bytes] */
+  int32_t  out_dt;       /* output interval [hours] */
+  int32_t  pid;          /* process id of the writer */
+  uint64_t write_seq;    /* number of records published */
+  uint32_t done;         /* 1 when the run has ended */
+  uint32_t pad;
+} vic_shm_header_struct;
+
+typedef struct {
+  char     name[VIC_SHM_VARNAME]; /* output variable name, e.g. OUT_RUNOFF */
+  uint32_t nelem;        /* number of elements */
+  uint32_t offset;       /* index of its first element in values */
+} vic_shm_var_struct;
+
+typedef struct {
+  uint64_t seq;          /* 2n+1 while record n is written, 2n+2 after */
+  int32_t  cell;         /* cell id (gridcel of the soil parameter file) */
+  int32_t  year;         /* start of the output interval */
+  int32_t  month;
+  int32_t  day;
+  int32_t  hour;
+  int32_t  pad;
+} vic_shm_slot_struct;
+
+#endif
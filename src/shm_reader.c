@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <shm_output.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  shm_reader.c		Keith Mathews			October 2026
+
+  Reference reader of the shared-memory output channel written by
+  vicNl with the SHM_NAME option (see shm_output.c, and shm_output.h
+  for the layout).  It waits for the channel to be set up, follows the
+  records as they are published, and writes each record to stdout as a
+  line of
+
+    cell year month day hour value value ...
+
+  with the values in the order of the variable table, which is written
+  first as a comment line.  It stops when vicNl has ended the run and
+  all records have been read, and reports to stderr the number of
+  records read, the number lost because they were overwritten before
+  they could be read (the reader fell more than SHM_SLOTS records
+  behind), and the number of sequence errors (records published out of
+  order, which indicates a corrupt channel).
+
+  The object must not be left over from an earlier run when the reader
+  is started, or the reader will read that run's records; vicNl
+  replaces any object of the same name when it starts, and -u removes
+  it when the reader is done.
+
+  Usage:
+    vicShmRead -n <name> [-w <wait>] [-q] [-u]
+
+    -n  name of the shared-memory object (SHM_NAME, e.g. /vic_out)
+    -w  number of seconds to wait for the channel (default 60)
+    -q  do not write the records, only count them
+    -u  remove the object when done
+
+  The exit status is 0 if all records were read, and 1 otherwise.
+
+  Modifications:
+**********************************************************************/
+
+static void usage_shm(char *program)
+{
+  fprintf(stderr, "Usage: %s -n <name> [-w <wait>] [-q] [-u]\n", program);
+  exit(1);
+}
+
+static void pause_shm()
+/* Waits 100 microseconds for the writer. */
+{
+  struct timespec ts;
+
+  ts.tv_sec = 0;
+  ts.tv_nsec = 100000;
+  nanosleep(&ts, NULL);
+}
+
+static vic_shm_header_struct *open_shm(char *name,
+                                       int   wait,
+                                       size_t *size)
+/* Maps the channel once its header is complete, waiting up to wait s. */
+{
+  vic_shm_header_struct *header;
+  struct stat            st;
+  char                   magic[8];
+  int                    fd;
+  long                   tries;
+
+  for (tries = 0; tries <= 10000L * wait; tries++) {
+    if (tries > 0)
+      pause_shm();
+    if ((fd = shm_open(name, O_RDONLY, 0)) < 0)
+      continue;
+    if (fstat(fd, &st) != 0 || st.st_size < sizeof(vic_shm_header_struct)) {
+      close(fd);
+      continue;
+    }
+    header = (vic_shm_header_struct *)mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (header == (vic_shm_header_struct *)MAP_FAILED)
+      continue;
+    memcpy(magic, (void *)header->magic, sizeof(magic));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (memcmp(magic, VIC_SHM_MAGIC, sizeof(magic)) == 0) {
+      if (header->version != VIC_SHM_VERSION) {
+        fprintf(stderr, "%s has version %u, not %d\n", name, header->version, VIC_SHM_VERSION);
+        exit(1);
+      }
+      *size = st.st_size;
+      return header;
+    }
+    munmap((void *)header, st.st_size);
+  }
+  fprintf(stderr, "%s was not set up within %d s\n", name, wait);
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  extern char *optarg;
+
+  vic_shm_header_struct *header;
+  vic_shm_var_struct    *vars;
+  vic_shm_slot_struct   *slot;
+  vic_shm_slot_struct    rec;
+  double                *values;
+  char                  *name = NULL;
+  int                    wait = 60;
+  int                    quiet = 0;
+  int                    remove = 0;
+  int                    optchar;
+  size_t                 size;
+  uint32_t               v, i;
+  uint64_t               next, write_seq, seq1, seq2;
+  uint64_t               nread = 0, nlost = 0, nerrors = 0;
+
+  while ((optchar = getopt(argc, argv, "n:w:qu")) != EOF) {
+    switch ((char)optchar) {
+    case 'n':
+      name = optarg;
+      break;
+    case 'w':
+      wait = atoi(optarg);
+      break;
+    case 'q':
+      quiet = 1;
+      break;
+    case 'u':
+      remove = 1;
+      break;
+    default:
+      usage_shm(argv[0]);
+    }
+  }
+  if (name == NULL)
+    usage_shm(argv[0]);
+
+  header = open_shm(name, wait, &size);
+  if (size < header->header_size + (size_t)header->nslots * header->slot_size) {
+    fprintf(stderr, "%s is smaller than its header says\n", name);
+    exit(1);
+  }
+  vars = (vic_shm_var_struct *)(header + 1);
+  values = (double *)calloc(header->nvalues > 0 ? header->nvalues : 1, sizeof(double));
+  if (values == NULL) {
+    fprintf(stderr, "Memory allocation failure in %s\n", argv[0]);
+    exit(1);
+  }
+
+  if (!quiet) {
+    printf("# cell year month day hour");
+    for (v = 0; v < header->nvars; v++) {
+      if (vars[v].nelem == 1)
+        printf(" %.*s", VIC_SHM_VARNAME, vars[v].name);
+      else
+        for (i = 0; i < vars[v].nelem; i++)
+          printf(" %.*s_%u", VIC_SHM_VARNAME, vars[v].name, i);
+    }
+    printf("\n");
+  }
+
+  next = 0;
+  while (1) {
+    write_seq = __atomic_load_n(&header->write_seq, __ATOMIC_ACQUIRE);
+    if (next == write_seq) {
+      if (__atomic_load_n(&header->done, __ATOMIC_ACQUIRE)
+          && __atomic_load_n(&header->write_seq, __ATOMIC_ACQUIRE) == next)
+        break;
+      pause_shm();
+      continue;
+    }
+
+    /* records older than the ring have been overwritten */
+    if (write_seq - next > header->nslots) {
+      nlost += write_seq - header->nslots - next;
+      next = write_seq - header->nslots;
+    }
+
+    slot = (vic_shm_slot_struct *)((char *)header + header->header_size
+                                   + (next % header->nslots) * header->slot_size);
+    seq1 = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+    memcpy(&rec, slot, sizeof(rec));
+    memcpy(values, slot + 1, header->nvalues * sizeof(double));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    seq2 = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+
+    if (seq1 == 2 * next + 2 && seq2 == seq1) {
+      nread++;
+      if (!quiet) {
+        printf("%d %04d %02d %02d %02d", rec.cell, rec.year, rec.month,
+               rec.day, rec.hour);
+        for (i = 0; i < header->nvalues; i++)
+          printf(" %.10g", values[i]);
+        printf("\n");
+      }
+    }
+    else if (seq1 > 2 * next + 2 || seq2 > 2 * next + 2)
+      nlost++;
+    else
+      nerrors++;
+    next++;
+  }
+
+  fprintf(stderr, "%s: %llu records read, %llu lost, %llu sequence errors\n",
+          name, (unsigned long long)nread, (unsigned long long)nlost,
+          (unsigned long long)nerrors);
+  munmap((void *)header, size);
+  free((char *)values);
+  if (remove)
+    shm_unlink(name);
+
+  return ((nlost > 0 || nerrors > 0) ? 1 : 0);
+}
@@ -22,6 +22,7 @@
 	      removed NEW_SNOW_DENSITY.					KMA via TJB
   2008-Apr-21 Re-inserted NEW_SNOW_DENSITY, for backwards compatibility
 	      with previous snow density algorithm.			TJB
+  2026-Oct-17 Added SNOW_STEP_ADAPT thresholds.				KM
  */
 
 
@@ -86,4 +87,17 @@
        snowpack albedo to new snow *****/
 #define TraceSnow 0.03
 
+/***** Thresholds of SNOW_STEP_ADAPT, which merges snow model sub-steps
+       while the snowpack is cold and dry *****/
+#define SNOW_ADAPT_TEMP		-2.0	/* max. air and snow temperature of
+					   merged sub-steps (C) */
+#define SNOW_ADAPT_DTAIR	8.0	/* max. range of air temperature
+					   over merged sub-steps (C) */
+#define SNOW_ADAPT_DFLUX	100.0	/* max. range of absorbed radiation
+					   over merged sub-steps (W/m^2) */
+#define SNOW_ADAPT_DTSURF	5.0	/* max. change of snow surface
+					   temperature in a merged step (C) */
+#define SNOW_ADAPT_DSWQ		0.0005	/* max. vapor exchange of the pack
+					   in a merged step (m) */
+
 #endif 
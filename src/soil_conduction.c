@@ -260,13 +260,125 @@ void set_node_parameters(double   *dz_node,
 
 }
 
-#define N_INTS 5
+void set_node_layer_weights(node_layer_struct *node_layer,
+			    double            *Zsum_node,
+			    double            *depth,
+			    double            *frost_fract,
+			    double             frost_slope,
+			    int                Nnodes,
+			    int                Nlayers) {
+/**********************************************************************
+  set_node_layer_weights	Keith Mathews		October 2026
+
+  Computes the mapping between the soil thermal nodes and the soil
+  moisture layers, which depends only on the node depths and layer
+  thicknesses of the grid cell, so that distribute_node_moisture_properties()
+  and estimate_layer_ice_content() do not have to search for it at
+  every call:
+  - the layer in which each node falls, as found by set_node_parameters(),
+    and whether the node lies on a layer boundary or below the bottom layer;
+  - the nodes bracketing each layer, the positions of the top and bottom
+    of the layer between them, and the widths of the intervals between
+    the top, the nodes within, and the bottom of the layer, over which
+    estimate_layer_ice_content() applies the trapezoidal rule;
+  - the position of each frost area within the frost distribution, and
+    the frost slope.
+  Only the searches are saved; the layer averages are computed in the
+  same order as before, so results do not change.  Must be called again
+  whenever the node depths change.
+
+  node_layer_struct *node_layer  node to layer mapping
+  double            *Zsum_node   thermal node depth (m)
+  double            *depth       soil moisture layer thickness (m)
+  double            *frost_fract spatially distributed frost coverage fractions
+  double             frost_slope slope of frost distribution (C)
+  int                Nnodes      number of soil thermal nodes
+  int                Nlayers     number of soil moisture layers
+
+  Modifications:
+**********************************************************************/
+
+  extern option_struct options;
+
+  char   PAST_BOTTOM;
+  int    nidx, lidx, min_nidx, max_nidx, frost_area;
+  double Ltop; /* cumulative depth of moisture layer */
+  double Lsum[MAX_LAYERS+1];
+  double tmpZ[MAX_NODES];
+  double tmp_fract;
+
+  /* layer of each node (as in set_node_parameters()) */
+  PAST_BOTTOM = FALSE;
+  lidx = 0;
+  Ltop = 0.;
+  for(nidx=0;nidx<Nnodes;nidx++) {
+    node_layer->lidx[nidx] = lidx;
+    node_layer->below[nidx] = PAST_BOTTOM;
+    node_layer->boundary[nidx] = (Zsum_node[nidx] == Ltop + depth[lidx]
+				  && nidx != 0 && lidx != Nlayers-1);
+    if(Zsum_node[nidx] > Ltop + depth[lidx] && !PAST_BOTTOM) {
+      Ltop += depth[lidx];
+      lidx++;
+      if( lidx == Nlayers ) {
+	PAST_BOTTOM = TRUE;
+	lidx = Nlayers-1;
+      }
+    }
+  }
+
+  /* cumulative layer depths */
+  Lsum[0] = 0;
+  for ( lidx = 1; lidx <= Nlayers; lidx++ ) Lsum[lidx] = depth[lidx-1] + Lsum[lidx-1];
+
+  for ( lidx = 0; lidx < Nlayers; lidx++ ) {
+
+    for ( nidx = 0; nidx < Nnodes; nidx++ ) node_layer->dz[lidx][nidx] = 0.;
+
+    /* bracket layer between nodes */
+    min_nidx = Nnodes-2;
+    while( Lsum[lidx] < Zsum_node[min_nidx] && min_nidx > 0 ) min_nidx --;
+    max_nidx = 1;
+    while( Lsum[lidx+1] > Zsum_node[max_nidx] && max_nidx < Nnodes ) max_nidx ++;
+    node_layer->min_nidx[lidx] = min_nidx;
+    node_layer->max_nidx[lidx] = max_nidx;
+    node_layer->ftop[lidx] = -1.;
+    node_layer->fbot[lidx] = -1.;
+    if ( max_nidx >= Nnodes ) continue;
+
+    /* position of layer top and bottom between the bracketing nodes */
+    if ( Zsum_node[min_nidx] < Lsum[lidx] )
+      node_layer->ftop[lidx] = (Lsum[lidx] - Zsum_node[min_nidx])
+	/ (Zsum_node[min_nidx+1] - Zsum_node[min_nidx]);
+    if ( Zsum_node[max_nidx] > Lsum[lidx+1] )
+      node_layer->fbot[lidx] = (Lsum[lidx+1] - Zsum_node[max_nidx-1])
+	/ (Zsum_node[max_nidx] - Zsum_node[max_nidx-1]);
+
+    /* widths of the intervals between the layer top, the nodes within
+       it, and the layer bottom */
+    tmpZ[min_nidx] = Lsum[lidx];
+    for ( nidx = min_nidx+1; nidx < max_nidx; nidx++ ) tmpZ[nidx] = Zsum_node[nidx];
+    tmpZ[max_nidx] = Lsum[lidx+1];
+    for ( nidx = min_nidx; nidx < max_nidx; nidx++ )
+      node_layer->dz[lidx][nidx] = tmpZ[nidx+1] - tmpZ[nidx];
+  }
+
+  /* frost area positions */
+  tmp_fract = 0;
+  for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
+    if ( frost_area == 0 ) tmp_fract = frost_fract[0] / 2.;
+    else tmp_fract += (frost_fract[frost_area-1] / 2. 
+		       + frost_fract[frost_area] / 2.);
+    node_layer->frost_pos[frost_area] = tmp_fract;
+  }
+  node_layer->frost_slope = frost_slope;
+
+}
 
 int distribute_node_moisture_properties(double *moist_node,
 					double *ice_node,
 					double *kappa_node,
 					double *Cs_node,
-					double *Zsum_node,
+					node_layer_struct *node_layer,
 					double *T_node,
 					double *max_moist_node,
 					double *expt_node,
@@ -293,7 +405,7 @@ int distribute_node_moisture_properties(double *moist_node,
   double *ice_node        thermal node ice content (mm/mm)
   double *kappa_node      thermal node thermal conductivity (W m-1 K-1)
   double *Cs_node         thermal node heat capacity (J m-3 K-1)
-  double *Zsum_node       thermal node depth (m)
+  node_layer_struct *node_layer  thermal node to soil layer mapping
   double *T_node          thermal node temperature (C)
   double *max_moist_node  thermal node maximum moisture content (mm/mm)
   double *expt_node       thermal node exponential
@@ -344,24 +456,21 @@ int distribute_node_moisture_properties(double *moist_node,
 	      set using SLAB_MOIST_FRACT * max_moist_node.		KAC via TJB
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2013-Dec-27 Removed QUICK_FS option.					TJB
+  2026-Oct-17 Replaced Zsum_node with node_layer; the layer of each
+	      node is now looked up rather than searched for.		KM
 *********************************************************************/
 
   extern option_struct options;
 
-  char PAST_BOTTOM;
   int nidx, lidx;
-  double Lsum; /* cumulative depth of moisture layer */
   double soil_fract;
 
-  lidx = 0;
-  Lsum = 0.;
-  PAST_BOTTOM = FALSE;
-
   /* node estimates */
   for(nidx=0;nidx<Nnodes;nidx++) {
+    lidx = node_layer->lidx[nidx];
  
-    if ( !PAST_BOTTOM || SLAB_MOIST_FRACT < 0 ) {
-      if(Zsum_node[nidx] == Lsum + depth[lidx] && nidx != 0 && lidx != Nlayers-1) {
+    if ( !node_layer->below[nidx] || SLAB_MOIST_FRACT < 0 ) {
+      if(node_layer->boundary[nidx]) {
         /* node on layer boundary */
         moist_node[nidx] = (moist[lidx] / depth[lidx] 
 			    + moist[lidx+1] / depth[lidx+1]) / 1000 / 2.;
@@ -417,24 +526,13 @@ int distribute_node_moisture_properties(double *moist_node,
     /* compute volumetric heat capacity */
     Cs_node[nidx] = volumetric_heat_capacity(bulk_density[lidx]/soil_density[lidx],
 					     moist_node[nidx] - ice_node[nidx], ice_node[nidx], organic[lidx]);
-
-    if(Zsum_node[nidx] > Lsum + depth[lidx] && !PAST_BOTTOM) {
-      Lsum += depth[lidx];
-      lidx++;
-      if( lidx == Nlayers ) {
-	PAST_BOTTOM = TRUE;
-	lidx = Nlayers-1;
-      }
-    }
   }
   return (0);
 
 }
 
-#undef N_INTS
-
 int estimate_layer_ice_content(layer_data_struct *layer,
-			       double            *Zsum_node,
+			       node_layer_struct *node_layer,
 			       double            *T,
 			       double            *max_moist_node,
 			       double            *expt_node,
@@ -443,8 +541,6 @@ int estimate_layer_ice_content(layer_data_struct *layer,
 			       double            *max_moist,
 			       double            *expt,
 			       double            *bubble,
-			       double            *frost_fract,
-			       double             frost_slope,
 			       int                Nnodes, 
 			       int                Nlayers,
 			       char               FS_ACTIVE) {
@@ -454,7 +550,7 @@ int estimate_layer_ice_content(layer_data_struct *layer,
   node temperatures.
 
   layer_struct *layer           structure with all soil moisture layer info
-  double       *Zsum_node       soil thermal node cumulative thicknesses (m)
+  node_layer_struct *node_layer soil thermal node to soil layer mapping
   double       *T               soil thermal node temperatures (C)
   double       *max_moist_node  soil thermal node max moisture content (mm/mm)
   double       *expt_node       soil thermal node exponential ()
@@ -483,99 +579,64 @@ int estimate_layer_ice_content(layer_data_struct *layer,
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
   2013-Dec-27 Removed QUICK_FS option.					TJB
+  2026-Oct-17 Replaced Zsum_node, frost_fract and frost_slope with
+	      node_layer; the nodes bracketing each layer, the
+	      interval widths and the frost area positions are no
+	      longer recomputed at every call.			KM
 **************************************************************/
 
   extern option_struct options;
 
   int    nidx, min_nidx, max_nidx;
   int    lidx, frost_area;
-  double Lsum[MAX_LAYERS+1];
-  double tmp_ice[MAX_NODES][MAX_FROST_AREAS];
-  double tmpT[MAX_NODES][MAX_FROST_AREAS+1];
-  double tmpZ[MAX_NODES];
-  double min_temp, max_temp, tmp_fract;
-
-  // compute cumulative layer depths
-  Lsum[0] = 0;
-  for ( lidx = 1; lidx <= Nlayers; lidx++ ) Lsum[lidx] = depth[lidx-1] + Lsum[lidx-1];
+  double tmpT[MAX_NODES];
+  double tmp_ice[MAX_NODES];
+  double *dz;
+  double min_temp, max_temp, Tfrost;
 
   // estimate soil layer average variables
   for ( lidx = 0; lidx < Nlayers; lidx++ ) {
 
-    // Initialize layer variables
-    layer[lidx].T = 0.;
-    for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
-      layer[lidx].ice[frost_area] = 0.;
-    }
-
-    // Bracket current layer between nodes
-    min_nidx = Nnodes-2;
-    while( Lsum[lidx] < Zsum_node[min_nidx] && min_nidx > 0 ) min_nidx --;
-    max_nidx = 1;
-    while( Lsum[lidx+1] > Zsum_node[max_nidx] && max_nidx < Nnodes ) max_nidx ++;
+    min_nidx = node_layer->min_nidx[lidx];
+    max_nidx = node_layer->max_nidx[lidx];
     if ( max_nidx >= Nnodes ) {
       fprintf( stderr, "ERROR: Soil thermal nodes do not extend below bottom soil layer, currently unable to handle this condition.\n" );
       return(ERROR);
     }
+    dz = node_layer->dz[lidx];
 
-    // Get soil node temperatures for current layer
-    if ( Zsum_node[min_nidx] < Lsum[lidx] )
-      tmpT[min_nidx][options.Nfrost] = linear_interp(Lsum[lidx], Zsum_node[min_nidx], Zsum_node[min_nidx+1], T[min_nidx], T[min_nidx+1]);
-    else tmpT[min_nidx][options.Nfrost] = T[min_nidx];
-    tmpZ[min_nidx] = Lsum[lidx];
-    for ( nidx = min_nidx+1; nidx < max_nidx; nidx++ ) {
-      tmpT[nidx][options.Nfrost] = T[nidx];
-      tmpZ[nidx] = Zsum_node[nidx];
-    }
-    if ( Zsum_node[max_nidx] > Lsum[lidx+1] )
-      tmpT[max_nidx][options.Nfrost] = linear_interp(Lsum[lidx+1], Zsum_node[max_nidx-1], Zsum_node[max_nidx], T[max_nidx-1], T[max_nidx]);
-    else tmpT[max_nidx][options.Nfrost] = T[max_nidx];
-    tmpZ[max_nidx] = Lsum[lidx+1];
+    // Get soil temperatures at the top of the layer, the nodes within it, and its bottom
+    for ( nidx = min_nidx; nidx <= max_nidx; nidx++ ) tmpT[nidx] = T[nidx];
+    if ( node_layer->ftop[lidx] >= 0 )
+      tmpT[min_nidx] = node_layer->ftop[lidx]*(T[min_nidx+1]-T[min_nidx])+T[min_nidx];
+    if ( node_layer->fbot[lidx] >= 0 )
+      tmpT[max_nidx] = node_layer->fbot[lidx]*(T[max_nidx]-T[max_nidx-1])+T[max_nidx-1];
 
-    // distribute temperatures for sub-areas
-    for ( nidx = min_nidx; nidx <= max_nidx; nidx++ ) {
-      min_temp = tmpT[nidx][options.Nfrost] - frost_slope / 2.;
-      max_temp = min_temp + frost_slope;
-      for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
-	if ( options.Nfrost > 1 ) {
-	  if ( frost_area == 0 ) tmp_fract = frost_fract[0] / 2.;
-	  else tmp_fract += (frost_fract[frost_area-1] / 2. 
-			     + frost_fract[frost_area] / 2.);
-	  tmpT[nidx][frost_area] = linear_interp(tmp_fract, 0, 1, min_temp, max_temp);
-	}
-	else tmpT[nidx][frost_area] = tmpT[nidx][options.Nfrost];
-      }
-    }
+    // Compute average soil layer temperature
+    layer[lidx].T = 0.;
+    for ( nidx = min_nidx; nidx < max_nidx; nidx++ )
+      layer[lidx].T += dz[nidx]*(tmpT[nidx+1]+tmpT[nidx])/2.;
+    layer[lidx].T /= depth[lidx];
 
-    // Get soil node ice content for current layer
-    if (options.FROZEN_SOIL && FS_ACTIVE) {
-      for ( nidx = min_nidx; nidx <= max_nidx; nidx++ ) {
-        for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
-	  tmp_ice[nidx][frost_area] = layer[lidx].moist 
-	    - maximum_unfrozen_water(tmpT[nidx][frost_area], max_moist[lidx], bubble[lidx], expt[lidx]);
-	  if ( tmp_ice[nidx][frost_area] < 0 ) tmp_ice[nidx][frost_area] = 0.;
-        }
-      }
-    }
-    else {
+    // Compute average soil layer ice content of each frost area
+    for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
+      layer[lidx].ice[frost_area] = 0.;
+      if (!(options.FROZEN_SOIL && FS_ACTIVE)) continue;
       for ( nidx = min_nidx; nidx <= max_nidx; nidx++ ) {
-        for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
-	  tmp_ice[nidx][frost_area] = 0; 
-        }
-      }
-    }
-
-    // Compute average soil layer values
-    for ( nidx = min_nidx; nidx < max_nidx; nidx++ ) {
-      for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
-	layer[lidx].ice[frost_area] += (tmpZ[nidx+1]-tmpZ[nidx])*(tmp_ice[nidx+1][frost_area]+tmp_ice[nidx][frost_area])/2.;
+	if ( options.Nfrost > 1 ) {
+	  min_temp = tmpT[nidx] - node_layer->frost_slope / 2.;
+	  max_temp = min_temp + node_layer->frost_slope;
+	  Tfrost = linear_interp(node_layer->frost_pos[frost_area], 0, 1, min_temp, max_temp);
+	}
+	else Tfrost = tmpT[nidx];
+	tmp_ice[nidx] = layer[lidx].moist 
+	  - maximum_unfrozen_water(Tfrost, max_moist[lidx], bubble[lidx], expt[lidx]);
+	if ( tmp_ice[nidx] < 0 ) tmp_ice[nidx] = 0.;
       }
-      layer[lidx].T += (tmpZ[nidx+1]-tmpZ[nidx])*(tmpT[nidx+1][options.Nfrost]+tmpT[nidx][options.Nfrost])/2.;
-    }
-    for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ )
+      for ( nidx = min_nidx; nidx < max_nidx; nidx++ )
+	layer[lidx].ice[frost_area] += dz[nidx]*(tmp_ice[nidx+1]+tmp_ice[nidx])/2.;
       layer[lidx].ice[frost_area] /= depth[lidx];
-    layer[lidx].T /= depth[lidx];
-
+    }
 
   }
     
@@ -7,13 +7,12 @@ static char vcid[] = "$Id$";
 double solve_snow(char                 overstory,
 		  double               BareAlbedo,
 		  double               LongUnderOut, // LW from understory
-		  double               MIN_RAIN_TEMP,
-		  double               MAX_SNOW_TEMP,
 		  double               Tcanopy, // canopy air temperature
 		  double               Tgrnd, // soil surface temperature
 		  double               air_temp, // air temperature
 		  double               dp,
-		  double               prec,
+		  double               step_rainfall, // gauge corrected rainfall
+		  double               step_snowfall, // gauge corrected snowfall
 		  double               snow_grnd_flux,
 		  double               wind_h,
 		  double              *AlbedoUnder,
@@ -31,7 +30,6 @@ double solve_snow(char                 overstory,
 		  double              *delta_coverage, // cover fract change
 		  double              *delta_snow_heat, // change in pack heat
 		  double              *displacement,
-		  double              *gauge_correction,
 		  double              *melt_energy,
 		  double              *out_prec,
 		  double              *out_rain,
@@ -136,6 +134,12 @@ double solve_snow(char                 overstory,
   2014-Apr-25 Added partial veg cover fraction, bare soil evap between
 	      the plants, and re-scaling of LAI & plant fluxes from
 	      global to local and back.					TJB
+  2026-Oct-17 Call snow_melt() through the kernel capture wrapper.	KM
+  2026-Oct-17 last_snow now counts SNOW_STEPs, so that the snow age
+	      is correct for steps merged by SNOW_STEP_ADAPT.		KM
+  2026-Oct-17 Rainfall and snowfall are passed in, as partitioned for
+	      all snow bands by band_forcing(), instead of prec,
+	      MIN_RAIN_TEMP, MAX_SNOW_TEMP and gauge_correction.	KM
 *********************************************************************/
 
   extern option_struct   options;
@@ -150,7 +154,6 @@ double solve_snow(char                 overstory,
   double              old_coverage;
   double              old_depth;
   double              old_swq;
-  double              rainonly;
   double              tmp_Wdew[2];
   double              tmp_grnd_flux;
   double              store_snowfall;
@@ -187,12 +190,9 @@ double solve_snow(char                 overstory,
   /* initialize change in snowpack heat storage */
   (*delta_snow_heat) = 0.;
 
-  /** Calculate Fraction of Precipitation that falls as Rain **/
-  rainonly      = calc_rainonly(air_temp, prec, MAX_SNOW_TEMP, 
-				MIN_RAIN_TEMP); 
-  *snowfall = gauge_correction[SNOW] * (prec - rainonly);
-  *rainfall = gauge_correction[RAIN] * rainonly;
-  if ( *snowfall < 1e-5 ) *snowfall = 0.;
+  /** Rainfall and snowfall of the band were computed by band_forcing() **/
+  *snowfall = step_snowfall;
+  *rainfall = step_rainfall;
   (*out_prec) = *snowfall + *rainfall;
   (*out_rain) = *rainfall;
   (*out_snow) = *snowfall;
@@ -350,9 +350,11 @@ double solve_snow(char                 overstory,
       if ( snow->swq > 0 && store_snowfall == 0 ) {
         // age snow albedo if no new snowfall
         // ignore effects of snow dropping from canopy; only consider fresh snow from sky
-        snow->last_snow++;
+        // last_snow counts SNOW_STEPs, also when dt spans several of them
+        snow->last_snow += dt / options.SNOW_STEP;
         snow->albedo = snow_albedo( *snowfall, snow->swq, snow->depth,
-				    snow->albedo, snow->coldcontent, (double)dt, 
+				    snow->albedo, snow->coldcontent,
+				    (double)options.SNOW_STEP,
 				    snow->last_snow, snow->MELTING); 
         (*AlbedoUnder) = (*coverage * snow->albedo + (1. - *coverage) * BareAlbedo);
       }
@@ -365,7 +367,7 @@ double solve_snow(char                 overstory,
       (*NetShortSnow) = (1.0 - *AlbedoUnder) * (*ShortUnderIn);
 
       /** Call snow pack accumulation and ablation algorithm **/
-      ErrorFlag = snow_melt((*Le), (*NetShortSnow), Tcanopy, Tgrnd, 
+      ErrorFlag = capture_snow_melt((*Le), (*NetShortSnow), Tcanopy, Tgrnd, 
 		roughness, aero_resist[*UnderStory], aero_resist_used,
 		air_temp, *coverage, (double)dt * SECPHOUR, density, 
 		displacement[*UnderStory], snow_grnd_flux, 
@@ -7,6 +7,146 @@ static char vcid[] = "$Id$";
 
 #define GRND_TOL 0.001
 #define OVER_TOL 0.001
+#define N_MERGED_FORCING 15
+
+static int snow_step_merge_length(atmos_data_struct   *atmos,
+				  band_forcing_struct *bf,
+				  int                  band,
+				  snow_data_struct    *snow,
+				  double               MIN_RAIN_TEMP,
+				  int                  hidx,
+				  int                  endhidx)
+/**********************************************************************
+  snow_step_merge_length	Keith Mathews		October 2026
+
+  Returns the number of SNOW_STEP sub-steps, starting with hidx, that
+  SNOW_STEP_ADAPT solves as one step.  This is 1 unless the snowpack is
+  cold (surface, and pack layer if any, at or below SNOW_ADAPT_TEMP)
+  and dry (no liquid water).  Then sub-steps are merged for as long as
+  each is cold and free of rain (air temperature at or below
+  SNOW_ADAPT_TEMP, and below MIN_RAIN_TEMP if it precipitates), and
+  the forcing stays steady: the air temperature within a range of
+  SNOW_ADAPT_DTAIR, and the radiation absorbed by the snow surface
+  within a range of SNOW_ADAPT_DFLUX.
+
+  Modifications:
+**********************************************************************/
+{
+  int    i, nsteps;
+  double Tair, flux;
+  double Tmin, Tmax, Fmin, Fmax;
+
+  if ( snow->swq <= MIN_SWQ_EB_THRES || snow->surf_temp > SNOW_ADAPT_TEMP
+       || ( snow->swq > MAX_SURFACE_SWE && snow->pack_temp > SNOW_ADAPT_TEMP )
+       || snow->surf_water > 0 || snow->pack_water > 0 )
+    return (1);
+
+  nsteps = 0;
+  Tmin = Tmax = Fmin = Fmax = 0;
+  for ( i = hidx; i < endhidx; i++ ) {
+    Tair = bf->Tair[i][band];
+    flux = (1. - snow->albedo) * atmos->shortwave[i] + atmos->longwave[i];
+    if ( Tair > SNOW_ADAPT_TEMP || ( Tair >= MIN_RAIN_TEMP && atmos->prec[i] > 0 ) )
+      break;
+    if ( i == hidx ) {
+      Tmin = Tmax = Tair;
+      Fmin = Fmax = flux;
+    }
+    else {
+      if ( Tair < Tmin ) Tmin = Tair;
+      if ( Tair > Tmax ) Tmax = Tair;
+      if ( flux < Fmin ) Fmin = flux;
+      if ( flux > Fmax ) Fmax = flux;
+      if ( Tmax - Tmin > SNOW_ADAPT_DTAIR || Fmax - Fmin > SNOW_ADAPT_DFLUX )
+	break;
+    }
+    nsteps++;
+  }
+
+  return ( nsteps > 1 ? nsteps : 1 );
+}
+
+static void merge_snow_step_forcing(atmos_data_struct *atmos,
+				    int                hidx,
+				    int                nsteps,
+				    atmos_data_struct *merged,
+				    double            *data,
+				    char              *snowflag)
+/**********************************************************************
+  merge_snow_step_forcing	Keith Mathews		October 2026
+
+  Sets merged to the forcing of the nsteps sub-steps starting with
+  hidx, as one step at index 0: the sum of the precipitation and
+  channel inflow, and the mean of all other variables.  The values are
+  stored in data (N_MERGED_FORCING elements) and snowflag.
+
+  Modifications:
+**********************************************************************/
+{
+  double **var[N_MERGED_FORCING];
+  double   sum;
+  int      i, v;
+
+  (*merged) = (*atmos);
+  /* summed variables first, then averaged ones */
+  var[0]  = &merged->prec;
+  var[1]  = &merged->channel_in;
+  var[2]  = &merged->air_temp;
+  var[3]  = &merged->Catm;
+  var[4]  = &merged->coszen;
+  var[5]  = &merged->density;
+  var[6]  = &merged->fdir;
+  var[7]  = &merged->longwave;
+  var[8]  = &merged->par;
+  var[9]  = &merged->pressure;
+  var[10] = &merged->shortwave;
+  var[11] = &merged->tskc;
+  var[12] = &merged->vp;
+  var[13] = &merged->vpd;
+  var[14] = &merged->wind;
+  for ( v = 0; v < N_MERGED_FORCING; v++ ) {
+    sum = 0;
+    for ( i = hidx; i < hidx + nsteps; i++ )
+      sum += (*var[v])[i];
+    data[v] = ( v < 2 ) ? sum : sum / (double)nsteps;
+    *var[v] = &data[v];
+  }
+
+  (*snowflag) = FALSE;
+  for ( i = hidx; i < hidx + nsteps; i++ )
+    if ( atmos->snowflag[i] ) (*snowflag) = TRUE;
+  merged->snowflag = snowflag;
+}
+
+static int snow_step_merge_ok(snow_data_struct *old_snow,
+			      snow_data_struct *new_snow,
+			      double            melt,
+			      int               INCLUDE_SNOW)
+/**********************************************************************
+  snow_step_merge_ok	Keith Mathews		October 2026
+
+  Error control of SNOW_STEP_ADAPT.  Returns TRUE if the solution of a
+  merged step is accepted: the snowpack did not melt, stayed dry and
+  cold (surface at or below SNOW_ADAPT_TEMP), and was solved with its
+  own energy balance rather than as a thin pack.  In addition its
+  surface temperature must not have changed by more than
+  SNOW_ADAPT_DTSURF, which bounds the error of the outgoing longwave
+  and turbulent fluxes evaluated at the end of the longer step, and
+  its exchange of mass with the atmosphere (sublimation and blowing
+  snow) must not exceed SNOW_ADAPT_DSWQ.
+
+  Modifications:
+**********************************************************************/
+{
+  if ( INCLUDE_SNOW || melt > 0 || new_snow->swq <= MIN_SWQ_EB_THRES
+       || new_snow->surf_water > 0 || new_snow->pack_water > 0
+       || new_snow->surf_temp > SNOW_ADAPT_TEMP
+       || fabs(new_snow->surf_temp - old_snow->surf_temp) > SNOW_ADAPT_DTSURF
+       || fabs(new_snow->vapor_flux) > SNOW_ADAPT_DSWQ )
+    return (FALSE);
+
+  return (TRUE);
+}
 
 int surface_fluxes(char                 overstory,
 		   double               BareAlbedo,
@@ -36,6 +176,7 @@ int surface_fluxes(char                 overstory,
 		   int                  rec,
 		   int                  veg_class,
 		   atmos_data_struct   *atmos,
+		   band_forcing_struct *bf,
 		   dmy_struct          *dmy,
 		   energy_bal_struct   *energy,
 		   global_param_struct *gp,
@@ -145,10 +286,23 @@ int surface_fluxes(char                 overstory,
   2014-Mar-28 Removed DIST_PRCP option.					TJB
   2014-Apr-25 Added non-climatological veg parameters.			TJB
   2014-Apr-25 Added partial vegcover fraction.				TJB
+  2026-Oct-17 Added phase timers.					KM
+  2026-Oct-17 Call CalcBlowingSnow() through the kernel capture
+	      wrapper.							KM
+  2026-Oct-17 Added SNOW_STEP_ADAPT: quiet snow sub-steps are merged
+	      into longer steps, whose accumulations are weighted by
+	      their number of sub-steps.				KM
+  2026-Oct-17 Potential evap is only computed when options.PET_OUTPUT
+	      is TRUE.							KM
+  2026-Oct-17 Takes the band air temperature, precipitation, rainfall
+	      and snowfall from bf, computed for all bands by
+	      band_forcing().  runoff() is now called by full_energy()
+	      for all bands of the tile at once.			KM
 **********************************************************************/
 {
   extern veg_lib_struct *veg_lib;
   extern option_struct   options;
+  extern solver_stats_struct solver_stats;
   double                 total_store_moist[3];
   double                 step_store_moist[3];
   int                    MAX_ITER_GRND_CANOPY;
@@ -164,6 +318,16 @@ int surface_fluxes(char                 overstory,
   int                    step_inc; // number of atmos array elements to skip per surface fluxes step
   int                    endhidx;  // index of final element of atmos array
   int                    step_dt;  // time length of surface fluxes step
+  int                    step_hidx; // index of the forcing of the step in step_atmos
+  int                    adapt;    // TRUE if SNOW_STEP_ADAPT may merge sub-steps
+  int                    adapt_end; // sub-steps before this index are solved at SNOW_STEP
+  double                 step_wt;  // number of SNOW_STEPs in the step
+  atmos_data_struct     *step_atmos; // forcing of the step
+  band_forcing_struct   *step_bf;  // band forcing of the step
+  atmos_data_struct      merged_atmos; // mean forcing of merged sub-steps
+  band_forcing_struct    merged_bf; // band forcing of merged sub-steps
+  double                 merged_data[N_MERGED_FORCING];
+  char                   merged_snowflag;
   int                    lidx;
   int                    over_iter;
   int                    under_iter;
@@ -292,6 +456,14 @@ int surface_fluxes(char                 overstory,
   double                 stability_factor[2];
   double                 iter_pot_evap[N_PET_TYPES];
 
+  // state restored when a merged step is rejected
+  int                    save_INCLUDE_SNOW;
+  int                    save_UNSTABLE_SNOW;
+  double                 save_AlbedoUnder;
+  double                 save_coverage;
+  double                 save_snow_flux;
+  double                 save_snow_inflow;
+
   // handle bisection of understory solution
   double store_tol_under;
   double A_tol_under;
@@ -394,6 +566,8 @@ int surface_fluxes(char                 overstory,
     endhidx   = hidx + step_inc;
     step_dt   = gp->dt;
   }
+  adapt     = ( options.SNOW_STEP_ADAPT && endhidx - hidx > 1 );
+  adapt_end = hidx;
 
   /*******************************************
     Initialize sub-model time step variables
@@ -481,18 +655,46 @@ int surface_fluxes(char                 overstory,
 
     /** Solve energy balance for all sub-model time steps **/
 
+    step_atmos = atmos;
+    step_bf    = bf;
+    step_hidx  = hidx;
+    if ( adapt ) {
+      /* SNOW_STEP_ADAPT: solve quiet sub-steps as one step, with their
+         mean forcing, unless refining after a rejected merged step */
+      step_inc = 1;
+      if ( hidx >= adapt_end )
+	step_inc = snow_step_merge_length(atmos, bf, band, &step_snow,
+					  gp->MIN_RAIN_TEMP, hidx, endhidx);
+      step_dt = step_inc * options.SNOW_STEP;
+      if ( step_inc > 1 ) {
+	merge_snow_step_forcing(atmos, hidx, step_inc, &merged_atmos,
+				merged_data, &merged_snowflag);
+	band_forcing(&merged_atmos, 1, Nbands, soil_con, gauge_correction,
+		     gp->MIN_RAIN_TEMP, gp->MAX_SNOW_TEMP, &merged_bf);
+	step_atmos = &merged_atmos;
+	step_bf    = &merged_bf;
+	step_hidx  = 0;
+	save_snow_flux      = snow_flux;
+	save_coverage       = coverage;
+	save_AlbedoUnder    = energy->AlbedoUnder;
+	save_snow_inflow    = (*snow_inflow);
+	save_INCLUDE_SNOW   = INCLUDE_SNOW;
+	save_UNSTABLE_SNOW  = UNSTABLE_SNOW;
+      }
+    }
+    step_wt = (double)step_inc;
 
     /* set air temperature and precipitation for this snow band */
-    Tair = atmos->air_temp[hidx] + soil_con->Tfactor[band];
-    step_prec = atmos->prec[hidx] * soil_con->Pfactor[band];
+    Tair = step_bf->Tair[step_hidx][band];
+    step_prec = step_bf->prec[step_hidx][band];
     
     // initialize ground surface temperaure
     Tgrnd = energy->T[0];
 
     // initialize canopy terms
     Tcanopy = Tair;
-    VPcanopy = atmos->vp[hidx];
-    VPDcanopy = atmos->vpd[hidx];
+    VPcanopy = step_atmos->vp[step_hidx];
+    VPDcanopy = step_atmos->vpd[step_hidx];
 
     over_iter  = 0;
     tol_over   = 999;
@@ -510,8 +712,8 @@ int surface_fluxes(char                 overstory,
       faparl(CanopLayerBnd,
              veg_var->LAI,
              soil_con->AlbedoPar,
-             atmos->coszen[hidx],
-             atmos->fdir[hidx],
+             step_atmos->coszen[step_hidx],
+             step_atmos->fdir[step_hidx],
              LAIlayer,
              faPAR);
       /* Convert to absolute (unnormalized) absorbed PAR per leaf area per canopy layer
@@ -519,12 +721,12 @@ int surface_fluxes(char                 overstory,
       veg_var->aPAR = 0;
       for (cidx=0; cidx<options.Ncanopy; cidx++) {
         if (LAIlayer[cidx] > 1e-10) {
-          veg_var->aPARLayer[cidx] = (atmos->par[hidx]/Epar) * faPAR[cidx] / LAIlayer[cidx];
-          veg_var->aPAR += atmos->par[hidx] * faPAR[cidx] / LAIlayer[cidx];
+          veg_var->aPARLayer[cidx] = (step_atmos->par[step_hidx]/Epar) * faPAR[cidx] / LAIlayer[cidx];
+          veg_var->aPAR += step_atmos->par[step_hidx] * faPAR[cidx] / LAIlayer[cidx];
         }
         else {
-          veg_var->aPARLayer[cidx] = atmos->par[hidx]/Epar * faPAR[cidx] / 1e-10;
-          veg_var->aPAR += atmos->par[hidx] * faPAR[cidx] / 1e-10;
+          veg_var->aPARLayer[cidx] = step_atmos->par[step_hidx]/Epar * faPAR[cidx] / 1e-10;
+          veg_var->aPAR += step_atmos->par[step_hidx] * faPAR[cidx] / 1e-10;
         }
       }
       free((char*)LAIlayer);
@@ -539,11 +741,13 @@ int surface_fluxes(char                 overstory,
     // Compute mass flux of blowing snow
     if( !overstory && options.BLOWING && step_snow.swq > 0.) {
       Ls = (677. - 0.07 * step_snow.surf_temp) * JOULESPCAL * GRAMSPKG;
-      step_snow.blowing_flux = CalcBlowingSnow((double) step_dt, Tair,
+      /* last_snow counts SNOW_STEPs, so the snow age is computed with
+         SNOW_STEP rather than step_dt */
+      step_snow.blowing_flux = capture_CalcBlowingSnow((double) options.SNOW_STEP, Tair,
 						step_snow.last_snow, step_snow.surf_water,
-						wind[2], Ls, atmos->density[hidx],
-						atmos->pressure[hidx],
-						atmos->vp[hidx], roughness[2],
+						wind[2], Ls, step_atmos->density[step_hidx],
+						step_atmos->pressure[step_hidx],
+						step_atmos->vp[step_hidx], roughness[2],
 						ref_height[2], step_snow.depth,
 						lag_one, sigma_slope,
 						step_snow.surf_temp, iveg, Nveg, fetch,
@@ -640,27 +844,30 @@ int surface_fluxes(char                 overstory,
         dryFrac = -1;
 
 	/** Solve snow accumulation, ablation and interception **/
+	timer_start(TIMER_SOLVE_SNOW);
 	step_melt = solve_snow(overstory, BareAlbedo, LongUnderOut, 
-			       gp->MIN_RAIN_TEMP, gp->MAX_SNOW_TEMP, 
 			       Tcanopy, Tgrnd, Tair, dp,
-			       step_prec, snow_grnd_flux, gp->wind_h, 
+			       step_bf->rainfall[step_hidx][band],
+			       step_bf->snowfall[step_hidx][band],
+			       snow_grnd_flux, gp->wind_h, 
 			       &energy->AlbedoUnder, &step_Evap, Le, 
 			       &LongUnderIn, &NetLongSnow, &NetShortGrnd, 
 			       &NetShortSnow, &ShortUnderIn, &OldTSurf, 
 			       iter_aero_resist, iter_aero_resist_used,
 			       &coverage, &delta_coverage, 
 			       &delta_snow_heat, displacement, 
-			       gauge_correction, &step_melt_energy, 
+			       &step_melt_energy, 
 			       &step_out_prec, &step_out_rain, &step_out_snow,
 			       &step_ppt, &rainfall, ref_height, 
 			       roughness, snow_inflow, &snowfall, &surf_atten, 
 			       wind, root, UNSTABLE_SNOW, options.Nnode, 
-			       Nveg, iveg, band, step_dt, rec, hidx, veg_class,
+			       Nveg, iveg, band, step_dt, rec, step_hidx, veg_class,
 			       &UnderStory, CanopLayerBnd, &dryFrac, 
-			       dmy, atmos, &(iter_snow_energy), 
+			       dmy, step_atmos, &(iter_snow_energy), 
 			       iter_layer, &(iter_snow), 
 			       soil_con, 
 			       &(iter_snow_veg_var));
+	timer_stop(TIMER_SOLVE_SNOW);
       
 // iter_snow_energy.sensible + iter_snow_energy.latent + iter_snow_energy.latent_sub + NetShortSnow + NetLongSnow + ( snow_grnd_flux + iter_snow_energy.advection - iter_snow_energy.deltaCC + iter_snow_energy.refreeze_energy + iter_snow_energy.advected_sensible ) * step_snow.coverage
         if ( step_melt == ERROR ) return (ERROR);
@@ -683,6 +890,7 @@ int surface_fluxes(char                 overstory,
           Solve Energy Balance Components at Soil Surface
         **************************************************/
 	      
+	timer_start(TIMER_SURF_ENERGY_BAL);
 	Tsurf = calc_surf_energy_bal((*Le), LongUnderIn, NetLongSnow, 
 				     NetShortGrnd, NetShortSnow, OldTSurf, 
 				     ShortUnderIn, iter_snow.albedo, 
@@ -702,13 +910,14 @@ int surface_fluxes(char                 overstory,
 				     rainfall, ref_height, roughness, 
 				     snowfall, wind, root, INCLUDE_SNOW, 
 				     UnderStory, options.Nnode, Nveg, band, 
-				     step_dt, hidx, iveg, options.Nlayer, 
+				     step_dt, step_hidx, iveg, options.Nlayer, 
 				     (int)overstory, rec, veg_class, 
-				     CanopLayerBnd, &dryFrac, atmos, 
+				     CanopLayerBnd, &dryFrac, step_atmos, 
 				     &(dmy[rec]), &iter_soil_energy, 
 				     iter_layer, 
 				     &(iter_snow), soil_con, 
 				     &iter_soil_veg_var, gp->nrecs); 
+	timer_stop(TIMER_SURF_ENERGY_BAL);
 
         if ( (int)Tsurf == ERROR ) {
           // Return error flag to skip rest of grid cell
@@ -737,8 +946,8 @@ int surface_fluxes(char                 overstory,
 					  iter_snow_energy.NetShortOver, 
 					  iter_soil_energy.NetShortUnder, 
 					  iter_aero_resist_used[1], Tair, 
-					  atmos->density[hidx], 
-					  atmos->vp[hidx], atmos->vpd[hidx], 
+					  step_atmos->density[step_hidx], 
+					  step_atmos->vp[step_hidx], step_atmos->vpd[step_hidx], 
 					  &iter_soil_energy.AtmosError, 
 					  &iter_soil_energy.AtmosLatent,
 					  &iter_soil_energy.AtmosLatentSub,
@@ -802,6 +1011,23 @@ int surface_fluxes(char                 overstory,
     } while ( ( fabs( tol_over - last_tol_over ) > OVER_TOL 
 		&& overstory ) && ( tol_over != 0 ) 
 	      && (over_iter < MAX_ITER_GRND_CANOPY) );
+
+    /* SNOW_STEP_ADAPT error control: if the merged step melted snow,
+       warmed the pack too far, or exchanged too much mass with the
+       atmosphere, discard it and solve its sub-steps at SNOW_STEP */
+    if ( step_inc > 1 && adapt
+	 && !snow_step_merge_ok(&step_snow, &iter_snow, step_melt,
+				INCLUDE_SNOW) ) {
+      snow_flux           = save_snow_flux;
+      coverage            = save_coverage;
+      energy->AlbedoUnder = save_AlbedoUnder;
+      (*snow_inflow)      = save_snow_inflow;
+      INCLUDE_SNOW        = save_INCLUDE_SNOW;
+      UNSTABLE_SNOW       = save_UNSTABLE_SNOW;
+      adapt_end           = hidx + step_inc;
+      solver_stats.snow_rejected++;
+      continue;
+    }
  
     /**************************************
       Compute GPP, Raut, and NPP
@@ -814,10 +1040,10 @@ int surface_fluxes(char                 overstory,
                             veg_lib[veg_class].CO2Specificity,
                             iter_soil_veg_var.NscaleFactor,
                             Tair,
-                            atmos->shortwave[hidx],
+                            step_atmos->shortwave[step_hidx],
                             iter_soil_veg_var.aPARLayer,
                             soil_con->elevation,
-                            atmos->Catm[hidx],
+                            step_atmos->Catm[step_hidx],
                             CanopLayerBnd,
                             veg_var->LAI,
                             "rs",
@@ -866,35 +1092,42 @@ int surface_fluxes(char                 overstory,
 
     /**************************************
       Compute Potential Evap
+      (only needed for the OUT_PET_* variables)
     **************************************/
-    // First, determine the stability correction used in the iteration
-    if (iter_aero_resist_used[0] == HUGE_RESIST)
-      stability_factor[0] = HUGE_RESIST;
-    else
-      stability_factor[0] = iter_aero_resist_used[0]/aero_resist[N_PET_TYPES][UnderStory];
-    if (iter_aero_resist_used[1] == iter_aero_resist_used[0])
-      stability_factor[1] = stability_factor[0];
-    else {
-      if (iter_aero_resist_used[1] == HUGE_RESIST)
-        stability_factor[1] = HUGE_RESIST;
+    if (options.PET_OUTPUT) {
+      // First, determine the stability correction used in the iteration
+      if (iter_aero_resist_used[0] == HUGE_RESIST)
+        stability_factor[0] = HUGE_RESIST;
       else
-        stability_factor[1] = iter_aero_resist_used[1]/aero_resist[N_PET_TYPES][1];
-    }
+        stability_factor[0] = iter_aero_resist_used[0]/aero_resist[N_PET_TYPES][UnderStory];
+      if (iter_aero_resist_used[1] == iter_aero_resist_used[0])
+        stability_factor[1] = stability_factor[0];
+      else {
+        if (iter_aero_resist_used[1] == HUGE_RESIST)
+          stability_factor[1] = HUGE_RESIST;
+        else
+          stability_factor[1] = iter_aero_resist_used[1]/aero_resist[N_PET_TYPES][1];
+      }
 
-    // Next, loop over pot_evap types and apply the correction to the relevant aerodynamic resistance
-    for (p=0; p<N_PET_TYPES; p++) {
-      if (stability_factor[0] == HUGE_RESIST)
-        step_aero_resist[p][0] = HUGE_RESIST;
-      else
-        step_aero_resist[p][0] = aero_resist[p][UnderStory]*stability_factor[0];
-      if (stability_factor[1] == HUGE_RESIST)
-        step_aero_resist[p][1] = HUGE_RESIST;
-      else
-        step_aero_resist[p][1] = aero_resist[p][1]*stability_factor[1];
-    }
+      // Next, loop over pot_evap types and apply the correction to the relevant aerodynamic resistance
+      for (p=0; p<N_PET_TYPES; p++) {
+        if (stability_factor[0] == HUGE_RESIST)
+          step_aero_resist[p][0] = HUGE_RESIST;
+        else
+          step_aero_resist[p][0] = aero_resist[p][UnderStory]*stability_factor[0];
+        if (stability_factor[1] == HUGE_RESIST)
+          step_aero_resist[p][1] = HUGE_RESIST;
+        else
+          step_aero_resist[p][1] = aero_resist[p][1]*stability_factor[1];
+      }
 
-    // Finally, compute pot_evap
-    compute_pot_evap(veg_class, dmy, rec, gp->dt, atmos->shortwave[hidx], iter_soil_energy.NetLongAtmos, Tair, VPDcanopy, soil_con->elevation, step_aero_resist, iter_pot_evap);
+      // Finally, compute pot_evap
+      compute_pot_evap(veg_class, dmy, rec, gp->dt, step_atmos->shortwave[step_hidx], iter_soil_energy.NetLongAtmos, Tair, VPDcanopy, soil_con->elevation, step_aero_resist, iter_pot_evap);
+    }
+    else {
+      for (p=0; p<N_PET_TYPES; p++)
+        iter_pot_evap[p] = 0;
+    }
 
     /**************************************
       Store sub-model time step variables 
@@ -922,31 +1155,31 @@ int surface_fluxes(char                 overstory,
       }
       step_Wdew = soil_veg_var.Wdew;
       if (options.CARBON) {
-        store_gc  += 1/soil_veg_var.rc;
+        store_gc  += step_wt * 1/soil_veg_var.rc;
         for (cidx=0; cidx<options.Ncanopy; cidx++) {
-          store_gsLayer[cidx]  += 1/soil_veg_var.rsLayer[cidx];
+          store_gsLayer[cidx]  += step_wt * 1/soil_veg_var.rsLayer[cidx];
         }
-        store_Ci  += soil_veg_var.Ci;
-        store_GPP  += soil_veg_var.GPP;
-        store_Rdark  += soil_veg_var.Rdark;
-        store_Rphoto  += soil_veg_var.Rphoto;
-        store_Rmaint  += soil_veg_var.Rmaint;
-        store_Rgrowth  += soil_veg_var.Rgrowth;
-        store_Raut  += soil_veg_var.Raut;
-        store_NPP  += soil_veg_var.NPP;
+        store_Ci  += step_wt * soil_veg_var.Ci;
+        store_GPP  += step_wt * soil_veg_var.GPP;
+        store_Rdark  += step_wt * soil_veg_var.Rdark;
+        store_Rphoto  += step_wt * soil_veg_var.Rphoto;
+        store_Rmaint  += step_wt * soil_veg_var.Rmaint;
+        store_Rgrowth  += step_wt * soil_veg_var.Rgrowth;
+        store_Raut  += step_wt * soil_veg_var.Raut;
+        store_NPP  += step_wt * soil_veg_var.NPP;
       }
     }
     for(lidx = 0; lidx < options.Nlayer; lidx++)
       store_layerevap[lidx] += step_layer[lidx].evap;
     store_ppt += step_ppt;
     if (iter_aero_resist_used[0]>0)
-      store_aero_cond_used[0] += 1/iter_aero_resist_used[0];
+      store_aero_cond_used[0] += step_wt * 1/iter_aero_resist_used[0];
     else
-      store_aero_cond_used[0] += HUGE_RESIST;
+      store_aero_cond_used[0] += step_wt * HUGE_RESIST;
     if (iter_aero_resist_used[1]>0)
-      store_aero_cond_used[1] += 1/iter_aero_resist_used[1];
+      store_aero_cond_used[1] += step_wt * 1/iter_aero_resist_used[1];
     else
-      store_aero_cond_used[1] += HUGE_RESIST;
+      store_aero_cond_used[1] += step_wt * HUGE_RESIST;
 
     if(iveg != Nveg) 
       store_canopy_vapor_flux += step_snow.canopy_vapor_flux;
@@ -971,55 +1204,59 @@ int surface_fluxes(char                 overstory,
       snow_energy.snow_flux          = soil_energy.snow_flux; 
     }
 
-    store_AlbedoOver        += snow_energy.AlbedoOver; 
-    store_AlbedoUnder       += soil_energy.AlbedoUnder;
-    store_AtmosLatent       += soil_energy.AtmosLatent;
-    store_AtmosLatentSub    += soil_energy.AtmosLatentSub;
-    store_AtmosSensible     += soil_energy.AtmosSensible;
-    store_LongOverIn        += snow_energy.LongOverIn; 
-    store_LongUnderIn       += LongUnderIn; 
-    store_LongUnderOut      += soil_energy.LongUnderOut; 
-    store_NetLongAtmos      += soil_energy.NetLongAtmos; 
-    store_NetLongOver       += snow_energy.NetLongOver; 
-    store_NetLongUnder      += soil_energy.NetLongUnder; 
-    store_NetShortAtmos     += soil_energy.NetShortAtmos; 
-    store_NetShortGrnd      += NetShortGrnd; 
-    store_NetShortOver      += snow_energy.NetShortOver; 
-    store_NetShortUnder     += soil_energy.NetShortUnder; 
-    store_ShortOverIn       += snow_energy.ShortOverIn; 
-    store_ShortUnderIn      += soil_energy.ShortUnderIn; 
-    store_canopy_advection  += snow_energy.canopy_advection; 
-    store_canopy_latent     += snow_energy.canopy_latent; 
-    store_canopy_latent_sub += snow_energy.canopy_latent_sub; 
-    store_canopy_sensible   += snow_energy.canopy_sensible; 
-    store_canopy_refreeze   += snow_energy.canopy_refreeze; 
-    store_deltaH            += soil_energy.deltaH; 
-    store_fusion            += soil_energy.fusion; 
-    store_grnd_flux         += soil_energy.grnd_flux; 
-    store_latent            += soil_energy.latent; 
-    store_latent_sub        += soil_energy.latent_sub; 
-    store_melt_energy       += step_melt_energy;
-    store_sensible          += soil_energy.sensible; 
+    store_AlbedoOver        += step_wt * snow_energy.AlbedoOver; 
+    store_AlbedoUnder       += step_wt * soil_energy.AlbedoUnder;
+    store_AtmosLatent       += step_wt * soil_energy.AtmosLatent;
+    store_AtmosLatentSub    += step_wt * soil_energy.AtmosLatentSub;
+    store_AtmosSensible     += step_wt * soil_energy.AtmosSensible;
+    store_LongOverIn        += step_wt * snow_energy.LongOverIn; 
+    store_LongUnderIn       += step_wt * LongUnderIn; 
+    store_LongUnderOut      += step_wt * soil_energy.LongUnderOut; 
+    store_NetLongAtmos      += step_wt * soil_energy.NetLongAtmos; 
+    store_NetLongOver       += step_wt * snow_energy.NetLongOver; 
+    store_NetLongUnder      += step_wt * soil_energy.NetLongUnder; 
+    store_NetShortAtmos     += step_wt * soil_energy.NetShortAtmos; 
+    store_NetShortGrnd      += step_wt * NetShortGrnd; 
+    store_NetShortOver      += step_wt * snow_energy.NetShortOver; 
+    store_NetShortUnder     += step_wt * soil_energy.NetShortUnder; 
+    store_ShortOverIn       += step_wt * snow_energy.ShortOverIn; 
+    store_ShortUnderIn      += step_wt * soil_energy.ShortUnderIn; 
+    store_canopy_advection  += step_wt * snow_energy.canopy_advection; 
+    store_canopy_latent     += step_wt * snow_energy.canopy_latent; 
+    store_canopy_latent_sub += step_wt * snow_energy.canopy_latent_sub; 
+    store_canopy_sensible   += step_wt * snow_energy.canopy_sensible; 
+    store_canopy_refreeze   += step_wt * snow_energy.canopy_refreeze; 
+    store_deltaH            += step_wt * soil_energy.deltaH; 
+    store_fusion            += step_wt * soil_energy.fusion; 
+    store_grnd_flux         += step_wt * soil_energy.grnd_flux; 
+    store_latent            += step_wt * soil_energy.latent; 
+    store_latent_sub        += step_wt * soil_energy.latent_sub; 
+    store_melt_energy       += step_wt * step_melt_energy;
+    store_sensible          += step_wt * soil_energy.sensible; 
     if ( step_snow.swq == 0 && INCLUDE_SNOW ) {
       if ( last_snow_coverage == 0 && step_prec > 0 ) last_snow_coverage = 1;
-      store_advected_sensible += snow_energy.advected_sensible * last_snow_coverage; 
-      store_advection         += snow_energy.advection * last_snow_coverage; 
-      store_deltaCC           += snow_energy.deltaCC * last_snow_coverage; 
-      store_snow_flux         += soil_energy.snow_flux * last_snow_coverage; 
-      store_refreeze_energy   += snow_energy.refreeze_energy * last_snow_coverage; 
+      store_advected_sensible += step_wt * snow_energy.advected_sensible * last_snow_coverage; 
+      store_advection         += step_wt * snow_energy.advection * last_snow_coverage; 
+      store_deltaCC           += step_wt * snow_energy.deltaCC * last_snow_coverage; 
+      store_snow_flux         += step_wt * soil_energy.snow_flux * last_snow_coverage; 
+      store_refreeze_energy   += step_wt * snow_energy.refreeze_energy * last_snow_coverage; 
     }
     else if ( step_snow.snow || INCLUDE_SNOW ) {
-      store_advected_sensible += snow_energy.advected_sensible * (step_snow.coverage + delta_coverage);
-      store_advection         += snow_energy.advection * (step_snow.coverage + delta_coverage); 
-      store_deltaCC           += snow_energy.deltaCC * (step_snow.coverage + delta_coverage); 
-      store_snow_flux         += soil_energy.snow_flux * (step_snow.coverage + delta_coverage); 
-      store_refreeze_energy   += snow_energy.refreeze_energy * (step_snow.coverage + delta_coverage); 
+      store_advected_sensible += step_wt * snow_energy.advected_sensible * (step_snow.coverage + delta_coverage);
+      store_advection         += step_wt * snow_energy.advection * (step_snow.coverage + delta_coverage); 
+      store_deltaCC           += step_wt * snow_energy.deltaCC * (step_snow.coverage + delta_coverage); 
+      store_snow_flux         += step_wt * soil_energy.snow_flux * (step_snow.coverage + delta_coverage); 
+      store_refreeze_energy   += step_wt * snow_energy.refreeze_energy * (step_snow.coverage + delta_coverage); 
     }
     for (p=0; p<N_PET_TYPES; p++)
-      store_pot_evap[p] += iter_pot_evap[p];
+      store_pot_evap[p] += step_wt * iter_pot_evap[p];
 
     /* increment time step */
-    N_steps ++;
+    if ( step_inc > 1 && adapt ) {
+      solver_stats.snow_merged++;
+      solver_stats.snow_merged_substeps += step_inc;
+    }
+    N_steps += step_inc;
     hidx += step_inc;
 
   } while (hidx < endhidx);
@@ -1155,17 +1392,17 @@ int surface_fluxes(char                 overstory,
   }
 
   /********************************************************
-    Compute Runoff, Baseflow, and Soil Moisture Transport
+    Store water reaching the soil surface; runoff, baseflow
+    and soil moisture transport are computed by runoff(),
+    which full_energy() calls for all bands of the tile
   ********************************************************/
 
   (*inflow) = ppt;
 
-  ErrorFlag = runoff(cell, energy, soil_con, ppt, soil_con->frost_fract,
-                     gp->dt, options.Nnode, band, rec, iveg);
-
-  return( ErrorFlag );
+  return( 0 );
 
 }
 
 #undef GRND_TOL
 #undef OVER_TOL
+#undef N_MERGED_FORCING
@@ -0,0 +1,291 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  timing.c		Keith Mathews			October 2026
+
+  Optional hierarchical phase timers.  A fixed set of timers (defined
+  in vicNl_def.h) brackets the major phases of the model call tree.
+  Timers nest dynamically: when a timer stops, its elapsed time is
+  charged to the inclusive total of that timer and to the "child" total
+  of whichever timer was running when it started, so that self time
+  (inclusive minus children) can be reported for every phase.
+
+  Timers are enabled by the TIMING option in the global parameter file:
+    TIMING_NONE  = no timers (default); timer calls return immediately
+    TIMING_CELL  = only the cell-level phases in vicNl.c are timed
+    TIMING_PHASE = the physics phases inside full_energy() are timed too
+
+  At the end of each cell, timer_end_cell() optionally writes one line
+  of per-cell inclusive times to the TIMING_FILE.  At the end of the run,
+  timer_summary() prints a per-phase summary to stderr.
+
+  Modifications:
+  2026-Oct-17 Added timer_name().					KM
+  2026-Oct-17 runoff is timed in full_energy(), for all bands of a
+	      tile, rather than in surface_fluxes().			KM
+**********************************************************************/
+
+typedef struct {
+  char   *name;      /* name of phase as printed in summary */
+  int     depth;     /* nominal depth in the call tree, for display */
+  char    level;     /* minimum TIMING level at which phase is timed */
+} timer_info_struct;
+
+static timer_info_struct timer_info[N_TIMERS] = {
+  { "cell",                 0, TIMING_CELL  },
+  { "read_param",           1, TIMING_CELL  },
+  { "open_close_files",     1, TIMING_CELL  },
+  { "initialize_atmos",     1, TIMING_CELL  },
+  { "read_forcing_data",    2, TIMING_PHASE },
+  { "mtclim_wrapper",       2, TIMING_PHASE },
+  { "initialize_model_state", 1, TIMING_CELL  },
+  { "full_energy",          1, TIMING_CELL  },
+  { "surface_fluxes",       2, TIMING_PHASE },
+  { "solve_snow",           3, TIMING_PHASE },
+  { "calc_surf_energy_bal", 3, TIMING_PHASE },
+  { "solve_T_profile",      4, TIMING_PHASE },
+  { "runoff",               2, TIMING_PHASE },
+  { "solve_lake",           2, TIMING_PHASE },
+  { "put_data",             1, TIMING_CELL  },
+  { "write_data",           2, TIMING_PHASE },
+};
+
+#define TIMER_STACK_SIZE 32
+
+static double  run_incl[N_TIMERS];   /* inclusive time, whole run [s] */
+static double  run_child[N_TIMERS];  /* time spent in nested timers [s] */
+static long    run_calls[N_TIMERS];  /* number of start/stop pairs */
+static double  cell_incl[N_TIMERS];  /* inclusive time, current cell [s] */
+
+static int     stack_id[TIMER_STACK_SIZE];
+static double  stack_t0[TIMER_STACK_SIZE];
+static int     stack_depth = 0;
+static int     ncells_timed = 0;
+static double  run_t0;
+static FILE   *timing_fp = NULL;
+
+static double timer_now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec);
+}
+
+void timer_init(filenames_struct *names)
+/**********************************************************************
+  timer_init		Keith Mathews			October 2026
+
+  Resets all timers and, if a TIMING_FILE was given, opens it and
+  writes the header line of the per-cell timing table.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int i;
+
+  for (i = 0; i < N_TIMERS; i++) {
+    run_incl[i] = 0;
+    run_child[i] = 0;
+    run_calls[i] = 0;
+    cell_incl[i] = 0;
+  }
+  stack_depth = 0;
+  ncells_timed = 0;
+  run_t0 = timer_now();
+
+  if (options.TIMING == TIMING_NONE)
+    return;
+
+  if (strcmp(names->timing, "NONE") != 0) {
+    timing_fp = open_file(names->timing, "w");
+    fprintf(timing_fp, "CELLNUM,GRIDCEL,LAT,LNG");
+    for (i = 0; i < N_TIMERS; i++)
+      if (options.TIMING >= timer_info[i].level)
+        fprintf(timing_fp, ",%s", timer_info[i].name);
+    fprintf(timing_fp, "\n");
+  }
+}
+
+void timer_start(int id)
+/**********************************************************************
+  timer_start		Keith Mathews			October 2026
+
+  Starts timer id.  Calls to timer_start() and timer_stop() must be
+  properly nested.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+
+  if (options.TIMING < timer_info[id].level)
+    return;
+
+  if (stack_depth >= TIMER_STACK_SIZE) {
+    stack_depth++;
+    return;
+  }
+  stack_id[stack_depth] = id;
+  stack_t0[stack_depth] = timer_now();
+  stack_depth++;
+}
+
+void timer_stop(int id)
+/**********************************************************************
+  timer_stop		Keith Mathews			October 2026
+
+  Stops timer id, which must be the most recently started timer, and
+  charges the elapsed time to it and to its enclosing timer.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  double elapsed;
+
+  if (options.TIMING < timer_info[id].level)
+    return;
+
+  stack_depth--;
+  if (stack_depth >= TIMER_STACK_SIZE)
+    return;
+  if (stack_depth < 0 || stack_id[stack_depth] != id) {
+    fprintf(stderr, "WARNING: timer \"%s\" stopped out of order; timing results will be unreliable.\n", timer_info[id].name);
+    stack_depth = 0;
+    return;
+  }
+
+  elapsed = timer_now() - stack_t0[stack_depth];
+  run_incl[id] += elapsed;
+  cell_incl[id] += elapsed;
+  run_calls[id]++;
+  if (stack_depth > 0)
+    run_child[stack_id[stack_depth-1]] += elapsed;
+}
+
+void timer_end_cell(int cellnum, soil_con_struct *soil_con)
+/**********************************************************************
+  timer_end_cell	Keith Mathews			October 2026
+
+  Writes the per-cell inclusive phase times of the current cell to the
+  TIMING_FILE (if any) and resets the per-cell accumulators.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int i;
+
+  if (options.TIMING == TIMING_NONE)
+    return;
+
+  ncells_timed++;
+  if (timing_fp != NULL) {
+    fprintf(timing_fp, "%d,%d,%.6f,%.6f", cellnum, soil_con->gridcel,
+            soil_con->lat, soil_con->lng);
+    for (i = 0; i < N_TIMERS; i++)
+      if (options.TIMING >= timer_info[i].level)
+        fprintf(timing_fp, ",%.6f", cell_incl[i]);
+    fprintf(timing_fp, "\n");
+  }
+  for (i = 0; i < N_TIMERS; i++)
+    cell_incl[i] = 0;
+}
+
+char *timer_name(int id)
+/**********************************************************************
+  timer_name		Keith Mathews			October 2026
+
+  Returns the name of timer id.
+
+  Modifications:
+**********************************************************************/
+{
+  return timer_info[id].name;
+}
+
+double timer_get(int id)
+/**********************************************************************
+  timer_get		Keith Mathews			October 2026
+
+  Returns the inclusive time [s] accumulated so far in timer id.
+
+  Modifications:
+**********************************************************************/
+{
+  return run_incl[id];
+}
+
+long timer_peak_rss()
+/**********************************************************************
+  timer_peak_rss	Keith Mathews			October 2026
+
+  Returns the peak resident set size of the process [kB].
+
+  Modifications:
+**********************************************************************/
+{
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+  return usage.ru_maxrss;
+}
+
+void timer_summary()
+/**********************************************************************
+  timer_summary		Keith Mathews			October 2026
+
+  Prints the per-phase timing summary for the whole run to stderr and
+  closes the TIMING_FILE.  Phases are indented by their nominal depth
+  in the call tree; percentages are relative to total wall time.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int    i;
+  double wall;
+  double self;
+
+  if (options.TIMING == TIMING_NONE)
+    return;
+
+  wall = timer_now() - run_t0;
+  if (wall <= 0) wall = SMALL;
+
+  fprintf(stderr, "\n");
+  fprintf(stderr, "Timing Summary (%d cells, %.3f s wall time)\n",
+          ncells_timed, wall);
+  fprintf(stderr, "%-30s %12s %12s %12s %7s\n", "Phase", "Calls",
+          "Incl [s]", "Self [s]", "Incl %");
+  for (i = 0; i < N_TIMERS; i++) {
+    if (options.TIMING < timer_info[i].level)
+      continue;
+    self = run_incl[i] - run_child[i];
+    fprintf(stderr, "%*s%-*s %12ld %12.4f %12.4f %7.2f\n",
+            2*timer_info[i].depth, "", 30-2*timer_info[i].depth,
+            timer_info[i].name, run_calls[i], run_incl[i], self,
+            100.*run_incl[i]/wall);
+  }
+  fprintf(stderr, "Peak resident set size: %ld kB\n", timer_peak_rss());
+  if (ncells_timed > 0)
+    fprintf(stderr, "Mean wall time per cell: %.4f s\n",
+            run_incl[TIMER_CELL]/(double)ncells_timed);
+  fprintf(stderr, "\n");
+
+  if (timing_fp != NULL) {
+    fclose(timing_fp);
+    timing_fp = NULL;
+  }
+}
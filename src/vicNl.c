@@ -98,6 +98,24 @@ int main(int argc, char *argv[])
 	      OUTPUT_FORCE condition to avoid memory leak.		TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
   2014-Apr-25 Added non-climatological veg parameters.			TJB
+  2026-Oct-17 Added optional phase timers (TIMING option).		KM
+  2026-Oct-17 Added kernel capture (KERNEL_CAPTURE option).		KM
+  2026-Oct-17 Added per-cell cost log (CELL_LOG option).		KM
+  2026-Oct-17 Added progress reporting (PROGRESS option).		KM
+  2026-Oct-17 Added memory accounting (MEM_STATS option).		KM
+  2026-Oct-17 Added region aggregation (REGION_MAP option).		KM
+  2026-Oct-17 Added unit-hydrograph routing (ROUTING_FLOWDIR option).	KM
+  2026-Oct-17 Added output statistics (STATVAR option).			KM
+  2026-Oct-17 Added forcing cache (FORCING_CACHE option).		KM
+  2026-Oct-17 Added threaded forcing disaggregation (FORCE_THREADS
+	      option).							KM
+  2026-Oct-17 Added reduced-precision forcing storage (FORCE_PRECISION
+	      option).							KM
+  2026-Oct-17 Added NetCDF forcing files (FORCE_FORMAT NETCDF).		KM
+  2026-Oct-17 Added read-ahead of the cells' inputs (PREFETCH_DEPTH).	KM
+  2026-Oct-17 Added output writer thread (WRITE_QUEUE).			KM
+  2026-Oct-17 Added Arrow IPC output files (ARROW_OUTPUT).		KM
+  2026-Oct-17 Added shared-memory output channel (SHM_NAME).		KM
 **********************************************************************/
 {
 
@@ -112,6 +130,7 @@ int main(int argc, char *argv[])
   char                     LASTREC;
   char                     MODEL_DONE;
   char                     RUN_MODEL;
+  char                     PACK_FORCE;
   char                     ErrStr[MAXSTRING];
   int                      rec, i, j;
   int                      veg;
@@ -128,7 +147,9 @@ int main(int argc, char *argv[])
   double                   Clake;
   dmy_struct              *dmy;
   atmos_data_struct       *atmos;
+  atmos_data_struct       *atmos_rec;
   veg_hist_struct        **veg_hist;
+  veg_hist_struct         *veg_hist_rec;
   veg_con_struct          *veg_con;
   soil_con_struct          soil_con;
   all_vars_struct          all_vars;
@@ -161,6 +182,21 @@ int main(int argc, char *argv[])
   /** Check and Open Files **/
   check_files(&filep, &filenames);
 
+  /** Initialize Phase Timers **/
+  timer_init(&filenames);
+
+  /** Initialize Memory Accounting **/
+  mem_stats_init(&filenames);
+
+  /** Open Kernel Capture File **/
+  kernel_capture_init(&filenames);
+
+  /** Open Per-Cell Cost Log **/
+  cell_stats_init(&filenames);
+
+  /** Open Forcing Cache **/
+  forcing_cache_init(&filenames);
+
   if (!options.OUTPUT_FORCE) {
     /** Read Vegetation Library File **/
     veg_lib = read_veglib(filep.veglib,&Nveg_type);
@@ -172,8 +208,30 @@ int main(int argc, char *argv[])
   /** Make Date Data Structure **/
   dmy      = make_dmy(&global_param);
 
-  /** allocate memory for the atmos_data_struct **/
-  alloc_atmos(global_param.nrecs, &atmos);
+  /** Open NetCDF Forcing Files, and Order the Cells for Them **/
+  netcdf_forcing_init(&filenames, &global_param, &filep);
+
+  /** Read Region Map **/
+  region_init(&filenames, &global_param, out_data);
+
+  /** Read Routing Network **/
+  route_init(&filenames, &global_param);
+
+  /** Allocate Output Statistics **/
+  out_stats_init(&filenames, &global_param, out_data, dmy);
+
+  /** Open Arrow Output Files **/
+  arrow_output_init(&filenames, out_data_files, out_data);
+
+  /** Open Shared-Memory Output Channel **/
+  shm_output_init(&filenames, &global_param, out_data);
+
+  /** allocate memory for the atmos_data_struct (per cell when the
+      forcings are stored in reduced precision) **/
+  PACK_FORCE = (!options.OUTPUT_FORCE
+                && options.FORCE_PRECISION != FORCE_PREC_DOUBLE);
+  if (!PACK_FORCE)
+    alloc_atmos(global_param.nrecs, &atmos);
 
   /** Initial state **/
   startrec = 0;
@@ -192,49 +250,90 @@ int main(int argc, char *argv[])
 
   } /* !OUTPUT_FORCE */
 
+  /** Start Progress Reporting **/
+  progress_init(filep.soilparam, &filenames, &global_param);
+
   /************************************
     Run Model for all Active Grid Cells
     ************************************/
   MODEL_DONE = FALSE;
+  if (options.OUTPUT_FORCE && options.FORCE_THREADS > 1) {
+    /** Disaggregate the Forcings of Several Cells at Once **/
+    force_disagg(filep.soilparam, &filenames, &global_param, dmy,
+                 out_data_files, out_data);
+    MODEL_DONE = TRUE;
+  }
+  else if (options.PREFETCH_DEPTH > 0) {
+    /** Read the Inputs of the Next Cells in the Background **/
+    prefetch_start(filep.soilparam, &filenames, &global_param);
+  }
+  if (options.WRITE_QUEUE > 0) {
+    /** Write the Output Files in the Background **/
+    write_queue_start(out_data);
+  }
   while(!MODEL_DONE) {
 
-    soil_con = read_soilparam(filep.soilparam, &RUN_MODEL, &MODEL_DONE);
+    if (options.PREFETCH_DEPTH > 0)
+      soil_con = prefetch_next_cell(&RUN_MODEL, &MODEL_DONE);
+    else
+      soil_con = read_soilparam(filep.soilparam, &RUN_MODEL, &MODEL_DONE);
 
     if(RUN_MODEL) {
 
       NEWCELL=TRUE;
       cellnum++;
 
+      timer_start(TIMER_CELL);
+      cell_stats_start();
+      progress_start_cell(soil_con.gridcel);
+      mem_stats_start_cell();
+      region_start_cell(&soil_con);
+      route_start_cell();
+      out_stats_start_cell();
+
       if (!options.OUTPUT_FORCE) {
 
+        timer_start(TIMER_READ_PARAM);
+
         /** Read Grid Cell Vegetation Parameters **/
         veg_con = read_vegparam(filep.vegparam, soil_con.gridcel,
                                 Nveg_type);
         calc_root_fractions(veg_con, &soil_con);
 
-        if ( options.LAKES ) 
+        if ( options.LAKES ) {
 	  lake_con = read_lakeparam(filep.lakeparam, soil_con, veg_con);
+	  mem_charge(MEM_LAKE, sizeof(lake_con_struct) + sizeof(lake_var_struct));
+	}
+
+        timer_stop(TIMER_READ_PARAM);
 
       } /* !OUTPUT_FORCE */
 
       /** Build Gridded Filenames, and Open **/
+      timer_start(TIMER_FILES);
       make_in_and_outfiles(&filep, &filenames, &soil_con, out_data_files);
 
-      if (options.PRT_HEADER) {
+      if (options.PRT_HEADER && !options.REGION_ONLY && !options.STAT_ONLY
+          && !options.ARROW_OUTPUT) {
         /** Write output file headers **/
         write_header(out_data_files, out_data, dmy, global_param);
       }
+      timer_stop(TIMER_FILES);
 
       if (!options.OUTPUT_FORCE) {
 
         /** Read Elevation Band Data if Used **/
+        timer_start(TIMER_READ_PARAM);
         read_snowband(filep.snowband, &soil_con);
+        timer_stop(TIMER_READ_PARAM);
 
         /** Make Top-level Control Structure **/
         all_vars     = make_all_vars(veg_con[0].vegetat_type_num);
 
         /** allocate memory for the veg_hist_struct **/
         alloc_veg_hist(global_param.nrecs, veg_con[0].vegetat_type_num, &veg_hist);
+        if (PACK_FORCE)
+          alloc_atmos(global_param.nrecs, &atmos);
 
       } /* !OUTPUT_FORCE */
 
@@ -247,8 +346,20 @@ int main(int argc, char *argv[])
       fprintf(stderr,"Initializing Forcing Data\n");
 #endif /* VERBOSE */
 
+      timer_start(TIMER_INIT_ATMOS);
       initialize_atmos(atmos, dmy, filep.forcing, veg_lib, veg_con, veg_hist,
 		       &soil_con, out_data_files, out_data); 
+      if (PACK_FORCE) {
+        /** Store the forcings in reduced precision, and keep one record
+            of atmos and veg_hist to widen them into **/
+        atmos_pack(global_param.nrecs, veg_con[0].vegetat_type_num, atmos, veg_hist);
+        free_atmos(global_param.nrecs, &atmos);
+        free_veg_hist(global_param.nrecs, veg_con[0].vegetat_type_num, &veg_hist);
+        alloc_atmos(1, &atmos);
+        alloc_veg_hist(1, veg_con[0].vegetat_type_num, &veg_hist);
+        atmos_unpack(0, atmos, veg_hist[0]);
+      }
+      timer_stop(TIMER_INIT_ATMOS);
 
       if (!options.OUTPUT_FORCE) {
 
@@ -259,11 +370,13 @@ int main(int argc, char *argv[])
 #if VERBOSE
         fprintf(stderr,"Model State Initialization\n");
 #endif /* VERBOSE */
+        timer_start(TIMER_INIT_STATE);
         ErrorFlag = initialize_model_state(&all_vars, dmy[0], &global_param, filep, 
 			       soil_con.gridcel, veg_con[0].vegetat_type_num,
 			       options.Nnode, 
 			       atmos[0].air_temp[NR],
 			       &soil_con, veg_con, lake_con);
+        timer_stop(TIMER_INIT_STATE);
         if ( ErrorFlag == ERROR ) {
 	  if ( options.CONTINUEONERROR == TRUE ) {
 	    // Handle grid cell solution error
@@ -297,15 +410,29 @@ int main(int argc, char *argv[])
           if ( rec == global_param.nrecs - 1 ) LASTREC = TRUE;
           else LASTREC = FALSE;
 
+	  if (PACK_FORCE) {
+	    atmos_unpack(rec, atmos, veg_hist[0]);
+	    atmos_rec = &atmos[0];
+	    veg_hist_rec = veg_hist[0];
+	  }
+	  else {
+	    atmos_rec = &atmos[rec];
+	    veg_hist_rec = veg_hist[rec];
+	  }
+
 	  /**************************************************
 	    Compute cell physics for 1 timestep
 	  **************************************************/
-	  ErrorFlag = full_energy(cellnum, rec, &atmos[rec], &all_vars, dmy, &global_param, &lake_con, &soil_con, veg_con, veg_hist);
+	  timer_start(TIMER_FULL_ENERGY);
+	  ErrorFlag = full_energy(cellnum, rec, atmos_rec, &all_vars, dmy, &global_param, &lake_con, &soil_con, veg_con, veg_hist_rec);
+	  timer_stop(TIMER_FULL_ENERGY);
 
 	  /**************************************************
 	    Write cell average values for current time step
 	  **************************************************/
-	  ErrorFlag = put_data(&all_vars, &atmos[rec], &soil_con, veg_con, &lake_con, out_data_files, out_data, &save_data, &dmy[rec], rec);
+	  timer_start(TIMER_PUT_DATA);
+	  ErrorFlag = put_data(&all_vars, atmos_rec, &soil_con, veg_con, &lake_con, out_data_files, out_data, &save_data, &dmy[rec], rec);
+	  timer_stop(TIMER_PUT_DATA);
 
 	  /************************************
 	    Save model state at assigned date
@@ -334,15 +461,27 @@ int main(int argc, char *argv[])
 
           NEWCELL=FALSE;
 
+          progress_step(rec);
+
         } /* End Rec Loop */
 
       } /* !OUTPUT_FORCE */
 
+      timer_start(TIMER_FILES);
       close_files(&filep,out_data_files,&filenames); 
+      timer_stop(TIMER_FILES);
 
       if (!options.OUTPUT_FORCE) {
 
-        free_veg_hist(global_param.nrecs, veg_con[0].vegetat_type_num, &veg_hist);
+        cell_stats_end(cellnum, &soil_con, veg_con, &all_vars, &lake_con);
+
+        if (PACK_FORCE) {
+          free_veg_hist(1, veg_con[0].vegetat_type_num, &veg_hist);
+          free_atmos(1, &atmos);
+          atmos_pack_free();
+        }
+        else
+          free_veg_hist(global_param.nrecs, veg_con[0].vegetat_type_num, &veg_hist);
         free_all_vars(&all_vars,veg_con[0].vegetat_type_num);
         free_vegcon(&veg_con);
         free((char *)soil_con.AreaFract);
@@ -350,14 +489,50 @@ int main(int argc, char *argv[])
         free((char *)soil_con.Tfactor);
         free((char *)soil_con.Pfactor);
         free((char *)soil_con.AboveTreeLine);
+        if ( options.LAKES )
+	  mem_charge(MEM_LAKE, -(long)(sizeof(lake_con_struct) + sizeof(lake_var_struct)));
 
       } /* !OUTPUT_FORCE */
 
+      timer_stop(TIMER_CELL);
+      timer_end_cell(cellnum, &soil_con);
+      progress_end_cell();
+      mem_stats_end_cell(cellnum, &soil_con);
+      region_end_cell(&soil_con);
+      route_end_cell(&soil_con);
+      out_stats_end_cell(out_data, &soil_con);
+
     }	/* End Run Model Condition */
   } 	/* End Grid Loop */
+  if (options.PREFETCH_DEPTH > 0)
+    prefetch_end();
+  if (options.WRITE_QUEUE > 0)
+    write_queue_end();
+
+  /** Report Phase Timers **/
+  timer_summary();
+  forcing_cache_summary();
+  progress_done();
+  kernel_capture_close();
+  cell_stats_close();
+
+  /** Write Region Output Files **/
+  region_write(&filenames, out_data);
+
+  /** Write Routed Streamflow Files **/
+  route_write(&filenames);
+
+  /** Close Arrow Output Files **/
+  arrow_output_close();
+
+  /** Close Shared-Memory Output Channel **/
+  shm_output_close();
 
   /** cleanup **/
-  free_atmos(global_param.nrecs, &atmos);
+  out_stats_free();
+  netcdf_forcing_close();
+  if (!PACK_FORCE)
+    free_atmos(global_param.nrecs, &atmos);
   free_dmy(&dmy);
   free_out_data_files(&out_data_files);
   free_out_data(&out_data);
@@ -376,6 +551,9 @@ int main(int argc, char *argv[])
       fclose(filep.statefile);
   } /* !OUTPUT_FORCE */
 
+  /** Report Memory Accounting **/
+  mem_stats_summary();
+
   return EXIT_SUCCESS;
 
 }	/* End Main Program */
@@ -124,6 +124,34 @@
   2014-Apr-25 Added non-climatological veg parameter functions.		TJB
   2014-Apr-25 Resurrected calc_veg_displacement() and
 	      calc_veg_roughness().					TJB
+  2026-Oct-17 Added timer functions.					KM
+  2026-Oct-17 Added kernel capture functions.				KM
+  2026-Oct-17 Added cell_stats functions.				KM
+  2026-Oct-17 Added progress functions and timer_name().		KM
+  2026-Oct-17 Added memory accounting functions.			KM
+  2026-Oct-17 Added region aggregation functions.			KM
+  2026-Oct-17 Added routing functions.					KM
+  2026-Oct-17 Added output statistics functions.			KM
+  2026-Oct-17 Added forcing cache functions.				KM
+  2026-Oct-17 Added force_disagg(), copy_output_list(), and
+	      copy_out_data_files().					KM
+  2026-Oct-17 Added atmos_pack functions.  full_energy() now takes the
+	      current record's veg_hist.				KM
+  2026-Oct-17 Added NetCDF forcing functions; added lat and lng to
+	      read_forcing_data().					KM
+  2026-Oct-17 Added rewind_file().					KM
+  2026-Oct-17 Added prefetch functions and make_in_files().		KM
+  2026-Oct-17 Added write_queue functions.				KM
+  2026-Oct-17 Added arrow_output functions.				KM
+  2026-Oct-17 Added shm_output functions.				KM
+  2026-Oct-17 Added set_node_layer_weights(); distribute_node_moisture_properties()
+	      and estimate_layer_ice_content() now take node_layer instead
+	      of Zsum_node (and frost_fract and frost_slope).		KM
+  2026-Oct-17 Added the number of veg_hist elements to read_atmos_data(),
+	      read_forcing_data() and prefetch_forcing_data().		KM
+  2026-Oct-17 Added band_forcing().  solve_snow() takes the band
+	      rainfall and snowfall; surface_fluxes() takes the band
+	      forcing; runoff() solves all bands of a veg tile.		KM
 ************************************************************************/
 
 #include <math.h>
@@ -135,9 +163,18 @@
 double advected_sensible_heat(double, double, double, double, double);
 void alloc_atmos(int, atmos_data_struct **);
 void alloc_veg_hist(int, int, veg_hist_struct ***);
+void   atmos_pack(int, int, atmos_data_struct *, veg_hist_struct **);
+void   atmos_pack_free();
+void   atmos_unpack(int, atmos_data_struct *, veg_hist_struct *);
 double arno_evap(layer_data_struct *, double, double, 
 		 double, double, double, double, double, double, double, 
 		 double, double *);
+void   arrow_output_accumulate(out_data_struct *, dmy_struct *, soil_con_struct *);
+void   arrow_output_close();
+void   arrow_output_init(filenames_struct *, out_data_file_struct *, out_data_struct *);
+
+void   band_forcing(atmos_data_struct *, int, int, soil_con_struct *,
+                    double *, double, double, band_forcing_struct *);
 
 int   CalcAerodynamic(char, double, double, double, double, double,
 	  	       double *, double *, double *, double *, double *);
@@ -206,6 +243,39 @@ double canopy_evap(layer_data_struct *,
 		   double, double, double, double, double, 
 		   double *, double *, double *, double *, double *,
                    float *, double *, double, double, double *);
+void   cell_stats_close();
+void   cell_stats_end(int, soil_con_struct *, veg_con_struct *,
+                      all_vars_struct *, lake_con_struct *);
+void   cell_stats_init(filenames_struct *);
+void   cell_stats_start();
+double capture_CalcBlowingSnow(double, double, int, double, double, double,
+                               double, double, double, double, double, double,
+                               float, float, double, int, int, float, double,
+                               double, double *);
+int    capture_snow_melt(double, double, double, double, double *, double,
+                         double *, double, double, double, double, double,
+                         double, double, double, double, double, double,
+                         double, double, double, double *, double *, double *,
+                         double *, double *, double *, double *, double *,
+                         double *, double *, double *, double *, int, int, int,
+                         int, snow_data_struct *, soil_con_struct *);
+int    capture_solve_lake(double, double, double, double, double, double,
+                          double, double, double, double, lake_var_struct *,
+                          lake_con_struct, soil_con_struct, int, int, double,
+                          dmy_struct, double);
+int    capture_solve_T_profile(double *, double *, char *, int *, double *,
+                               double *, double *, double *, double, double *,
+                               double *, double *, double *, double *,
+                               double *, double *, double, double *, int,
+                               int *, int, int, int, int);
+int    capture_solve_T_profile_implicit(double *, double *, char *, int *,
+                                        double *, double *, double *,
+                                        double *, double, double *, double *,
+                                        double *, double *, double *,
+                                        double *, double *, double, int,
+                                        int *, int, int, int, int, double *,
+                                        double *, double *, double *,
+                                        double *, double *, double *);
 void   check_files(filep_struct *, filenames_struct *);
 FILE  *check_state_file(char *, dmy_struct *, global_param_struct *, int, int, 
                         int *);
@@ -231,12 +301,14 @@ void   compute_soil_layer_thermal_properties(layer_data_struct *, double *,
                                              double *, int);
 void   compute_treeline(atmos_data_struct *, dmy_struct *, double, double *, char *);
 double compute_zwt(soil_con_struct *, int, double);
+out_data_file_struct *copy_out_data_files(out_data_file_struct *);
+out_data_struct *copy_output_list(out_data_struct *);
 out_data_struct *create_output_list();
 
 double darkinhib(double);
 void   display_current_settings(int, filenames_struct *, global_param_struct *);
 int  distribute_node_moisture_properties(double *, double *, double *, 
-					 double *, double *, double *,
+					 double *, node_layer_struct *, double *,
 					 double *, double *, double *,
 					 double *, double *, double *, double *, double *,
 					 double *, double *, double *, int, int, char);
@@ -257,10 +329,10 @@ double error_print_solve_T_profile(double, va_list);
 double error_print_surf_energy_bal(double, va_list);
 double error_solve_T_profile(double Tsurf, ...);
 double estimate_dew_point(double, double, double, double, double);
-int estimate_layer_ice_content(layer_data_struct *, double *, double *,
+int estimate_layer_ice_content(layer_data_struct *, node_layer_struct *, double *,
 			       double *, double *, double *, double *,
 			       double *, double *, double *, 
-			       double *, double, int, int, char);
+			       int, int, char);
 int estimate_layer_ice_content_quick_flux(layer_data_struct *, double *,
 					  double, double, double, double,
 					  double *, double *, double *,
@@ -280,6 +352,13 @@ void   fdjac3(double *, double *, double *, double *, double *,
 void   find_0_degree_fronts(energy_bal_struct *, double *, double *, int);
 layer_data_struct find_average_layer(layer_data_struct *, layer_data_struct *,
 				     double, double);
+void   force_disagg(FILE *, filenames_struct *, global_param_struct *,
+                    dmy_struct *, out_data_file_struct *, out_data_struct *);
+void   forcing_cache_init(filenames_struct *);
+int    forcing_cache_key(FILE **, soil_con_struct *, unsigned long *);
+int    forcing_cache_load(unsigned long, atmos_data_struct *);
+void   forcing_cache_store(unsigned long, atmos_data_struct *);
+void   forcing_cache_summary();
 void   free_atmos(int nrecs, atmos_data_struct **atmos);
 void   free_all_vars(all_vars_struct *, int);
 void   free_dmy(dmy_struct **dmy);
@@ -290,7 +369,7 @@ void   free_out_data_files(out_data_file_struct **);
 void   free_out_data(out_data_struct **);
 int    full_energy(int, int, atmos_data_struct *, all_vars_struct *,
 		   dmy_struct *, global_param_struct *, lake_con_struct *,
-                   soil_con_struct *, veg_con_struct *, veg_hist_struct **);
+                   soil_con_struct *, veg_con_struct *, veg_hist_struct *);
 double func_atmos_energy_bal(double, va_list);
 double func_atmos_moist_bal(double, va_list);
 double func_canopy_energy_bal(double, va_list);
@@ -320,6 +399,16 @@ void   initialize_soil(cell_data_struct **, soil_con_struct *, veg_con_struct *,
 void   initialize_veg( veg_var_struct **, veg_con_struct *,
 		       global_param_struct *, int);
 
+int    kernel_arg_size(int);
+void   kernel_capture_close();
+void   kernel_capture_init(filenames_struct *);
+int    kernel_id(char *);
+double kernel_invoke(int, kernel_arg_struct *);
+char  *kernel_name(int);
+int    kernel_read_header(FILE *);
+int    kernel_read_record(FILE *, int *, char *, int *, kernel_arg_struct *,
+                          void **, double *);
+
 void   latent_heat_from_snow(double, double, double, double, double, 
                              double, double, double *, double *, 
                              double *, double *, double *);
@@ -331,16 +420,27 @@ dmy_struct *make_dmy(global_param_struct *);
 energy_bal_struct **make_energy_bal(int);
 void make_in_and_outfiles(filep_struct *, filenames_struct *, 
 			  soil_con_struct *, out_data_file_struct *);
+void make_in_files(filep_struct *, filenames_struct *, soil_con_struct *);
 snow_data_struct **make_snow_data(int);
 veg_var_struct **make_veg_var(int);
 void   MassRelease(double *,double *,double *,double *);
 double maximum_unfrozen_water(double, double, double, double);
+void  *mem_calloc(size_t, size_t, int);
+void   mem_charge(int, long);
+void   mem_free(void *, int);
+void  *mem_malloc(size_t, int);
+void   mem_stats_end_cell(int, soil_con_struct *);
+void   mem_stats_init(filenames_struct *);
+void   mem_stats_start_cell();
+void   mem_stats_summary();
 double modify_Ksat(double);
 void mtclim_wrapper(int, int, double, double, double, double,
                       double, double, double, double,
                       int, dmy_struct *, double *,
                       double *, double *, double *, double *, double *, double *);
 
+void   netcdf_forcing_close();
+void   netcdf_forcing_init(filenames_struct *, global_param_struct *, filep_struct *);
 double new_snow_density(double);
 int    newt_raph(void (*vecfunc)(double *, double *, int, int, ...), 
                double *, int);
@@ -348,12 +448,23 @@ void   nrerror(char *);
 
 FILE  *open_file(char string[], char type[]);
 FILE  *open_state_file(global_param_struct *, filenames_struct, int, int);
+void   out_stats_accumulate(out_data_struct *, dmy_struct *);
+int    out_stats_add_var(out_data_struct *, char *);
+void   out_stats_end_cell(out_data_struct *, soil_con_struct *);
+void   out_stats_free();
+void   out_stats_init(filenames_struct *, global_param_struct *, out_data_struct *, dmy_struct *);
+int    out_stats_set_quantiles(char *);
+void   out_stats_start_cell();
 
 void parse_output_info(filenames_struct *, FILE *, out_data_file_struct **, out_data_struct *);
 double penman(double, double, double, double, double, double, double);
 void photosynth(char, double, double, double, double, double, double,
                 double, double, double, char *, double *, double *,
                 double *, double *, double *);
+void   prefetch_end();
+double **prefetch_forcing_data(double ****, int *);
+soil_con_struct prefetch_next_cell(char *, char *);
+void   prefetch_start(FILE *, filenames_struct *, global_param_struct *);
 void   prepare_full_energy(int, int, int, all_vars_struct *, 
 			   soil_con_struct *, double *, double *); 
 int    put_data(all_vars_struct *, atmos_data_struct *,
@@ -388,8 +499,14 @@ void print_veg_con(veg_con_struct *vcon, size_t nroots, char blowing, char lake,
                             char carbon, size_t ncanopy);
 void print_veg_lib(veg_lib_struct *vlib, char carbon);
 void print_veg_var(veg_var_struct *vvar, size_t ncanopy);
-void   read_atmos_data(FILE *, global_param_struct, int, int, double **, double ***);
-double **read_forcing_data(FILE **, global_param_struct, double ****);
+void   progress_done();
+void   progress_end_cell();
+void   progress_init(FILE *, filenames_struct *, global_param_struct *);
+void   progress_start_cell(int);
+void   progress_step(int);
+void   read_atmos_data(FILE *, global_param_struct, int, int, int, double **, double ***);
+double **read_forcing_data(FILE **, global_param_struct, double, double, int, double ****);
+void   read_netcdf_forcing(int, double, double, global_param_struct, int, double **);
 void   read_initial_model_state(FILE *, all_vars_struct *, 
 				global_param_struct *, int, int, int, 
 				soil_con_struct *, lake_con_struct);
@@ -397,16 +514,35 @@ void   read_snowband(FILE *, soil_con_struct *);
 soil_con_struct read_soilparam(FILE *, char *, char *);
 veg_lib_struct *read_veglib(FILE *, int *);
 veg_con_struct *read_vegparam(FILE *, int, int);
+void   region_accumulate(out_data_struct *, dmy_struct *, soil_con_struct *);
+int    region_add_var(out_data_struct *, char *);
+void   region_end_cell(soil_con_struct *);
+void   region_init(filenames_struct *, global_param_struct *, out_data_struct *);
+void   region_start_cell(soil_con_struct *);
+void   region_write(filenames_struct *, out_data_struct *);
 void   redistribute_moisture(layer_data_struct *, double *, double *,
 			     double *, double *, double *, int);
+void   rewind_file(FILE *);
 double root_brent(double, double, char *, double (*Function)(double, va_list), ...);
+void   route_accumulate(out_data_struct *, dmy_struct *, int);
+void   route_end_cell(soil_con_struct *);
+void   route_init(filenames_struct *, global_param_struct *);
+void   route_start_cell();
+void   route_write(filenames_struct *);
 int    runoff(cell_data_struct *, energy_bal_struct *, soil_con_struct *,
-              double, double *, int, int, int, int, int);
+              double *, int, int, int, int, int);
+
+void   shm_output_accumulate(out_data_struct *, dmy_struct *, soil_con_struct *);
+int    shm_output_add_var(out_data_struct *, char *);
+void   shm_output_close();
+void   shm_output_init(filenames_struct *, global_param_struct *, out_data_struct *);
 
 void set_max_min_hour(double *, int, int *, int *);
 void set_node_parameters(double *, double *, double *, double *, double *, double *,
 			 double *, double *, double *, double *, double *,
 			 double *, double *, int, int, char);
+void set_node_layer_weights(node_layer_struct *, double *, double *, double *,
+			    double, int, int);
 out_data_file_struct *set_output_defaults(out_data_struct *);
 int set_output_var(out_data_file_struct *, int, int, out_data_struct *, char *, int, char *, int, float);
 double snow_albedo(double, double, double, double, double, double, int, char);
@@ -435,10 +571,10 @@ void   soil_carbon_balance(soil_con_struct *, energy_bal_struct *,
 double soil_conductivity(double, double, double, double, double, double, double, double);
 double soil_thermal_eqn(double, va_list);
 double solve_snow(char, double, double, double, double, double,
-                  double, double, double, double, double, double,
+                  double, double, double, double, double,
+                  double *, double *, double *, double *, double *,
                   double *, double *, double *, double *, double *,
                   double *, double *, double *, double *, double *,
-                  double *, double *, double *, double *, double *, double *,
                   double *, double *, double *, double *, double *, double *,
                   double *, double *, double *, double *, double *, double *,
                   float *, int, int, int, int, int, int, int, int, int, int *,
@@ -467,7 +603,8 @@ int    surface_fluxes(char, double, double, double, double,
                       double *, double *, double *, double *, 
                       double *, double *, double *, double *, double *,
 		      float *, int, int, int, int, int, 
-                      int, int, int, atmos_data_struct *, dmy_struct *, 
+                      int, int, int, atmos_data_struct *,
+                      band_forcing_struct *, dmy_struct *, 
                       energy_bal_struct *, global_param_struct *, 
                       cell_data_struct *, 
                       snow_data_struct *, soil_con_struct *, 
@@ -475,6 +612,15 @@ int    surface_fluxes(char, double, double, double, double,
 double svp(double);
 double svp_slope(double);
 
+void   timer_end_cell(int, soil_con_struct *);
+double timer_get(int);
+void   timer_init(filenames_struct *);
+char  *timer_name(int);
+long   timer_peak_rss();
+void   timer_start(int);
+void   timer_stop(int);
+void   timer_summary();
+
 void transpiration(layer_data_struct *, veg_var_struct *, int, int, double, double, double, 
 		   double, double, double, double, double, double, 
 		   double *, double *, double *, double *, double *,
@@ -491,6 +637,10 @@ double volumetric_heat_capacity(double,double,double,double);
 void wrap_compute_zwt(soil_con_struct *, cell_data_struct *);
 void write_data(out_data_file_struct *, out_data_struct *, dmy_struct *, int);
 void write_forcing_file(atmos_data_struct *, int, out_data_file_struct *, out_data_struct *);
+void write_queue_close(out_data_file_struct *);
+void write_queue_end();
+void write_queue_push(out_data_file_struct *, out_data_struct *, dmy_struct *, int);
+void write_queue_start(out_data_struct *);
 void write_header(out_data_file_struct *, out_data_struct *, dmy_struct *, global_param_struct);
 void write_layer(layer_data_struct *, int, int, 
                  double *, double *);
@@ -148,6 +148,37 @@
   2014-Apr-25 Added partial vegcover fraction.				TJB
   2014-May-05 Moved constants CLOSURE, RSMAX, and VPDMINFACTOR from
 	      penman.c to here.						TJB
+  2026-Oct-17 Added TIMING option, timer ids, and filenames.timing.	KM
+  2026-Oct-17 Added kernel capture options, kernel ids, and
+	      kernel_arg_struct.					KM
+  2026-Oct-17 Added filenames.cell_log and solver_stats_struct.	KM
+  2026-Oct-17 Added PROGRESS option and filenames.progress.		KM
+  2026-Oct-17 Added MEM_STATS option, memory subsystem ids, and
+	      filenames.mem_stats.					KM
+  2026-Oct-17 Added REGION_ONLY option, filenames.region_map and
+	      filenames.region_prefix.					KM
+  2026-Oct-17 Added MEM_ROUTING, filenames.route_*, and routing
+	      velocity and diffusivity.					KM
+  2026-Oct-17 Added STAT_ONLY option and filenames.stat_prefix.	KM
+  2026-Oct-17 Added FORCING_CACHE_MAX option and filenames.forcing_cache.	KM
+  2026-Oct-17 Added FORCE_THREADS option.				KM
+  2026-Oct-17 Added FORCE_PRECISION option.				KM
+  2026-Oct-17 Added NETCDF forcing format, param_set.FORCE_VAR, and
+	      NETCDF_CACHE_MAX option.					KM
+  2026-Oct-17 Added PREFETCH_DEPTH option.				KM
+  2026-Oct-17 Added WRITE_QUEUE option.				KM
+  2026-Oct-17 Added ARROW_OUTPUT option.				KM
+  2026-Oct-17 Added SHM_SLOTS option and filenames.shm_name.		KM
+  2026-Oct-17 Added lake_con.volume (lake hypsometry table).		KM
+  2026-Oct-17 Added SOIL_T_SOLVER option and soil temperature solver
+	      counters in solver_stats_struct.				KM
+  2026-Oct-17 Added node_layer_struct (thermal node to soil layer
+	      mapping) and soil_con.node_layer.				KM
+  2026-Oct-17 Added SNOW_STEP_ADAPT option and merged snow step
+	      counters in solver_stats_struct.				KM
+  2026-Oct-17 Added PET_OUTPUT option.					KM
+  2026-Oct-17 Added IMPLICIT_JACOBIAN option.				KM
+  2026-Oct-17 Added band_forcing_struct.				KM
 *********************************************************************/
 #include <snow.h>
 
@@ -185,6 +216,8 @@
 /***** Met file formats *****/
 #define ASCII 1
 #define BINARY 2
+#define NETCDF 3
+#define MAX_FORCE_VARNAME 128	/* maximum length of a NETCDF variable name */
 
 /***** Snow Density parametrizations *****/
 #define DENS_BRAS   0
@@ -222,6 +255,67 @@
 #define LW_CLOUD_BRAS       0
 #define LW_CLOUD_DEARDORFF  1
 
+/***** Forcing storage precision options *****/
+#define FORCE_PREC_DOUBLE 0
+#define FORCE_PREC_FLOAT  1
+#define FORCE_PREC_SHORT  2
+
+/***** Timing options *****/
+#define TIMING_NONE  0
+#define TIMING_CELL  1
+#define TIMING_PHASE 2
+
+/***** Timed phases (see timing.c) *****/
+#define TIMER_CELL            0
+#define TIMER_READ_PARAM      1
+#define TIMER_FILES           2
+#define TIMER_INIT_ATMOS      3
+#define TIMER_READ_FORCING    4
+#define TIMER_MTCLIM          5
+#define TIMER_INIT_STATE      6
+#define TIMER_FULL_ENERGY     7
+#define TIMER_SURFACE_FLUXES  8
+#define TIMER_SOLVE_SNOW      9
+#define TIMER_SURF_ENERGY_BAL 10
+#define TIMER_SOLVE_T_PROFILE 11
+#define TIMER_RUNOFF          12
+#define TIMER_SOLVE_LAKE      13
+#define TIMER_PUT_DATA        14
+#define TIMER_WRITE_DATA      15
+#define N_TIMERS              16
+
+/***** Captured kernels (see kernel_capture.c) *****/
+#define KERNEL_T_PROFILE          0
+#define KERNEL_T_PROFILE_IMPLICIT 1
+#define KERNEL_SNOW_MELT          2
+#define KERNEL_BLOWING_SNOW       3
+#define KERNEL_SOLVE_LAKE         4
+#define N_KERNELS                 5
+#define MAX_KERNEL_ARGS           48
+
+/***** Memory accounting subsystems (see mem_stats.c) *****/
+#define MEM_ATMOS        0  /* atmos_data_struct arrays (alloc_atmos) */
+#define MEM_VEG_HIST     1  /* veg_hist_struct arrays (alloc_veg_hist) */
+#define MEM_DMY          2  /* date structure (make_dmy) */
+#define MEM_FORCING      3  /* forcing data and disaggregation work arrays */
+#define MEM_MTCLIM       4  /* MTCLIM buffers */
+#define MEM_MODEL_STATE  5  /* cell, veg_var, energy, and snow structures */
+#define MEM_LAKE         6  /* lake structures */
+#define MEM_OUTPUT       7  /* output variable arrays */
+#define MEM_ROUTING      8  /* routing grids and hydrographs */
+#define N_MEM_SUBSYS     9
+
+/***** Captured kernel argument types *****/
+#define KARG_DOUBLE   0
+#define KARG_FLOAT    1
+#define KARG_INT      2
+#define KARG_CHAR     3
+#define KARG_SNOW     4  /* snow_data_struct */
+#define KARG_LAKE     5  /* lake_var_struct */
+#define KARG_LAKE_CON 6  /* lake_con_struct */
+#define KARG_SOIL_CON 7  /* soil_con_struct */
+#define KARG_DMY      8  /* dmy_struct */
+
 /***** Potential Evap types *****/
 #define N_PET_TYPES 6
 #define N_PET_TYPES_NON_NAT 4
@@ -244,6 +338,14 @@
 #define RC_JARVIS 0
 #define RC_PHOTO  1
 
+/***** Soil temperature profile solvers (explicit scheme) *****/
+#define SOIL_T_GS     0
+#define SOIL_T_NEWTON 1
+
+/***** Jacobians of the implicit soil temperature solution *****/
+#define IMPL_JAC_NODE    0
+#define IMPL_JAC_GROUPED 1
+
 /***** Photosynthesis parametrizations *****/
 #define PS_FARQUHAR 1
 #define PS_MONTEITH 2
@@ -698,15 +800,29 @@ typedef struct {
 } filep_struct;
 
 typedef struct {
+  char  cell_log[MAXSTRING];    /* per-cell cost log file name */
   char  forcing[2][MAXSTRING];  /* atmospheric forcing data file names */
+  char  forcing_cache[MAXSTRING]; /* forcing cache directory */
   char  f_path_pfx[2][MAXSTRING];  /* path and prefix for atmospheric forcing data file names */
   char  global[MAXSTRING];      /* global control file name */
   char  init_state[MAXSTRING];  /* initial model state file name */
+  char  kernel[MAXSTRING];      /* kernel capture file name */
   char  lakeparam[MAXSTRING];   /* lake model constants file */
+  char  mem_stats[MAXSTRING];   /* per-cell memory table file name */
+  char  progress[MAXSTRING];    /* progress status file name */
+  char  region_map[MAXSTRING];  /* cell to region weight map file name */
+  char  region_prefix[MAXSTRING]; /* prefix of the region output files */
+  char  route_flowdir[MAXSTRING]; /* routing flow direction grid file name */
+  char  route_fraction[MAXSTRING]; /* routing contributing fraction grid file name */
+  char  route_stations[MAXSTRING]; /* routing station list file name */
+  char  route_uh[MAXSTRING];     /* routing within-cell unit hydrograph file name */
+  char  shm_name[MAXSTRING];     /* shared-memory output object name */
+  char  stat_prefix[MAXSTRING];  /* prefix of the statistics output files */
   char  result_dir[MAXSTRING];  /* directory where results will be written */
   char  snowband[MAXSTRING];    /* snow band parameter file name */
   char  soil[MAXSTRING];        /* soil parameter file name */
   char  statefile[MAXSTRING];   /* name of file in which to store model state */
+  char  timing[MAXSTRING];      /* per-cell timing table file name */
   char  veg[MAXSTRING];         /* vegetation grid coverage file */
   char  veglib[MAXSTRING];      /* vegetation parameter library file */
 } filenames_struct;
@@ -765,6 +881,11 @@ typedef struct {
                             "GF_410"  = use formulas from VIC 4.1.0 */
   char   IMPLICIT;       /* TRUE = Use implicit solution when computing 
 			    soil thermal fluxes */
+  char   IMPLICIT_JACOBIAN; /* Jacobian of the implicit solution;
+                            IMPL_JAC_NODE = one residual evaluation per
+                            node (default)
+                            IMPL_JAC_GROUPED = one evaluation per group
+                            of every third node */
   char   JULY_TAVG_SUPPLIED; /* If TRUE and COMPUTE_TREELINE is also true,
 			        then average July air temperature will be read
 			        from soil file and used in calculating treeline */
@@ -805,6 +926,13 @@ typedef struct {
 			    snow model */
   int    SNOW_STEP;      /* Time step in hours to use when solving the 
 			    snow model */
+  char   SNOW_STEP_ADAPT; /* TRUE = solve consecutive SNOW_STEPs as one
+                            step while the snowpack is cold and dry */
+  char   SOIL_T_SOLVER;  /* Solver of the explicit (IMPLICIT = FALSE)
+                            soil temperature profile;
+                            SOIL_T_GS = Gauss-Seidel iteration (default)
+                            SOIL_T_NEWTON = Newton's method on the whole
+                            profile */
   int    SPATIAL_FROST;  /* TRUE = use a uniform distribution to simulate the
                             spatial distribution of soil frost; FALSE = assume
                             that the entire grid cell is frozen uniformly. */
@@ -831,7 +959,19 @@ typedef struct {
   // input options
   char   ALMA_INPUT;     /* TRUE = input variables are in ALMA-compliant units; FALSE = standard VIC units */
   char   BASEFLOW;       /* ARNO: read Ds, Dm, Ws, c; NIJSSEN2001: read d1, d2, d3, d4 */
+  int    FORCING_CACHE_MAX; /* maximum size [MB] of the forcing cache;
+                            0 = no limit (default) */
+  char   FORCE_PRECISION;/* FORCE_PREC_DOUBLE = keep the forcings and veg
+                            history in double precision (default)
+                            FORCE_PREC_FLOAT = store them as float
+                            FORCE_PREC_SHORT = store them as 16-bit integers
+                            scaled over each field's range in the cell */
   int    GRID_DECIMAL;   /* Number of decimal places in grid file extensions */
+  int    NETCDF_CACHE_MAX; /* maximum size [MB] of the chunk cache of each
+                            variable of a NETCDF forcing file */
+  int    PREFETCH_DEPTH; /* number of cells whose inputs are read ahead of
+                            the cell loop by a background thread;
+                            0 = no read-ahead (default) */
   char   VEGLIB_PHOTO;   /* TRUE = veg library contains photosynthesis parameters */
   char   VEGLIB_VEGCOVER;/* TRUE = veg library file contains monthly vegcover values */
   char   VEGPARAM_ALB;   /* TRUE = veg param file contains monthly albedo values */
@@ -853,18 +993,48 @@ typedef struct {
 
   // output options
   char   ALMA_OUTPUT;    /* TRUE = output variables are in ALMA-compliant units; FALSE = standard VIC units */
+  char   ARROW_OUTPUT;   /* TRUE = output files are Arrow IPC files holding
+                            all cells, not per-cell ASCII or binary files */
   char   BINARY_OUTPUT;  /* TRUE = output files are in binary, not ASCII */
   char   COMPRESS;       /* TRUE = Compress all output files */
   char   MOISTFRACT;     /* TRUE = output soil moisture as fractional moisture content */
+  int    FORCE_THREADS;  /* number of threads that disaggregate the forcings
+                            of different cells at once when OUTPUT_FORCE
+                            is TRUE; 1 = serial (default) */
   int    Noutfiles;      /* Number of output files (not including state files) */
   char   OUTPUT_FORCE;   /* TRUE = perform disaggregation of forcings, skip
                             the simulation, and output the disaggregated
                             forcings. */
+  char   PET_OUTPUT;     /* TRUE = an OUT_PET_* variable is written (as an
+                            OUTVAR, REGIONVAR, SHMVAR or STATVAR), so potential
+                            evap is computed for the reference surfaces; set
+                            by parse_output_info(), not by the user */
   char   PRT_HEADER;     /* TRUE = insert header at beginning of output file; FALSE = no header */
   char   PRT_SNOW_BAND;  /* TRUE = print snow parameters for each snow band. This is only used when default
 				   output files are used (for backwards-compatibility); if outfiles and
 				   variables are explicitly mentioned in global parameter file, this option
 				   is ignored. */
+  char   REGION_ONLY;    /* TRUE = write only the region output files (REGION_MAP),
+                            not the per-cell output files */
+  int    SHM_SLOTS;      /* number of records in the shared-memory output
+                            ring (SHM_NAME) */
+  char   STAT_ONLY;      /* TRUE = write only the statistics output files (STATVAR),
+                            not the per-cell output files */
+  int    WRITE_QUEUE;    /* number of output records queued for the output
+                            writer thread; 0 = write inline (default) */
+
+  // diagnostic options
+  char   TIMING;         /* TIMING_NONE = no timers (default)
+                            TIMING_CELL = time cell-level phases
+                            TIMING_PHASE = also time physics phases */
+  int    KERNEL_CAPTURE; /* bit mask (1 << KERNEL_*) of the kernels whose
+                            inputs and outputs are captured; 0 = none (default) */
+  int    KERNEL_MAX;     /* maximum number of records captured per kernel */
+  int    KERNEL_SAMPLE;  /* capture one out of every KERNEL_SAMPLE calls
+                            to each kernel */
+  int    PROGRESS;       /* interval [s] between progress reports;
+                            0 = no progress reports (default) */
+  char   MEM_STATS;      /* TRUE = account for memory by subsystem */
 } option_struct;
 
 /*******************************************************
@@ -887,9 +1057,11 @@ typedef struct {
   int  FORCE_DT[2];     /* forcing file time step */
   int  FORCE_ENDIAN[2]; /* endian-ness of input file, used for
 			   DAILY_BINARY format */
-  int  FORCE_FORMAT[2]; /* ASCII or BINARY */
+  int  FORCE_FORMAT[2]; /* ASCII, BINARY, or NETCDF */
   int  FORCE_INDEX[2][N_FORCING_TYPES];
   int  N_TYPES[2];
+  char FORCE_VAR[N_FORCING_TYPES][MAX_FORCE_VARNAME]; /* name of each forcing
+			   type's variable in a NETCDF forcing file */
 } param_set_struct;
 
 /*******************************************************
@@ -900,6 +1072,8 @@ typedef struct {
   double MIN_RAIN_TEMP; /* minimum temperature at which rain can fall (C) */
   double measure_h;  /* height of measurements (m) */
   double wind_h;     /* height of wind measurements (m) */ 
+  double route_velocity;  /* routing wave velocity (m/s) */
+  double route_diffusion; /* routing diffusivity (m^2/s) */
   float  resolution; /* Model resolution (degrees) */
   int    dt;         /* Time step in hours (24/dt must be an integer) */
   int    out_dt;     /* Output time step in hours (24/out_dt must be an integer) */
@@ -923,6 +1097,24 @@ typedef struct {
   int    stateyear;  /* Year of the simulation at which to save model state */
 } global_param_struct;
 
+/***********************************************************
+  This structure stores the mapping between the soil thermal
+  nodes and the soil moisture layers of a grid cell, which is
+  fixed once the node depths are set (set_node_layer_weights()).
+  ***********************************************************/
+typedef struct {
+  int      lidx[MAX_NODES];           /* soil layer in which each node falls */
+  char     boundary[MAX_NODES];       /* TRUE if node lies on the boundary between layers lidx and lidx+1 */
+  char     below[MAX_NODES];          /* TRUE if node lies below the bottom soil layer */
+  int      min_nidx[MAX_LAYERS];      /* node at or above the top of each layer */
+  int      max_nidx[MAX_LAYERS];      /* node at or below the bottom of each layer (Nnodes if the nodes do not reach it) */
+  double   ftop[MAX_LAYERS];          /* position of the top of each layer between nodes min_nidx and min_nidx+1 (negative if the top is on node min_nidx) */
+  double   fbot[MAX_LAYERS];          /* position of the bottom of each layer between nodes max_nidx-1 and max_nidx (negative if the bottom is on node max_nidx) */
+  double   dz[MAX_LAYERS][MAX_NODES]; /* width of the interval from the top of each layer (min_nidx) or a node within it to the next node within it or its bottom (max_nidx) (m) */
+  double   frost_pos[MAX_FROST_AREAS]; /* position of each frost area within the frost distribution (fraction) */
+  double   frost_slope;               /* slope of frost distribution (C) */
+} node_layer_struct;
+
 /***********************************************************
   This structure stores the soil parameters for a grid cell.
   ***********************************************************/
@@ -964,6 +1156,7 @@ typedef struct {
   double   frost_fract[MAX_FROST_AREAS]; /* spatially distributed frost coverage fractions */
   double   frost_slope;               /* slope of frost distribution */
   double   gamma[MAX_NODES];          /* thermal solution constant */
+  node_layer_struct node_layer;       /* mapping between thermal nodes and soil layers */
   double   init_moist[MAX_LAYERS];    /* initial layer moisture level (mm) */
   double   max_infil;                 /* maximum infiltration rate */
   double   max_moist[MAX_LAYERS];     /* maximum moisture content (mm) per layer */
@@ -1100,6 +1293,22 @@ typedef struct {
   double *wind;      /* wind speed (m/s) */
 } atmos_data_struct;
 
+/***************************************************************************
+   This structure stores the forcing of each snow band for all SNOW_STEPs of
+   the current model step, as computed by band_forcing() once per grid cell
+   and time step.  Element [i][band] is the value of atmos element i lapsed
+   to the band; rainfall and snowfall are gauge corrected.  Bands are the
+   fastest varying index, so that a time step is processed across all bands
+   at once.
+***************************************************************************/
+typedef struct {
+  char   active[MAX_BANDS];  /* TRUE if the band has a non-zero area */
+  double Tair[HOURSPERDAY+1][MAX_BANDS];     /* air temperature (C) */
+  double prec[HOURSPERDAY+1][MAX_BANDS];     /* precipitation (mm) */
+  double rainfall[HOURSPERDAY+1][MAX_BANDS]; /* rainfall (mm) */
+  double snowfall[HOURSPERDAY+1][MAX_BANDS]; /* snowfall (mm) */
+} band_forcing_struct;
+
 /*************************************************************************
   This structure stores information about the time and date of the current
   time step.
@@ -1327,6 +1536,7 @@ typedef struct {
   double z[MAX_LAKE_NODES+1];     /* Elevation of each lake node (when lake storage is at maximum), relative to lake's deepest point (m) */  
   double basin[MAX_LAKE_NODES+1]; /* Area of lake basin at each lake node (when lake storage is at maximum) (m^2) */
   double Cl[MAX_LAKE_NODES+1];    /* Fractional coverage of lake basin at each node (when lake storage is at maximum) (fraction of grid cell area) */
+  double volume[MAX_LAKE_NODES+1]; /* Lake volume when the depth of liquid water is z[i] (m^3); computed by compute_lake_volumes() */
   double b;                       /* Exponent in default lake depth-area profile (y=Ax^b) */
   double maxdepth;                /* Maximum allowable depth of liquid portion of lake (m) */
   double mindepth;                /* Minimum allowable depth of liquid portion of lake (m) */
@@ -1476,3 +1686,34 @@ typedef struct {
   veg_var_struct    *veg_var;
 } Error_struct;
 
+
+/********************************************************
+  This structure describes one argument of a captured
+  kernel call (see kernel_capture.c).
+  ********************************************************/
+typedef struct {
+  char   type;       /* argument type (KARG_DOUBLE, KARG_SNOW, etc.) */
+  char   out;        /* TRUE = argument is modified by the kernel */
+  int    n;          /* number of elements */
+  void  *ptr;        /* location of the first element */
+} kernel_arg_struct;
+
+/********************************************************
+  This structure counts the effort spent in the iterative
+  solvers during the current cell (see cell_stats.c).
+  ********************************************************/
+typedef struct {
+  long   root_brent_calls;  /* number of calls to root_brent() */
+  long   root_brent_iter;   /* number of root_brent() search iterations */
+  long   newt_raph_calls;   /* number of calls to newt_raph() */
+  long   newt_raph_iter;    /* number of newt_raph() Newton iterations */
+  long   soil_T_calls;      /* number of explicit soil T profile solutions */
+  long   soil_T_iter;       /* number of their Gauss-Seidel sweeps and
+                               Newton iterations */
+  long   soil_T_fallbacks;  /* number of Newton solutions that failed and
+                               fell back to Gauss-Seidel */
+  long   snow_merged;       /* number of merged snow steps (SNOW_STEP_ADAPT) */
+  long   snow_merged_substeps; /* number of SNOW_STEPs they covered */
+  long   snow_rejected;     /* number of merged snow steps rejected and
+                               solved at SNOW_STEP */
+} solver_stats_struct;
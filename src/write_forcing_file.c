@@ -29,6 +29,8 @@ void write_forcing_file(atmos_data_struct *atmos,
   2013-Jul-25 Added OUT_CATM, OUT_COSZEN, OUT_FDIR, and OUT_PAR.	TJB
   2013-Dec-27 Moved OUTPUT_FORCE to options_struct.					TJB
   2014-Apr-02 Fixed uninitialized dummy variables.					TJB
+  2026-Oct-17 Records are queued for the writer thread if
+	      WRITE_QUEUE > 0.						KM
 **********************************************************************/
 {
   extern global_param_struct global_param;
@@ -98,7 +100,10 @@ void write_forcing_file(atmos_data_struct *atmos,
           }
         }
       }
-      write_data(out_data_files, out_data, dummy_dmy, global_param.dt);
+      if (options.WRITE_QUEUE > 0)
+        write_queue_push(out_data_files, out_data, dummy_dmy, global_param.dt);
+      else
+        write_data(out_data_files, out_data, dummy_dmy, global_param.dt);
     }
   }
 
@@ -0,0 +1,280 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+/**********************************************************************
+  write_queue.c		Keith Mathews			October 2026
+
+  Output writer thread.  When WRITE_QUEUE is greater than 0, vicNl.c
+  calls write_queue_start() before the cell loop, and put_data() (and
+  write_forcing_file(), when OUTPUT_FORCE is TRUE) hand each aggregated
+  output record to write_queue_push() instead of writing it with
+  write_data().  The record (the aggdata of all output variables, the
+  date, and the output file handles) is copied into a ring of
+  WRITE_QUEUE records, and a writer thread formats and writes the
+  records with write_data(), in the order in which they were pushed.
+  close_files() passes the output files of a cell to write_queue_close(),
+  and the writer thread closes them (and compresses them, if COMPRESS
+  is TRUE) after the cell's last record.  The simulation only waits for
+  the writer when the ring is full, so the output files are identical
+  to those written without the queue.
+
+  The ring has one producer (the cell loop) and one consumer (the
+  writer thread); records are copied in and written out without holding
+  the lock, which only guards the ring indices.  WRITE_QUEUE > 0 cannot
+  be combined with MEM_STATS, or with FORCE_THREADS > 1 (see
+  get_global_param()).  write_queue_end() waits for the writer thread to
+  write all records, and prints to stderr the time the simulation spent
+  waiting for a free place in the ring and the time the writer thread
+  spent writing.
+
+  Modifications:
+**********************************************************************/
+
+#define WQ_DATA  0 /* write one record */
+#define WQ_CLOSE 1 /* close (and compress) the output files */
+
+typedef struct {
+  int                   kind;  /* WQ_DATA or WQ_CLOSE */
+  dmy_struct            dmy;
+  int                   dt;
+  double               *aggdata; /* aggdata of all output variables */
+  out_data_file_struct *files;   /* copy of the output file list */
+} write_queue_record_struct;
+
+static write_queue_record_struct *queue = NULL; /* ring of records */
+static int                        queue_size = 0;
+static int                        queue_head = 0; /* next record to write */
+static int                        queue_count = 0;
+static int                        queue_closed = FALSE;
+static pthread_mutex_t            queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t             queue_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t             queue_not_full = PTHREAD_COND_INITIALIZER;
+static pthread_t                  writer_thread;
+
+static out_data_struct           *writer_out_data = NULL; /* variable descriptions */
+static int                        offset[N_OUTVAR_TYPES]; /* of each variable in aggdata */
+static int                        nvalues = 0;
+
+/* statistics */
+static int                        nrecords = 0;
+static int                        nstalls = 0;      /* records that waited */
+static double                     push_wait = 0;    /* s the simulation waited */
+static double                     writer_busy = 0;  /* s the writer wrote */
+static double                     writer_idle = 0;  /* s the writer waited */
+
+static double write_queue_now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec);
+}
+
+static void *write_queue_writer(void *arg)
+/* Writes the records of the ring, waiting while it is empty. */
+{
+  extern option_struct options;
+  write_queue_record_struct *rec;
+  int                        v;
+  int                        filenum;
+  double                     t0;
+
+  while (TRUE) {
+
+    pthread_mutex_lock(&queue_lock);
+    t0 = write_queue_now();
+    while (queue_count == 0 && !queue_closed)
+      pthread_cond_wait(&queue_not_empty, &queue_lock);
+    writer_idle += write_queue_now() - t0;
+    if (queue_count == 0) {
+      pthread_mutex_unlock(&queue_lock);
+      break;
+    }
+    rec = &queue[queue_head];
+    pthread_mutex_unlock(&queue_lock);
+
+    t0 = write_queue_now();
+    if (rec->kind == WQ_DATA) {
+      for (v=0; v<N_OUTVAR_TYPES; v++)
+        writer_out_data[v].aggdata = &rec->aggdata[offset[v]];
+      write_data(rec->files, writer_out_data, &rec->dmy, rec->dt);
+    }
+    else {
+      for (filenum=0; filenum<options.Noutfiles; filenum++) {
+        fclose(rec->files[filenum].fh);
+        if (options.COMPRESS) compress_files(rec->files[filenum].filename);
+      }
+    }
+    writer_busy += write_queue_now() - t0;
+
+    pthread_mutex_lock(&queue_lock);
+    queue_head = (queue_head + 1) % queue_size;
+    queue_count--;
+    pthread_cond_signal(&queue_not_full);
+    pthread_mutex_unlock(&queue_lock);
+  }
+
+  return NULL;
+}
+
+static write_queue_record_struct *write_queue_slot()
+/* Returns the next free record of the ring, waiting while it is full. */
+{
+  write_queue_record_struct *rec;
+  double                     t0;
+
+  pthread_mutex_lock(&queue_lock);
+  if (queue_count == queue_size) {
+    nstalls++;
+    t0 = write_queue_now();
+    while (queue_count == queue_size)
+      pthread_cond_wait(&queue_not_full, &queue_lock);
+    push_wait += write_queue_now() - t0;
+  }
+  rec = &queue[(queue_head + queue_count) % queue_size];
+  pthread_mutex_unlock(&queue_lock);
+
+  return rec;
+}
+
+static void write_queue_commit()
+/* Hands the record returned by write_queue_slot() to the writer. */
+{
+  pthread_mutex_lock(&queue_lock);
+  queue_count++;
+  pthread_cond_signal(&queue_not_empty);
+  pthread_mutex_unlock(&queue_lock);
+}
+
+void write_queue_start(out_data_struct *out_data)
+/**********************************************************************
+  write_queue_start	Keith Mathews			October 2026
+
+  Allocates the ring of WRITE_QUEUE records for the output variables
+  of out_data, and starts the writer thread.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int                  v;
+  int                  i;
+
+  writer_out_data = (out_data_struct *)calloc(N_OUTVAR_TYPES, sizeof(out_data_struct));
+  if (writer_out_data == NULL)
+    nrerror("Memory allocation failure in write_queue_start");
+  nvalues = 0;
+  for (v=0; v<N_OUTVAR_TYPES; v++) {
+    writer_out_data[v] = out_data[v];
+    writer_out_data[v].data = NULL;
+    writer_out_data[v].aggdata = NULL;
+    offset[v] = nvalues;
+    nvalues += out_data[v].nelem;
+  }
+
+  queue_size = options.WRITE_QUEUE;
+  queue = (write_queue_record_struct *)calloc(queue_size, sizeof(write_queue_record_struct));
+  if (queue == NULL)
+    nrerror("Memory allocation failure in write_queue_start");
+  for (i=0; i<queue_size; i++) {
+    queue[i].aggdata = (double *)calloc(nvalues, sizeof(double));
+    queue[i].files = (out_data_file_struct *)calloc(options.Noutfiles, sizeof(out_data_file_struct));
+    if (queue[i].aggdata == NULL || queue[i].files == NULL)
+      nrerror("Memory allocation failure in write_queue_start");
+  }
+
+  if (pthread_create(&writer_thread, NULL, write_queue_writer, NULL) != 0)
+    nrerror("Unable to start the output writer thread.");
+}
+
+void write_queue_push(out_data_file_struct *out_data_files,
+                      out_data_struct      *out_data,
+                      dmy_struct           *dmy,
+                      int                   dt)
+/**********************************************************************
+  write_queue_push	Keith Mathews			October 2026
+
+  Queues one output record, with the same arguments as write_data()
+  (dmy is not used, and may be NULL, when OUTPUT_FORCE is TRUE).
+  out_data may be changed as soon as this returns.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  write_queue_record_struct *rec;
+  int                        v;
+
+  rec = write_queue_slot();
+  rec->kind = WQ_DATA;
+  if (dmy != NULL)
+    rec->dmy = *dmy;
+  rec->dt = dt;
+  for (v=0; v<N_OUTVAR_TYPES; v++)
+    memcpy(&rec->aggdata[offset[v]], out_data[v].aggdata,
+           out_data[v].nelem * sizeof(double));
+  memcpy(rec->files, out_data_files, options.Noutfiles * sizeof(out_data_file_struct));
+  nrecords++;
+  write_queue_commit();
+}
+
+void write_queue_close(out_data_file_struct *out_data_files)
+/**********************************************************************
+  write_queue_close	Keith Mathews			October 2026
+
+  Queues the closing (and compression) of the output files, after the
+  records already queued for them.  out_data_files may be reused for
+  the next cell as soon as this returns.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  write_queue_record_struct *rec;
+
+  rec = write_queue_slot();
+  rec->kind = WQ_CLOSE;
+  memcpy(rec->files, out_data_files, options.Noutfiles * sizeof(out_data_file_struct));
+  write_queue_commit();
+}
+
+void write_queue_end()
+/**********************************************************************
+  write_queue_end	Keith Mathews			October 2026
+
+  Waits for the writer thread to write all queued records and close
+  the files, and prints the writer statistics.
+
+  Modifications:
+**********************************************************************/
+{
+  extern option_struct options;
+  int                  i;
+
+  pthread_mutex_lock(&queue_lock);
+  queue_closed = TRUE;
+  pthread_cond_signal(&queue_not_empty);
+  pthread_mutex_unlock(&queue_lock);
+  pthread_join(writer_thread, NULL);
+
+  for (i=0; i<queue_size; i++) {
+    free((char *)queue[i].aggdata);
+    free((char *)queue[i].files);
+  }
+  free((char *)queue);
+  queue = NULL;
+  free((char *)writer_out_data);
+  writer_out_data = NULL;
+
+  fprintf(stderr, "Output writer (WRITE_QUEUE %d): %d records; the simulation "
+          "waited %.2f s for a free place in the queue (%d records); the "
+          "writer thread wrote for %.2f s and waited %.2f s for records\n",
+          options.WRITE_QUEUE, nrecords, push_wait, nstalls, writer_busy,
+          writer_idle);
+}
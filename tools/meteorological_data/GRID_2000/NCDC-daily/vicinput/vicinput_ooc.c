@@ -0,0 +1,479 @@
+/* File:             vicinput_ooc.c                                          */
+/* Programmer :      Keith Mathews                                           */
+/* Date:             October 2026                                            */
+/* Version:          1.0                                                     */
+
+/* Out-of-core version of vicinput.  Reads the same input (the prcp, tmax    */
+/* and tmin grids written by the regridding program, one time step of all    */
+/* valid cells after another, plus the elevation mask) and writes the same   */
+/* per-cell vicinput files (data_<lat>_<lng>, three values per time step,    */
+/* 2-byte signed binary or ASCII), with the same corrections (tmax and tmin  */
+/* swapped if tmax < tmin, negative prcp reset to 0).  The output files are  */
+/* byte-for-byte identical to those of vicinput.                             */
+/*                                                                           */
+/* vicinput reads 50 time steps at a time, and then reopens every cell file  */
+/* in append mode to add them, so that for long records over large domains   */
+/* nearly all of its time is spent opening files and making small writes.    */
+/* This program instead works in two passes over bounded memory:             */
+/*                                                                           */
+/*  1. The grids are read in blocks of as many time steps as fit in the      */
+/*     memory limit.  Each block is transposed to cell-major order           */
+/*     ([cell][step][variable]) and appended to a temporary spill file.      */
+/*  2. The cells are processed in groups of as many complete series as fit   */
+/*     in the memory limit.  The part of each block belonging to the group   */
+/*     is contiguous in the spill file, so a group is gathered with one      */
+/*     read per block.  Each cell file is then opened once and written in    */
+/*     one sequential pass.                                                  */
+/*                                                                           */
+/* If the whole record fits in the memory limit, no spill file is used.      */
+/* The reading of the three variables, the transposition, and the writing   */
+/* of the cell files are spread over several threads.                       */
+/*                                                                           */
+/* Usage:                                                                    */
+/*   vicinput_ooc prcp tmax tmin elev_mask out_dir binflag                   */
+/*                [-m mem_MB] [-t nthreads] [-T tmp_dir]                     */
+/*                                                                           */
+/*   binflag=1 means input and output are in 2-byte (signed) binary format,  */
+/*   with the multipliers applied by the regridding program (the matching    */
+/*   FORCE_TYPE multipliers must be given in the VIC global file).           */
+/*   mem_MB   memory limit for the data buffers [MB] (default 1024)          */
+/*   nthreads number of threads (default 4)                                  */
+/*   tmp_dir  directory for the spill file (default out_dir)                 */
+/*                                                                           */
+/* Compile with:  gcc -O2 -o vicinput_ooc vicinput_ooc.c -lpthread           */
+
+#define _FILE_OFFSET_BITS 64
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+#define NVARS      3        /* prcp, tmax, tmin */
+#define MAXTHREADS 64
+
+typedef struct {
+  int     binflag;          /* 1 = 2-byte binary, else ASCII */
+  size_t  esize;            /* size of one value in memory */
+  size_t  rsize;            /* size of one record (NVARS values) */
+  int     ncells;
+  long    nsteps;
+  int     nthreads;
+  char  **names;            /* output file names */
+} job_struct;
+
+typedef struct {            /* argument of the worker threads */
+  job_struct *job;
+  int         id;
+  FILE       *fp;           /* input file (read threads) */
+  char       *in;           /* time-major block [var][step][cell] */
+  char       *out;          /* cell-major block [cell][step][var] */
+  long        nb;           /* steps in block */
+  int         c0, c1;       /* cell range */
+  int         g0;           /* first cell stored in out (write threads) */
+  long        nneg;         /* negative prcp values reset */
+  int         error;
+} work_struct;
+
+static void *xcalloc(size_t n, size_t size, char *what)
+{
+  void *p;
+  if ((p = calloc(n, size)) == NULL) {
+    fprintf(stderr, "Memory Allocation error: %s (%lu bytes)\n", what,
+            (unsigned long)(n * size));
+    exit(8);
+  }
+  return p;
+}
+
+static FILE *xfopen(char *name, char *mode)
+{
+  FILE *fp;
+  if ((fp = fopen(name, mode)) == NULL) {
+    fprintf(stderr, "Cannot open file %s \n", name);
+    exit(EXIT_FAILURE);
+  }
+  return fp;
+}
+
+/**************************************************************************/
+/* Reads the mask file and returns the names of the valid cells, in the   */
+/* order (and with the exact arithmetic) of vicinput's make_flist().      */
+static char **read_mask(char *maskfile, int *ncells)
+{
+  FILE  *fp;
+  char   str1[BUFSIZ+1], void_nr[BUFSIZ+1], name[BUFSIZ+1];
+  char **names;
+  int    cols, rows, i, j, n, nmax;
+  float  uplftlat, uplftlong, llftlat, llftlong, resolution, longitude, value;
+  float  high, low;
+
+  fp = xfopen(maskfile, "r");
+  fscanf(fp, "%*s %s", str1);  cols = atoi(str1);
+  fscanf(fp, "%*s %s", str1);  rows = atoi(str1);
+  fscanf(fp, "%*s %s", str1);  llftlong = atof(str1);
+  fscanf(fp, "%*s %s", str1);  llftlat = atof(str1);
+  fscanf(fp, "%*s %s", str1);  resolution = atof(str1);
+  fscanf(fp, "%*s %s", void_nr);
+  high = atof(void_nr) + 0.001;
+  low  = atof(void_nr) - 0.001;
+
+  /* place nodes at center of grid cells */
+  uplftlong = llftlong + (resolution/2);
+  uplftlat  = llftlat + ((float)(rows-1)*resolution) + (resolution/2);
+
+  nmax = 1024;
+  names = (char **)xcalloc(nmax, sizeof(char *), "names");
+  n = 0;
+  for (i = 0; i < rows; i++) {
+    longitude = uplftlong;
+    for (j = 0; j < cols; j++) {
+      if (fscanf(fp, "%s", str1) != 1) {
+        fprintf(stderr, "Mask file %s ends before row %d col %d\n",
+                maskfile, i, j);
+        exit(EXIT_FAILURE);
+      }
+      value = atof(str1);
+      if (value > high || value < low) {
+        if (n == nmax) {
+          nmax *= 2;
+          if ((names = (char **)realloc(names, nmax * sizeof(char *))) == NULL) {
+            fprintf(stderr, "Memory Allocation error: names\n");
+            exit(8);
+          }
+        }
+        sprintf(name, "data_%.4f_%.4f", uplftlat, longitude);
+        names[n++] = strdup(name);
+      }
+      longitude = longitude + resolution;
+    }
+    uplftlat = uplftlat - resolution;
+  }
+  fclose(fp);
+  *ncells = n;
+  return names;
+}
+
+/**************************************************************************/
+/* Returns the number of time steps in an input file.                     */
+static long nr_timesteps(char *file, int ncells, int binflag)
+{
+  FILE  *fp;
+  char   str1[BUFSIZ+1];
+  off_t  n;
+
+  if (binflag == 1) {
+    fp = xfopen(file, "rb");
+    fseeko(fp, 0, SEEK_END);
+    n = ftello(fp) / (off_t)sizeof(short int);
+  }
+  else {
+    fp = xfopen(file, "r");
+    n = 0;
+    while (fscanf(fp, "%s", str1) != EOF) n++;
+  }
+  fclose(fp);
+  return (long)(n / ncells);
+}
+
+/**************************************************************************/
+/* Thread: reads nb time steps of one variable into work->in.             */
+static void *read_var(void *arg)
+{
+  work_struct *w = (work_struct *)arg;
+  job_struct  *job = w->job;
+  size_t       n = (size_t)w->nb * job->ncells, i;
+  float       *f;
+
+  if (job->binflag == 1) {
+    if (fread(w->in, sizeof(short int), n, w->fp) != n)
+      w->error = 1;
+  }
+  else {
+    f = (float *)w->in;
+    for (i = 0; i < n; i++)
+      if (fscanf(w->fp, "%f", &f[i]) != 1) {
+        w->error = 1;
+        break;
+      }
+  }
+  return NULL;
+}
+
+/**************************************************************************/
+/* Thread: transposes cells c0..c1-1 of a block from [var][step][cell] to */
+/* [cell][step][var], swapping tmax and tmin where tmax < tmin and        */
+/* resetting negative prcp to 0.                                          */
+static void *transpose(void *arg)
+{
+  work_struct *w = (work_struct *)arg;
+  job_struct  *job = w->job;
+  long         nc = job->ncells, nb = w->nb, t;
+  int          c;
+
+  if (job->binflag == 1) {
+    short int *in = (short int *)w->in, *out, tmp;
+    for (c = w->c0; c < w->c1; c++) {
+      out = (short int *)w->out + (size_t)c * nb * NVARS;
+      for (t = 0; t < nb; t++, out += NVARS) {
+        out[0] = in[(0*nb + t)*nc + c];
+        out[1] = in[(1*nb + t)*nc + c];
+        out[2] = in[(2*nb + t)*nc + c];
+        if (out[1] < out[2]) { tmp = out[1]; out[1] = out[2]; out[2] = tmp; }
+        if (out[0] < 0) { out[0] = 0; w->nneg++; }
+      }
+    }
+  }
+  else {
+    float *in = (float *)w->in, *out, tmp;
+    for (c = w->c0; c < w->c1; c++) {
+      out = (float *)w->out + (size_t)c * nb * NVARS;
+      for (t = 0; t < nb; t++, out += NVARS) {
+        out[0] = in[(0*nb + t)*nc + c];
+        out[1] = in[(1*nb + t)*nc + c];
+        out[2] = in[(2*nb + t)*nc + c];
+        if (out[1] < out[2]) { tmp = out[1]; out[1] = out[2]; out[2] = tmp; }
+        if (out[0] < 0) { out[0] = 0; w->nneg++; }
+      }
+    }
+  }
+  return NULL;
+}
+
+/**************************************************************************/
+/* Thread: writes the complete series of cells c0..c1-1, stored from cell */
+/* g0 on in work->out, to the output directory (work->in).                */
+static void *write_cells(void *arg)
+{
+  work_struct *w = (work_struct *)arg;
+  job_struct  *job = w->job;
+  char         out[2*BUFSIZ+2];
+  FILE        *fp;
+  char        *series;
+  float       *f;
+  long         t;
+  int          c;
+
+  for (c = w->c0; c < w->c1; c++) {
+    series = w->out + (size_t)(c - w->g0) * job->nsteps * job->rsize;
+    sprintf(out, "%s%s", w->in, job->names[c]);
+    if ((fp = fopen(out, (job->binflag == 1) ? "wb" : "w")) == NULL) {
+      fprintf(stderr, "Cannot open file %s \n", out);
+      w->error = 1;
+      return NULL;
+    }
+    if (job->binflag == 1) {
+      if (fwrite(series, job->rsize, job->nsteps, fp) != (size_t)job->nsteps)
+        w->error = 1;
+    }
+    else {
+      f = (float *)series;
+      for (t = 0; t < job->nsteps; t++, f += NVARS)
+        fprintf(fp, "%4.2f  %4.2f  %4.2f\n", f[0], f[1], f[2]);
+    }
+    if (fclose(fp) != 0) w->error = 1;
+    if (w->error) {
+      fprintf(stderr, "Error writing file %s \n", out);
+      return NULL;
+    }
+  }
+  return NULL;
+}
+
+/**************************************************************************/
+/* Runs func over nthreads contiguous ranges of cells c0..c1-1.           */
+static void run_threads(job_struct *job, void *(*func)(void *),
+                        work_struct *proto, int c0, int c1, long *nneg)
+{
+  pthread_t   tid[MAXTHREADS];
+  work_struct w[MAXTHREADS];
+  int         i, n, per;
+
+  n = job->nthreads;
+  if (n > c1 - c0) n = c1 - c0;
+  if (n < 1) n = 1;
+  per = (c1 - c0 + n - 1) / n;
+  for (i = 0; i < n; i++) {
+    w[i] = *proto;
+    w[i].id = i;
+    w[i].c0 = c0 + i * per;
+    w[i].c1 = (w[i].c0 + per < c1) ? w[i].c0 + per : c1;
+    w[i].nneg = 0;
+    w[i].error = 0;
+    if (pthread_create(&tid[i], NULL, func, &w[i]) != 0) {
+      fprintf(stderr, "Cannot create thread\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+  for (i = 0; i < n; i++) {
+    pthread_join(tid[i], NULL);
+    if (w[i].error) exit(EXIT_FAILURE);
+    if (nneg != NULL) *nneg += w[i].nneg;
+  }
+}
+
+/**************************************************************************/
+int main(int argc, char **argv)
+{
+  job_struct   job;
+  work_struct  proto, rw[NVARS];
+  pthread_t    rtid[NVARS];
+  FILE        *fpin[NVARS], *fpspill = NULL;
+  char        *out_dir, *tmp_dir, spill[2*BUFSIZ+2];
+  char        *in = NULL, *blk = NULL, *gbuf = NULL, *gblk = NULL;
+  char        *varname[NVARS] = { "prcp", "tmax", "tmin" };
+  double       mem;
+  long         bsteps, nblocks, b, nb, t0, nneg = 0, gcells;
+  int          i, v, c0, c1, c, ncells;
+  size_t       blkbytes;
+
+  if (argc < 7) {
+    fprintf(stderr, "Not correct number of commandline arguments \n");
+    fprintf(stderr, "vicinput_ooc \"prcp\" \"tmax\" \"tmin\" \"elev_mask.txt\" "
+            "\"out_dir\" binflag [-m mem_MB] [-t nthreads] [-T tmp_dir]\n");
+    exit(EXIT_FAILURE);
+  }
+  out_dir = argv[5];
+  tmp_dir = out_dir;
+  memset(&job, 0, sizeof(job));
+  job.binflag = atoi(argv[6]);
+  job.nthreads = 4;
+  mem = 1024;
+  for (i = 7; i < argc; i++) {
+    if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) mem = atof(argv[++i]);
+    else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+      job.nthreads = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-T") == 0 && i + 1 < argc) tmp_dir = argv[++i];
+    else {
+      fprintf(stderr, "Unknown option %s \n", argv[i]);
+      exit(EXIT_FAILURE);
+    }
+  }
+  if (job.nthreads < 1) job.nthreads = 1;
+  if (job.nthreads > MAXTHREADS) job.nthreads = MAXTHREADS;
+  if (mem <= 0) {
+    fprintf(stderr, "Memory limit must be positive\n");
+    exit(EXIT_FAILURE);
+  }
+  mem *= 1024. * 1024.;
+
+  job.esize = (job.binflag == 1) ? sizeof(short int) : sizeof(float);
+  job.rsize = NVARS * job.esize;
+  job.names = read_mask(argv[4], &job.ncells);
+  ncells = job.ncells;
+  if (ncells == 0) {
+    fprintf(stderr, "No valid cells in mask %s \n", argv[4]);
+    exit(EXIT_FAILURE);
+  }
+  job.nsteps = nr_timesteps(argv[1], ncells, job.binflag);
+  for (v = 1; v < NVARS; v++)
+    if (nr_timesteps(argv[1+v], ncells, job.binflag) < job.nsteps) {
+      fprintf(stderr, "%s has fewer time steps than %s \n", argv[1+v], argv[1]);
+      exit(EXIT_FAILURE);
+    }
+  printf("cells  = %d \n", ncells);
+  printf("timesteps = %ld \n", job.nsteps);
+  if (job.nsteps == 0) exit(EXIT_FAILURE);
+
+  /* pass 1 holds a time-major and a cell-major copy of each block */
+  bsteps = (long)(mem / (2. * ncells * job.rsize));
+  if (bsteps < 1) bsteps = 1;
+  if (bsteps > job.nsteps) bsteps = job.nsteps;
+  nblocks = (job.nsteps + bsteps - 1) / bsteps;
+  blkbytes = (size_t)bsteps * ncells * job.rsize;
+  printf("block = %ld timesteps, %ld blocks \n", bsteps, nblocks);
+
+  for (v = 0; v < NVARS; v++)
+    fpin[v] = xfopen(argv[1+v], (job.binflag == 1) ? "rb" : "r");
+  in  = (char *)xcalloc(blkbytes, 1, "input block");
+  blk = (char *)xcalloc(blkbytes, 1, "transposed block");
+  if (nblocks > 1) {
+    sprintf(spill, "%s/vicinput_ooc.%ld.spill", tmp_dir, (long)getpid());
+    fpspill = xfopen(spill, "w+b");
+  }
+
+  /*** Pass 1: read, transpose and spill blocks of time steps ***/
+  memset(&proto, 0, sizeof(proto));
+  proto.job = &job;
+  for (b = 0; b < nblocks; b++) {
+    nb = (b < nblocks - 1) ? bsteps : job.nsteps - b * bsteps;
+    for (v = 0; v < NVARS; v++) {
+      rw[v] = proto;
+      rw[v].fp = fpin[v];
+      rw[v].nb = nb;
+      rw[v].in = in + (size_t)v * nb * ncells * job.esize;
+      pthread_create(&rtid[v], NULL, read_var, &rw[v]);
+    }
+    for (v = 0; v < NVARS; v++) {
+      pthread_join(rtid[v], NULL);
+      if (rw[v].error) {
+        fprintf(stderr, "Error reading %s at block %ld \n", varname[v], b);
+        exit(EXIT_FAILURE);
+      }
+    }
+    proto.in = in;
+    proto.out = blk;
+    proto.nb = nb;
+    run_threads(&job, transpose, &proto, 0, ncells, &nneg);
+    if (fpspill != NULL &&
+        fwrite(blk, job.rsize, (size_t)nb * ncells, fpspill) != (size_t)nb * ncells) {
+      fprintf(stderr, "Error writing spill file %s \n", spill);
+      exit(EXIT_FAILURE);
+    }
+    printf(" timestep %ld \n", b * bsteps + nb);
+  }
+  for (v = 0; v < NVARS; v++) fclose(fpin[v]);
+  free(in);
+  if (nneg > 0)
+    fprintf(stderr, "neg. prcp reset to 0 (%ld values)\n", nneg);
+
+  /*** Pass 2: gather complete series by groups of cells and write ***/
+  proto.in = out_dir;
+  if (fpspill == NULL) {
+    /* the single block already holds the complete series of all cells */
+    proto.out = blk;
+    proto.g0 = 0;
+    run_threads(&job, write_cells, &proto, 0, ncells, NULL);
+  }
+  else {
+    free(blk);
+    gcells = (long)(mem / ((double)(job.nsteps + bsteps) * job.rsize));
+    if (gcells < 1) gcells = 1;
+    if (gcells > ncells) gcells = ncells;
+    gbuf = (char *)xcalloc((size_t)gcells * job.nsteps, job.rsize, "group");
+    gblk = (char *)xcalloc((size_t)gcells * bsteps, job.rsize, "group block");
+    printf("group = %ld cells \n", gcells);
+    for (c0 = 0; c0 < ncells; c0 += gcells) {
+      c1 = (c0 + gcells < ncells) ? c0 + gcells : ncells;
+      for (b = 0, t0 = 0; b < nblocks; b++, t0 += nb) {
+        nb = (b < nblocks - 1) ? bsteps : job.nsteps - b * bsteps;
+        fseeko(fpspill, ((off_t)b * bsteps * ncells + (off_t)c0 * nb)
+               * (off_t)job.rsize, SEEK_SET);
+        if (fread(gblk, job.rsize, (size_t)(c1 - c0) * nb, fpspill)
+            != (size_t)(c1 - c0) * nb) {
+          fprintf(stderr, "Error reading spill file %s \n", spill);
+          exit(EXIT_FAILURE);
+        }
+        for (c = c0; c < c1; c++)
+          memcpy(gbuf + ((size_t)(c - c0) * job.nsteps + t0) * job.rsize,
+                 gblk + (size_t)(c - c0) * nb * job.rsize,
+                 (size_t)nb * job.rsize);
+      }
+      proto.out = gbuf;
+      proto.g0 = c0;
+      run_threads(&job, write_cells, &proto, c0, c1, NULL);
+      printf(" cells %d \n", c1);
+    }
+    fclose(fpspill);
+    remove(spill);
+    free(gbuf);
+    free(gblk);
+  }
+  if (fpspill == NULL) free(blk);
+
+  for (c = 0; c < ncells; c++) free(job.names[c]);
+  free(job.names);
+  return 0;
+}
+/*** END main    *************/